@@ -34,6 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AdaptiveAlignment.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -41,6 +45,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
@@ -49,12 +54,68 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/ITK/itkBridge.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/PhaseCorrelation.hpp"
 
 #include "itkHoughTransform2DCirclesImageFilter.h"
 
+namespace
+{
+/**
+ * @brief The FindPhaseCorrelationPeaksImpl class finds the phase correlation peaks of a range of section pairs.
+ * Consecutive pairs share a section, so the spectrum of each section in the range is computed only once.
+ */
+class FindPhaseCorrelationPeaksImpl
+{
+public:
+  FindPhaseCorrelationPeaksImpl(const std::function<void(int64_t, float*)>& fillSectionImage, const std::array<int64_t, 3>& dims, size_t numPeaks,
+                                std::vector<std::vector<PhaseCorrelation::Peak>>& peaks)
+  : m_FillSectionImage(fillSectionImage)
+  , m_Dims(dims)
+  , m_NumPeaks(numPeaks)
+  , m_Peaks(peaks)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    PhaseCorrelation phaseCorrelation(m_Dims[0], m_Dims[1]);
+    std::vector<float> image(static_cast<size_t>(m_Dims[0] * m_Dims[1]), 0.0f);
+    PhaseCorrelation::SpectrumType reference;
+    PhaseCorrelation::SpectrumType moving;
+    // A shift must stay inside the 2 * halfDim grid searched by the subclasses
+    const int64_t maxShiftX = static_cast<int64_t>(m_Dims[0] * 0.5f) - 1;
+    const int64_t maxShiftY = static_cast<int64_t>(m_Dims[1] * 0.5f) - 1;
+    for(size_t iter = range.min(); iter < range.max(); iter++)
+    {
+      const int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+      if(iter == range.min())
+      {
+        m_FillSectionImage(slice + 1, image.data());
+        phaseCorrelation.transform(image.data(), reference);
+      }
+      else
+      {
+        // The moving section of the previous pair is the reference section of this one
+        reference.swap(moving);
+      }
+      m_FillSectionImage(slice, image.data());
+      phaseCorrelation.transform(image.data(), moving);
+      m_Peaks[iter] = phaseCorrelation.findPeaks(reference, moving, m_NumPeaks, maxShiftX, maxShiftY);
+    }
+  }
+
+private:
+  const std::function<void(int64_t, float*)>& m_FillSectionImage;
+  std::array<int64_t, 3> m_Dims;
+  size_t m_NumPeaks;
+  std::vector<std::vector<PhaseCorrelation::Peak>>& m_Peaks;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -115,6 +176,20 @@ void AdaptiveAlignment::setupFilterParameters()
     parameters.push_back(SIMPL_NEW_FLOAT_FP("Total Shift In X-Direction (Microns)", ShiftX, FilterParameter::Category::Parameter, AdaptiveAlignment, {2}));
     parameters.push_back(SIMPL_NEW_FLOAT_FP("Total Shift In Y-Direction (Microns)", ShiftY, FilterParameter::Category::Parameter, AdaptiveAlignment, {2}));
   }
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Shift Search");
+    parameter->setPropertyName("ShiftSearch");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(AdaptiveAlignment, this, ShiftSearch));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(AdaptiveAlignment, this, ShiftSearch));
+    std::vector<QString> choices;
+    choices.push_back("Local Search");
+    choices.push_back("Phase Correlation + Local Search");
+    choices.push_back("Phase Correlation");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
   {
     MultiDataArraySelectionFilterParameter::RequirementType req;
     parameters.push_back(SIMPL_NEW_MDA_SELECTION_FP("Attribute Arrays to Ignore", IgnoredDataArrayPaths, FilterParameter::Category::Parameter, AdaptiveAlignment, req));
@@ -131,6 +206,7 @@ void AdaptiveAlignment::readFilterParameters(AbstractFilterParametersReader* rea
   setAlignmentShiftFileName(reader->readString("AlignmentShiftFileName", getAlignmentShiftFileName()));
   setWriteAlignmentShifts(reader->readValue("WriteAlignmentShifts", getWriteAlignmentShifts()));
   setGlobalCorrection(reader->readValue("UseImages", getGlobalCorrection()));
+  setShiftSearch(reader->readValue("ShiftSearch", getShiftSearch()));
   setImageDataArrayPath(reader->readDataArrayPath("ImageDataArrayPath", getImageDataArrayPath()));
   setShiftX(reader->readValue("ShiftX", getShiftX()));
   setShiftY(reader->readValue("ShiftY", getShiftY()));
@@ -648,6 +724,99 @@ void AdaptiveAlignment::find_shifts(std::vector<int64_t>& xshifts, std::vector<i
 {
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AdaptiveAlignment::find_phase_correlation_shifts(const std::function<void(int64_t, float*)>& fillSectionImage, std::vector<std::vector<int64_t>>& newxshift,
+                                                      std::vector<std::vector<int64_t>>& newyshift, std::vector<std::vector<float>>& mindisorientation)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+
+  const std::array<int64_t, 3> dims = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+
+  notifyStatusMessage("Aligning Anisotropic Sections || Phase Correlation");
+
+  const bool phaseCorrelationOnly = (m_ShiftSearch == 2);
+  size_t numPeaks = 1;
+  if(phaseCorrelationOnly && dims[2] > 1)
+  {
+    numPeaks = newxshift[1].size();
+  }
+
+  std::vector<std::vector<PhaseCorrelation::Peak>> peaks(dims[2]);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, static_cast<size_t>(std::max<int64_t>(dims[2], 1)));
+  dataAlg.execute(FindPhaseCorrelationPeaksImpl(fillSectionImage, dims, numPeaks, peaks));
+
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    // The filter applies whole Cell shifts, so the sub-pixel peak is rounded
+    for(size_t p = 0; p < peaks[iter].size() && p < newxshift[iter].size(); p++)
+    {
+      newxshift[iter][p] = static_cast<int64_t>(std::lround(peaks[iter][p].subX));
+      newyshift[iter][p] = static_cast<int64_t>(std::lround(peaks[iter][p].subY));
+      if(phaseCorrelationOnly)
+      {
+        mindisorientation[iter][p] = 1.0f - peaks[iter][p].value;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<uint64_t> AdaptiveAlignment::correct_shifts(const std::vector<std::vector<int64_t>>& newxshift, const std::vector<std::vector<int64_t>>& newyshift,
+                                                        const std::vector<std::vector<float>>& mindisorientation, const std::vector<float>& xneedshifts, const std::vector<float>& yneedshifts,
+                                                        GlobalShiftCorrection::ScoreChange scoreChange)
+{
+  if(xneedshifts.empty())
+  {
+    return std::vector<uint64_t>(newxshift.size(), 0);
+  }
+
+  QString ss = QObject::tr("Aligning Anisotropic Sections || Correcting shifts");
+  notifyStatusMessage(ss);
+
+  GlobalShiftCorrection correction(newxshift, newyshift, mindisorientation, scoreChange);
+  if(xneedshifts.size() == 1) // error is computed as misagreement between slopes
+  {
+    correction.setTargetTrend(xneedshifts[0], yneedshifts[0]);
+  }
+  else // error is computed as misagreement with shifts estimated from SEM images
+  {
+    correction.setTargetShifts(xneedshifts, yneedshifts);
+  }
+
+  // iterative selection of a candidate shift, recomputing of current candidates, evaluation of error
+  if(correction.needsCorrection())
+  {
+    uint64_t progInt2 = 0;
+    bool improving = true;
+    while(improving)
+    {
+      ss = QObject::tr("Aligning Anisotropic Sections || Correcting Shifts || Iteration %1").arg(++progInt2);
+      notifyStatusMessage(ss);
+      if(getCancel())
+      {
+        return correction.getSelection();
+      }
+      improving = correction.iterate();
+    }
+  }
+
+  const GlobalShiftCorrection::Timings& timings = correction.getTimings();
+  ss = QObject::tr("Aligning Anisotropic Sections || Correcting Shifts || %1 Iterations, Setup %2 ms, Correction %3 ms")
+           .arg(timings.iterations)
+           .arg(timings.setupMilliseconds, 0, 'f', 1)
+           .arg(timings.correctionMilliseconds, 0, 'f', 1);
+  notifyStatusMessage(ss);
+
+  return correction.getSelection();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -993,6 +1162,18 @@ int AdaptiveAlignment::getGlobalCorrection() const
   return m_GlobalCorrection;
 }
 
+// -----------------------------------------------------------------------------
+void AdaptiveAlignment::setShiftSearch(int value)
+{
+  m_ShiftSearch = value;
+}
+
+// -----------------------------------------------------------------------------
+int AdaptiveAlignment::getShiftSearch() const
+{
+  return m_ShiftSearch;
+}
+
 // -----------------------------------------------------------------------------
 void AdaptiveAlignment::setInputPath(const QString& value)
 {
@@ -35,7 +35,9 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -44,6 +46,7 @@
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewDLLExport.h"
 #include "DREAM3DReview/DREAM3DReviewItkConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/GlobalShiftCorrection.hpp"
 
 /**
  * @brief The AdaptiveAlignment class. This class serves as a superclass for other classes
@@ -59,6 +62,7 @@ class DREAM3DReview_EXPORT AdaptiveAlignment : public AbstractFilter
   PYB11_SHARED_POINTERS(AdaptiveAlignment)
   PYB11_FILTER_NEW_MACRO(AdaptiveAlignment)
   PYB11_PROPERTY(int GlobalCorrection READ getGlobalCorrection WRITE setGlobalCorrection)
+  PYB11_PROPERTY(int ShiftSearch READ getShiftSearch WRITE setShiftSearch)
   PYB11_PROPERTY(QString InputPath READ getInputPath WRITE setInputPath)
   PYB11_PROPERTY(float ShiftX READ getShiftX WRITE setShiftX)
   PYB11_PROPERTY(float ShiftY READ getShiftY WRITE setShiftY)
@@ -146,6 +150,17 @@ public:
   int getGlobalCorrection() const;
   Q_PROPERTY(int GlobalCorrection READ getGlobalCorrection WRITE setGlobalCorrection)
 
+  /**
+   * @brief Setter property for ShiftSearch
+   */
+  void setShiftSearch(int value);
+  /**
+   * @brief Getter property for ShiftSearch
+   * @return Value of ShiftSearch
+   */
+  int getShiftSearch() const;
+  Q_PROPERTY(int ShiftSearch READ getShiftSearch WRITE setShiftSearch)
+
   /**
    * @brief Setter property for InputPath
    */
@@ -360,6 +375,35 @@ protected:
    */
   virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, std::vector<float>& xneedshifts, std::vector<float>& yneedshifts);
 
+  /**
+   * @brief find_phase_correlation_shifts Estimates the shift of every section against the section above it from the
+   * phase correlation of their section images, in parallel over the section pairs.  With the "Phase Correlation"
+   * shift search the highest peaks are stored as the candidate shifts, scored 1 - peak height; otherwise only the
+   * highest peak is stored, as the starting point of the local search.
+   * @param fillSectionImage Writes the dims[0] * dims[1] image of a section; called from several threads at once
+   * @param newxshift Candidate x-shifts of each section pair
+   * @param newyshift Candidate y-shifts of each section pair
+   * @param mindisorientation Scores of the candidate shifts
+   */
+  void find_phase_correlation_shifts(const std::function<void(int64_t, float*)>& fillSectionImage, std::vector<std::vector<int64_t>>& newxshift, std::vector<std::vector<int64_t>>& newyshift,
+                                     std::vector<std::vector<float>>& mindisorientation);
+
+  /**
+   * @brief correct_shifts Adapts the shifts to the complementary criterion, the shifts estimated from the SEM images
+   * or the user defined total shift, by swapping candidate shifts with @see GlobalShiftCorrection.  Reports the time
+   * spent in each stage of the correction when done.
+   * @param newxshift Candidate x-shifts of each section pair, best first
+   * @param newyshift Candidate y-shifts of each section pair, best first
+   * @param mindisorientation Scores of the candidate shifts
+   * @param xneedshifts One total shift, or the shift of each section pair estimated from the SEM images; empty for no correction
+   * @param yneedshifts
+   * @param scoreChange How a candidate score is compared to the best score of its section pair
+   * @return Index of the selected candidate of every section pair
+   */
+  std::vector<uint64_t> correct_shifts(const std::vector<std::vector<int64_t>>& newxshift, const std::vector<std::vector<int64_t>>& newyshift,
+                                       const std::vector<std::vector<float>>& mindisorientation, const std::vector<float>& xneedshifts, const std::vector<float>& yneedshifts,
+                                       GlobalShiftCorrection::ScoreChange scoreChange);
+
 private:
   std::weak_ptr<DataArray<DREAM3DReviewConstants::DefaultPixelType>> m_ImageDataPtr;
   DREAM3DReviewConstants::DefaultPixelType* m_ImageData = nullptr;
@@ -371,6 +415,7 @@ private:
   bool m_WriteAlignmentShifts = {false};
   QString m_AlignmentShiftFileName = {""};
   int m_GlobalCorrection = {0};
+  int m_ShiftSearch = {0};
   QString m_InputPath = {""};
   float m_ShiftX = {0.0f};
   float m_ShiftY = {0.0f};
@@ -173,14 +173,30 @@ void AdaptiveAlignmentFeature::find_shifts(std::vector<int64_t>& xshifts, std::v
   int64_t curposition = 0;
   uint64_t progInt = 0;
 
+  if(getShiftSearch() != 0)
+  {
+    const bool* goodVoxels = m_GoodVoxels;
+    const int64_t sliceSize = dims[0] * dims[1];
+    find_phase_correlation_shifts(
+        [goodVoxels, sliceSize](int64_t section, float* image) {
+          for(int64_t i = 0; i < sliceSize; i++)
+          {
+            image[i] = goodVoxels[section * sliceSize + i] ? 1.0f : 0.0f;
+          }
+        },
+        newxshift, newyshift, mindisorientation);
+  }
+
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
     progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
     QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
 
     slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
+    // The search starts from the stored shift, the phase correlation estimate if there is one; with phase
+    // correlation alone there is no search
+    oldxshift = (getShiftSearch() == 2) ? newxshift[iter][0] : newxshift[iter][0] - 1;
+    oldyshift = (getShiftSearch() == 2) ? newyshift[iter][0] : newyshift[iter][0] - 1;
 
     for(size_t i = 0; i < udims[0]; i++)
     {
@@ -253,124 +269,10 @@ void AdaptiveAlignmentFeature::find_shifts(std::vector<int64_t>& xshifts, std::v
     yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
   }
 
-  std::vector<uint64_t> curindex(dims[2], 0);
-
-  // find corrected shifts
-  if(!xneedshifts.empty())
+  std::vector<uint64_t> curindex = correct_shifts(newxshift, newyshift, mindisorientation, xneedshifts, yneedshifts, GlobalShiftCorrection::ScoreChange::Difference);
+  if(getCancel())
   {
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Correcting shifts");
-    notifyStatusMessage(ss);
-
-    std::vector<float> changedisorientation(dims[2], 0);
-    std::vector<uint64_t> changeindex(dims[2], 0);
-    std::vector<float> changeerror(dims[2], 0);
-
-    std::vector<float> xshiftsest; // cumulative x-shifts estimated from SEM images
-    std::vector<float> yshiftsest; // cumulative y-shifts estimated from SEM images
-
-    float curerror = 0.0f;
-    float tolerance = 0.0f;
-
-    // evaluate error between current shifts and desired shifts
-    if(xneedshifts.size() == 1) // error is computed as misagreement between slopes
-    {
-      tolerance = 1.0f / static_cast<float>(dims[2] - 1);
-      curerror = compute_error1(dims[2], 0, xneedshifts[0], yneedshifts[0], newxshift, newyshift, curindex);
-    }
-    else if(xneedshifts.size() > 1) // error is computed as misagreement with shifts estimated from SEM images
-    {
-      tolerance = 1.0f;
-      xshiftsest.resize(dims[2], 0);
-      yshiftsest.resize(dims[2], 0);
-      for(size_t iter = 1; iter < udims[2]; iter++)
-      {
-        xshiftsest[iter] = xshiftsest[iter - 1] + xneedshifts[iter - 1];
-        yshiftsest[iter] = yshiftsest[iter - 1] + yneedshifts[iter - 1];
-      }
-      curerror = compute_error2(dims[2], 0, xshiftsest, yshiftsest, newxshift, newyshift, curindex);
-    }
-
-    // iterative selection of a candidate shift, recomputing of current candidates, evaluation of error
-    if(curerror > tolerance)
-    {
-      float minchangedisorientation = 0;
-      float minchangeerror = 0;
-      int64_t minchangeindex = 0;
-      int64_t minchangeiter = 0;
-      float olderror = 0;
-      float newerror = 0;
-      uint64_t progInt2 = 0;
-
-      do
-      {
-        ss = QObject::tr("Aligning Anisotropic Sections || Correcting Shifts || Iteration %1").arg(++progInt2);
-        notifyStatusMessage(ss);
-        if(getCancel())
-        {
-          return;
-        }
-
-        olderror = curerror;
-        for(size_t iter = 1; iter < udims[2]; iter++)
-        {
-          float newminerror = std::numeric_limits<float>::max();
-          float newmindisorientation = std::numeric_limits<float>::max();
-          uint64_t newminindex = 0;
-          for(uint64_t index = curindex[iter] + 1; index < maxstoredshifts; index++)
-          {
-            // recompute error for the configuration with this candidate changed
-            if(xneedshifts.size() == 1)
-            {
-              newerror = compute_error1(iter, index, xneedshifts[0], yneedshifts[0], newxshift, newyshift, curindex);
-            }
-            else if(xneedshifts.size() > 1)
-            {
-              newerror = compute_error2(iter, index, xshiftsest, yshiftsest, newxshift, newyshift, curindex);
-            }
-
-            // compare the new error with the best current error
-            if(newerror < curerror && mindisorientation[iter][index] - mindisorientation[iter][0] < newmindisorientation)
-            {
-              newminerror = newerror;
-              newminindex = index;
-              newmindisorientation = mindisorientation[iter][index] - mindisorientation[iter][0];
-            }
-          }
-          // assign best error, corresponding index and disorientation value for this slice
-          changeerror[iter] = newminerror;
-          changeindex[iter] = newminindex;
-          changedisorientation[iter] = newmindisorientation;
-        }
-
-        // among all slices, find the best candidate (with minimum disorientation change)
-        minchangedisorientation = std::numeric_limits<float>::max() - 1;
-        minchangeerror = std::numeric_limits<float>::max();
-        minchangeindex = 0;
-        minchangeiter = 0;
-        for(size_t iter = 1; iter < udims[2]; iter++)
-        {
-          if(changeerror[iter] < curerror && (changedisorientation[iter] < minchangedisorientation ||
-                                              (changedisorientation[iter] == minchangedisorientation && llabs(newxshift[iter][changeindex[iter]]) + llabs(newyshift[iter][changeindex[iter]]) <
-                                                                                                            llabs(newxshift[iter][minchangeindex]) + llabs(newyshift[iter][minchangeindex]))))
-          {
-            minchangeiter = iter;
-            minchangeindex = changeindex[iter];
-            minchangedisorientation = changedisorientation[iter];
-            minchangeerror = changeerror[iter];
-          }
-        }
-
-        if(minchangeerror < curerror && minchangeerror >= tolerance)
-        {
-          // assign the best candidate
-          changedisorientation[minchangeiter] = minchangedisorientation;
-          curindex[minchangeiter] = minchangeindex;
-          // reassign current error
-          curerror = minchangeerror;
-        }
-
-      } while(minchangedisorientation < std::numeric_limits<float>::max() - 1 && curerror < olderror && curerror > tolerance);
-    }
+    return;
   }
 
   if(getWriteAlignmentShifts())
@@ -388,91 +290,6 @@ void AdaptiveAlignmentFeature::find_shifts(std::vector<int64_t>& xshifts, std::v
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-// find the error if the current shifts are changed by modification provided on slice 'iter'
-// where currently selected shift is substituted by the shift stored in position 'index'
-float AdaptiveAlignmentFeature::compute_error1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, std::vector<std::vector<int64_t>>& newxshift,
-                                               std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex)
-{
-  int64_t n = curindex.size() - 1;
-
-  int64_t xshifts = 0;
-  int64_t yshifts = 0;
-
-  double sumX = 0.0f;
-  double sumX_2 = 0.0f;
-  double x_sumY = 0.0f;
-  double x_sumXY = 0.0f;
-  double y_sumY = 0.0f;
-  double y_sumXY = 0.0f;
-
-  for(int64_t i = 1; i <= n; i++)
-  {
-    if(i != iter) // shifts without modification
-    {
-      xshifts += newxshift[i][curindex[i]];
-      yshifts += newyshift[i][curindex[i]];
-    }
-    else // modified shift
-    {
-      xshifts += newxshift[i][index];
-      yshifts += newyshift[i][index];
-    }
-    // all values are divided by n for better numerical stability
-    sumX += static_cast<double>(i) / static_cast<double>(n);
-    sumX_2 += static_cast<double>(i * i) / static_cast<double>(n * n);
-    x_sumY += static_cast<double>(xshifts) / static_cast<double>(n);
-    x_sumXY += static_cast<double>(i * xshifts) / static_cast<double>(n * n);
-    y_sumY += static_cast<double>(yshifts) / static_cast<double>(n);
-    y_sumXY += static_cast<double>(i * yshifts) / static_cast<double>(n * n);
-  }
-
-  double xtrend = static_cast<double>((n * x_sumXY - sumX * x_sumY) / (n * sumX_2 - sumX * sumX));
-  double ytrend = static_cast<double>((n * y_sumXY - sumX * y_sumY) / (n * sumX_2 - sumX * sumX));
-
-  // error is computed from angular deviation as
-  // |xang1 - xang2| + |yang1 - yang2| = |arctg(xtrend) - arctg(xneedtrend)| + |arctg(ytrend) - arctg(yneedtrend)|
-  return std::fabs(atan(xtrend) - atan(xneedtrend)) + std::fabs(atan(ytrend) - atan(yneedtrend));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float AdaptiveAlignmentFeature::compute_error2(uint64_t iter, uint64_t index, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest, std::vector<std::vector<int64_t>>& newxshift,
-                                               std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex)
-{
-  uint64_t n = curindex.size() - 1;
-
-  int64_t xshifts = 0;
-  int64_t yshifts = 0;
-
-  float error = 0;
-  float xdif = 0;
-  float ydif = 0;
-  float divide = static_cast<float>(2 * n);
-
-  for(uint64_t i = 1; i <= n; i++)
-  {
-    if(i != iter)
-    {
-      xshifts += newxshift[i][curindex[i]];
-      yshifts += newyshift[i][curindex[i]];
-    }
-    else
-    {
-      xshifts += newxshift[i][index];
-      yshifts += newyshift[i][index];
-    }
-
-    xdif = static_cast<float>(xshifts) - xshiftsest[i];
-    ydif = static_cast<float>(yshifts) - yshiftsest[i];
-    error += (xdif * xdif + ydif * ydif) / divide;
-  }
-  return error;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
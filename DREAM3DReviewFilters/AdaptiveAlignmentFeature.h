@@ -180,36 +180,6 @@ protected:
    */
   void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, std::vector<float>& xneedshifts, std::vector<float>& yneedshifts) override;
 
-  /**
-   * @brief compute_error1 Determines error between the current and desired shifts
-   * (based on discrepancy of slopes)
-   * @param iter
-   * @param index
-   * @param xneedtrend
-   * @param yneedtrend
-   * @param newxshift
-   * @param newyshift
-   * @param curindex
-   * @return
-   */
-  virtual float compute_error1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, std::vector<std::vector<int64_t>>& newxshift, std::vector<std::vector<int64_t>>& newyshift,
-                               std::vector<uint64_t>& curindex);
-
-  /**
-   * @brief compute_error1 Determines error between the current and desired shifts
-   * (based on discrepancy from the estimates obtained from SEM images)
-   * @param iter
-   * @param index
-   * @param xshiftsest
-   * @param yshiftsest
-   * @param newxshift
-   * @param newyshift
-   * @param curindex
-   * @return
-   */
-  virtual float compute_error2(uint64_t iter, uint64_t index, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest, std::vector<std::vector<int64_t>>& newxshift,
-                               std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex);
-
 private:
   std::weak_ptr<DataArray<bool>> m_GoodVoxelsPtr;
   bool* m_GoodVoxels = nullptr;
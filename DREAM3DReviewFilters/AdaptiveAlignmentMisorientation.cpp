@@ -35,7 +35,15 @@
 
 #include "AdaptiveAlignmentMisorientation.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
@@ -46,16 +54,355 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/SymmetricMisorientation.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+namespace
+{
+/**
+ * @brief The SliceShiftSearch class finds the shift of one section against the section above it by descending
+ * through a 7x7 stencil of shifts until the best shift is the center of the stencil.  The score of a shift is the
+ * fraction of sampled Cell pairs whose misorientation exceeds the tolerance.  Every score is cached, so a shift is
+ * evaluated once however often the stencil passes over it.  The misorientations of a shift are found in batches: the
+ * misorientation products of all sampled pairs of one crystal structure are gathered into structure of arrays
+ * buffers and reduced against each symmetry operator in turn.
+ */
+class SliceShiftSearch
+{
+public:
+  SliceShiftSearch(const float* quats, const int32_t* cellPhases, const bool* goodVoxels, const uint32_t* crystalStructures,
+                   const std::vector<SymmetricMisorientation::SymmetryTable>& symmetryTables, const std::array<int64_t, 3>& dims, float misorientationToleranceRad)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_CrystalStructures(crystalStructures)
+  , m_SymmetryTables(symmetryTables)
+  , m_Dims(dims)
+  , m_CosHalfTolerance(std::cos(0.5 * static_cast<double>(misorientationToleranceRad)))
+  , m_Batches(symmetryTables.size())
+  {
+  }
+
+  /**
+   * @brief search Descends from a starting shift with stencil steps of the given size, sampling every sampleStep
+   * Cells in x and y, and keeps the best shifts found
+   * @param slice Section compared with the section above it
+   * @param startX
+   * @param startY
+   * @param stepSize Distance between neighboring shifts of the stencil
+   * @param sampleStep
+   * @param xshifts Best x shifts, best first; the size is the number of shifts to keep
+   * @param yshifts Best y shifts
+   * @param scores Scores of the best shifts
+   */
+  void search(int64_t slice, int64_t startX, int64_t startY, int64_t stepSize, int64_t sampleStep, std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, std::vector<float>& scores)
+  {
+    const int64_t halfDim0 = static_cast<int64_t>(m_Dims[0] * 0.5f);
+    const int64_t halfDim1 = static_cast<int64_t>(m_Dims[1] * 0.5f);
+    const size_t maxStoredShifts = xshifts.size();
+    std::fill(xshifts.begin(), xshifts.end(), startX);
+    std::fill(yshifts.begin(), yshifts.end(), startY);
+    std::fill(scores.begin(), scores.end(), std::numeric_limits<float>::max());
+    std::unordered_map<int64_t, float> cache;
+
+    int64_t oldxshift = 0;
+    int64_t oldyshift = 0;
+    bool firstPass = true;
+    while(firstPass || xshifts[0] != oldxshift || yshifts[0] != oldyshift)
+    {
+      firstPass = false;
+      oldxshift = xshifts[0];
+      oldyshift = yshifts[0];
+      for(int64_t j = -3; j <= 3; j++)
+      {
+        for(int64_t k = -3; k <= 3; k++)
+        {
+          const int64_t xshift = oldxshift + k * stepSize;
+          const int64_t yshift = oldyshift + j * stepSize;
+          if(std::llabs(xshift) >= halfDim0 || std::llabs(yshift) >= halfDim1)
+          {
+            continue;
+          }
+          const int64_t key = (xshift + halfDim0) * (2 * halfDim1 + 1) + (yshift + halfDim1);
+          if(cache.find(key) != cache.end())
+          {
+            continue;
+          }
+          const float disorientation = score(slice, xshift, yshift, sampleStep);
+          cache[key] = disorientation;
+
+          // compare the new shift with currently stored ones
+          int64_t s = maxStoredShifts;
+          while(s - 1 >= 0 && disorientation < scores[s - 1])
+          {
+            s--;
+          }
+
+          // new shift is stored with index 's' in the arrays
+          if(s < static_cast<int64_t>(maxStoredShifts))
+          {
+            // lag the shifts already stored
+            for(int64_t t = maxStoredShifts - 1; t > s; t--)
+            {
+              xshifts[t] = xshifts[t - 1];
+              yshifts[t] = yshifts[t - 1];
+              scores[t] = scores[t - 1];
+            }
+            // store the new shift
+            xshifts[s] = xshift;
+            yshifts[s] = yshift;
+            scores[s] = disorientation;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief fillBoundaryImage Marks the Cells of a section that lie on a boundary with the next Cell in x or in y:
+   * the two Cells differ in mask or phase, or are misoriented by more than the tolerance.  The boundary network is
+   * what the phase correlation of two sections lines up.
+   * @param section
+   * @param image dims[0] * dims[1] values, 1 on a boundary and 0 elsewhere
+   */
+  void fillBoundaryImage(int64_t section, float* image) const
+  {
+    const size_t sliceSize = static_cast<size_t>(m_Dims[0] * m_Dims[1]);
+    for(int64_t l = 0; l < m_Dims[1]; l++)
+    {
+      for(int64_t n = 0; n < m_Dims[0]; n++)
+      {
+        const size_t position = section * sliceSize + l * m_Dims[0] + n;
+        const bool boundary = (n + 1 < m_Dims[0] && isBoundary(position, position + 1)) || (l + 1 < m_Dims[1] && isBoundary(position, position + m_Dims[0]));
+        image[l * m_Dims[0] + n] = boundary ? 1.0f : 0.0f;
+      }
+    }
+  }
+
+private:
+  const float* m_Quats = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  const uint32_t* m_CrystalStructures = nullptr;
+  const std::vector<SymmetricMisorientation::SymmetryTable>& m_SymmetryTables;
+  std::array<int64_t, 3> m_Dims;
+  double m_CosHalfTolerance = 1.0;
+
+  /**
+   * @brief The Batch struct holds the misorientation products of the sampled pairs of one crystal structure
+   */
+  struct Batch
+  {
+    std::vector<double> w;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> best;
+
+    void clear()
+    {
+      w.clear();
+      x.clear();
+      y.clear();
+      z.clear();
+    }
+  };
+  std::vector<Batch> m_Batches;
+
+  /**
+   * @brief score Returns the fraction of sampled Cell pairs between a section and the section above it that are
+   * misoriented by more than the tolerance when the section is shifted, counting pairs with one masked Cell as
+   * misoriented
+   */
+  float score(int64_t slice, int64_t xshift, int64_t yshift, int64_t sampleStep)
+  {
+    const bool useGoodVoxels = (m_GoodVoxels != nullptr);
+    const size_t sliceSize = static_cast<size_t>(m_Dims[0] * m_Dims[1]);
+    size_t count = 0;
+    size_t disorientation = 0;
+    for(Batch& batch : m_Batches)
+    {
+      batch.clear();
+    }
+
+    for(int64_t l = 0; l < m_Dims[1]; l += sampleStep)
+    {
+      if(l + yshift < 0 || l + yshift >= m_Dims[1])
+      {
+        continue;
+      }
+      for(int64_t n = 0; n < m_Dims[0]; n += sampleStep)
+      {
+        if(n + xshift < 0 || n + xshift >= m_Dims[0])
+        {
+          continue;
+        }
+        count++;
+        const size_t refposition = (slice + 1) * sliceSize + l * m_Dims[0] + n;
+        const size_t curposition = slice * sliceSize + (l + yshift) * m_Dims[0] + (n + xshift);
+        if(useGoodVoxels && m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+        {
+          disorientation++;
+          continue;
+        }
+        if(useGoodVoxels && !m_GoodVoxels[refposition])
+        {
+          continue;
+        }
+        if(m_CellPhases[refposition] <= 0 || m_CellPhases[curposition] <= 0)
+        {
+          disorientation++;
+          continue;
+        }
+        const uint32_t phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+        const uint32_t phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+        if(phase1 != phase2 || phase1 >= static_cast<uint32_t>(m_SymmetryTables.size()))
+        {
+          disorientation++;
+          continue;
+        }
+        Batch& batch = m_Batches[phase1];
+        const QuatD product = SymmetricMisorientation::FindMisorientationProduct(m_Quats + refposition * 4, m_Quats + curposition * 4);
+        batch.w.push_back(product.w());
+        batch.x.push_back(product.x());
+        batch.y.push_back(product.y());
+        batch.z.push_back(product.z());
+      }
+    }
+
+    if(count == 0)
+    {
+      // Only sparse coarse samples can miss the overlap of the sections entirely
+      return std::numeric_limits<float>::max();
+    }
+    for(size_t phase = 0; phase < m_Batches.size(); phase++)
+    {
+      disorientation += countMisoriented(phase);
+    }
+    return static_cast<float>(disorientation) / static_cast<float>(count);
+  }
+
+  bool isBoundary(size_t position1, size_t position2) const
+  {
+    if(m_GoodVoxels != nullptr)
+    {
+      if(m_GoodVoxels[position1] != m_GoodVoxels[position2])
+      {
+        return true;
+      }
+      if(!m_GoodVoxels[position1])
+      {
+        return false;
+      }
+    }
+    if(m_CellPhases[position1] != m_CellPhases[position2])
+    {
+      return true;
+    }
+    if(m_CellPhases[position1] <= 0)
+    {
+      return false;
+    }
+    const uint32_t phase = m_CrystalStructures[m_CellPhases[position1]];
+    if(phase >= static_cast<uint32_t>(m_SymmetryTables.size()))
+    {
+      return false;
+    }
+    const QuatD product = SymmetricMisorientation::FindMisorientationProduct(m_Quats + position1 * 4, m_Quats + position2 * 4);
+    return SymmetricMisorientation::FindMaxSymmetricCosine(m_SymmetryTables[phase], product) < m_CosHalfTolerance;
+  }
+
+  /**
+   * @brief countMisoriented Counts the pairs of a batch whose misorientation exceeds the tolerance.  The angle
+   * 2 * acos(|w|) exceeds the tolerance exactly when the largest |w| over the symmetric equivalents is below
+   * cos(tolerance / 2), so no angle is computed.  The two forms round differently, so a pair misoriented by the
+   * tolerance to within rounding may be counted where comparing the LaueOps angle with the tolerance would not, or the
+   * reverse; pairs 1e-4 radians or more away from the tolerance are always classified the same way.  isBoundary() uses
+   * the same test, so the boundary images and the scores always agree.
+   */
+  size_t countMisoriented(size_t phase)
+  {
+    Batch& batch = m_Batches[phase];
+    const size_t numPairs = batch.w.size();
+    if(numPairs == 0)
+    {
+      return 0;
+    }
+    batch.best.assign(numPairs, 0.0);
+    SymmetricMisorientation::FindMaxSymmetricCosines(m_SymmetryTables[phase], batch.w.data(), batch.x.data(), batch.y.data(), batch.z.data(), numPairs, batch.best.data());
+    const double cosHalfTolerance = m_CosHalfTolerance;
+    size_t misoriented = 0;
+    for(size_t i = 0; i < numPairs; i++)
+    {
+      misoriented += (batch.best[i] < cosHalfTolerance) ? 1 : 0;
+    }
+    return misoriented;
+  }
+};
+
+/**
+ * @brief The FindSliceShiftsImpl class finds the shifts of a range of section pairs.  The sections are independent,
+ * so each pair runs its own search; with coarse-to-fine levels the search first runs on sparser samples with wider
+ * stencil steps and each level starts from the best shift of the level above.
+ */
+class FindSliceShiftsImpl
+{
+public:
+  FindSliceShiftsImpl(const SliceShiftSearch& prototype, const std::array<int64_t, 3>& dims, int32_t coarseLevels, std::vector<std::vector<int64_t>>& newxshift,
+                      std::vector<std::vector<int64_t>>& newyshift, std::vector<std::vector<float>>& mindisorientation)
+  : m_Prototype(prototype)
+  , m_Dims(dims)
+  , m_CoarseLevels(coarseLevels)
+  , m_NewXShift(newxshift)
+  , m_NewYShift(newyshift)
+  , m_MinDisorientation(mindisorientation)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    SliceShiftSearch search = m_Prototype;
+    std::vector<int64_t> coarseX(1, 0);
+    std::vector<int64_t> coarseY(1, 0);
+    std::vector<float> coarseScores(1, 0.0f);
+    for(size_t iter = range.min(); iter < range.max(); iter++)
+    {
+      const int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+      // The shifts hold the phase correlation estimate when it is used, and zero otherwise
+      int64_t startX = m_NewXShift[iter][0];
+      int64_t startY = m_NewYShift[iter][0];
+      for(int32_t level = m_CoarseLevels; level > 0; level--)
+      {
+        const int64_t scale = int64_t(1) << level;
+        search.search(slice, startX, startY, scale, k_SampleStep * scale, coarseX, coarseY, coarseScores);
+        startX = coarseX[0];
+        startY = coarseY[0];
+      }
+      search.search(slice, startX, startY, 1, k_SampleStep, m_NewXShift[iter], m_NewYShift[iter], m_MinDisorientation[iter]);
+    }
+  }
+
+private:
+  static constexpr int64_t k_SampleStep = 4;
+  const SliceShiftSearch& m_Prototype;
+  std::array<int64_t, 3> m_Dims;
+  int32_t m_CoarseLevels = 0;
+  std::vector<std::vector<int64_t>>& m_NewXShift;
+  std::vector<std::vector<int64_t>>& m_NewYShift;
+  std::vector<std::vector<float>>& m_MinDisorientation;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -86,6 +433,7 @@ void AdaptiveAlignmentMisorientation::setupFilterParameters()
   // getting the current parameters that were set by the parent and adding to it before resetting it
   FilterParameterVectorType parameters = getFilterParameters();
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Category::Parameter, AdaptiveAlignmentMisorientation));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Coarse-to-Fine Levels", CoarseToFineLevels, FilterParameter::Category::Parameter, AdaptiveAlignmentMisorientation));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, AdaptiveAlignmentMisorientation, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -123,6 +471,7 @@ void AdaptiveAlignmentMisorientation::readFilterParameters(AbstractFilterParamet
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
+  setCoarseToFineLevels(reader->readValue("CoarseToFineLevels", getCoarseToFineLevels()));
   reader->closeFilterGroup();
 }
 
@@ -153,6 +502,13 @@ void AdaptiveAlignmentMisorientation::dataCheck()
     return;
   }
 
+  if(getCoarseToFineLevels() < 0 || getCoarseToFineLevels() > 8)
+  {
+    QString ss = QObject::tr("The number of coarse-to-fine levels must be between 0 and 8");
+    setErrorCondition(-3020, ss);
+    return;
+  }
+
   QVector<DataArrayPath> dataArrayPaths;
 
   std::vector<size_t> cDims(1, 4);
@@ -220,8 +576,6 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
     maxstoredshifts = 20;
   }
 
-  float disorientation = 0.0f;
-
   std::vector<std::vector<int64_t>> newxshift(dims[2]);
   std::vector<std::vector<int64_t>> newyshift(dims[2]);
   std::vector<std::vector<float>> mindisorientation(dims[2]);
@@ -232,27 +586,28 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
     mindisorientation[a].resize(maxstoredshifts, std::numeric_limits<float>::max());
   }
 
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
   uint64_t slice = 0;
-  uint64_t refposition = 0;
-  uint64_t curposition = 0;
-
-  uint32_t phase1 = 0, phase2 = 0;
   uint64_t progInt = 0;
 
-  // Allocate a 2D Array which will be reused from slice to slice
-  // second dimension is assigned in each cycle separately
-  std::vector<std::vector<bool>> misorients(dims[0]);
-
-  const uint64_t halfDim0 = static_cast<uint64_t>(dims[0] * 0.5f);
-  const uint64_t halfDim1 = static_cast<uint64_t>(dims[1] * 0.5f);
+  std::vector<SymmetricMisorientation::SymmetryTable> symmetryTables;
+  for(const LaueOpsShPtrType& ops : m_OrientationOps)
+  {
+    symmetryTables.push_back(SymmetricMisorientation::CreateSymmetryTable(*ops));
+  }
 
   float misorientationToleranceRad = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
-  float* currentQuatPtr = nullptr;
-  // Loop over the Z Direction
-  for(uint64_t iter = 1; iter < dims[2]; iter++)
+  const std::array<int64_t, 3> idims = {static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[1]), static_cast<int64_t>(dims[2])};
+  SliceShiftSearch prototype(m_Quats, m_CellPhases, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_CrystalStructures, symmetryTables, idims, misorientationToleranceRad);
+
+  if(getShiftSearch() != 0)
+  {
+    find_phase_correlation_shifts([&prototype](int64_t section, float* image) { prototype.fillBoundaryImage(section, image); }, newxshift, newyshift, mindisorientation);
+  }
+
+  // The section pairs are independent; they are searched in parallel a block at a time so that progress can be
+  // reported and the search canceled between blocks
+  const uint64_t blockSize = std::max<uint64_t>(4 * std::thread::hardware_concurrency(), 1);
+  for(uint64_t iter = 1; iter < dims[2] && getShiftSearch() != 2; iter += blockSize)
   {
     progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
     QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
@@ -262,228 +617,21 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
       return;
     }
 
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-
-    for(uint64_t i = 0; i < dims[0]; i++)
-    {
-      misorients[i].assign(dims[1], false);
-    }
-
-    while(newxshift[iter][0] != oldxshift || newyshift[iter][0] != oldyshift)
-    {
-      oldxshift = newxshift[iter][0];
-      oldyshift = newyshift[iter][0];
-
-      for(int32_t j = -3; j <= 3; j++)
-      {
-        for(int32_t k = -3; k <= 3; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          if(llabs(k + oldxshift) < static_cast<int64_t>(halfDim0) && llabs(j + oldyshift) < static_cast<int64_t>(halfDim1) && !misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1])
-          {
-            for(uint64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(uint64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if(int64_t((l + j + oldyshift)) >= 0 && (l + j + oldyshift) < dims[1] && int64_t((n + k + oldxshift)) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
-                  {
-                    OrientationD axisAngle(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-                      currentQuatPtr = m_Quats + refposition * 4;
-
-                      QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      currentQuatPtr = m_Quats + curposition * 4;
-                      QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                      }
-                    }
-                    if(axisAngle[3] > misorientationToleranceRad)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-
-            disorientation = disorientation / count;
-            misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1] = true;
-
-            // compare the new shift with currently stored ones
-            int64_t s = maxstoredshifts;
-            while(s - 1 >= 0 && disorientation < mindisorientation[iter][s - 1])
-            {
-              s--;
-            }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(iter, std::min(iter + blockSize, dims[2]));
+    dataAlg.execute(FindSliceShiftsImpl(prototype, idims, m_CoarseToFineLevels, newxshift, newyshift, mindisorientation));
+  }
 
-            // new shift is stored with index 's' in the arrays
-            if(s < static_cast<int64_t>(maxstoredshifts))
-            {
-              // lag the shifts already stored
-              for(int64_t t = maxstoredshifts - 1; t > s; t--)
-              {
-                newxshift[iter][t] = newxshift[iter][t - 1];
-                newyshift[iter][t] = newyshift[iter][t - 1];
-                mindisorientation[iter][t] = mindisorientation[iter][t - 1];
-              }
-              // store the new shift
-              newxshift[iter][s] = k + oldxshift;
-              newyshift[iter][s] = j + oldyshift;
-              mindisorientation[iter][s] = disorientation;
-            }
-          }
-        }
-      }
-    }
+  for(uint64_t iter = 1; iter < dims[2]; iter++)
+  {
     xshifts[iter] = xshifts[iter - 1] + newxshift[iter][0];
     yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
   }
 
-  std::vector<uint64_t> curindex(dims[2], 0);
-
-  // find corrected shifts
-  if(!xneedshifts.empty())
+  std::vector<uint64_t> curindex = correct_shifts(newxshift, newyshift, mindisorientation, xneedshifts, yneedshifts, GlobalShiftCorrection::ScoreChange::Difference);
+  if(getCancel())
   {
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Correcting shifts");
-    notifyStatusMessage(ss);
-
-    std::vector<float> changedisorientation(dims[2], 0);
-    std::vector<uint64_t> changeindex(dims[2], 0);
-    std::vector<float> changeerror(dims[2], 0);
-
-    std::vector<float> xshiftsest; // cumulative x-shifts estimated from SEM images
-    std::vector<float> yshiftsest; // cumulative y-shifts estimated from SEM images
-
-    float curerror = 0.0f;
-    float tolerance = 0.0f;
-
-    // evaluate error between current shifts and desired shifts
-    if(xneedshifts.size() == 1) // error is computed as misagreement between slopes
-    {
-      tolerance = 1.0f / static_cast<float>(dims[2] - 1);
-      curerror = compute_error1(dims[2], 0, xneedshifts[0], yneedshifts[0], newxshift, newyshift, curindex);
-    }
-    else if(xneedshifts.size() > 1) // error is computed as misagreement with shifts estimated from SEM images
-    {
-      tolerance = 1.0f;
-      xshiftsest.resize(dims[2], 0);
-      yshiftsest.resize(dims[2], 0);
-      for(uint64_t iter = 1; iter < dims[2]; iter++)
-      {
-        xshiftsest[iter] = xshiftsest[iter - 1] + xneedshifts[iter - 1];
-        yshiftsest[iter] = yshiftsest[iter - 1] + yneedshifts[iter - 1];
-      }
-      curerror = compute_error2(dims[2], 0, xshiftsest, yshiftsest, newxshift, newyshift, curindex);
-    }
-
-    // iterative selection of a candidate shift, recomputing of current candidates, evaluation of error
-    if(curerror > tolerance)
-    {
-      float minchangedisorientation = 0;
-      float minchangeerror = 0;
-      int64_t minchangeindex = 0;
-      int64_t minchangeiter = 0;
-      float olderror = 0;
-      float newerror = 0;
-      uint64_t progInt2 = 0;
-
-      do
-      {
-        ss = QObject::tr("Aligning Anisotropic Sections || Correcting Shifts || Iteration %1").arg(++progInt2);
-        notifyStatusMessage(ss);
-        if(getCancel())
-        {
-          return;
-        }
-
-        olderror = curerror;
-        for(uint64_t iter = 1; iter < dims[2]; iter++)
-        {
-          float newminerror = std::numeric_limits<float>::max();
-          float newmindisorientation = std::numeric_limits<float>::max();
-          uint64_t newminindex = 0;
-          for(uint64_t index = curindex[iter] + 1; index < maxstoredshifts; index++)
-          {
-            // recompute error for the configuration with this candidate changed
-            if(xneedshifts.size() == 1)
-            {
-              newerror = compute_error1(iter, index, xneedshifts[0], yneedshifts[0], newxshift, newyshift, curindex);
-            }
-            else if(xneedshifts.size() > 1)
-            {
-              newerror = compute_error2(iter, index, xshiftsest, yshiftsest, newxshift, newyshift, curindex);
-            }
-
-            // compare the new error with the best current error
-            if(newerror < curerror && mindisorientation[iter][index] - mindisorientation[iter][0] < newmindisorientation)
-            {
-              newminerror = newerror;
-              newminindex = index;
-              newmindisorientation = mindisorientation[iter][index] - mindisorientation[iter][0];
-            }
-          }
-          // assign best error, corresponding index and disorientation value for this slice
-          changeerror[iter] = newminerror;
-          changeindex[iter] = newminindex;
-          changedisorientation[iter] = newmindisorientation;
-        }
-
-        // among all slices, find the best candidate (with minimum disorientation change)
-        minchangedisorientation = std::numeric_limits<float>::max() - 1;
-        minchangeerror = std::numeric_limits<float>::max();
-        minchangeindex = 0;
-        minchangeiter = 0;
-        for(uint64_t iter = 1; iter < dims[2]; iter++)
-        {
-          if(changeerror[iter] < curerror && (changedisorientation[iter] < minchangedisorientation ||
-                                              (changedisorientation[iter] == minchangedisorientation && llabs(newxshift[iter][changeindex[iter]]) + llabs(newyshift[iter][changeindex[iter]]) <
-                                                                                                            llabs(newxshift[iter][minchangeindex]) + llabs(newyshift[iter][minchangeindex]))))
-          {
-            minchangeiter = iter;
-            minchangeindex = changeindex[iter];
-            minchangedisorientation = changedisorientation[iter];
-            minchangeerror = changeerror[iter];
-          }
-        }
-
-        if(minchangeerror < curerror && minchangeerror >= tolerance)
-        {
-          // assign the best candidate
-          changedisorientation[minchangeiter] = minchangedisorientation;
-          curindex[minchangeiter] = minchangeindex;
-          // reassign current error
-          curerror = minchangeerror;
-        }
-
-      } while(minchangedisorientation < std::numeric_limits<float>::max() - 1 && curerror < olderror && curerror > tolerance);
-    }
+    return;
   }
 
   if(getWriteAlignmentShifts())
@@ -501,91 +649,6 @@ void AdaptiveAlignmentMisorientation::find_shifts(std::vector<int64_t>& xshifts,
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-// find the error if the current shifts are changed by modification provided on slice 'iter'
-// where currently selected shift is substituted by the shift stored in position 'index'
-float AdaptiveAlignmentMisorientation::compute_error1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, std::vector<std::vector<int64_t>>& newxshift,
-                                                      std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex)
-{
-  int64_t n = curindex.size() - 1;
-
-  int64_t xshifts = 0;
-  int64_t yshifts = 0;
-
-  double sumX = 0.0;
-  double sumX_2 = 0.0;
-  double x_sumY = 0.0;
-  double x_sumXY = 0.0;
-  double y_sumY = 0.0;
-  double y_sumXY = 0.0;
-
-  for(int64_t i = 1; i <= n; i++)
-  {
-    if(i != iter) // shifts without modification
-    {
-      xshifts += newxshift[i][curindex[i]];
-      yshifts += newyshift[i][curindex[i]];
-    }
-    else // modified shift
-    {
-      xshifts += newxshift[i][index];
-      yshifts += newyshift[i][index];
-    }
-    // all values are divided by n for better numerical stability
-    sumX += static_cast<double>(i) / static_cast<double>(n);
-    sumX_2 += static_cast<double>(i * i) / static_cast<double>(n * n);
-    x_sumY += static_cast<double>(xshifts) / static_cast<double>(n);
-    x_sumXY += static_cast<double>(i * xshifts) / static_cast<double>(n * n);
-    y_sumY += static_cast<double>(yshifts) / static_cast<double>(n);
-    y_sumXY += static_cast<double>(i * yshifts) / static_cast<double>(n * n);
-  }
-
-  double xtrend = static_cast<double>((n * x_sumXY - sumX * x_sumY) / (n * sumX_2 - sumX * sumX));
-  double ytrend = static_cast<double>((n * y_sumXY - sumX * y_sumY) / (n * sumX_2 - sumX * sumX));
-
-  // error is computed from angular deviation as
-  // |xang1 - xang2| + |yang1 - yang2| = |arctg(xtrend) - arctg(xneedtrend)| + |arctg(ytrend) - arctg(yneedtrend)|
-  return std::fabs(atan(xtrend) - atan(xneedtrend)) + std::fabs(atan(ytrend) - atan(yneedtrend));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float AdaptiveAlignmentMisorientation::compute_error2(uint64_t iter, uint64_t index, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest, std::vector<std::vector<int64_t>>& newxshift,
-                                                      std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex)
-{
-  uint64_t n = curindex.size() - 1;
-
-  int64_t xshifts = 0;
-  int64_t yshifts = 0;
-
-  float error = 0;
-  float xdif = 0;
-  float ydif = 0;
-  float divide = static_cast<float>(2 * n);
-
-  for(uint64_t i = 1; i <= n; i++)
-  {
-    if(i != iter)
-    {
-      xshifts += newxshift[i][curindex[i]];
-      yshifts += newyshift[i][curindex[i]];
-    }
-    else
-    {
-      xshifts += newxshift[i][index];
-      yshifts += newyshift[i][index];
-    }
-
-    xdif = static_cast<float>(xshifts) - xshiftsest[i];
-    ydif = static_cast<float>(yshifts) - yshiftsest[i];
-    error += (xdif * xdif + ydif * ydif) / divide;
-  }
-  return error;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -715,6 +778,18 @@ float AdaptiveAlignmentMisorientation::getMisorientationTolerance() const
   return m_MisorientationTolerance;
 }
 
+// -----------------------------------------------------------------------------
+void AdaptiveAlignmentMisorientation::setCoarseToFineLevels(int32_t value)
+{
+  m_CoarseToFineLevels = value;
+}
+
+// -----------------------------------------------------------------------------
+int32_t AdaptiveAlignmentMisorientation::getCoarseToFineLevels() const
+{
+  return m_CoarseToFineLevels;
+}
+
 // -----------------------------------------------------------------------------
 void AdaptiveAlignmentMisorientation::setUseGoodVoxels(bool value)
 {
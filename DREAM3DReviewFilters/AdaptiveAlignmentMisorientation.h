@@ -61,6 +61,7 @@ class DREAM3DReview_EXPORT AdaptiveAlignmentMisorientation : public AdaptiveAlig
   PYB11_SHARED_POINTERS(AdaptiveAlignmentMisorientation)
   PYB11_FILTER_NEW_MACRO(AdaptiveAlignmentMisorientation)
   PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
+  PYB11_PROPERTY(int CoarseToFineLevels READ getCoarseToFineLevels WRITE setCoarseToFineLevels)
   PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
@@ -101,6 +102,17 @@ public:
   float getMisorientationTolerance() const;
   Q_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
 
+  /**
+   * @brief Setter property for CoarseToFineLevels
+   */
+  void setCoarseToFineLevels(int32_t value);
+  /**
+   * @brief Getter property for CoarseToFineLevels
+   * @return Value of CoarseToFineLevels
+   */
+  int32_t getCoarseToFineLevels() const;
+  Q_PROPERTY(int CoarseToFineLevels READ getCoarseToFineLevels WRITE setCoarseToFineLevels)
+
   /**
    * @brief Setter property for UseGoodVoxels
    */
@@ -234,18 +246,6 @@ protected:
    */
   void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, std::vector<float>& xneedshifts, std::vector<float>& yneedshifts) override;
 
-  /**
-   * @brief compute_error1 Determines error between the current and desired shifts (based on discrepancy of slopes)
-   */
-  virtual float compute_error1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, std::vector<std::vector<int64_t>>& newxshift, std::vector<std::vector<int64_t>>& newyshift,
-                               std::vector<uint64_t>& curindex);
-
-  /**
-   * @brief compute_error1 Determines error between the current and desired shifts (based on discrepancy from the estimates obtained from SEM images)
-   */
-  virtual float compute_error2(uint64_t iter, uint64_t index, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest, std::vector<std::vector<int64_t>>& newxshift,
-                               std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex);
-
 private:
   std::weak_ptr<DataArray<float>> m_QuatsPtr;
   float* m_Quats = nullptr;
@@ -257,6 +257,7 @@ private:
   uint32_t* m_CrystalStructures = nullptr;
 
   float m_MisorientationTolerance = {};
+  int32_t m_CoarseToFineLevels = {0};
   bool m_UseGoodVoxels = {};
   DataArrayPath m_QuatsArrayPath = {};
   DataArrayPath m_CellPhasesArrayPath = {};
@@ -35,7 +35,15 @@
 
 #include "AdaptiveAlignmentMutualInformation.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -43,6 +51,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -50,11 +59,290 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/JointHistogram.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/SectionComponentLabeling.hpp"
+
+namespace
+{
+constexpr uint64_t k_HashSeed = 0xCBF29CE484222325ULL;
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief hashBytes Folds a block of memory into a 64 bit hash, a word at a time
+ */
+uint64_t hashBytes(const void* data, size_t numBytes, uint64_t hash)
+{
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  const size_t numWords = numBytes / sizeof(uint64_t);
+  for(size_t i = 0; i < numWords; i++)
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes + i * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * 0x100000001B3ULL;
+    hash ^= hash >> 29;
+  }
+  for(size_t i = numWords * sizeof(uint64_t); i < numBytes; i++)
+  {
+    hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+  }
+  return hash ^ numBytes;
+}
+
+/**
+ * @brief The FindEdgeAnglesImpl class finds, for a range of sections, the misorientation of every Cell with its
+ * neighbor in +X and in +Y.  Pairs that cannot belong to one Feature, because a phase is not positive or the crystal
+ * structures differ, get an infinite angle.
+ */
+class FindEdgeAnglesImpl
+{
+public:
+  FindEdgeAnglesImpl(const float* quats, const int32_t* cellPhases, const uint32_t* crystalStructures, const LaueOpsContainer& orientationOps, const std::array<int64_t, 3>& dims, float* edgeAngles)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_OrientationOps(orientationOps)
+  , m_Dims(dims)
+  , m_EdgeAngles(edgeAngles)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(size_t slice = range.min(); slice < range.max(); slice++)
+    {
+      for(int64_t row = 0; row < m_Dims[1]; row++)
+      {
+        for(int64_t col = 0; col < m_Dims[0]; col++)
+        {
+          const int64_t point = static_cast<int64_t>(slice) * sliceSize + row * m_Dims[0] + col;
+          m_EdgeAngles[2 * point] = (col + 1 < m_Dims[0]) ? findAngle(point, point + 1) : std::numeric_limits<float>::infinity();
+          m_EdgeAngles[2 * point + 1] = (row + 1 < m_Dims[1]) ? findAngle(point, point + m_Dims[0]) : std::numeric_limits<float>::infinity();
+        }
+      }
+    }
+  }
+
+private:
+  const float* m_Quats = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const uint32_t* m_CrystalStructures = nullptr;
+  const LaueOpsContainer& m_OrientationOps;
+  std::array<int64_t, 3> m_Dims;
+  float* m_EdgeAngles = nullptr;
+
+  float findAngle(int64_t point1, int64_t point2) const
+  {
+    if(m_CellPhases[point1] <= 0 || m_CellPhases[point2] <= 0)
+    {
+      return std::numeric_limits<float>::infinity();
+    }
+    const uint32_t phase1 = m_CrystalStructures[m_CellPhases[point1]];
+    const uint32_t phase2 = m_CrystalStructures[m_CellPhases[point2]];
+    if(phase1 != phase2 || phase1 >= static_cast<uint32_t>(m_OrientationOps.size()))
+    {
+      return std::numeric_limits<float>::infinity();
+    }
+    const float* q1 = m_Quats + point1 * 4;
+    const float* q2 = m_Quats + point2 * 4;
+    OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(QuatF(q1[0], q1[1], q1[2], q1[3]), QuatF(q2[0], q2[1], q2[2], q2[3]));
+    return static_cast<float>(axisAngle[3]);
+  }
+};
+
+/**
+ * @brief The LabelSectionsImpl class segments a range of sections into Features.  A Feature is a connected set of
+ * Cells with a positive phase in which face neighbors are misoriented by less than the tolerance, and it must
+ * contain at least one Cell of the mask; Cells outside the mask may still join a Feature through a neighbor.  The
+ * Feature Ids of each section start at 1, with 0 for Cells in no Feature, and the Feature count of a section is one
+ * more than its largest Feature Id.
+ */
+class LabelSectionsImpl
+{
+public:
+  LabelSectionsImpl(const int32_t* cellPhases, const bool* goodVoxels, const float* edgeAngles, float misorientationToleranceRad, const std::array<int64_t, 3>& dims, int32_t* miFeatureIds,
+                    int32_t* featureCounts)
+  : m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_EdgeAngles(edgeAngles)
+  , m_MisorientationToleranceRad(misorientationToleranceRad)
+  , m_Dims(dims)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    std::vector<int64_t> parents;
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(size_t slice = range.min(); slice < range.max(); slice++)
+    {
+      const int64_t offset = static_cast<int64_t>(slice) * sliceSize;
+      const int32_t* cellPhases = m_CellPhases + offset;
+      const bool* goodVoxels = (m_GoodVoxels != nullptr) ? m_GoodVoxels + offset : nullptr;
+      const float* edgeAngles = m_EdgeAngles + 2 * offset;
+      const float tolerance = m_MisorientationToleranceRad;
+      const int64_t dimX = m_Dims[0];
+      const int32_t numLabels = SectionComponentLabeling::LabelSection(
+          m_Dims[0], m_Dims[1], [cellPhases](int64_t i) { return cellPhases[i] > 0; },
+          [edgeAngles, tolerance, dimX](int64_t i, int64_t j) { return edgeAngles[2 * i + (j - i == dimX ? 1 : 0)] < tolerance; },
+          [goodVoxels](int64_t i) { return goodVoxels == nullptr || goodVoxels[i]; }, m_MIFeatureIds + offset, parents);
+      m_FeatureCounts[slice] = numLabels + 1;
+    }
+  }
+
+private:
+  const int32_t* m_CellPhases = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  const float* m_EdgeAngles = nullptr;
+  float m_MisorientationToleranceRad = 0.0f;
+  std::array<int64_t, 3> m_Dims;
+  int32_t* m_MIFeatureIds = nullptr;
+  int32_t* m_FeatureCounts = nullptr;
+};
+
+/**
+ * @brief The FindMutualInformationShiftsImpl class finds the shifts of a range of section pairs.  Each pair descends
+ * through a 7x7 stencil of shifts, starting from the stored shift, until the best shift is the center of the stencil.
+ * The score of a shift is the inverse of the mutual information between the section Feature Ids of the sampled
+ * Cell pairs, so lower is better.  Every score is cached, so a shift is evaluated once however often the stencil
+ * passes over it.
+ */
+class FindMutualInformationShiftsImpl
+{
+public:
+  FindMutualInformationShiftsImpl(const int32_t* miFeatureIds, const int32_t* featureCounts, const std::array<int64_t, 3>& dims, std::vector<std::vector<int64_t>>& newxshift,
+                                  std::vector<std::vector<int64_t>>& newyshift, std::vector<std::vector<float>>& mindisorientation)
+  : m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  , m_Dims(dims)
+  , m_NewXShift(newxshift)
+  , m_NewYShift(newyshift)
+  , m_MinDisorientation(mindisorientation)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    JointHistogram histogram;
+    std::unordered_map<int64_t, float> cache;
+    const int64_t halfDim0 = static_cast<int64_t>(m_Dims[0] * 0.5f);
+    const int64_t halfDim1 = static_cast<int64_t>(m_Dims[1] * 0.5f);
+    for(size_t iter = range.min(); iter < range.max(); iter++)
+    {
+      const int64_t slice = (m_Dims[2] - 1) - static_cast<int64_t>(iter);
+      histogram.resize(m_FeatureCounts[slice], m_FeatureCounts[slice + 1]);
+      cache.clear();
+
+      std::vector<int64_t>& xshifts = m_NewXShift[iter];
+      std::vector<int64_t>& yshifts = m_NewYShift[iter];
+      std::vector<float>& scores = m_MinDisorientation[iter];
+      const int64_t maxStoredShifts = static_cast<int64_t>(xshifts.size());
+      // The search starts from the stored shift, the phase correlation estimate if there is one
+      int64_t oldxshift = xshifts[0] - 1;
+      int64_t oldyshift = yshifts[0] - 1;
+      while(xshifts[0] != oldxshift || yshifts[0] != oldyshift)
+      {
+        oldxshift = xshifts[0];
+        oldyshift = yshifts[0];
+        for(int64_t j = -3; j <= 3; j++)
+        {
+          for(int64_t k = -3; k <= 3; k++)
+          {
+            const int64_t xshift = k + oldxshift;
+            const int64_t yshift = j + oldyshift;
+            if(std::llabs(xshift) >= halfDim0 || std::llabs(yshift) >= halfDim1)
+            {
+              continue;
+            }
+            const int64_t key = (xshift + halfDim0) * (2 * halfDim1 + 1) + (yshift + halfDim1);
+            if(cache.find(key) != cache.end())
+            {
+              continue;
+            }
+            const float disorientation = score(histogram, slice, xshift, yshift);
+            cache[key] = disorientation;
+
+            // compare the new shift with currently stored ones
+            int64_t s = maxStoredShifts;
+            while(s - 1 >= 0 && disorientation < scores[s - 1])
+            {
+              s--;
+            }
+
+            // new shift is stored with index 's' in the arrays
+            if(s < maxStoredShifts)
+            {
+              // lag the shifts already stored
+              for(int64_t t = maxStoredShifts - 1; t > s; t--)
+              {
+                xshifts[t] = xshifts[t - 1];
+                yshifts[t] = yshifts[t - 1];
+                scores[t] = scores[t - 1];
+              }
+              // store the new shift
+              xshifts[s] = xshift;
+              yshifts[s] = yshift;
+              scores[s] = disorientation;
+            }
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_MIFeatureIds = nullptr;
+  const int32_t* m_FeatureCounts = nullptr;
+  std::array<int64_t, 3> m_Dims;
+  std::vector<std::vector<int64_t>>& m_NewXShift;
+  std::vector<std::vector<int64_t>>& m_NewYShift;
+  std::vector<std::vector<float>>& m_MinDisorientation;
+
+  /**
+   * @brief score Returns the inverse mutual information of every fourth Cell in x and y of the section above and
+   * the Cell it meets in the shifted section.  Samples that fall outside the shifted section are counted in the
+   * (0, 0) bin but not in the normalization.
+   */
+  float score(JointHistogram& histogram, int64_t slice, int64_t xshift, int64_t yshift) const
+  {
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    size_t count = 0;
+    for(int64_t l = 0; l < m_Dims[1]; l = l + 4)
+    {
+      for(int64_t n = 0; n < m_Dims[0]; n = n + 4)
+      {
+        if((l + yshift) >= 0 && (l + yshift) < m_Dims[1] && (n + xshift) >= 0 && (n + xshift) < m_Dims[0])
+        {
+          const int64_t refposition = (slice + 1) * sliceSize + l * m_Dims[0] + n;
+          const int64_t curposition = slice * sliceSize + (l + yshift) * m_Dims[0] + (n + xshift);
+          const int32_t refgnum = m_MIFeatureIds[refposition];
+          const int32_t curgnum = m_MIFeatureIds[curposition];
+          if(curgnum >= 0 && refgnum >= 0)
+          {
+            histogram.add(curgnum, refgnum);
+            count++;
+          }
+        }
+        else
+        {
+          histogram.add(0, 0);
+        }
+      }
+    }
+    const double mutualInformation = histogram.findMutualInformation(static_cast<double>(count));
+    histogram.clear();
+    return static_cast<float>(1.0 / mutualInformation);
+  }
+};
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -62,6 +350,7 @@
 AdaptiveAlignmentMutualInformation::AdaptiveAlignmentMutualInformation()
 : m_MisorientationTolerance(5.0f)
 , m_UseGoodVoxels(true)
+, m_KeepMisorientations(false)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -90,6 +379,7 @@ void AdaptiveAlignmentMutualInformation::setupFilterParameters()
   // getting the current parameters that were set by the parent and adding to it before resetting it
   FilterParameterVectorType parameters = getFilterParameters();
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance", MisorientationTolerance, FilterParameter::Category::Parameter, AdaptiveAlignmentMutualInformation));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Keep Misorientations Between Runs", KeepMisorientations, FilterParameter::Category::Parameter, AdaptiveAlignmentMutualInformation));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, AdaptiveAlignmentMutualInformation, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
@@ -128,6 +418,7 @@ void AdaptiveAlignmentMutualInformation::readFilterParameters(AbstractFilterPara
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
+  setKeepMisorientations(reader->readValue("KeepMisorientations", getKeepMisorientations()));
   reader->closeFilterGroup();
 }
 
@@ -230,8 +521,6 @@ void AdaptiveAlignmentMutualInformation::find_shifts(std::vector<int64_t>& xshif
     maxstoredshifts = 20;
   }
 
-  float disorientation = 0.0f;
-
   std::vector<std::vector<int64_t>> newxshift(dims[2]);
   std::vector<std::vector<int64_t>> newyshift(dims[2]);
   std::vector<std::vector<float>> mindisorientation(dims[2]);
@@ -242,298 +531,62 @@ void AdaptiveAlignmentMutualInformation::find_shifts(std::vector<int64_t>& xshif
     mindisorientation[a].resize(maxstoredshifts, std::numeric_limits<float>::max());
   }
 
-  std::vector<std::vector<float>> mutualinfo12 = {};
-  std::vector<float> mutualinfo1 = {};
-  std::vector<float> mutualinfo2 = {};
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
   uint64_t slice = 0;
 
-  int32_t refgnum = 0, curgnum = 0;
-  uint64_t refposition = 0;
-  uint64_t curposition = 0;
-
   form_features_sections();
 
-  // Allocate a 2D Array which will be reused from slice to slice
-  // second dimension is assigned in each cycle separately
-  std::vector<std::vector<bool>> misorients(dims[0]);
-
-  const uint64_t halfDim0 = static_cast<uint64_t>(dims[0] * 0.5f);
-  const uint64_t halfDim1 = static_cast<uint64_t>(dims[1] * 0.5f);
   uint64_t progInt = 0;
 
-  for(uint64_t iter = 1; iter < dims[2]; iter++)
+  if(getShiftSearch() != 0)
   {
-    progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12.resize(featurecount1);
-    mutualinfo1.resize(featurecount1);
-    mutualinfo2.resize(featurecount2);
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a].resize(featurecount2);
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-
-    for(uint64_t i = 0; i < dims[0]; i++)
-    {
-      misorients[i].assign(dims[1], false);
-    }
-
-    while(newxshift[iter][0] != oldxshift || newyshift[iter][0] != oldyshift)
-    {
-      oldxshift = newxshift[iter][0];
-      oldyshift = newyshift[iter][0];
-
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(static_cast<uint64_t>(std::abs(k + oldxshift)) < halfDim0 && static_cast<uint64_t>(std::abs(j + oldyshift)) < halfDim1 && !misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1])
+    // The sections are correlated through the boundaries of their section Features
+    const int64_t dimX = static_cast<int64_t>(dims[0]);
+    const int64_t dimY = static_cast<int64_t>(dims[1]);
+    find_phase_correlation_shifts(
+        [miFeatureIds, dimX, dimY](int64_t section, float* image) {
+          const int32_t* sectionIds = miFeatureIds + section * dimX * dimY;
+          for(int64_t l = 0; l < dimY; l++)
           {
-            for(uint64_t l = 0; l < dims[1]; l = l + 4)
+            for(int64_t n = 0; n < dimX; n++)
             {
-              for(uint64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if(int64_t((l + j + oldyshift)) >= 0 && (l + j + oldyshift) < dims[1] && int64_t((n + k + oldxshift)) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0.0f)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0.0f)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0.0f)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0.0f)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + halfDim0][j + oldyshift + halfDim1] = true;
-
-            // compare the new shift with currently stored ones
-            int64_t s = static_cast<int64_t>(maxstoredshifts);
-            while(s - 1 >= 0 && disorientation < mindisorientation[iter][s - 1])
-            {
-              s--;
-            }
-
-            // new shift is stored with index 's' in the arrays
-            if(s < static_cast<int64_t>(maxstoredshifts))
-            {
-              // lag the shifts already stored
-              for(int64_t t = maxstoredshifts - 1; t > s; t--)
-              {
-                newxshift[iter][t] = newxshift[iter][t - 1];
-                newyshift[iter][t] = newyshift[iter][t - 1];
-                mindisorientation[iter][t] = mindisorientation[iter][t - 1];
-              }
-              // store the new shift
-              newxshift[iter][s] = k + oldxshift;
-              newyshift[iter][s] = j + oldyshift;
-              mindisorientation[iter][s] = disorientation;
+              const int64_t position = l * dimX + n;
+              const bool boundary = (n + 1 < dimX && sectionIds[position] != sectionIds[position + 1]) || (l + 1 < dimY && sectionIds[position] != sectionIds[position + dimX]);
+              image[position] = boundary ? 1.0f : 0.0f;
             }
           }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift[iter][0];
-    yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
+        },
+        newxshift, newyshift, mindisorientation);
   }
 
-  std::vector<uint64_t> curindex(dims[2], 0);
-
-  // find corrected shifts
-  if(!xneedshifts.empty())
+  // The section pairs are independent; they are searched in parallel a block at a time so that progress can be
+  // reported and the search canceled between blocks
+  const std::array<int64_t, 3> idims = {static_cast<int64_t>(dims[0]), static_cast<int64_t>(dims[1]), static_cast<int64_t>(dims[2])};
+  const uint64_t blockSize = std::max<uint64_t>(4 * std::thread::hardware_concurrency(), 1);
+  for(uint64_t iter = 1; iter < dims[2] && getShiftSearch() != 2; iter += blockSize)
   {
-    QString ss = QObject::tr("Aligning Anisotropic Sections || Correcting shifts");
+    progInt = static_cast<uint64_t>(iter * 100 / static_cast<float>(dims[2]));
+    QString ss = QObject::tr("Aligning Anisotropic Sections || Determining Shifts || %1% Complete").arg(progInt);
     notifyStatusMessage(ss);
-
-    std::vector<float> changedisorientation(dims[2], 0);
-    std::vector<uint64_t> changeindex(dims[2], 0);
-    std::vector<float> changeerror(dims[2], 0);
-
-    std::vector<float> xshiftsest; // cumulative x-shifts estimated from SEM images
-    std::vector<float> yshiftsest; // cumulative y-shifts estimated from SEM images
-
-    float curerror = 0.0f;
-    float tolerance = 0.0f;
-
-    // evaluate error between current shifts and desired shifts
-    if(xneedshifts.size() == 1) // error is computed as misagreement between slopes
-    {
-      tolerance = 1.0f / static_cast<float>(dims[2] - 1);
-      curerror = compute_error1(dims[2], 0, xneedshifts[0], yneedshifts[0], newxshift, newyshift, curindex);
-    }
-    else if(xneedshifts.size() > 1) // error is computed as misagreement with shifts estimated from SEM images
+    if(getCancel())
     {
-      tolerance = 1.0f;
-      xshiftsest.resize(dims[2], 0);
-      yshiftsest.resize(dims[2], 0);
-      for(uint64_t iter = 1; iter < dims[2]; iter++)
-      {
-        xshiftsest[iter] = xshiftsest[iter - 1] + xneedshifts[iter - 1];
-        yshiftsest[iter] = yshiftsest[iter - 1] + yneedshifts[iter - 1];
-      }
-      curerror = compute_error2(dims[2], 0, xshiftsest, yshiftsest, newxshift, newyshift, curindex);
+      return;
     }
 
-    // iterative selection of a candidate shift, recomputing of current candidates, evaluation of error
-    if(curerror > tolerance)
-    {
-      float minchangedisorientation = 0;
-      float minchangeerror = 0;
-      int64_t minchangeindex = 0;
-      int64_t minchangeiter = 0;
-      float olderror = 0;
-      float newerror = 0;
-      uint64_t progInt2 = 0;
-
-      do
-      {
-        ss = QObject::tr("Aligning Anisotropic Sections || Correcting Shifts || Iteration %1").arg(++progInt2);
-        notifyStatusMessage(ss);
-        if(getCancel())
-        {
-          return;
-        }
-
-        olderror = curerror;
-        for(uint64_t iter = 1; iter < dims[2]; iter++)
-        {
-          float newminerror = std::numeric_limits<float>::max();
-          float newmindisorientation = std::numeric_limits<float>::max();
-          uint64_t newminindex = 0;
-          for(uint64_t index = curindex[iter] + 1; index < maxstoredshifts; index++)
-          {
-            // recompute error for the configuration with this candidate changed
-            if(xneedshifts.size() == 1)
-            {
-              newerror = compute_error1(iter, index, xneedshifts[0], yneedshifts[0], newxshift, newyshift, curindex);
-            }
-            else if(xneedshifts.size() > 1)
-            {
-              newerror = compute_error2(iter, index, xshiftsest, yshiftsest, newxshift, newyshift, curindex);
-            }
-
-            // compare the new error with the best current error
-            if(newerror < curerror && mindisorientation[iter][index] / mindisorientation[iter][0] < newmindisorientation)
-            {
-              newminerror = newerror;
-              newminindex = index;
-              newmindisorientation = mindisorientation[iter][index] / mindisorientation[iter][0];
-            }
-          }
-          // assign best error, corresponding index and disorientation value for this slice
-          changeerror[iter] = newminerror;
-          changeindex[iter] = newminindex;
-          changedisorientation[iter] = newmindisorientation;
-        }
-
-        // among all slices, find the best candidate (with minimum disorientation change)
-        minchangedisorientation = std::numeric_limits<float>::max() - 1;
-        minchangeerror = std::numeric_limits<float>::max();
-        minchangeindex = 0;
-        minchangeiter = 0;
-        for(uint64_t iter = 1; iter < dims[2]; iter++)
-        {
-          if(changeerror[iter] < curerror && (changedisorientation[iter] < minchangedisorientation ||
-                                              (changedisorientation[iter] == minchangedisorientation && llabs(newxshift[iter][changeindex[iter]]) + llabs(newyshift[iter][changeindex[iter]]) <
-                                                                                                            llabs(newxshift[iter][minchangeindex]) + llabs(newyshift[iter][minchangeindex]))))
-          {
-            minchangeiter = iter;
-            minchangeindex = changeindex[iter];
-            minchangedisorientation = changedisorientation[iter];
-            minchangeerror = changeerror[iter];
-          }
-        }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(iter, std::min(iter + blockSize, dims[2]));
+    dataAlg.execute(FindMutualInformationShiftsImpl(miFeatureIds, featurecounts, idims, newxshift, newyshift, mindisorientation));
+  }
 
-        if(minchangeerror < curerror && minchangeerror >= tolerance)
-        {
-          // assign the best candidate
-          changedisorientation[minchangeiter] = minchangedisorientation;
-          curindex[minchangeiter] = minchangeindex;
-          // reassign current error
-          curerror = minchangeerror;
-        }
+  for(uint64_t iter = 1; iter < dims[2]; iter++)
+  {
+    xshifts[iter] = xshifts[iter - 1] + newxshift[iter][0];
+    yshifts[iter] = yshifts[iter - 1] + newyshift[iter][0];
+  }
 
-      } while(minchangedisorientation < std::numeric_limits<float>::max() - 1 && curerror < olderror && curerror > tolerance);
-    }
+  std::vector<uint64_t> curindex = correct_shifts(newxshift, newyshift, mindisorientation, xneedshifts, yneedshifts, GlobalShiftCorrection::ScoreChange::Ratio);
+  if(getCancel())
+  {
+    return;
   }
 
   if(getWriteAlignmentShifts())
@@ -553,254 +606,55 @@ void AdaptiveAlignmentMutualInformation::find_shifts(std::vector<int64_t>& xshif
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-// find the error if the current shifts are changed by modification provided on slice 'iter'
-// where currently selected shift is substituted by the shift stored in position 'index'
-float AdaptiveAlignmentMutualInformation::compute_error1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, std::vector<std::vector<int64_t>>& newxshift,
-                                                         std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex)
-{
-  int64_t n = curindex.size() - 1;
-
-  int64_t xshifts = 0;
-  int64_t yshifts = 0;
-
-  double sumX = 0.0f;
-  double sumX_2 = 0.0f;
-  double x_sumY = 0.0f;
-  double x_sumXY = 0.0f;
-  double y_sumY = 0.0f;
-  double y_sumXY = 0.0f;
-
-  for(int64_t i = 1; i <= n; i++)
-  {
-    if(i != iter) // shifts without modification
-    {
-      xshifts += newxshift[i][curindex[i]];
-      yshifts += newyshift[i][curindex[i]];
-    }
-    else // modified shift
-    {
-      xshifts += newxshift[i][index];
-      yshifts += newyshift[i][index];
-    }
-    // all values are divided by n for better numerical stability
-    sumX += static_cast<double>(i) / static_cast<double>(n);
-    sumX_2 += static_cast<double>(i * i) / static_cast<double>(n * n);
-    x_sumY += static_cast<double>(xshifts) / static_cast<double>(n);
-    x_sumXY += static_cast<double>(i * xshifts) / static_cast<double>(n * n);
-    y_sumY += static_cast<double>(yshifts) / static_cast<double>(n);
-    y_sumXY += static_cast<double>(i * yshifts) / static_cast<double>(n * n);
-  }
-
-  double xtrend = static_cast<double>((n * x_sumXY - sumX * x_sumY) / (n * sumX_2 - sumX * sumX));
-  double ytrend = static_cast<double>((n * y_sumXY - sumX * y_sumY) / (n * sumX_2 - sumX * sumX));
-
-  // error is computed from angular deviation as
-  // |xang1 - xang2| + |yang1 - yang2| = |arctg(xtrend) - arctg(xneedtrend)| + |arctg(ytrend) - arctg(yneedtrend)|
-  return std::fabs(atan(xtrend) - atan(xneedtrend)) + std::fabs(atan(ytrend) - atan(yneedtrend));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-float AdaptiveAlignmentMutualInformation::compute_error2(uint64_t iter, uint64_t index, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest, std::vector<std::vector<int64_t>>& newxshift,
-                                                         std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex)
-{
-  uint64_t n = curindex.size() - 1;
-
-  int64_t xshifts = 0;
-  int64_t yshifts = 0;
-
-  float error = 0;
-  float xdif = 0;
-  float ydif = 0;
-  float divide = static_cast<float>(2 * n);
-
-  for(uint64_t i = 1; i <= n; i++)
-  {
-    if(i != iter)
-    {
-      xshifts += newxshift[i][curindex[i]];
-      yshifts += newyshift[i][curindex[i]];
-    }
-    else
-    {
-      xshifts += newxshift[i][index];
-      yshifts += newyshift[i][index];
-    }
-
-    xdif = static_cast<float>(xshifts) - xshiftsest[i];
-    ydif = static_cast<float>(yshifts) - yshiftsest[i];
-    error += (xdif * xdif + ydif * ydif) / divide;
-  }
-  return error;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void AdaptiveAlignmentMutualInformation::form_features_sections()
 {
-  SIMPL_RANDOMNG_NEW()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
-  int64_t dims[3] = {
+  const std::array<int64_t, 3> dims = {
       static_cast<int64_t>(udims[0]),
       static_cast<int64_t>(udims[1]),
       static_cast<int64_t>(udims[2]),
   };
-
-  int64_t point = 0;
-  int64_t seed = 0;
-  bool noseeds = false;
-  int32_t featurecount = 1;
-  int64_t neighbor = 0;
-  float w = 0.0f;
-
-  int64_t randx = 0;
-  int64_t randy = 0;
-  bool good = false;
-  int64_t x = 0, y = 0, z = 0;
-  int64_t col = 0, row = 0;
-  size_t size = 0;
-  size_t initialVoxelsListSize = 1000;
+  const size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
 
   m_FeatureCounts->resizeTuples(dims[2]);
   featurecounts = m_FeatureCounts->getPointer(0);
 
   int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
 
-  std::vector<int64_t> voxelslist(initialVoxelsListSize, -1);
-  int64_t neighpoints[4] = {0, 0, 0, 0};
-  neighpoints[0] = -dims[0];
-  neighpoints[1] = -1;
-  neighpoints[2] = 1;
-  neighpoints[3] = dims[0];
-
-  uint32_t phase1 = 0, phase2 = 0;
-  float* currentQuatPtr = nullptr;
-
-  for(int64_t slice = 0; slice < dims[2]; slice++)
+  // The misorientations between neighboring Cells do not depend on the tolerance, so if asked to they are kept for
+  // as long as the orientations, phases and crystal structures stay the same
+  uint64_t key = 0;
+  if(m_KeepMisorientations)
   {
-    float prog = ((float)slice / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Identifying Features on Sections || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    featurecount = 1;
-    noseeds = false;
-    while(!noseeds)
-    {
-      seed = -1;
-      randx = int64_t(float(rg.genrand_res53()) * float(dims[0]));
-      randy = int64_t(float(rg.genrand_res53()) * float(dims[1]));
-      for(int64_t j = 0; j < dims[1]; ++j)
-      {
-        for(int64_t i = 0; i < dims[0]; ++i)
-        {
-          x = randx + i;
-          y = randy + j;
-          z = slice;
-          if(x > dims[0] - 1)
-          {
-            x = x - dims[0];
-          }
-          if(y > dims[1] - 1)
-          {
-            y = y - dims[1];
-          }
-          point = (z * dims[0] * dims[1]) + (y * dims[0]) + x;
-          if((!m_UseGoodVoxels || m_GoodVoxels[point]) && miFeatureIds[point] == 0 && m_CellPhases[point] > 0)
-          {
-            seed = point;
-          }
-          if(seed > -1)
-          {
-            break;
-          }
-        }
-        if(seed > -1)
-        {
-          break;
-        }
-      }
-      if(seed == -1)
-      {
-        noseeds = true;
-      }
-      if(seed >= 0)
-      {
-        size = 0;
-        miFeatureIds[seed] = featurecount;
-        voxelslist[size] = seed;
-        size++;
-        for(size_t j = 0; j < size; ++j)
-        {
-          int64_t currentpoint = voxelslist[j];
-          col = currentpoint % dims[0];
-          row = (currentpoint / dims[0]) % dims[1];
-
-          currentQuatPtr = m_Quats + currentpoint * 4;
-          QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]); // Copy data into Quaternion
-
-          phase1 = m_CrystalStructures[m_CellPhases[currentpoint]];
-          for(int32_t i = 0; i < 4; i++)
-          {
-            good = true;
-            neighbor = currentpoint + neighpoints[i];
-            if((i == 0) && row == 0)
-            {
-              good = false;
-            }
-            if((i == 3) && row == (dims[1] - 1))
-            {
-              good = false;
-            }
-            if((i == 1) && col == 0)
-            {
-              good = false;
-            }
-            if((i == 2) && col == (dims[0] - 1))
-            {
-              good = false;
-            }
-            if(good && miFeatureIds[neighbor] <= 0 && m_CellPhases[neighbor] > 0)
-            {
-              w = std::numeric_limits<float>::max();
-              currentQuatPtr = m_Quats + neighbor * 4;
-              QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]); // Copy data into Quaternion
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              if(phase1 == phase2)
-              {
-                OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                w = axisAngle[3];
-              }
-              if(w < m_MisorientationTolerance)
-              {
-                miFeatureIds[neighbor] = featurecount;
-                voxelslist[size] = neighbor;
-                size++;
-                if(std::vector<int64_t>::size_type(size) >= voxelslist.size())
-                {
-                  size = voxelslist.size();
-                  voxelslist.resize(size + initialVoxelsListSize);
-                  for(std::vector<int64_t>::size_type v = size; v < voxelslist.size(); ++v)
-                  {
-                    voxelslist[v] = -1;
-                  }
-                }
-              }
-            }
-          }
-        }
-        voxelslist.erase(std::remove(voxelslist.begin(), voxelslist.end(), -1), voxelslist.end());
-        featurecount++;
-        voxelslist.assign(initialVoxelsListSize, -1);
-      }
-    }
-    featurecounts[slice] = featurecount;
+    key = hashBytes(dims.data(), sizeof(dims), k_HashSeed);
+    key = hashBytes(m_Quats, totalPoints * 4 * sizeof(float), key);
+    key = hashBytes(m_CellPhases, totalPoints * sizeof(int32_t), key);
+    key = hashBytes(m_CrystalStructures, m_CrystalStructuresPtr.lock()->getSize() * sizeof(uint32_t), key);
+  }
+  if(!m_KeepMisorientations || m_CachedEdgeAngles.size() != 2 * totalPoints || m_CachedEdgeAnglesKey != key)
+  {
+    notifyStatusMessage("Aligning Sections || Finding Misorientations on Sections");
+    m_CachedEdgeAngles.resize(2 * totalPoints);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, dims[2]);
+    dataAlg.execute(FindEdgeAnglesImpl(m_Quats, m_CellPhases, m_CrystalStructures, m_OrientationOps, dims, m_CachedEdgeAngles.data()));
+    m_CachedEdgeAnglesKey = key;
   }
+  if(getCancel())
+  {
+    return;
+  }
+
+  notifyStatusMessage("Aligning Sections || Identifying Features on Sections");
+  const float misorientationToleranceRad = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dims[2]);
+  dataAlg.execute(LabelSectionsImpl(m_CellPhases, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_CachedEdgeAngles.data(), misorientationToleranceRad, dims, miFeatureIds, featurecounts));
 }
 
 // -----------------------------------------------------------------------------
@@ -814,10 +668,14 @@ void AdaptiveAlignmentMutualInformation::execute()
     return;
   }
 
-  // Converting the user defined tolerance to radians.
-  m_MisorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
-
   AdaptiveAlignment::execute();
+
+  if(!m_KeepMisorientations)
+  {
+    // The misorientations take two floats per Cell, so they are only held on to when asked for
+    std::vector<float>().swap(m_CachedEdgeAngles);
+    m_CachedEdgeAnglesKey = 0;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -944,6 +802,18 @@ bool AdaptiveAlignmentMutualInformation::getUseGoodVoxels() const
   return m_UseGoodVoxels;
 }
 
+// -----------------------------------------------------------------------------
+void AdaptiveAlignmentMutualInformation::setKeepMisorientations(bool value)
+{
+  m_KeepMisorientations = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AdaptiveAlignmentMutualInformation::getKeepMisorientations() const
+{
+  return m_KeepMisorientations;
+}
+
 // -----------------------------------------------------------------------------
 void AdaptiveAlignmentMutualInformation::setQuatsArrayPath(const DataArrayPath& value)
 {
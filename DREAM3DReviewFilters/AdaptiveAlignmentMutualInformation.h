@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -62,6 +63,7 @@ class DREAM3DReview_EXPORT AdaptiveAlignmentMutualInformation : public AdaptiveA
   PYB11_FILTER_NEW_MACRO(AdaptiveAlignmentMutualInformation)
   PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
   PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+  PYB11_PROPERTY(bool KeepMisorientations READ getKeepMisorientations WRITE setKeepMisorientations)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
@@ -124,6 +126,17 @@ public:
   bool getUseGoodVoxels() const;
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  /**
+   * @brief Setter property for KeepMisorientations
+   */
+  void setKeepMisorientations(bool value);
+  /**
+   * @brief Getter property for KeepMisorientations
+   * @return Value of KeepMisorientations
+   */
+  bool getKeepMisorientations() const;
+  Q_PROPERTY(bool KeepMisorientations READ getKeepMisorientations WRITE setKeepMisorientations)
+
   /**
    * @brief Setter property for QuatsArrayPath
    */
@@ -247,19 +260,9 @@ protected:
   void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts, std::vector<float>& xneedshifts, std::vector<float>& yneedshifts) override;
 
   /**
-   * @brief compute_error1 Determines error between the current and desired shifts (based on discrepancy of slopes)
-   */
-  virtual float compute_error1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, std::vector<std::vector<int64_t>>& newxshift, std::vector<std::vector<int64_t>>& newyshift,
-                               std::vector<uint64_t>& curindex);
-
-  /**
-   * @brief compute_error1 Determines error between the current and desired shifts (based on discrepancy from the estimates obtained from SEM images)
-   */
-  virtual float compute_error2(uint64_t iter, uint64_t index, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest, std::vector<std::vector<int64_t>>& newxshift,
-                               std::vector<std::vector<int64_t>>& newyshift, std::vector<uint64_t>& curindex);
-
-  /**
-   * @brief form_features_sections Determines the existing features in a give slice
+   * @brief form_features_sections Determines the existing features in a give slice.  If KeepMisorientations is set,
+   * the misorientations between neighboring Cells are cached, so running again with only a new tolerance just
+   * relabels the sections
    */
   void form_features_sections();
 
@@ -278,6 +281,7 @@ private:
 
   float m_MisorientationTolerance = {};
   bool m_UseGoodVoxels = {};
+  bool m_KeepMisorientations = {};
   DataArrayPath m_QuatsArrayPath = {};
   DataArrayPath m_CellPhasesArrayPath = {};
   DataArrayPath m_GoodVoxelsArrayPath = {};
@@ -287,6 +291,9 @@ private:
   Int32ArrayType::Pointer m_MIFeaturesPtr;
   uint64_t m_Seed;
 
+  uint64_t m_CachedEdgeAnglesKey = 0;
+  std::vector<float> m_CachedEdgeAngles;
+
 public:
   AdaptiveAlignmentMutualInformation(const AdaptiveAlignmentMutualInformation&) = delete;            // Copy Constructor Not Implemented
   AdaptiveAlignmentMutualInformation(AdaptiveAlignmentMutualInformation&&) = delete;                 // Move Constructor Not Implemented
@@ -48,6 +48,7 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DynamicTableFilterParameter.h"
@@ -429,6 +430,7 @@ void ApplyTransformationToGeometry::setupFilterParameters()
     parameter2->setCategory(FilterParameter::Category::Parameter);
     parameters.push_back(parameter2);
   }
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Low Memory Mode", SliceBySlice, FilterParameter::Category::Parameter, ApplyTransformationToGeometry));
   {
     LinkedBooleanFilterParameter::Pointer parameter3 = LinkedBooleanFilterParameter::New();
     parameter3->setHumanLabel("Select Data Arrays");
@@ -499,6 +501,7 @@ void ApplyTransformationToGeometry::readFilterParameters(AbstractFilterParameter
   setTranslation(reader->readFloatVec3("Translation", getTranslation()));
   setScale(reader->readFloatVec3("Scale", getScale()));
   setUseDataArraySelection(reader->readValue("UseDataArraySelection", getUseDataArraySelection()));
+  setSliceBySlice(reader->readValue("SliceBySlice", getSliceBySlice()));
   // setDataArraySelection(reader->readDataArrayPathVector("DataArraySelection", getDataArraySelection()));
   reader->closeFilterGroup();
 }
@@ -774,8 +777,11 @@ void ApplyTransformationToGeometry::applyImageGeometryTransformation()
 
   QList<QString> selectedCellArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
 
+  // Each array is already interpolated in parallel slab by slab. In low memory mode the arrays are also run one
+  // at a time, so a destination array is only allocated once the previous array is finished and its source has
+  // been released; peak memory is then the source arrays plus a single destination array.
   ParallelTaskAlgorithm taskRunner;
-  taskRunner.setParallelizationEnabled(true);
+  taskRunner.setParallelizationEnabled(!m_SliceBySlice);
 
   for(const auto& attrArrayName : selectedCellArrayNames)
   {
@@ -1130,6 +1136,18 @@ bool ApplyTransformationToGeometry::getUseDataArraySelection() const
   return m_UseDataArraySelection;
 }
 
+// -----------------------------------------------------------------------------
+void ApplyTransformationToGeometry::setSliceBySlice(bool value)
+{
+  m_SliceBySlice = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ApplyTransformationToGeometry::getSliceBySlice() const
+{
+  return m_SliceBySlice;
+}
+
 // -----------------------------------------------------------------------------
 void ApplyTransformationToGeometry::setDataArraySelection(const std::vector<DataArrayPath>& value)
 {
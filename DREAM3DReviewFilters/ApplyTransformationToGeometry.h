@@ -73,6 +73,7 @@ class DREAM3DReview_EXPORT ApplyTransformationToGeometry : public AbstractFilter
   PYB11_PROPERTY(float RotationAngle READ getRotationAngle WRITE setRotationAngle)
   PYB11_PROPERTY(FloatVec3Type Translation READ getTranslation WRITE setTranslation)
   PYB11_PROPERTY(FloatVec3Type Scale READ getScale WRITE setScale)
+  PYB11_PROPERTY(bool SliceBySlice READ getSliceBySlice WRITE setSliceBySlice)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -214,6 +215,18 @@ public:
   std::vector<DataArrayPath> getDataArraySelection() const;
   Q_PROPERTY(std::vector<DataArrayPath> DataArraySelection READ getDataArraySelection WRITE setDataArraySelection)
 
+  /**
+   * @brief Setter property for SliceBySlice
+   */
+  void setSliceBySlice(bool value);
+
+  /**
+   * @brief Getter property for SliceBySlice
+   * @return Value of SliceBySlice
+   */
+  bool getSliceBySlice() const;
+  Q_PROPERTY(bool SliceBySlice READ getSliceBySlice WRITE setSliceBySlice)
+
   /**
    * @brief setCellAttributeMatrixPath
    * @param value
@@ -6,6 +6,7 @@
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
@@ -18,6 +19,7 @@
 #include "SIMPLib/Geometry/IGeometryGrid.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewFilters/util/Delaunay2D.h"
@@ -112,6 +114,52 @@ void mergeTriangleGeometries(std::vector<TriangleGeom::Pointer>& triangles)
   triangles.resize(1);
   triangles[0] = mergedTriangle;
 }
+
+/**
+ * @brief The TriangulateFeatureImpl class triangulates the vertices of a single Feature so
+ * that Features can be triangulated concurrently.
+ */
+class TriangulateFeatureImpl
+{
+public:
+  TriangulateFeatureImpl(AbstractFilter* filter, int32_t featureId, TriMesh::VertexCoordList& vertices, TriangleGeom::Pointer& triangles, double offset, double tolerance,
+                         Delaunay2D::InsertionOrder insertionOrder, Delaunay2D::Algorithm algorithm)
+  : m_Filter(filter)
+  , m_FeatureId(featureId)
+  , m_Vertices(vertices)
+  , m_Triangles(triangles)
+  , m_Offset(offset)
+  , m_Tolerance(tolerance)
+  , m_InsertionOrder(insertionOrder)
+  , m_Algorithm(algorithm)
+  {
+  }
+
+  void operator()() const
+  {
+    if(m_Filter->getCancel())
+    {
+      return;
+    }
+    Delaunay2D::Pointer delaunay = Delaunay2D::New(std::move(m_Vertices), m_Offset, m_Tolerance, 0.0, m_Filter);
+    delaunay->setFilter(m_Filter);
+    delaunay->setMessagePrefix(m_Filter->getHumanLabel());
+    delaunay->setMessageTitle(QObject::tr("Performing Delaunay Triangulation || Feature %1").arg(m_FeatureId));
+    delaunay->setInsertionOrder(m_InsertionOrder);
+    delaunay->setAlgorithm(m_Algorithm);
+    m_Triangles = delaunay->triangulate();
+  }
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  int32_t m_FeatureId = 0;
+  TriMesh::VertexCoordList& m_Vertices;
+  TriangleGeom::Pointer& m_Triangles;
+  double m_Offset = 0.0;
+  double m_Tolerance = 0.0;
+  Delaunay2D::InsertionOrder m_InsertionOrder = Delaunay2D::InsertionOrder::SpatiallySorted;
+  Delaunay2D::Algorithm m_Algorithm = Delaunay2D::Algorithm::Incremental;
+};
 }; // namespace
 
 // -----------------------------------------------------------------------------
@@ -132,6 +180,28 @@ void DelaunayTriangulation::setupFilterParameters()
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Offset", Offset, FilterParameter::Category::Parameter, DelaunayTriangulation));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Tolerance", Tolerance, FilterParameter::Category::Parameter, DelaunayTriangulation));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Algorithm");
+    parameter->setPropertyName("Algorithm");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(DelaunayTriangulation, this, Algorithm));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(DelaunayTriangulation, this, Algorithm));
+    std::vector<QString> choices = {"Incremental", "Divide and Conquer"};
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Insertion Order");
+    parameter->setPropertyName("InsertionOrder");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(DelaunayTriangulation, this, InsertionOrder));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(DelaunayTriangulation, this, InsertionOrder));
+    std::vector<QString> choices = {"Input Order", "Spatially Sorted"};
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
   std::vector<QString> linkedProps = {"FeatureIdsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Triangulate by Feature", TriangulateByFeature, FilterParameter::Category::Parameter, DelaunayTriangulation, linkedProps));
   DataContainerSelectionFilterParameter::RequirementType dcReq;
@@ -331,22 +401,38 @@ void DelaunayTriangulation::execute()
     }
   }
 
-  size_t counter = 1;
   std::vector<TriangleGeom::Pointer> triangles(vertexLists.size());
+  Delaunay2D::InsertionOrder insertionOrder = static_cast<Delaunay2D::InsertionOrder>(m_InsertionOrder);
+  Delaunay2D::Algorithm algorithm = static_cast<Delaunay2D::Algorithm>(m_Algorithm);
 
-  for(auto&& vertexList : vertexLists)
+  if(m_TriangulateByFeature)
   {
-    Delaunay2D::Pointer delaunay = Delaunay2D::New(vertexList, m_Offset, m_Tolerance, 0.0, this);
-    delaunay->setMessagePrefix(getHumanLabel());
-    QString ss = QObject::tr("Performing Delaunay Triangulation");
-    if(m_TriangulateByFeature)
+    // Each Feature is an independent triangulation, so run them concurrently
+    QString ss = QObject::tr("Performing Delaunay Triangulation || %1 Features").arg(numFeatures);
+    notifyStatusMessage(ss);
+
+    ParallelTaskAlgorithm taskRunner;
+    taskRunner.setParallelizationEnabled(true);
+    for(size_t i = 0; i < vertexLists.size(); i++)
     {
-      QString featureProgress = QObject::tr(" || Feature %1 of %2").arg(counter).arg(numFeatures);
-      ss += featureProgress;
+      taskRunner.execute(TriangulateFeatureImpl(this, static_cast<int32_t>(i), vertexLists[i], triangles[i], m_Offset, m_Tolerance, insertionOrder, algorithm));
     }
-    delaunay->setMessageTitle(ss);
-    triangles[counter - 1] = delaunay->triangulate();
-    counter++;
+    taskRunner.wait();
+  }
+  else
+  {
+    Delaunay2D::Pointer delaunay = Delaunay2D::New(std::move(vertexLists[0]), m_Offset, m_Tolerance, 0.0, this);
+    delaunay->setMessagePrefix(getHumanLabel());
+    delaunay->setMessageTitle(QObject::tr("Performing Delaunay Triangulation"));
+    delaunay->setFilter(this);
+    delaunay->setInsertionOrder(insertionOrder);
+    delaunay->setAlgorithm(algorithm);
+    triangles[0] = delaunay->triangulate();
+  }
+
+  if(getCancel())
+  {
+    return;
   }
 
   DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName);
@@ -586,6 +672,38 @@ bool DelaunayTriangulation::getTriangulateByFeature() const
   return m_TriangulateByFeature;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DelaunayTriangulation::setInsertionOrder(const int& value)
+{
+  m_InsertionOrder = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DelaunayTriangulation::getInsertionOrder() const
+{
+  return m_InsertionOrder;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DelaunayTriangulation::setAlgorithm(const int& value)
+{
+  m_Algorithm = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int DelaunayTriangulation::getAlgorithm() const
+{
+  return m_Algorithm;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
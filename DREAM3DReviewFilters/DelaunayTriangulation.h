@@ -107,6 +107,30 @@ public:
   double getTolerance() const;
   Q_PROPERTY(double Tolerance READ getTolerance WRITE setTolerance)
 
+  /**
+   * @brief Setter property for InsertionOrder
+   */
+  void setInsertionOrder(const int& value);
+
+  /**
+   * @brief Getter property for InsertionOrder
+   * @return Value of InsertionOrder
+   */
+  int getInsertionOrder() const;
+  Q_PROPERTY(int InsertionOrder READ getInsertionOrder WRITE setInsertionOrder)
+
+  /**
+   * @brief Setter property for Algorithm
+   */
+  void setAlgorithm(const int& value);
+
+  /**
+   * @brief Getter property for Algorithm
+   * @return Value of Algorithm
+   */
+  int getAlgorithm() const;
+  Q_PROPERTY(int Algorithm READ getAlgorithm WRITE setAlgorithm)
+
   /**
    * @brief Setter property for TriangulateByFeature
    */
@@ -206,6 +230,8 @@ private:
   QString m_FaceAttributeMatrixName = {SIMPL::Defaults::FaceAttributeMatrixName};
   double m_Offset = {1.0};
   double m_Tolerance = {0.00001};
+  int m_InsertionOrder = {1};
+  int m_Algorithm = {0};
   bool m_TriangulateByFeature = {false};
   DataArrayPath m_FeatureIdsArrayPath = {"", "", ""};
   std::weak_ptr<Int32ArrayType> m_FeatureIdsPtr;
@@ -13,7 +13,10 @@
 
 #include "EstablishFoamMorphology.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -51,22 +54,22 @@
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/EuclideanDistanceTransform.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/MajorityGapFiller.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ShapeRasterizer.hpp"
+
 // SIMPLib.h MUST be included before this or the guard will block the include but not its uses below.
 // This is consistent with previous behavior, only earlier parallelization split the includes between
 // the corresponding .h and .cpp files.
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 // clang-format off
-#include <tbb/blocked_range.h>
-#include <tbb/blocked_range3d.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
 #include <tbb/task_group.h>
 // clang-format on
 #endif
 
 /**
- * @brief The FindEuclideanMap2 class implements a threaded algorithm that computes the Euclidean distance map
- * for each point in the supplied volume
+ * @brief The FindEuclideanMap2 class computes the exact Euclidean distance map from the boundary voxels of one order
+ * (grain boundary, triple junction or quadruple point) for each point in the supplied volume
  */
 class FindEuclideanMap2
 {
@@ -94,348 +97,58 @@ public:
 
   void operator()() const
   {
-    size_t totalPoints = m_DataContainer->getGeometryAs<ImageGeom>()->getNumberOfElements();
-    double euclideanDistance = 0.0f;
-    size_t count = 1;
-    size_t changed = 1;
-    size_t neighpoint = 0;
-    int64_t nearestneighbor;
-    std::array<int64_t, 6> neighbors = {0, 0, 0, 0, 0, 0};
     ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
-    int64_t xpoints = static_cast<int64_t>(imageGeom->getXPoints());
-    int64_t ypoints = static_cast<int64_t>(imageGeom->getYPoints());
-    int64_t zpoints = static_cast<int64_t>(imageGeom->getZPoints());
-
+    size_t totalPoints = imageGeom->getNumberOfElements();
+    SizeVec3Type udims = imageGeom->getDimensions();
     FloatVec3Type spacing = imageGeom->getSpacing();
 
-    double resx = static_cast<double>(spacing[0]);
-    double resy = static_cast<double>(spacing[1]);
-    double resz = static_cast<double>(spacing[2]);
-
-    neighbors[0] = -xpoints * ypoints;
-    neighbors[1] = -xpoints;
-    neighbors[2] = -1;
-    neighbors[3] = 1;
-    neighbors[4] = xpoints;
-    neighbors[5] = xpoints * ypoints;
+    std::array<int64_t, 3> dims = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+    std::array<double, 3> res = {static_cast<double>(spacing[0]), static_cast<double>(spacing[1]), static_cast<double>(spacing[2])};
 
-    // Use a std::vector to get an auto cleaned up array thus not needing the 'delete' keyword later on.
-    std::vector<int64_t> voxNN(totalPoints, 0);
-    int64_t* voxel_NearestNeighbor = &(voxNN.front());
-    std::vector<double> voxEDist(totalPoints, 0.0);
-    double* voxel_EuclideanDistance = &(voxEDist.front());
-
-    euclideanDistance = 0;
-    for(size_t a = 0; a < totalPoints; ++a)
+    float* euclideanDistances = m_GBEuclideanDistances;
+    if(mapType == 1)
     {
-      if(m_NearestNeighbors[a * 3 + mapType] >= 0)
-      {
-        voxel_NearestNeighbor[a] = a;
-      } // if voxel is boundary voxel, then want to use itself as nearest boundary voxel
-      else
-      {
-        voxel_NearestNeighbor[a] = -1;
-      }
-      if(mapType == 0)
-      {
-        voxel_EuclideanDistance[a] = static_cast<double>(m_GBEuclideanDistances[a]);
-      }
-      else if(mapType == 1)
-      {
-        voxel_EuclideanDistance[a] = static_cast<double>(m_TJEuclideanDistances[a]);
-      }
-      else if(mapType == 2)
-      {
-        voxel_EuclideanDistance[a] = static_cast<double>(m_QPEuclideanDistances[a]);
-      }
-    }
-    count = 1;
-    changed = 1;
-    int64_t i = 0;
-    int64_t zBlock = xpoints * ypoints;
-    int64_t zStride = 0;
-    int64_t yStride = 0;
-    std::array<char, 6> mask = {0, 0, 0, 0, 0, 0};
-    while(count > 0 && changed > 0)
-    {
-      count = 0;
-      changed = 0;
-      euclideanDistance++;
-
-      for(int64_t z = 0; z < zpoints; ++z)
-      {
-        zStride = z * zBlock;
-        mask[0] = mask[5] = 1;
-        if(z == 0)
-        {
-          mask[0] = 0;
-        }
-        if(z == zpoints - 1)
-        {
-          mask[5] = 0;
-        }
-
-        for(int64_t y = 0; y < ypoints; ++y)
-        {
-          yStride = y * xpoints;
-          mask[1] = mask[4] = 1;
-          if(y == 0)
-          {
-            mask[1] = 0;
-          }
-          if(y == ypoints - 1)
-          {
-            mask[4] = 0;
-          }
-
-          for(int64_t x = 0; x < xpoints; ++x)
-          {
-            mask[2] = mask[3] = 1;
-            if(x == 0)
-            {
-              mask[2] = 0;
-            }
-            if(x == xpoints - 1)
-            {
-              mask[3] = 0;
-            }
-
-            i = zStride + yStride + x;
-            if(voxel_NearestNeighbor[i] == -1 && m_FeatureIds[i] > 0)
-            {
-              count++;
-              for(int32_t j = 0; j < 6; j++)
-              {
-                neighpoint = i + neighbors[j];
-                if(mask[j] == 1)
-                {
-                  if(voxel_EuclideanDistance[neighpoint] != -1.0)
-                  {
-                    voxel_NearestNeighbor[i] = voxel_NearestNeighbor[neighpoint];
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
-      for(size_t j = 0; j < totalPoints; ++j)
-      {
-        if(voxel_NearestNeighbor[j] != -1 && voxel_EuclideanDistance[j] == -1.0 && m_FeatureIds[j] > 0)
-        {
-          changed++;
-          voxel_EuclideanDistance[j] = euclideanDistance;
-        }
-      }
+      euclideanDistances = m_TJEuclideanDistances;
     }
-    double x1 = 0.0;
-    double x2 = 0.0;
-    double y1 = 0.0;
-    double y2 = 0.0;
-    double z1 = 0.0;
-    double z2 = 0.0;
-    double dist = 0.0;
-    double oneOverzBlock = 1.0 / double(zBlock);
-    double oneOverxpoints = 1.0 / double(xpoints);
-    for(int64_t m = 0; m < zpoints; m++)
+    else if(mapType == 2)
     {
-      zStride = m * zBlock;
-      for(int64_t n = 0; n < ypoints; n++)
-      {
-        yStride = n * xpoints;
-        for(int64_t p = 0; p < xpoints; p++)
-        {
-          x1 = double(p) * resx;
-          y1 = double(n) * resy;
-          z1 = double(m) * resz;
-          nearestneighbor = voxel_NearestNeighbor[zStride + yStride + p];
-          if(nearestneighbor >= 0)
-          {
-            x2 = resx * double(nearestneighbor % xpoints);                           // find_xcoord(nearestneighbor);
-            y2 = resy * double(int64_t(nearestneighbor * oneOverxpoints) % ypoints); // find_ycoord(nearestneighbor);
-            z2 = resz * floor(nearestneighbor * oneOverzBlock);                      // find_zcoord(nearestneighbor);
-            dist = ((x1 - x2) * (x1 - x2)) + ((y1 - y2) * (y1 - y2)) + ((z1 - z2) * (z1 - z2));
-            dist = sqrt(dist);
-            voxel_EuclideanDistance[zStride + yStride + p] = dist;
-          }
-        }
-      }
+      euclideanDistances = m_QPEuclideanDistances;
     }
+
+    // Boundary voxels of this order that belong to a Feature are the seeds of the transform
+    std::vector<double> sqDistances(totalPoints, std::numeric_limits<double>::infinity());
+    std::vector<int64_t> voxelNearestNeighbor(totalPoints, -1);
     for(size_t a = 0; a < totalPoints; ++a)
     {
-      m_NearestNeighbors[a * 3 + mapType] = voxel_NearestNeighbor[a];
-      if(mapType == 0)
-      {
-        m_GBEuclideanDistances[a] = static_cast<float>(voxel_EuclideanDistance[a]);
-      }
-      else if(mapType == 1)
+      if(m_NearestNeighbors[a * 3 + mapType] >= 0 && m_FeatureIds[a] > 0)
       {
-        m_TJEuclideanDistances[a] = static_cast<float>(voxel_EuclideanDistance[a]);
-      }
-      else if(mapType == 2)
-      {
-        m_QPEuclideanDistances[a] = static_cast<float>(voxel_EuclideanDistance[a]);
+        sqDistances[a] = 0.0;
+        voxelNearestNeighbor[a] = static_cast<int64_t>(a);
       }
     }
-  }
-};
-
-/**
- * @brief The FoamAssignVoxelsGapsImpl class implements a threaded algorithm that assigns all the voxels
- * in the volume to a unique Feature.
- */
-class FoamAssignVoxelsGapsImpl
-{
-  std::array<size_t, 3> m_UDims;
-  std::array<float, 3> m_Invradcur;
-  std::array<float, 3> m_Spacing;
-
-  float ga[3][3];
-  int32_t curFeature = 0;
-
-  float xc = 0.0f;
-  float yc = 0.0f;
-  float zc = 0.0f;
-  // int32_t* m_FeatureIds = nullptr;
-  ShapeOps* m_ShapeOps = nullptr;
-
-  Int32ArrayType::Pointer m_NewOwnersPtr;
-  FloatArrayType::Pointer mEllipFuncsPtr;
 
-public:
-  FoamAssignVoxelsGapsImpl(SizeVec3Type& dimensions, FloatVec3Type& resolution, int32_t* featureIds, const float* radCur, const float* xx, ShapeOps* shapeOps, float gA[3][3], const float* size,
-                           int32_t cur_feature, const Int32ArrayType::Pointer& newowners, const FloatArrayType::Pointer& ellipfuncs)
-  : curFeature(cur_feature)
-  , m_ShapeOps(shapeOps)
-  {
-    m_UDims[0] = dimensions[0];
-    m_UDims[1] = dimensions[1];
-    m_UDims[2] = dimensions[2];
-
-    m_Invradcur[0] = 1.0 / radCur[0];
-    m_Invradcur[1] = 1.0 / radCur[1];
-    m_Invradcur[2] = 1.0 / radCur[2];
-
-    m_Spacing[0] = resolution[0];
-    m_Spacing[1] = resolution[1];
-    m_Spacing[2] = resolution[2];
-
-    xc = xx[0];
-    yc = xx[1];
-    zc = xx[2];
-
-    ga[0][0] = gA[0][0];
-    ga[0][1] = gA[0][1];
-    ga[0][2] = gA[0][2];
-    ga[1][0] = gA[1][0];
-    ga[1][1] = gA[1][1];
-    ga[1][2] = gA[1][2];
-    ga[2][0] = gA[2][0];
-    ga[2][1] = gA[2][1];
-    ga[2][2] = gA[2][2];
-
-    m_NewOwnersPtr = newowners;
-    mEllipFuncsPtr = ellipfuncs;
-  }
-
-  ~FoamAssignVoxelsGapsImpl() = default;
-
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  void convert(int64_t zStart, int64_t zEnd, int64_t yStart, int64_t yEnd, int64_t xStart, int64_t xEnd) const
-  {
-    int64_t column = 0;
-    int64_t row = 0;
-    int64_t plane = 0;
-    int64_t index = 0;
-    std::array<float, 3> coords = {0.0f, 0.0f, 0.0f};
-    float inside = 0.0f;
-    std::array<float, 3> coordsRotated = {0.0f, 0.0f, 0.0f};
-    int32_t* newowners = m_NewOwnersPtr->getPointer(0);
-    float* ellipfuncs = mEllipFuncsPtr->getPointer(0);
-
-    const std::array<int64_t, 3> dims = {
-        static_cast<int64_t>(m_UDims[0]),
-        static_cast<int64_t>(m_UDims[1]),
-        static_cast<int64_t>(m_UDims[2]),
-    };
+    EuclideanDistanceTransform::ComputeSquaredDistanceMap(dims, res, sqDistances, voxelNearestNeighbor);
 
-    int64_t dim0_dim_1 = m_UDims[0] * m_UDims[1];
-    for(int64_t iter1 = xStart; iter1 < xEnd; iter1++)
+    for(size_t a = 0; a < totalPoints; ++a)
     {
-      column = iter1;
-      if(iter1 < 0)
+      if(m_FeatureIds[a] <= 0)
       {
-        column = iter1 + dims[0];
+        // Voxels outside of any Feature are their own nearest boundary
+        m_NearestNeighbors[a * 3 + mapType] = static_cast<int32_t>(a);
+        euclideanDistances[a] = 0.0f;
       }
-      else if(iter1 > dims[0] - 1)
+      else if(voxelNearestNeighbor[a] >= 0)
       {
-        column = iter1 - dims[0];
+        m_NearestNeighbors[a * 3 + mapType] = static_cast<int32_t>(voxelNearestNeighbor[a]);
+        euclideanDistances[a] = static_cast<float>(std::sqrt(sqDistances[a]));
       }
-
-      for(int64_t iter2 = yStart; iter2 < yEnd; iter2++)
+      else
       {
-        row = iter2;
-        if(iter2 < 0)
-        {
-          row = iter2 + dims[1];
-        }
-        else if(iter2 > dims[1] - 1)
-        {
-          row = iter2 - dims[1];
-        }
-        size_t row_dim = row * dims[0];
-
-        for(int64_t iter3 = zStart; iter3 < zEnd; iter3++)
-        {
-          plane = iter3;
-          if(iter3 < 0)
-          {
-            plane = iter3 + dims[2];
-          }
-          else if(iter3 > dims[2] - 1)
-          {
-            plane = iter3 - dims[2];
-          }
-
-          index = static_cast<int64_t>((plane * dim0_dim_1) + (row_dim) + column);
-
-          inside = -1.0f;
-          coords[0] = float(iter1) * m_Spacing[0];
-          coords[1] = float(iter2) * m_Spacing[1];
-          coords[2] = float(iter3) * m_Spacing[2];
-
-          coords[0] = coords[0] - xc;
-          coords[1] = coords[1] - yc;
-          coords[2] = coords[2] - zc;
-          MatrixMath::Multiply3x3with3x1(ga, coords.data(), coordsRotated.data());
-          float axis1comp = coordsRotated[0] * m_Invradcur[0];
-          float axis2comp = coordsRotated[1] * m_Invradcur[1];
-          float axis3comp = coordsRotated[2] * m_Invradcur[2];
-          inside = m_ShapeOps->inside(axis1comp, axis2comp, axis3comp);
-
-          if(inside >= 0 && newowners[index] > 0 && inside > ellipfuncs[index])
-          {
-            newowners[index] = curFeature;
-            ellipfuncs[index] = inside;
-          }
-          else if(inside >= 0 && newowners[index] == -1)
-          {
-            newowners[index] = curFeature;
-            ellipfuncs[index] = inside;
-          }
-        }
+        m_NearestNeighbors[a * 3 + mapType] = -1;
+        euclideanDistances[a] = -1.0f;
       }
     }
   }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range3d<int64_t, int64_t, int64_t>& r) const
-  {
-    convert(r.pages().begin(), r.pages().end(), r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-  }
-#endif
 };
 
 // Include the MOC generated file for this class
@@ -460,7 +173,6 @@ EstablishFoamMorphology::~EstablishFoamMorphology() = default;
 // -----------------------------------------------------------------------------
 void EstablishFoamMorphology::initialize()
 {
-  m_Neighbors = nullptr;
   m_BoundaryCells = nullptr;
 
   m_StatsDataArray = StatsDataArray::NullPointer();
@@ -473,10 +185,11 @@ void EstablishFoamMorphology::initialize()
   m_SuperEllipsoidOps = ShapeOps::NullPointer();
   m_OrthoOps = OrthoRhombicOps::New();
 
-  m_ColumnList.clear();
-  m_RowList.clear();
-  m_PlaneList.clear();
-  m_EllipFuncList.clear();
+  m_FeatureStencils.clear();
+  for(auto& packingWrap : m_PackingWrap)
+  {
+    packingWrap.clear();
+  }
 
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
@@ -506,6 +219,12 @@ void EstablishFoamMorphology::initialize()
   m_PrecipitatePhases.clear();
   m_PrecipitatePhaseFractions.clear();
 
+  m_CentroidHashCellSize = 1.0f;
+  m_CentroidHashDims[0] = m_CentroidHashDims[1] = m_CentroidHashDims[2] = 1;
+  m_CentroidHashCells.clear();
+  m_FeatureHashCell.clear();
+  m_FeatureHashSlot.clear();
+
   m_AvailablePointsCount = 1;
   m_FillingError = m_OldFillingError = 0.0f;
   m_CurrentNeighborhoodError = m_OldNeighborhoodError = 0.0f;
@@ -1167,9 +886,11 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
   Int32ArrayType::Pointer exclusionOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, cDim, "_INTERNAL_USE_ONLY_PackPrecipitateFeatures::exclusions_owners", true);
   exclusionOwnersPtr->initializeWithValue(0);
 
-  // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // This is the set that we are going to keep updated with the points that are not in an exclusion zone.
+  // availablePointsInv packs the available packing points and availablePoints holds the slot of each
+  // packing point in that list (or -1), so membership updates and random picks are constant time
+  std::vector<int64_t> availablePoints;
+  std::vector<size_t> availablePointsInv;
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -1178,12 +899,14 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
 
   // determine initial set of available points
   m_AvailablePointsCount = 0;
+  availablePoints.assign(m_TotalPackingPoints, -1);
+  availablePointsInv.clear();
   for(int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if(exclusionOwners[i] == 0)
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
+      availablePoints[i] = static_cast<int64_t>(m_AvailablePointsCount);
+      availablePointsInv.push_back(i);
       m_AvailablePointsCount++;
     }
   }
@@ -1367,12 +1090,10 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
     return;
   }
 
-  m_ColumnList.resize(totalFeatures);
-  m_RowList.resize(totalFeatures);
-  m_PlaneList.resize(totalFeatures);
-  m_EllipFuncList.resize(totalFeatures);
+  m_FeatureStencils.assign(totalFeatures, FeatureStencil());
   m_PackQualities.resize(totalFeatures);
   m_FillingError = 1.0f;
+  initialize_centroidhash();
 
   int64_t count = 0;
   int64_t column = 0;
@@ -1455,12 +1176,14 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
 
   // determine initial set of available points
   m_AvailablePointsCount = 0;
+  availablePoints.assign(m_TotalPackingPoints, -1);
+  availablePointsInv.clear();
   for(int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if(exclusionOwners[i] == 0)
     {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
+      availablePoints[i] = static_cast<int64_t>(m_AvailablePointsCount);
+      availablePointsInv.push_back(i);
       m_AvailablePointsCount++;
     }
   }
@@ -1477,6 +1200,7 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
   float yshift = 0.0f;
   float zshift = 0.0f;
   int32_t lastIteration = 0;
+  int64_t fillingErrorChange = 0;
   for(int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
   {
     currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -1502,7 +1226,7 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
 
     if(writeErrorFile && iteration % 25 == 0)
     {
-      outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
+      outFile << iteration << " " << m_FillingError << "  " << availablePointsInv.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
     }
 
     // JUMP - this option moves one feature to a random spot in the volume
@@ -1536,7 +1260,7 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
       }
       m_Seed++;
 
-      if(!availablePoints.empty())
+      if(m_AvailablePointsCount > 0)
       {
         key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
         featureOwnersIdx = availablePointsInv[key];
@@ -1557,18 +1281,32 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
       oldyc = m_Centroids[3 * randomfeature + 1];
       oldzc = m_Centroids[3 * randomfeature + 2];
       m_OldFillingError = m_FillingError;
-      m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      move_feature(randomfeature, xc, yc, zc);
-      m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-
-      if(m_FillingError > m_OldFillingError)
+      // Evaluate the move read-only first so that only accepted moves write to the packing grid
+      if(check_movefillingerror(randomfeature, xc, yc, zc, featureOwners, fillingErrorChange))
+      {
+        if(fillingErrorChange <= 0)
+        {
+          m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+          move_feature(randomfeature, xc, yc, zc);
+          m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        }
+      }
+      else
       {
         m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        move_feature(randomfeature, oldxc, oldyc, oldzc);
+        move_feature(randomfeature, xc, yc, zc);
         m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
+
+        if(m_FillingError > m_OldFillingError)
+        {
+          m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+          move_feature(randomfeature, oldxc, oldyc, oldzc);
+          m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+          m_PointsToRemove.clear();
+          m_PointsToAdd.clear();
+        }
       }
+      update_availablepoints(availablePoints, availablePointsInv, exclusionOwners);
     }
 
     // NUDGE - this option moves one feature to a spot close to its current centroid
@@ -1632,20 +1370,42 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
         zc = oldzc;
       }
       m_OldFillingError = m_FillingError;
-      m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      move_feature(randomfeature, xc, yc, zc);
-      m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-
-      if(m_FillingError > m_OldFillingError)
+      // Evaluate the move read-only first so that only accepted moves write to the packing grid
+      if(check_movefillingerror(randomfeature, xc, yc, zc, featureOwners, fillingErrorChange))
       {
-        m_FillingError = check_fillingerror(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        move_feature(randomfeature, oldxc, oldyc, oldzc);
-        m_FillingError = check_fillingerror(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
+        if(fillingErrorChange <= 0)
+        {
+          m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+          move_feature(randomfeature, xc, yc, zc);
+          m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        }
       }
+      else
+      {
+        m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+        move_feature(randomfeature, xc, yc, zc);
+        m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+
+        if(m_FillingError > m_OldFillingError)
+        {
+          m_FillingError = check_fillingerror(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+          move_feature(randomfeature, oldxc, oldyc, oldzc);
+          m_FillingError = check_fillingerror(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+          m_PointsToRemove.clear();
+          m_PointsToAdd.clear();
+        }
+      }
+      update_availablepoints(availablePoints, availablePointsInv, exclusionOwners);
     }
   }
+
+  currentMillis = QDateTime::currentMSecsSinceEpoch();
+  uint64_t packingMillis = std::max(currentMillis - startMillis, static_cast<uint64_t>(1));
+  ss = QObject::tr("Packing Features || %1 Moves in %2 || Moves/Sec: %3")
+           .arg(totalAdjustments)
+           .arg(DREAM3D::convertMillisToHrsMinSecs(packingMillis))
+           .arg(static_cast<double>(totalAdjustments) * 1000.0 / static_cast<double>(packingMillis));
+  notifyStatusMessage(ss);
 }
 
 // -----------------------------------------------------------------------------
@@ -1685,6 +1445,7 @@ Int32ArrayType::Pointer EstablishFoamMorphology::initialize_packinggrid()
   }
 
   m_TotalPackingPoints = m_PackingPoints[0] * m_PackingPoints[1] * m_PackingPoints[2];
+  initialize_packingwrap();
 
   Int32ArrayType::Pointer featureOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, std::string("_INTERNAL_USE_ONLY_PackPrecipitateFeatures::feature_owners"), true);
   featureOwnersPtr->initializeWithZeros();
@@ -1858,26 +1619,109 @@ void EstablishFoamMorphology::move_feature(size_t gnum, float xc, float yc, floa
   m_Centroids[3 * gnum] = xc;
   m_Centroids[3 * gnum + 1] = yc;
   m_Centroids[3 * gnum + 2] = zc;
-  size_t size = m_ColumnList[gnum].size();
+  update_centroidhash(gnum);
+
+  std::array<int64_t, 3>& center = m_FeatureStencils[gnum].m_Center;
+  center[0] += shiftcolumn;
+  center[1] += shiftrow;
+  center[2] += shiftplane;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EstablishFoamMorphology::initialize_centroidhash()
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  size_t totalFeatures = m->getAttributeMatrix(getOutputCellFeatureAttributeMatrixName())->getNumberOfTuples();
+
+  // Two Features can only count each other as neighbors if their centroids are closer than the larger of
+  // their equivalent diameters along every axis, so with cells this wide the neighbors always lie in adjacent cells
+  float maxDia = 0.0f;
+  for(size_t n = m_FirstFoamFeature; n < totalFeatures; n++)
+  {
+    maxDia = std::max(maxDia, m_EquivalentDiameters[n]);
+  }
+  // Never use more cells than Features; larger cells are still correct, just less selective
+  size_t numFoamFeatures = totalFeatures > static_cast<size_t>(m_FirstFoamFeature) ? totalFeatures - m_FirstFoamFeature : 1;
+  float minCellSize = std::cbrt(m_TotalVol / static_cast<float>(numFoamFeatures));
+  m_CentroidHashCellSize = std::max(maxDia, minCellSize);
+  if(m_CentroidHashCellSize <= 0.0f)
+  {
+    m_CentroidHashCellSize = 1.0f;
+  }
 
-  for(size_t i = 0; i < size; i++)
+  std::array<float, 3> boxSize = {m_SizeX, m_SizeY, m_SizeZ};
+  for(size_t d = 0; d < 3; d++)
   {
-    int64_t& cl = m_ColumnList[gnum][i];
-    cl += shiftcolumn;
-    int64_t& rl = m_RowList[gnum][i];
-    rl += shiftrow;
-    int64_t& pl = m_PlaneList[gnum][i];
-    pl += shiftplane;
+    m_CentroidHashDims[d] = std::max(static_cast<int64_t>(1), static_cast<int64_t>(std::ceil(boxSize[d] / m_CentroidHashCellSize)));
+  }
+
+  m_CentroidHashCells.assign(m_CentroidHashDims[0] * m_CentroidHashDims[1] * m_CentroidHashDims[2], std::vector<int32_t>());
+  m_FeatureHashCell.assign(totalFeatures, -1);
+  m_FeatureHashSlot.assign(totalFeatures, 0);
+  for(size_t n = m_FirstFoamFeature; n < totalFeatures; n++)
+  {
+    update_centroidhash(n);
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EstablishFoamMorphology::determine_neighbors(size_t gnum, bool add)
+std::array<int64_t, 3> EstablishFoamMorphology::find_centroidhashcell(const float* coords) const
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  std::array<int64_t, 3> cell = {0, 0, 0};
+  for(size_t d = 0; d < 3; d++)
+  {
+    float pos = std::floor(coords[d] / m_CentroidHashCellSize);
+    if(pos > 0.0f)
+    {
+      cell[d] = std::min(static_cast<int64_t>(pos), m_CentroidHashDims[d] - 1);
+    }
+  }
+  return cell;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EstablishFoamMorphology::update_centroidhash(size_t gnum)
+{
+  if(gnum >= m_FeatureHashCell.size())
+  {
+    return;
+  }
 
+  std::array<int64_t, 3> cell = find_centroidhashcell(m_Centroids + 3 * gnum);
+  int64_t cellIdx = (m_CentroidHashDims[0] * m_CentroidHashDims[1] * cell[2]) + (m_CentroidHashDims[0] * cell[1]) + cell[0];
+  int64_t oldCellIdx = m_FeatureHashCell[gnum];
+  if(cellIdx == oldCellIdx)
+  {
+    return;
+  }
+
+  if(oldCellIdx >= 0)
+  {
+    // Swap-remove from the old cell and fix the slot of the Feature that took its place
+    std::vector<int32_t>& oldCell = m_CentroidHashCells[oldCellIdx];
+    size_t slot = m_FeatureHashSlot[gnum];
+    oldCell[slot] = oldCell.back();
+    m_FeatureHashSlot[oldCell[slot]] = slot;
+    oldCell.pop_back();
+  }
+
+  std::vector<int32_t>& newCell = m_CentroidHashCells[cellIdx];
+  m_FeatureHashCell[gnum] = cellIdx;
+  m_FeatureHashSlot[gnum] = newCell.size();
+  newCell.push_back(static_cast<int32_t>(gnum));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EstablishFoamMorphology::determine_neighbors(size_t gnum, bool add)
+{
   float x = 0.0f;
   float y = 0.0f;
   float z = 0.0f;
@@ -1893,7 +1737,6 @@ void EstablishFoamMorphology::determine_neighbors(size_t gnum, bool add)
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
   dia = m_EquivalentDiameters[gnum];
-  size_t totalFeatures = m->getAttributeMatrix(getOutputCellFeatureAttributeMatrixName())->getNumberOfTuples();
   int32_t increment = 0;
   if(add)
   {
@@ -1903,22 +1746,35 @@ void EstablishFoamMorphology::determine_neighbors(size_t gnum, bool add)
   {
     increment = -1;
   }
-  for(size_t n = m_FirstFoamFeature; n < totalFeatures; n++)
+
+  // Only the cells adjacent to the Feature's own cell can hold centroids within a diameter of it
+  std::array<int64_t, 3> cell = find_centroidhashcell(m_Centroids + 3 * gnum);
+  for(int64_t k = std::max(cell[2] - 1, static_cast<int64_t>(0)); k <= std::min(cell[2] + 1, m_CentroidHashDims[2] - 1); k++)
   {
-    xn = m_Centroids[3 * n];
-    yn = m_Centroids[3 * n + 1];
-    zn = m_Centroids[3 * n + 2];
-    dia2 = m_EquivalentDiameters[n];
-    dx = fabs(x - xn);
-    dy = fabs(y - yn);
-    dz = fabs(z - zn);
-    if(dx < dia && dy < dia && dz < dia)
+    for(int64_t j = std::max(cell[1] - 1, static_cast<int64_t>(0)); j <= std::min(cell[1] + 1, m_CentroidHashDims[1] - 1); j++)
     {
-      m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
-    }
-    if(dx < dia2 && dy < dia2 && dz < dia2)
-    {
-      m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      for(int64_t i = std::max(cell[0] - 1, static_cast<int64_t>(0)); i <= std::min(cell[0] + 1, m_CentroidHashDims[0] - 1); i++)
+      {
+        const std::vector<int32_t>& features = m_CentroidHashCells[(m_CentroidHashDims[0] * m_CentroidHashDims[1] * k) + (m_CentroidHashDims[0] * j) + i];
+        for(int32_t n : features)
+        {
+          xn = m_Centroids[3 * n];
+          yn = m_Centroids[3 * n + 1];
+          zn = m_Centroids[3 * n + 2];
+          dia2 = m_EquivalentDiameters[n];
+          dx = fabs(x - xn);
+          dy = fabs(y - yn);
+          dz = fabs(z - zn);
+          if(dx < dia && dy < dia && dz < dia)
+          {
+            m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+          }
+          if(dx < dia2 && dy < dia2 && dz < dia2)
+          {
+            m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+          }
+        }
+      }
     }
   }
 }
@@ -2221,14 +2077,11 @@ float EstablishFoamMorphology::check_sizedisterror(Feature_t* feature)
 // -----------------------------------------------------------------------------
 float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove, const Int32ArrayType::Pointer& featureOwnersPtr, const Int32ArrayType::Pointer& exclusionOwnersPtr)
 {
-  size_t featureOwnersIdx = 0;
+  int64_t featureOwnersIdx = 0;
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
   int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
 
   m_FillingError = m_FillingError * float(m_TotalPackingPoints);
-  int64_t col = 0;
-  int64_t row = 0;
-  int64_t plane = 0;
   int32_t k1 = 0;
   int32_t k2 = 0;
   int32_t k3 = 0;
@@ -2237,81 +2090,28 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
     k1 = 2;
     k2 = -1;
     k3 = 1;
-    size_t numVoxelsForCurrentGrain = m_ColumnList[gadd].size();
-    std::vector<int64_t>& cl = m_ColumnList[gadd];
-    std::vector<int64_t>& rl = m_RowList[gadd];
-    std::vector<int64_t>& pl = m_PlaneList[gadd];
-    std::vector<float>& efl = m_EllipFuncList[gadd];
+    const FeatureStencil& stencil = m_FeatureStencils[gadd];
+    size_t numVoxelsForCurrentGrain = stencil.m_ShapeFunc.size();
     float packquality = 0;
     for(size_t i = 0; i < numVoxelsForCurrentGrain; i++)
     {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
-      if(m_PeriodicBoundaries)
+      featureOwnersIdx = find_packingpointindex(stencil.m_Center[0] + stencil.m_Columns[i], stencil.m_Center[1] + stencil.m_Rows[i], stencil.m_Center[2] + stencil.m_Planes[i]);
+      if(featureOwnersIdx < 0)
       {
-        if(col < 0)
-        {
-          col = col + m_PackingPoints[0];
-        }
-        if(col > m_PackingPoints[0] - 1)
-        {
-          col = col - m_PackingPoints[0];
-        }
-        if(row < 0)
-        {
-          row = row + m_PackingPoints[1];
-        }
-        if(row > m_PackingPoints[1] - 1)
-        {
-          row = row - m_PackingPoints[1];
-        }
-        if(plane < 0)
-        {
-          plane = plane + m_PackingPoints[2];
-        }
-        if(plane > m_PackingPoints[2] - 1)
-        {
-          plane = plane - m_PackingPoints[2];
-        }
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-        int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-        if(efl[i] > 0.1f)
-        {
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToRemove.push_back(featureOwnersIdx);
-          }
-          exclusionOwners[featureOwnersIdx]++;
-        }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-        //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-        featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
-        packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
+        continue;
       }
-      else
+      int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
+      if(stencil.m_ShapeFunc[i] > 0.1f)
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        if(exclusionOwners[featureOwnersIdx] == 0)
         {
-          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-          int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-          if(exclusionOwners[featureOwnersIdx] > 0)
-          {
-          }
-          if(efl[i] > 0.1f)
-          {
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToRemove.push_back(featureOwnersIdx);
-            }
-            exclusionOwners[featureOwnersIdx]++;
-          }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-          //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-          featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
-          packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
+          m_PointsToRemove.push_back(featureOwnersIdx);
         }
+        exclusionOwners[featureOwnersIdx]++;
       }
+      m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+      featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+      packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
     }
     m_PackQualities[gadd] = static_cast<int64_t>(packquality / float(numVoxelsForCurrentGrain));
   }
@@ -2320,75 +2120,26 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
     k1 = -2;
     k2 = 3;
     k3 = -1;
-    size_t size = m_ColumnList[gremove].size();
-    std::vector<int64_t>& cl = m_ColumnList[gremove];
-    std::vector<int64_t>& rl = m_RowList[gremove];
-    std::vector<int64_t>& pl = m_PlaneList[gremove];
-    std::vector<float>& efl = m_EllipFuncList[gremove];
+    const FeatureStencil& stencil = m_FeatureStencils[gremove];
+    size_t size = stencil.m_ShapeFunc.size();
     for(size_t i = 0; i < size; i++)
     {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
-      if(m_PeriodicBoundaries)
+      featureOwnersIdx = find_packingpointindex(stencil.m_Center[0] + stencil.m_Columns[i], stencil.m_Center[1] + stencil.m_Rows[i], stencil.m_Center[2] + stencil.m_Planes[i]);
+      if(featureOwnersIdx < 0)
       {
-        if(col < 0)
-        {
-          col = col + m_PackingPoints[0];
-        }
-        if(col > m_PackingPoints[0] - 1)
-        {
-          col = col - m_PackingPoints[0];
-        }
-        if(row < 0)
-        {
-          row = row + m_PackingPoints[1];
-        }
-        if(row > m_PackingPoints[1] - 1)
-        {
-          row = row - m_PackingPoints[1];
-        }
-        if(plane < 0)
-        {
-          plane = plane + m_PackingPoints[2];
-        }
-        if(plane > m_PackingPoints[2] - 1)
-        {
-          plane = plane - m_PackingPoints[2];
-        }
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-        int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-        if(efl[i] > 0.1f)
-        {
-          exclusionOwners[featureOwnersIdx]--;
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToAdd.push_back(featureOwnersIdx);
-          }
-        }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-        //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-        featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+        continue;
       }
-      else
+      int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
+      if(stencil.m_ShapeFunc[i] > 0.1f)
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        exclusionOwners[featureOwnersIdx]--;
+        if(exclusionOwners[featureOwnersIdx] == 0)
         {
-          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-          int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-          if(efl[i] > 0.1f)
-          {
-            exclusionOwners[featureOwnersIdx]--;
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToAdd.push_back(featureOwnersIdx);
-            }
-          }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-          //          fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-          featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+          m_PointsToAdd.push_back(featureOwnersIdx);
         }
       }
+      m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+      featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
     }
   }
   m_FillingError = m_FillingError / float(m_TotalPackingPoints);
@@ -2398,33 +2149,163 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EstablishFoamMorphology::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+bool EstablishFoamMorphology::check_movefillingerror(size_t gnum, float xc, float yc, float zc, const int32_t* featureOwners, int64_t& delta) const
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0;
-  size_t val = 0;
-  for(size_t i = 0; i < removeSize; i++)
+  delta = 0;
+  const FeatureStencil& stencil = m_FeatureStencils[gnum];
+
+  std::array<int64_t, 3> shift = {
+      static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]) - static_cast<int64_t>((m_Centroids[3 * gnum] - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]),
+      static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]) - static_cast<int64_t>((m_Centroids[3 * gnum + 1] - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]),
+      static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]) - static_cast<int64_t>((m_Centroids[3 * gnum + 2] - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]),
+  };
+  const std::array<int64_t, 3>& oldCenter = stencil.m_Center;
+  std::array<int64_t, 3> newCenter = {oldCenter[0] + shift[0], oldCenter[1] + shift[1], oldCenter[2] + shift[2]};
+  std::array<int64_t, 3> boxDims = {stencil.m_Max[0] - stencil.m_Min[0] + 1, stencil.m_Max[1] - stencil.m_Min[1] + 1, stencil.m_Max[2] - stencil.m_Min[2] + 1};
+
+  // With periodic boundaries an offset only has a unique image in the stencil if the stencil is no wider than the grid
+  if(m_PeriodicBoundaries && (boxDims[0] > m_PackingPoints[0] || boxDims[1] > m_PackingPoints[1] || boxDims[2] > m_PackingPoints[2]))
+  {
+    return false;
+  }
+
+  // Returns whether the Feature covers the given offset, taking periodic images into account
+  auto contains = [&](int64_t column, int64_t row, int64_t plane) {
+    std::array<int64_t, 3> offset = {column, row, plane};
+    for(size_t d = 0; d < 3; d++)
+    {
+      if(m_PeriodicBoundaries)
+      {
+        offset[d] = stencil.m_Min[d] + (((offset[d] - stencil.m_Min[d]) % m_PackingPoints[d]) + m_PackingPoints[d]) % m_PackingPoints[d];
+      }
+      if(offset[d] < stencil.m_Min[d] || offset[d] > stencil.m_Max[d])
+      {
+        return false;
+      }
+    }
+    return stencil.m_Mask[(boxDims[0] * boxDims[1] * (offset[2] - stencil.m_Min[2])) + (boxDims[0] * (offset[1] - stencil.m_Min[1])) + (offset[0] - stencil.m_Min[0])] != 0;
+  };
+
+  size_t numPoints = stencil.m_ShapeFunc.size();
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    int64_t column = stencil.m_Columns[i];
+    int64_t row = stencil.m_Rows[i];
+    int64_t plane = stencil.m_Planes[i];
+
+    // Point covered at the new position only: (c + 1 - 1)^2 - (c - 1)^2
+    int64_t featureOwnersIdx = find_packingpointindex(newCenter[0] + column, newCenter[1] + row, newCenter[2] + plane);
+    if(featureOwnersIdx >= 0 && !contains(column + shift[0], row + shift[1], plane + shift[2]))
+    {
+      delta += 2 * static_cast<int64_t>(featureOwners[featureOwnersIdx]) - 1;
+    }
+
+    // Point covered at the old position only: (c - 1 - 1)^2 - (c - 1)^2
+    featureOwnersIdx = find_packingpointindex(oldCenter[0] + column, oldCenter[1] + row, oldCenter[2] + plane);
+    if(featureOwnersIdx >= 0 && !contains(column - shift[0], row - shift[1], plane - shift[2]))
+    {
+      delta += 3 - 2 * static_cast<int64_t>(featureOwners[featureOwnersIdx]);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EstablishFoamMorphology::initialize_packingwrap()
+{
+  std::array<int64_t, 3> strides = {1, m_PackingPoints[0], m_PackingPoints[0] * m_PackingPoints[1]};
+  for(size_t d = 0; d < 3; d++)
+  {
+    // Covers [-2P, 3P), which holds every point of a Feature whose centroid is inside the volume
+    int64_t numPoints = m_PackingPoints[d];
+    m_PackingWrap[d].resize(5 * numPoints);
+    for(int64_t i = 0; i < 5 * numPoints; i++)
+    {
+      int64_t value = i - 2 * numPoints;
+      if(m_PeriodicBoundaries)
+      {
+        m_PackingWrap[d][i] = (((value % numPoints) + numPoints) % numPoints) * strides[d];
+      }
+      else
+      {
+        m_PackingWrap[d][i] = (value >= 0 && value < numPoints) ? value * strides[d] : -1;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t EstablishFoamMorphology::find_packingpointindex(int64_t column, int64_t row, int64_t plane) const
+{
+  std::array<int64_t, 3> coords = {column, row, plane};
+  int64_t index = 0;
+  for(size_t d = 0; d < 3; d++)
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    int64_t numPoints = m_PackingPoints[d];
+    int64_t tableIdx = coords[d] + 2 * numPoints;
+    int64_t offset = 0;
+    if(tableIdx >= 0 && tableIdx < 5 * numPoints)
+    {
+      offset = m_PackingWrap[d][tableIdx];
+    }
+    else if(m_PeriodicBoundaries)
+    {
+      offset = (((coords[d] % numPoints) + numPoints) % numPoints) * (d == 0 ? 1 : (d == 1 ? m_PackingPoints[0] : m_PackingPoints[0] * m_PackingPoints[1]));
+    }
+    else
+    {
+      offset = -1;
+    }
+    if(offset < 0)
+    {
+      return -1;
+    }
+    index += offset;
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EstablishFoamMorphology::update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<size_t>& availablePointsInv, const int32_t* exclusionOwners)
+{
+  // A point can be listed in both vectors when a move covers and then uncovers it, so the
+  // final state of the point is taken from the exclusion owners rather than from the list
+  auto updatePoint = [&](size_t featureOwnersIdx) {
+    int64_t key = availablePoints[featureOwnersIdx];
+    if(exclusionOwners[featureOwnersIdx] == 0)
     {
+      if(key < 0)
+      {
+        availablePoints[featureOwnersIdx] = static_cast<int64_t>(m_AvailablePointsCount);
+        availablePointsInv.push_back(featureOwnersIdx);
+        m_AvailablePointsCount++;
+      }
+    }
+    else if(key >= 0)
+    {
+      // Move the last available point into the vacated slot
+      size_t val = availablePointsInv[m_AvailablePointsCount - 1];
       availablePointsInv[key] = val;
       availablePoints[val] = key;
+      availablePoints[featureOwnersIdx] = -1;
+      availablePointsInv.pop_back();
+      m_AvailablePointsCount--;
     }
-    m_AvailablePointsCount--;
+  };
+
+  for(size_t featureOwnersIdx : m_PointsToRemove)
+  {
+    updatePoint(featureOwnersIdx);
   }
-  for(size_t i = 0; i < addSize; i++)
+  for(size_t featureOwnersIdx : m_PointsToAdd)
   {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
+    updatePoint(featureOwnersIdx);
   }
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
@@ -2437,10 +2318,6 @@ void EstablishFoamMorphology::insert_feature(size_t gnum)
 {
   SIMPL_RANDOMNG_NEW();
 
-  float inside = -1.0f;
-  int64_t column = 0;
-  int64_t row = 0;
-  int64_t plane = 0;
   int64_t centercolumn = 0;
   int64_t centerrow = 0;
   int64_t centerplane = 0;
@@ -2453,8 +2330,6 @@ void EstablishFoamMorphology::insert_feature(size_t gnum)
   float xc = 0.0f;
   float yc = 0.0f;
   float zc = 0.0f;
-  std::array<float, 3> coordsRotated = {0.0f, 0.0f, 0.0f};
-  std::array<float, 3> coords = {0.0f, 0.0f, 0.0f};
   float volcur = m_Volumes[gnum];
   float bovera = m_AxisLengths[3 * gnum + 1];
   float covera = m_AxisLengths[3 * gnum + 2];
@@ -2530,41 +2405,63 @@ void EstablishFoamMorphology::insert_feature(size_t gnum)
   {
     zmax = (2 * m_PackingPoints[2] - 1);
   }
-
-  float OneOverRadcur1 = 1.0f / radcur1;
-  float OneOverRadcur2 = 1.0f / radcur2;
-  float OneOverRadcur3 = 1.0f / radcur3;
-  for(int64_t iter1 = xmin; iter1 < xmax + 1; iter1++)
-  {
-    for(int64_t iter2 = ymin; iter2 < ymax + 1; iter2++)
-    {
-      for(int64_t iter3 = zmin; iter3 < zmax + 1; iter3++)
-      {
-        column = iter1;
-        row = iter2;
-        plane = iter3;
-        coords[0] = float(column) * m_PackingRes[0];
-        coords[1] = float(row) * m_PackingRes[1];
-        coords[2] = float(plane) * m_PackingRes[2];
-        inside = -1.0f;
-        coords[0] = coords[0] - xc;
-        coords[1] = coords[1] - yc;
-        coords[2] = coords[2] - zc;
-        MatrixMath::Multiply3x3with3x1(ga, coords.data(), coordsRotated.data());
-        float axis1comp = coordsRotated[0] * OneOverRadcur1;
-        float axis2comp = coordsRotated[1] * OneOverRadcur2;
-        float axis3comp = coordsRotated[2] * OneOverRadcur3;
-        inside = m_ShapeOps[shapeclass]->inside(axis1comp, axis2comp, axis3comp);
-        if(inside >= 0)
+  // The stencil stores the points as 16 bit offsets from the center
+  constexpr int64_t k_MaxOffset = std::numeric_limits<int16_t>::max();
+  xmin = std::max(xmin, centercolumn - k_MaxOffset);
+  xmax = std::min(xmax, centercolumn + k_MaxOffset);
+  ymin = std::max(ymin, centerrow - k_MaxOffset);
+  ymax = std::min(ymax, centerrow + k_MaxOffset);
+  zmin = std::max(zmin, centerplane - k_MaxOffset);
+  zmax = std::min(zmax, centerplane + k_MaxOffset);
+
+  FeatureStencil& stencil = m_FeatureStencils[gnum];
+  stencil = FeatureStencil();
+  stencil.m_Center = {centercolumn, centerrow, centerplane};
+  stencil.m_Min = {xmax - centercolumn, ymax - centerrow, zmax - centerplane};
+  stencil.m_Max = {xmin - centercolumn, ymin - centerrow, zmin - centerplane};
+
+  ShapeRasterizer::Shape shape;
+  shape.center = {xc, yc, zc};
+  std::copy(&ga[0][0], &ga[0][0] + 9, &shape.axes[0][0]);
+  shape.invRadii = {1.0f / radcur1, 1.0f / radcur2, 1.0f / radcur3};
+  shape.shapeOps = m_ShapeOps[shapeclass].get();
+  const std::array<float, 3> packingRes = {m_PackingRes[0], m_PackingRes[1], m_PackingRes[2]};
+  std::vector<float> scratch;
+  for(int64_t plane = zmin; plane < zmax + 1; plane++)
+  {
+    for(int64_t row = ymin; row < ymax + 1; row++)
+    {
+      ShapeRasterizer::RasterizeRow(shape, packingRes, row, plane, xmin, xmax, scratch, [&](int64_t column, float inside) {
+        std::array<int64_t, 3> offset = {column - centercolumn, row - centerrow, plane - centerplane};
+        stencil.m_Columns.push_back(static_cast<int16_t>(offset[0]));
+        stencil.m_Rows.push_back(static_cast<int16_t>(offset[1]));
+        stencil.m_Planes.push_back(static_cast<int16_t>(offset[2]));
+        stencil.m_ShapeFunc.push_back(inside);
+        for(size_t d = 0; d < 3; d++)
         {
-          m_ColumnList[gnum].push_back(column);
-          m_RowList[gnum].push_back(row);
-          m_PlaneList[gnum].push_back(plane);
-          m_EllipFuncList[gnum].push_back(inside);
+          stencil.m_Min[d] = std::min(stencil.m_Min[d], offset[d]);
+          stencil.m_Max[d] = std::max(stencil.m_Max[d], offset[d]);
         }
-      }
+      });
     }
   }
+
+  if(stencil.m_ShapeFunc.empty())
+  {
+    stencil.m_Min = {0, 0, 0};
+    stencil.m_Max = {-1, -1, -1};
+    return;
+  }
+
+  // Occupancy mask over the bounding box of the offsets, used to find the points shared by two positions of the Feature
+  std::array<int64_t, 3> boxDims = {stencil.m_Max[0] - stencil.m_Min[0] + 1, stencil.m_Max[1] - stencil.m_Min[1] + 1, stencil.m_Max[2] - stencil.m_Min[2] + 1};
+  stencil.m_Mask.assign(boxDims[0] * boxDims[1] * boxDims[2], 0);
+  size_t numPoints = stencil.m_ShapeFunc.size();
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    int64_t maskIdx = (boxDims[0] * boxDims[1] * (stencil.m_Planes[i] - stencil.m_Min[2])) + (boxDims[0] * (stencil.m_Rows[i] - stencil.m_Min[1])) + (stencil.m_Columns[i] - stencil.m_Min[0]);
+    stencil.m_Mask[maskIdx] = 1;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -2591,7 +2488,6 @@ void EstablishFoamMorphology::assign_voxels()
   float xc = 0.0f;
   float yc = 0.0f;
   float zc = 0.0f;
-  std::array<float, 3> size = {m_SizeX, m_SizeY, m_SizeZ};
 
   int64_t xmin = 0;
   int64_t xmax = 0;
@@ -2601,6 +2497,7 @@ void EstablishFoamMorphology::assign_voxels()
   int64_t zmax = 0;
 
   FloatVec3Type res = m->getGeometryAs<ImageGeom>()->getSpacing();
+  const std::array<float, 3> spacing = {res[0], res[1], res[2]};
 
   Int32ArrayType::Pointer newownersPtr = Int32ArrayType::CreateArray(totalPoints, std::string("_INTERNAL_USE_ONLY_newowners"), true);
   newownersPtr->initializeWithValue(-1);
@@ -2732,24 +2629,12 @@ void EstablishFoamMorphology::assign_voxels()
       }
     }
 
-    std::array<float, 3> radCur = {radcur1, radcur2, radcur3};
-    std::array<float, 3> xx = {xc, yc, zc};
-    ShapeOps* shapeOps = m_ShapeOps[shapeclass].get();
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    bool doParallel = true;
-
-    if(doParallel)
-    {
-      tbb::parallel_for(tbb::blocked_range3d<int64_t, int64_t, int64_t>(zmin, zmax + 1, ymin, ymax + 1, xmin, xmax + 1),
-                        FoamAssignVoxelsGapsImpl(udims, res, m_FeatureIds, radCur.data(), xx.data(), shapeOps, ga, size.data(), i, newownersPtr, ellipfuncsPtr), tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      FoamAssignVoxelsGapsImpl serial(udims, res, m_FeatureIds, radCur.data(), xx.data(), shapeOps, ga, size.data(), i, newownersPtr, ellipfuncsPtr);
-      serial.convert(zmin, zmax + 1, ymin, ymax + 1, xmin, xmax + 1);
-    }
+    ShapeRasterizer::Shape shape;
+    shape.center = {xc, yc, zc};
+    std::copy(&ga[0][0], &ga[0][0] + 9, &shape.axes[0][0]);
+    shape.invRadii = {static_cast<float>(1.0 / radcur1), static_cast<float>(1.0 / radcur2), static_cast<float>(1.0 / radcur3)};
+    shape.shapeOps = m_ShapeOps[shapeclass].get();
+    ShapeRasterizer::RasterizeShape(shape, static_cast<int32_t>(i), dims, spacing, {xmin, xmax, ymin, ymax, zmin, zmax}, newowners, ellipfuncs);
   }
 
   QVector<bool> activeObjects(totalFeatures, false);
@@ -2810,163 +2695,27 @@ void EstablishFoamMorphology::assign_gaps_only()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
 
-  int32_t featurename = 0;
-  int32_t feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t gapVoxelCount = 1;
-  int64_t previousGapVoxelCount = 0;
-  int32_t iterationCounter = 0;
-  int64_t neighpoint;
-  bool good = false;
-  int32_t neighbor = 0;
-
-  int64_t xPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int64_t yPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int64_t zPoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
   size_t totalPoints = m->getAttributeMatrix(m_OutputCellAttributeMatrixPath.getAttributeMatrixName())->getNumberOfTuples();
-  size_t totalFeatures = m->getAttributeMatrix(getOutputCellFeatureAttributeMatrixName())->getNumberOfTuples();
-
-  std::array<int64_t, 6> neighpoints = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  Int64ArrayType::Pointer neighborsPtr = Int64ArrayType::CreateArray(m->getGeometryAs<ImageGeom>()->getNumberOfElements(), std::string("_INTERNAL_USE_ONLY_Neighbors"), true);
-  neighborsPtr->initializeWithValue(-1);
-  m_Neighbors = neighborsPtr->getPointer(0);
-
-  std::vector<int32_t> n(totalFeatures + 1, 0);
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::array<int64_t, 3> dims = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
 
-  while(gapVoxelCount != 0 && gapVoxelCount != previousGapVoxelCount)
+  // Grow the Features into the gaps one voxel layer at a time, only visiting the gap voxels on the frontier
+  MajorityGapFiller gapFiller(dims, m_FeatureIds);
+  int32_t iterationCounter = 0;
+  while(gapFiller.getFrontierSize() > 0)
   {
     iterationCounter++;
-    previousGapVoxelCount = gapVoxelCount;
-    gapVoxelCount = 0;
-    int64_t zStride;
-    int64_t yStride;
-    for(int64_t i = 0; i < zPoints; i++)
-    {
-      zStride = i * xPoints * yPoints;
-      for(int64_t j = 0; j < yPoints; j++)
-      {
-        yStride = j * xPoints;
-        for(int64_t k = 0; k < xPoints; k++)
-        {
-          featurename = m_FeatureIds[zStride + yStride + k];
-          if(featurename < 0)
-          {
-            gapVoxelCount++;
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = true;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = false;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = false;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = false;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = false;
-              }
-              if(good)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[zStride + yStride + k] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = true;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = false;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = false;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = false;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = false;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = false;
-              }
-              if(good)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
-      {
-        m_FeatureIds[j] = m_FeatureIds[neighbor];
-        m_CellPhases[j] = m_FeaturePhases[m_FeatureIds[neighbor]];
-      }
-    }
-    if(iterationCounter >= 1)
-    {
-      QString ss = QObject::tr("Assign Gaps || Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(iterationCounter).arg(gapVoxelCount);
-      notifyStatusMessage(ss);
-    }
+    QString ss = QObject::tr("Assign Gaps || Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(iterationCounter).arg(gapFiller.getRemainingGaps());
+    notifyStatusMessage(ss);
+    gapFiller.fillNextLayer(m_CellPhases, m_FeaturePhases);
     if(getCancel())
     {
       return;
     }
   }
-  if(gapVoxelCount != 0)
+
+  // Gaps that no Feature can reach are left unassigned
+  if(gapFiller.getRemainingGaps() != 0)
   {
     for(size_t j = 0; j < totalPoints; j++)
     {
@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/DataArrays/StatsDataArray.h"
@@ -478,6 +480,25 @@ protected:
    */
   void move_feature(size_t gnum, float xc, float yc, float zc);
 
+  /**
+   * @brief initialize_centroidhash Bins every Feature centroid into a uniform grid whose cells are as wide
+   * as the largest equivalent diameter, so that neighborhood queries only visit the 27 adjacent cells
+   */
+  void initialize_centroidhash();
+
+  /**
+   * @brief update_centroidhash Moves a Feature to the grid cell that contains its current centroid
+   * @param gnum Id for the Feature to be rebinned
+   */
+  void update_centroidhash(size_t gnum);
+
+  /**
+   * @brief find_centroidhashcell Returns the grid cell coordinates that contain the supplied centroid
+   * @param coords Centroid coordinates
+   * @return Cell (x, y, z) indices clamped to the grid
+   */
+  std::array<int64_t, 3> find_centroidhashcell(const float* coords) const;
+
   /**
    * @brief check_sizedisterror Computes the error between the current Feature size distribution
    * and the goal Feature size distribution
@@ -514,11 +535,42 @@ protected:
   float check_fillingerror(int32_t gadd, int32_t gremove, const Int32ArrayType::Pointer& featureOwnersPtr, const Int32ArrayType::Pointer& exclusionOwnersPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between Feature owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief check_movefillingerror Computes the change in the (unnormalized) filling error that moving a Feature
+   * to the supplied (x,y,z) centroid coordinate would cause, without modifying the packing grid.  Packing points
+   * covered at both the old and new positions do not change and are skipped.
+   * @param gnum Id for the Feature to be moved
+   * @param xc x centroid coordinate
+   * @param yc y centroid coordinate
+   * @param zc z centroid coordinate
+   * @param featureOwners Number of Features covering each packing point
+   * @param delta Change in the summed squared over/under filling
+   * @return False if the Feature wraps onto itself across a periodic boundary, in which case the move has to be
+   * evaluated with check_fillingerror instead
    */
-  void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  bool check_movefillingerror(size_t gnum, float xc, float yc, float zc, const int32_t* featureOwners, int64_t& delta) const;
+
+  /**
+   * @brief initialize_packingwrap Precomputes the wrapped (periodic) or bounds checked packing grid offsets for
+   * column, row and plane values within one packing grid length of the grid
+   */
+  void initialize_packingwrap();
+
+  /**
+   * @brief find_packingpointindex Returns the flat packing grid index of a (possibly wrapped) packing point
+   * @param column Packing point column
+   * @param row Packing point row
+   * @param plane Packing point plane
+   * @return Flat index, or -1 if the point lies outside a non-periodic packing grid
+   */
+  int64_t find_packingpointindex(int64_t column, int64_t row, int64_t plane) const;
+
+  /**
+   * @brief update_availablepoints Updates the sparse set used to associate packing points with an "available" state
+   * @param availablePoints Slot of each packing point in availablePointsInv, or -1 if the point is not available
+   * @param availablePointsInv Packed list of the available packing points
+   * @param exclusionOwners Number of Features covering each packing point
+   */
+  void update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<size_t>& availablePointsInv, const int32_t* exclusionOwners);
 
   /**
    * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -654,7 +706,6 @@ private:
   QString m_AxisEulerAnglesArrayName = SIMPL::FeatureData::AxisEulerAngles;
   QString m_Omega3sArrayName = SIMPL::FeatureData::Omega3s;
   QString m_EquivalentDiametersArrayName = SIMPL::FeatureData::EquivalentDiameters;
-  int64_t* m_Neighbors = nullptr;
 
   // Cell Data - make sure these are all initialized to nullptr in the constructor
   int8_t* m_BoundaryCells = nullptr;
@@ -675,10 +726,25 @@ private:
   ShapeOps::Pointer m_SuperEllipsoidOps;
   OrthoRhombicOps::Pointer m_OrthoOps;
 
-  std::vector<std::vector<int64_t>> m_ColumnList;
-  std::vector<std::vector<int64_t>> m_RowList;
-  std::vector<std::vector<int64_t>> m_PlaneList;
-  std::vector<std::vector<float>> m_EllipFuncList;
+  /**
+   * @brief The FeatureStencil struct holds the packing points covered by one Feature as packed offsets from the
+   * packing point that contains the Feature centroid, the shape function value at each of those points, and an
+   * occupancy mask over the bounding box of the offsets.  Moving the Feature only moves the center.
+   */
+  struct FeatureStencil
+  {
+    std::array<int64_t, 3> m_Center = {0, 0, 0};
+    std::vector<int16_t> m_Columns;
+    std::vector<int16_t> m_Rows;
+    std::vector<int16_t> m_Planes;
+    std::vector<float> m_ShapeFunc;
+    std::array<int64_t, 3> m_Min = {0, 0, 0};
+    std::array<int64_t, 3> m_Max = {-1, -1, -1};
+    std::vector<uint8_t> m_Mask;
+  };
+
+  std::vector<FeatureStencil> m_FeatureStencils;
+  std::array<std::vector<int64_t>, 3> m_PackingWrap;
 
   std::vector<size_t> m_PointsToAdd;
   std::vector<size_t> m_PointsToRemove;
@@ -713,6 +779,12 @@ private:
   std::vector<int32_t> m_PrecipitatePhases;
   std::vector<float> m_PrecipitatePhaseFractions;
 
+  float m_CentroidHashCellSize = 1.0f;
+  std::array<int64_t, 3> m_CentroidHashDims = {1, 1, 1};
+  std::vector<std::vector<int32_t>> m_CentroidHashCells;
+  std::vector<int64_t> m_FeatureHashCell;
+  std::vector<size_t> m_FeatureHashSlot;
+
   size_t m_AvailablePointsCount = 0;
   float m_FillingError = 0.0f;
   float m_OldFillingError = 0.0f;
@@ -34,10 +34,12 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindArrayStatistics.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <functional>
-#include <unordered_map>
+#include <thread>
+#include <type_traits>
 
 #include <QtCore/QTextStream>
 
@@ -53,19 +55,16 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
 #define STATISTICS_FILTER_CLASS_NAME FindArrayStatistics
+#include "util/QuantileSketch.hpp"
 #include "util/StatisticsHelpers.hpp"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 // -----------------------------------------------------------------------------
 FindArrayStatistics::FindArrayStatistics() = default;
 
@@ -109,6 +108,15 @@ void FindArrayStatistics::setupFilterParameters()
   linkedProps.push_back("MedianArrayName");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Median", FindMedian, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
   linkedProps.clear();
+  linkedProps.push_back("Percentiles");
+  linkedProps.push_back("PercentilesArrayName");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Percentiles", FindPercentiles, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Percentiles", Percentiles, FilterParameter::Category::Parameter, FindArrayStatistics));
+  linkedProps.clear();
+  linkedProps.push_back("QuantileRankError");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Approximate Median and Percentiles", UseApproximateQuantiles, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
+  parameters.push_back(SIMPL_NEW_DOUBLE_FP("Quantile Rank Error", QuantileRankError, FilterParameter::Category::Parameter, FindArrayStatistics));
+  linkedProps.clear();
   linkedProps.push_back("StdDeviationArrayName");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Standard Deviation", FindStdDeviation, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
   linkedProps.clear();
@@ -146,6 +154,8 @@ void FindArrayStatistics::setupFilterParameters()
       SIMPL_NEW_DA_WITH_LINKED_AM_FP("Maximum", MaximumArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray, FindArrayStatistics));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Mean", MeanArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray, FindArrayStatistics));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Median", MedianArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray, FindArrayStatistics));
+  parameters.push_back(
+      SIMPL_NEW_DA_WITH_LINKED_AM_FP("Percentiles", PercentilesArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray, FindArrayStatistics));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Standard Deviation", StdDeviationArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray,
                                                       FindArrayStatistics));
   parameters.push_back(
@@ -170,7 +180,7 @@ void FindArrayStatistics::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  if(!getFindHistogram() && !getFindMin() && !getFindMax() && !getFindMean() && !getFindMedian() && !getFindStdDeviation() && !getFindSummation() && !getFindLength())
+  if(!getFindHistogram() && !getFindMin() && !getFindMax() && !getFindMean() && !getFindMedian() && !getFindPercentiles() && !getFindStdDeviation() && !getFindSummation() && !getFindLength())
   {
     QString ss = QObject::tr("No statistics have been selected, so this filter will perform no operations");
     setWarningCondition(-701, ss);
@@ -255,6 +265,48 @@ void FindArrayStatistics::dataCheck()
     }
   }
 
+  if(m_FindPercentiles)
+  {
+    m_Quantiles.clear();
+    QStringList tokens = m_Percentiles.split(',');
+    for(const QString& token : tokens)
+    {
+      if(token.trimmed().isEmpty())
+      {
+        continue;
+      }
+      bool ok = false;
+      double percentile = token.trimmed().toDouble(&ok);
+      if(!ok || percentile < 0.0 || percentile > 100.0)
+      {
+        QString ss = QObject::tr("Percentiles must be a comma separated list of values between 0 and 100, but \"%1\" is not").arg(token.trimmed());
+        setErrorCondition(-11004, ss);
+        return;
+      }
+      m_Quantiles.push_back(static_cast<float>(percentile / 100.0));
+    }
+    if(m_Quantiles.empty())
+    {
+      QString ss = QObject::tr("At least one percentile must be given to find percentiles");
+      setErrorCondition(-11004, ss);
+      return;
+    }
+
+    std::vector<size_t> cDims_List = {m_Quantiles.size()};
+    DataArrayPath path(getDestinationAttributeMatrix().getDataContainerName(), getDestinationAttributeMatrix().getAttributeMatrixName(), getPercentilesArrayName());
+    m_PercentilesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<FloatArrayType>(this, path, 0, cDims_List, "", DataArrayID38);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+
+  if(m_UseApproximateQuantiles && (m_FindMedian || m_FindPercentiles) && (m_QuantileRankError <= 0.0 || m_QuantileRankError > 0.5))
+  {
+    QString ss = QObject::tr("The quantile rank error must be greater than 0 and at most 0.5");
+    setErrorCondition(-11005, ss);
+  }
+
   if(getUseMask())
   {
     m_MaskPtr = getDataContainerArray()->getPrereqArrayFromPath<BoolArrayType>(this, getMaskArrayPath(), cDims);
@@ -290,10 +342,10 @@ void FindArrayStatistics::dataCheck()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-std::vector<float> findHistogram(C<T, Ts...>& source, float histmin, float histmax, bool histfullrange, int32_t numBins)
+template <typename Iterator>
+std::vector<float> findHistogram(Iterator first, Iterator last, float histmin, float histmax, bool histfullrange, int32_t numBins)
 {
-  if(source.empty())
+  if(first == last)
   {
     return std::vector<float>(numBins, 0);
   }
@@ -303,8 +355,8 @@ std::vector<float> findHistogram(C<T, Ts...>& source, float histmin, float histm
 
   if(histfullrange)
   {
-    min = static_cast<float>(StatisticsHelpers::findMin(source));
-    max = static_cast<float>(StatisticsHelpers::findMax(source));
+    min = static_cast<float>(*std::min_element(first, last));
+    max = static_cast<float>(*std::max_element(first, last));
   }
   else
   {
@@ -322,13 +374,13 @@ std::vector<float> findHistogram(C<T, Ts...>& source, float histmin, float histm
 
   if(numBins == 1) // if one bin, just set the first element to total number of points
   {
-    Histogram[0] = static_cast<float>(source.size());
+    Histogram[0] = static_cast<float>(std::distance(first, last));
   }
   else
   {
-    for(const auto s : source)
+    for(Iterator iter = first; iter != last; ++iter)
     {
-      float value = static_cast<float>(s);
+      float value = static_cast<float>(*iter);
       size_t bin = static_cast<size_t>((value - min) / increment); // find bin for this input array value
       if((bin >= 0) && (bin < numBins))                            // make certain bin is in range
       {
@@ -432,204 +484,257 @@ void standardizeData<bool>(IDataArray::Pointer dataPtr, FloatArrayType::Pointer
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T>
-class FindArrayStatisticsByIndexImpl
+/**
+ * @brief The AccumulateStatisticsImpl class accumulates the running statistics, and optionally the quantile sketches,
+ * of every Feature over one chunk of the input array.  Each chunk owns its accumulators, so the chunks need no
+ * synchronization.
+ */
+template <typename T, typename ValueType>
+class AccumulateStatisticsImpl
 {
 public:
-  FindArrayStatisticsByIndexImpl(std::unordered_map<int32_t, std::list<T>>& featureDataMap, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray::Pointer>& arrays, bool hist, float histmin, float histmax, bool histfullrange, int32_t numBins)
-  : m_FeatureDataMap(featureDataMap)
-  , m_Length(length)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Mean(mean)
-  , m_Median(median)
-  , m_StdDeviation(stdDeviation)
-  , m_Summation(summation)
-  , m_Histogram(hist)
-  , m_HistMin(histmin)
-  , m_HistMax(histmax)
-  , m_HistFullRange(histfullrange)
-  , m_NumBins(numBins)
-  , m_Arrays(arrays)
+  AccumulateStatisticsImpl(const T* data, const int32_t* featureIds, const bool* mask, size_t start, size_t end, std::vector<StatisticsHelpers::RunningStatistics<T>>& accumulators,
+                           std::vector<QuantileSketch<ValueType>>* sketches)
+  : m_Data(data)
+  , m_FeatureIds(featureIds)
+  , m_Mask(mask)
+  , m_Start(start)
+  , m_End(end)
+  , m_Accumulators(accumulators)
+  , m_Sketches(sketches)
   {
   }
 
-  virtual ~FindArrayStatisticsByIndexImpl() = default;
-
-  void compute(size_t start, size_t end) const
+  void operator()() const
   {
-    for(size_t i = start; i < end; i++)
+    for(size_t i = m_Start; i < m_End; i++)
     {
-      if(m_FeatureDataMap.find(i) == m_FeatureDataMap.end())
+      if(m_Mask != nullptr && !m_Mask[i])
       {
         continue;
       }
-      if(m_Length)
+      const int32_t featureId = (m_FeatureIds != nullptr) ? m_FeatureIds[i] : 0;
+      if(featureId < 0)
       {
-        if(m_Arrays[0])
-        {
-          int64_t val = static_cast<int64_t>(m_FeatureDataMap[i].size());
-          m_Arrays[0]->initializeTuple(i, &val);
-        }
+        continue;
       }
-      if(m_Min)
+      m_Accumulators[featureId].add(m_Data[i]);
+      if(m_Sketches != nullptr)
       {
-        if(m_Arrays[1])
-        {
-          T val = StatisticsHelpers::findMin(m_FeatureDataMap[i]);
-          m_Arrays[1]->initializeTuple(i, &val);
-        }
+        (*m_Sketches)[featureId].add(static_cast<ValueType>(m_Data[i]));
       }
-      if(m_Max)
+    }
+  }
+
+private:
+  const T* m_Data;
+  const int32_t* m_FeatureIds;
+  const bool* m_Mask;
+  size_t m_Start;
+  size_t m_End;
+  std::vector<StatisticsHelpers::RunningStatistics<T>>& m_Accumulators;
+  std::vector<QuantileSketch<ValueType>>* m_Sketches;
+};
+
+/**
+ * @brief The GatherFeatureValuesImpl class copies the values of one chunk of the input array into the buffer that
+ * holds the values grouped by Feature.  The cursors start at the first slot of every Feature that belongs to this
+ * chunk, so the chunks never write to the same slot and the values of a Feature stay in array order.
+ */
+template <typename T, typename ValueType>
+class GatherFeatureValuesImpl
+{
+public:
+  GatherFeatureValuesImpl(const T* data, const int32_t* featureIds, const bool* mask, size_t start, size_t end, std::vector<size_t>& cursors, ValueType* values)
+  : m_Data(data)
+  , m_FeatureIds(featureIds)
+  , m_Mask(mask)
+  , m_Start(start)
+  , m_End(end)
+  , m_Cursors(cursors)
+  , m_Values(values)
+  {
+  }
+
+  void operator()() const
+  {
+    for(size_t i = m_Start; i < m_End; i++)
+    {
+      if(m_Mask != nullptr && !m_Mask[i])
       {
-        if(m_Arrays[2])
-        {
-          T val = StatisticsHelpers::findMax(m_FeatureDataMap[i]);
-          m_Arrays[2]->initializeTuple(i, &val);
-        }
+        continue;
       }
-      if(m_Mean)
+      const int32_t featureId = (m_FeatureIds != nullptr) ? m_FeatureIds[i] : 0;
+      if(featureId < 0)
       {
-        if(m_Arrays[3])
-        {
-          float val = StatisticsHelpers::findMean(m_FeatureDataMap[i]);
-          m_Arrays[3]->initializeTuple(i, &val);
-        }
+        continue;
       }
-      if(m_Median)
+      m_Values[m_Cursors[featureId]++] = static_cast<ValueType>(m_Data[i]);
+    }
+  }
+
+private:
+  const T* m_Data;
+  const int32_t* m_FeatureIds;
+  const bool* m_Mask;
+  size_t m_Start;
+  size_t m_End;
+  std::vector<size_t>& m_Cursors;
+  ValueType* m_Values;
+};
+
+/**
+ * @brief The FindOrderStatisticsImpl class finds the median, the percentiles and the histogram of a range of Features
+ * from their grouped values.  The values of each Feature are reordered in place.
+ */
+template <typename ValueType>
+class FindOrderStatisticsImpl
+{
+public:
+  FindOrderStatisticsImpl(ValueType* values, const std::vector<size_t>& offsets, FloatArrayType::Pointer median, FloatArrayType::Pointer percentiles, const std::vector<float>& quantiles,
+                          FloatArrayType::Pointer histogram, float histmin, float histmax, bool histfullrange, int32_t numBins)
+  : m_Values(values)
+  , m_Offsets(offsets)
+  , m_Median(median)
+  , m_Percentiles(percentiles)
+  , m_Quantiles(quantiles)
+  , m_Histogram(histogram)
+  , m_HistMin(histmin)
+  , m_HistMax(histmax)
+  , m_HistFullRange(histfullrange)
+  , m_NumBins(numBins)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      ValueType* first = m_Values + m_Offsets[i];
+      ValueType* last = m_Values + m_Offsets[i + 1];
+      if(first == last)
       {
-        if(m_Arrays[4])
-        {
-          float val = StatisticsHelpers::findMedian(m_FeatureDataMap[i]);
-          m_Arrays[4]->initializeTuple(i, &val);
-        }
+        continue;
       }
-      if(m_StdDeviation)
+      if(m_Histogram)
       {
-        if(m_Arrays[5])
-        {
-          float val = StatisticsHelpers::findStdDeviation(m_FeatureDataMap[i]);
-          m_Arrays[5]->initializeTuple(i, &val);
-        }
+        std::vector<float> vals = findHistogram(first, last, m_HistMin, m_HistMax, m_HistFullRange, m_NumBins);
+        // A Feature whose values span no range comes back as a single bin
+        vals.resize(m_NumBins, 0.0f);
+        m_Histogram->setTuple(i, vals);
       }
-      if(m_Summation)
+      if(m_Median)
       {
-        if(m_Arrays[6])
-        {
-          float val = StatisticsHelpers::findSummation(m_FeatureDataMap[i]);
-          m_Arrays[6]->initializeTuple(i, &val);
-        }
+        m_Median->setValue(i, StatisticsHelpers::findMedianInPlace(first, last));
       }
-
-      if(m_Histogram)
+      if(m_Percentiles)
       {
-        if(m_Arrays[7])
-        {
-          std::vector<float> vals = findHistogram(m_FeatureDataMap[i], m_HistMin, m_HistMax, m_HistFullRange, m_NumBins);
-          std::shared_ptr<FloatArrayType> histArray = std::dynamic_pointer_cast<FloatArrayType>(m_Arrays[7]);
-          histArray->setTuple(i, vals);
-        }
+        std::vector<float> vals = StatisticsHelpers::findPercentilesInPlace(first, last, m_Quantiles);
+        m_Percentiles->setTuple(i, vals);
       }
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    compute(r.begin(), r.end());
-  }
-#endif
-
 private:
-  std::unordered_map<int32_t, std::list<T>>& m_FeatureDataMap;
-  bool m_Length;
-  bool m_Min;
-  bool m_Max;
-  bool m_Mean;
-  bool m_Median;
-  bool m_StdDeviation;
-  bool m_Summation;
-  bool m_Histogram;
+  ValueType* m_Values;
+  const std::vector<size_t>& m_Offsets;
+  FloatArrayType::Pointer m_Median;
+  FloatArrayType::Pointer m_Percentiles;
+  const std::vector<float>& m_Quantiles;
+  FloatArrayType::Pointer m_Histogram;
   float m_HistMin;
   float m_HistMax;
   bool m_HistFullRange;
   int32_t m_NumBins;
-  std::vector<IDataArray::Pointer>& m_Arrays;
 };
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <typename T>
-void findStatisticsImpl(bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation, std::vector<IDataArray::Pointer>& arrays, std::vector<T>& data, bool hist,
-                        float histmin, float histmax, bool histfullrange, int32_t numBins)
+/**
+ * @brief The FindSketchQuantilesImpl class merges the quantile sketches of all chunks for a range of Features, in
+ * chunk order, and reads the approximate median and percentiles from the merged sketches.
+ */
+template <typename ValueType>
+class FindSketchQuantilesImpl
 {
-  if(length)
-  {
-    if(arrays[0])
-    {
-      int64_t val = static_cast<int64_t>(data.size());
-      arrays[0]->initializeTuple(0, &val);
-    }
-  }
-  if(min)
+public:
+  FindSketchQuantilesImpl(std::vector<std::vector<QuantileSketch<ValueType>>>& chunkSketches, FloatArrayType::Pointer median, FloatArrayType::Pointer percentiles, const std::vector<float>& quantiles)
+  : m_ChunkSketches(chunkSketches)
+  , m_Median(median)
+  , m_Percentiles(percentiles)
+  , m_Quantiles(quantiles)
   {
-    if(arrays[1])
-    {
-      T val = StatisticsHelpers::findMin(data);
-      arrays[1]->initializeTuple(0, &val);
-    }
   }
-  if(max)
+
+  void operator()(const SIMPLRange& range) const
   {
-    if(arrays[2])
+    std::vector<float> quantiles = m_Quantiles;
+    if(m_Median)
     {
-      T val = StatisticsHelpers::findMax(data);
-      arrays[2]->initializeTuple(0, &val);
+      quantiles.push_back(0.5f);
     }
-  }
-  if(mean)
-  {
-    if(arrays[3])
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      float val = StatisticsHelpers::findMean(data);
-      arrays[3]->initializeTuple(0, &val);
+      QuantileSketch<ValueType>& sketch = m_ChunkSketches[0][i];
+      for(size_t c = 1; c < m_ChunkSketches.size(); c++)
+      {
+        sketch.merge(m_ChunkSketches[c][i]);
+        m_ChunkSketches[c][i] = QuantileSketch<ValueType>();
+      }
+      if(sketch.getCount() == 0)
+      {
+        continue;
+      }
+      std::vector<float> vals = sketch.getQuantiles(quantiles);
+      sketch = QuantileSketch<ValueType>();
+      if(m_Median)
+      {
+        m_Median->setValue(i, vals.back());
+        vals.pop_back();
+      }
+      if(m_Percentiles)
+      {
+        m_Percentiles->setTuple(i, vals);
+      }
     }
   }
-  if(median)
+
+private:
+  std::vector<std::vector<QuantileSketch<ValueType>>>& m_ChunkSketches;
+  FloatArrayType::Pointer m_Median;
+  FloatArrayType::Pointer m_Percentiles;
+  const std::vector<float>& m_Quantiles;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+float findMeanValue(const StatisticsHelpers::RunningStatistics<T>& stats)
+{
+  if constexpr(std::is_same_v<T, bool>)
   {
-    if(arrays[4])
-    {
-      float val = StatisticsHelpers::findMedian(data);
-      arrays[4]->initializeTuple(0, &val);
-    }
+    // As in StatisticsHelpers::findMean(), a boolean array reports whether most of its values are true
+    return (stats.getSum() >= stats.getCount() - stats.getSum()) ? 1.0f : 0.0f;
   }
-  if(stdDeviation)
+  else
   {
-    if(arrays[5])
-    {
-      float val = StatisticsHelpers::findStdDeviation(data);
-      arrays[5]->initializeTuple(0, &val);
-    }
+    return static_cast<float>(stats.getSum()) / static_cast<float>(stats.getCount());
   }
-  if(summation)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+float findStdDeviationValue(const StatisticsHelpers::RunningStatistics<T>& stats)
+{
+  if constexpr(std::is_same_v<T, bool>)
   {
-    if(arrays[6])
-    {
-      float val = StatisticsHelpers::findSummation(data);
-      arrays[6]->initializeTuple(0, &val);
-    }
+    // As in StatisticsHelpers::findStdDeviation(), a boolean array reports whether most of its values are true
+    return (stats.getSum() >= stats.getCount() - stats.getSum()) ? 1.0f : 0.0f;
   }
-
-  if(hist)
+  else
   {
-    if(arrays[7])
-    {
-      std::vector<float> vals = findHistogram(data, histmin, histmax, histfullrange, numBins);
-      std::shared_ptr<FloatArrayType> histArray = std::dynamic_pointer_cast<FloatArrayType>(arrays[7]);
-      histArray->setTuple(0, vals);
-    }
+    return static_cast<float>(std::sqrt(stats.getVariance()));
   }
 }
 
@@ -638,72 +743,159 @@ void findStatisticsImpl(bool length, bool min, bool max, bool mean, bool median,
 // -----------------------------------------------------------------------------
 template <typename T>
 void findStatistics(IDataArray::Pointer source, Int32ArrayType::Pointer featureIds, bool useMask, bool* mask, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation,
-                    bool summation, std::vector<IDataArray::Pointer>& arrays, int32_t numFeatures, bool computeByIndex, bool hist, float histmin, float histmax, bool histfullrange, int32_t numBins)
+                    bool summation, std::vector<IDataArray::Pointer>& arrays, int32_t numFeatures, bool computeByIndex, bool hist, float histmin, float histmax, bool histfullrange, int32_t numBins,
+                    bool percentiles, const std::vector<float>& quantiles, bool approximate, double rankError)
 {
+  // Boolean values are grouped as bytes so that the value buffer is never a std::vector<bool>
+  using ValueType = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+  using Accumulator = StatisticsHelpers::RunningStatistics<T>;
+  using Sketch = QuantileSketch<ValueType>;
+  constexpr size_t k_MinTuplesPerChunk = 65536;
+
   size_t numTuples = source->getNumberOfTuples();
   typename DataArray<T>::Pointer sourcePtr = std::dynamic_pointer_cast<DataArray<T>>(source);
   T* dataPtr = sourcePtr->getPointer(0);
+  const int32_t* featureIdsPtr = computeByIndex ? featureIds->getPointer(0) : nullptr;
+  const bool* maskPtr = useMask ? mask : nullptr;
+  const size_t numSlots = computeByIndex ? static_cast<size_t>(std::max(numFeatures, 0)) : 1;
+  if(numSlots == 0)
+  {
+    return;
+  }
 
-  if(computeByIndex)
+  FloatArrayType::Pointer medianArray = median ? std::dynamic_pointer_cast<FloatArrayType>(arrays[4]) : nullptr;
+  FloatArrayType::Pointer histogramArray = hist ? std::dynamic_pointer_cast<FloatArrayType>(arrays[7]) : nullptr;
+  FloatArrayType::Pointer percentilesArray = percentiles ? std::dynamic_pointer_cast<FloatArrayType>(arrays[8]) : nullptr;
+  // In approximate mode the median and percentiles come from bounded size quantile sketches built in the same pass
+  const bool useSketches = approximate && (medianArray != nullptr || percentilesArray != nullptr);
+
+  // The array is split into chunks that each accumulate every Feature on their own.  The chunk count is bounded so
+  // that the accumulators and sketches of all chunks never take more memory than the input array itself.  A sketch
+  // keeps every value of a small Feature, so each one is counted at its largest size.
+  const size_t sketchCapacity = useSketches ? Sketch::FindCapacity(rankError) : 0;
+  const size_t slotSize = sizeof(Accumulator) + (useSketches ? sizeof(Sketch) + Sketch::FindMaxSize(sketchCapacity) * sizeof(ValueType) : 0);
+  size_t numChunks = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  numChunks = std::min(numChunks, numTuples / k_MinTuplesPerChunk);
+  numChunks = std::min(numChunks, (numTuples * sizeof(T)) / (numSlots * slotSize));
+  numChunks = std::max<size_t>(numChunks, 1);
+  std::vector<size_t> chunkBounds(numChunks + 1);
+  for(size_t c = 0; c <= numChunks; c++)
   {
-    int32_t* featureIdsPtr = featureIds->getPointer(0);
-    std::unordered_map<int32_t, std::list<T>> featureValueMap;
+    chunkBounds[c] = numTuples * c / numChunks;
+  }
 
-    for(size_t i = 0; i < numTuples; i++)
+  std::vector<std::vector<Accumulator>> chunkAccumulators(numChunks, std::vector<Accumulator>(numSlots));
+  std::vector<std::vector<Sketch>> chunkSketches;
+  if(useSketches)
+  {
+    chunkSketches.assign(numChunks, std::vector<Sketch>(numSlots, Sketch(sketchCapacity)));
+  }
+  {
+    ParallelTaskAlgorithm taskRunner;
+    for(size_t c = 0; c < numChunks; c++)
     {
-      if(useMask)
-      {
-        if(mask[i])
-        {
-          featureValueMap[featureIdsPtr[i]].push_back(dataPtr[i]);
-        }
-      }
-      else
+      taskRunner.execute(
+          AccumulateStatisticsImpl<T, ValueType>(dataPtr, featureIdsPtr, maskPtr, chunkBounds[c], chunkBounds[c + 1], chunkAccumulators[c], useSketches ? &chunkSketches[c] : nullptr));
+    }
+    taskRunner.wait();
+  }
+
+  if(useSketches)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numSlots);
+    dataAlg.execute(FindSketchQuantilesImpl<ValueType>(chunkSketches, medianArray, percentilesArray, quantiles));
+    std::vector<std::vector<Sketch>>().swap(chunkSketches);
+    medianArray = nullptr;
+    percentilesArray = nullptr;
+  }
+
+  // The exact median, percentiles and histogram need the values themselves; a counting sort by Feature groups them
+  // into one buffer, with the slots of each Feature split between the chunks in array order
+  const bool findOrderStatistics = (medianArray != nullptr || percentilesArray != nullptr || histogramArray != nullptr);
+  std::vector<size_t> offsets;
+  std::vector<std::vector<size_t>> chunkCursors;
+  if(findOrderStatistics)
+  {
+    offsets.assign(numSlots + 1, 0);
+    chunkCursors.assign(numChunks, std::vector<size_t>(numSlots));
+    for(size_t i = 0; i < numSlots; i++)
+    {
+      size_t cursor = offsets[i];
+      for(size_t c = 0; c < numChunks; c++)
       {
-        featureValueMap[featureIdsPtr[i]].push_back(dataPtr[i]);
+        chunkCursors[c][i] = cursor;
+        cursor += chunkAccumulators[c][i].getCount();
       }
+      offsets[i + 1] = cursor;
     }
+  }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    bool doParallel = true;
-#endif
+  std::vector<Accumulator>& accumulators = chunkAccumulators[0];
+  for(size_t c = 1; c < numChunks; c++)
+  {
+    for(size_t i = 0; i < numSlots; i++)
+    {
+      accumulators[i].merge(chunkAccumulators[c][i]);
+    }
+    std::vector<Accumulator>().swap(chunkAccumulators[c]);
+  }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
+  for(size_t i = 0; i < numSlots; i++)
+  {
+    const Accumulator& stats = accumulators[i];
+    if(stats.getCount() == 0)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures),
-                        FindArrayStatisticsByIndexImpl<T>(featureValueMap, length, min, max, mean, median, stdDeviation, summation, arrays, hist, histmin, histmax, histfullrange, numBins),
-                        tbb::auto_partitioner());
+      continue;
     }
-    else
-#endif
+    if(length && arrays[0])
+    {
+      int64_t val = static_cast<int64_t>(stats.getCount());
+      arrays[0]->initializeTuple(i, &val);
+    }
+    if(min && arrays[1])
     {
-      FindArrayStatisticsByIndexImpl<T> serial(featureValueMap, length, min, max, mean, median, stdDeviation, summation, arrays, hist, histmin, histmax, histfullrange, numBins);
-      serial.compute(0, numFeatures);
+      T val = stats.getMin();
+      arrays[1]->initializeTuple(i, &val);
+    }
+    if(max && arrays[2])
+    {
+      T val = stats.getMax();
+      arrays[2]->initializeTuple(i, &val);
+    }
+    if(mean && arrays[3])
+    {
+      float val = findMeanValue(stats);
+      arrays[3]->initializeTuple(i, &val);
+    }
+    if(stdDeviation && arrays[5])
+    {
+      float val = findStdDeviationValue(stats);
+      arrays[5]->initializeTuple(i, &val);
+    }
+    if(summation && arrays[6])
+    {
+      float val = static_cast<float>(stats.getSum());
+      arrays[6]->initializeTuple(i, &val);
     }
   }
-  else
+
+  if(findOrderStatistics)
   {
-    std::vector<T> data;
-    data.reserve(numTuples);
-    for(size_t i = 0; i < numTuples; i++)
+    std::vector<Accumulator>().swap(accumulators);
+    std::vector<ValueType> values(offsets.back());
     {
-      if(useMask)
+      ParallelTaskAlgorithm taskRunner;
+      for(size_t c = 0; c < numChunks; c++)
       {
-        if(mask[i])
-        {
-          data.push_back(dataPtr[i]);
-        }
-      }
-      else
-      {
-        data.push_back(dataPtr[i]);
+        taskRunner.execute(GatherFeatureValuesImpl<T, ValueType>(dataPtr, featureIdsPtr, maskPtr, chunkBounds[c], chunkBounds[c + 1], chunkCursors[c], values.data()));
       }
+      taskRunner.wait();
     }
 
-    data.shrink_to_fit();
-
-    findStatisticsImpl(length, min, max, mean, median, stdDeviation, summation, arrays, data, hist, histmin, histmax, histfullrange, numBins);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numSlots);
+    dataAlg.execute(FindOrderStatisticsImpl<ValueType>(values.data(), offsets, medianArray, percentilesArray, quantiles, histogramArray, histmin, histmax, histfullrange, numBins));
   }
 }
 
@@ -718,7 +910,7 @@ void FindArrayStatistics::execute()
     return;
   }
 
-  if(!m_FindHistogram && !m_FindMin && !m_FindMax && !m_FindMean && !m_FindMedian && !m_FindStdDeviation && !m_FindSummation && !m_FindLength)
+  if(!m_FindHistogram && !m_FindMin && !m_FindMax && !m_FindMean && !m_FindMedian && !m_FindPercentiles && !m_FindStdDeviation && !m_FindSummation && !m_FindLength)
   {
     return;
   }
@@ -759,7 +951,7 @@ void FindArrayStatistics::execute()
     }
   }
 
-  std::vector<IDataArray::Pointer> arrays(8, nullptr);
+  std::vector<IDataArray::Pointer> arrays(9, nullptr);
 
   for(size_t i = 0; i < arrays.size(); i++)
   {
@@ -803,10 +995,16 @@ void FindArrayStatistics::execute()
       arrays[7] = m_HistogramListPtr.lock();
       arrays[7]->initializeWithZeros();
     }
+    if(m_FindPercentiles)
+    {
+      arrays[8] = m_PercentilesPtr.lock();
+      arrays[8]->initializeWithZeros();
+    }
   }
 
   EXECUTE_FUNCTION_TEMPLATE(this, findStatistics, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), m_FeatureIdsPtr.lock(), m_UseMask, m_Mask, m_FindLength, m_FindMin, m_FindMax, m_FindMean,
-                            m_FindMedian, m_FindStdDeviation, m_FindSummation, arrays, numFeatures, m_ComputeByIndex, m_FindHistogram, m_MinRange, m_MaxRange, m_UseFullRange, m_NumBins)
+                            m_FindMedian, m_FindStdDeviation, m_FindSummation, arrays, numFeatures, m_ComputeByIndex, m_FindHistogram, m_MinRange, m_MaxRange, m_UseFullRange, m_NumBins,
+                            m_FindPercentiles, m_Quantiles, m_UseApproximateQuantiles, m_QuantileRankError)
 
   if(m_StandardizeData)
   {
@@ -1039,6 +1237,54 @@ bool FindArrayStatistics::getFindMedian() const
   return m_FindMedian;
 }
 
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setFindPercentiles(bool value)
+{
+  m_FindPercentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindArrayStatistics::getFindPercentiles() const
+{
+  return m_FindPercentiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setPercentiles(const QString& value)
+{
+  m_Percentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindArrayStatistics::getPercentiles() const
+{
+  return m_Percentiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setUseApproximateQuantiles(bool value)
+{
+  m_UseApproximateQuantiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindArrayStatistics::getUseApproximateQuantiles() const
+{
+  return m_UseApproximateQuantiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setQuantileRankError(double value)
+{
+  m_QuantileRankError = value;
+}
+
+// -----------------------------------------------------------------------------
+double FindArrayStatistics::getQuantileRankError() const
+{
+  return m_QuantileRankError;
+}
+
 // -----------------------------------------------------------------------------
 void FindArrayStatistics::setFindStdDeviation(bool value)
 {
@@ -1195,6 +1441,18 @@ QString FindArrayStatistics::getMedianArrayName() const
   return m_MedianArrayName;
 }
 
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setPercentilesArrayName(const QString& value)
+{
+  m_PercentilesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindArrayStatistics::getPercentilesArrayName() const
+{
+  return m_PercentilesArrayName;
+}
+
 // -----------------------------------------------------------------------------
 void FindArrayStatistics::setStdDeviationArrayName(const QString& value)
 {
@@ -88,6 +88,11 @@ class DREAM3DReview_EXPORT FindArrayStatistics : public AbstractFilter
   PYB11_PROPERTY(int32_t NumBins READ getNumBins WRITE setNumBins)
   PYB11_PROPERTY(float MinRange READ getMinRange WRITE setMinRange)
   PYB11_PROPERTY(float MaxRange READ getMaxRange WRITE setMaxRange)
+  PYB11_PROPERTY(bool FindPercentiles READ getFindPercentiles WRITE setFindPercentiles)
+  PYB11_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+  PYB11_PROPERTY(QString PercentilesArrayName READ getPercentilesArrayName WRITE setPercentilesArrayName)
+  PYB11_PROPERTY(bool UseApproximateQuantiles READ getUseApproximateQuantiles WRITE setUseApproximateQuantiles)
+  PYB11_PROPERTY(double QuantileRankError READ getQuantileRankError WRITE setQuantileRankError)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -220,6 +225,50 @@ public:
   bool getFindMedian() const;
   Q_PROPERTY(bool FindMedian READ getFindMedian WRITE setFindMedian)
 
+  /**
+   * @brief Setter property for FindPercentiles
+   */
+  void setFindPercentiles(bool value);
+  /**
+   * @brief Getter property for FindPercentiles
+   * @return Value of FindPercentiles
+   */
+  bool getFindPercentiles() const;
+  Q_PROPERTY(bool FindPercentiles READ getFindPercentiles WRITE setFindPercentiles)
+
+  /**
+   * @brief Setter property for Percentiles
+   */
+  void setPercentiles(const QString& value);
+  /**
+   * @brief Getter property for Percentiles
+   * @return Value of Percentiles
+   */
+  QString getPercentiles() const;
+  Q_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+
+  /**
+   * @brief Setter property for UseApproximateQuantiles
+   */
+  void setUseApproximateQuantiles(bool value);
+  /**
+   * @brief Getter property for UseApproximateQuantiles
+   * @return Value of UseApproximateQuantiles
+   */
+  bool getUseApproximateQuantiles() const;
+  Q_PROPERTY(bool UseApproximateQuantiles READ getUseApproximateQuantiles WRITE setUseApproximateQuantiles)
+
+  /**
+   * @brief Setter property for QuantileRankError
+   */
+  void setQuantileRankError(double value);
+  /**
+   * @brief Getter property for QuantileRankError
+   * @return Value of QuantileRankError
+   */
+  double getQuantileRankError() const;
+  Q_PROPERTY(double QuantileRankError READ getQuantileRankError WRITE setQuantileRankError)
+
   /**
    * @brief Setter property for FindStdDeviation
    */
@@ -363,6 +412,17 @@ public:
   QString getMedianArrayName() const;
   Q_PROPERTY(QString MedianArrayName READ getMedianArrayName WRITE setMedianArrayName)
 
+  /**
+   * @brief Setter property for PercentilesArrayName
+   */
+  void setPercentilesArrayName(const QString& value);
+  /**
+   * @brief Getter property for PercentilesArrayName
+   * @return Value of PercentilesArrayName
+   */
+  QString getPercentilesArrayName() const;
+  Q_PROPERTY(QString PercentilesArrayName READ getPercentilesArrayName WRITE setPercentilesArrayName)
+
   /**
    * @brief Setter property for StdDeviationArrayName
    */
@@ -505,6 +565,8 @@ private:
   std::weak_ptr<BoolArrayType> m_MaskPtr;
   bool* m_Mask = nullptr;
   std::weak_ptr<FloatArrayType> m_HistogramListPtr;
+  std::weak_ptr<FloatArrayType> m_PercentilesPtr;
+  std::vector<float> m_Quantiles;
 
   // Histogram Related Parameters
   double m_MinRange = {};
@@ -518,6 +580,10 @@ private:
   bool m_FindMax = false;
   bool m_FindMean = false;
   bool m_FindMedian = false;
+  bool m_FindPercentiles = false;
+  QString m_Percentiles = {"25, 75"};
+  bool m_UseApproximateQuantiles = false;
+  double m_QuantileRankError = 0.001;
   bool m_FindStdDeviation = false;
   bool m_FindSummation = false;
   bool m_UseMask = false;
@@ -533,6 +599,7 @@ private:
   QString m_MaximumArrayName = {"Maximum"};
   QString m_MeanArrayName = {"Mean"};
   QString m_MedianArrayName = {"Median"};
+  QString m_PercentilesArrayName = {"Percentiles"};
   QString m_StdDeviationArrayName = {"StandardDeviation"};
   QString m_SummationArrayName = {"Summation"};
   QString m_StandardizedArrayName = {"Standardized"};
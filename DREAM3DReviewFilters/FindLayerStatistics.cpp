@@ -13,7 +13,14 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindLayerStatistics.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -24,112 +31,313 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "util/StatisticsHelpers.hpp"
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
+namespace
+{
+/**
+ * @brief The LayerGeometry struct describes how the layers of an Image Geometry are laid out for the chosen plane:
+ * the voxel at in-plane position (j, k) of layer l is at l * layerStride + j * stride[0] + k * stride[1].
+ */
+struct LayerGeometry
+{
+  size_t numLayers = 0;
+  size_t layerStride = 0;
+  std::array<size_t, 2> dims = {0, 0};
+  std::array<size_t, 2> stride = {0, 0};
+};
 
 /**
- * @brief The CalcProjectedStatsImpl class implements a templated threaded algorithm for
- * determining the projected image statistics of a given volume.
+ * @brief The LayerOutputs struct holds the output arrays of one quantified array, one tuple per layer.  The
+ * percentiles and histogram are null if they are not requested.
  */
-template <typename T>
-class CalcLayerStatsImpl
+struct LayerOutputs
+{
+  float* min = nullptr;
+  float* max = nullptr;
+  float* avg = nullptr;
+  float* std = nullptr;
+  float* var = nullptr;
+  float* percentiles = nullptr;
+  float* histogram = nullptr;
+};
+
+/**
+ * @brief The LayerMoments struct holds the count, mean, sum of squared deviations, minimum and maximum of the
+ * positive values of one layer.  Each row is summarized on its own while it is in cache and merged in (Chan et al.),
+ * so the values are read once and the variance does not suffer from the cancellation of a sum of squares.
+ */
+struct LayerMoments
 {
+  size_t count = 0;
+  double mean = 0.0;
+  double m2 = 0.0;
+  double min = 0.0;
+  double max = 0.0;
 
+  void merge(size_t rowCount, double rowMean, double rowM2, double rowMin, double rowMax)
+  {
+    if(rowCount == 0)
+    {
+      return;
+    }
+    if(count == 0)
+    {
+      count = rowCount;
+      mean = rowMean;
+      m2 = rowM2;
+      min = rowMin;
+      max = rowMax;
+      return;
+    }
+    const double total = static_cast<double>(count + rowCount);
+    const double delta = rowMean - mean;
+    mean += delta * static_cast<double>(rowCount) / total;
+    m2 += rowM2 + delta * delta * static_cast<double>(count) * static_cast<double>(rowCount) / total;
+    min = std::min(min, rowMin);
+    max = std::max(max, rowMax);
+    count += rowCount;
+  }
+};
+
+/**
+ * @brief The LayerStatisticsKernel class is the type independent interface to the statistics of one quantified array
+ */
+class LayerStatisticsKernel
+{
 public:
-  CalcLayerStatsImpl(T* data, float* min, float* max, float* avg, float* std, float* var, int32_t* startPoints, size_t* stride, size_t* dims)
+  virtual ~LayerStatisticsKernel() = default;
+
+  /**
+   * @brief computeLayers Computes the statistics of the layers [start, end)
+   * @param start
+   * @param end
+   */
+  virtual void computeLayers(size_t start, size_t end) const = 0;
+};
+
+/**
+ * @brief The LayerStatisticsKernelImpl class computes the layer statistics of one array in a single sweep.  The
+ * layers of a tile are swept together one in-plane row at a time; when the layers are adjacent voxels (YZ plane) the
+ * rows are gathered from contiguous runs across the tile instead of with a stride of one voxel row per value.  Only
+ * positive values take part in the statistics.
+ */
+template <typename T>
+class LayerStatisticsKernelImpl : public LayerStatisticsKernel
+{
+public:
+  LayerStatisticsKernelImpl(const T* data, const LayerGeometry& geometry, const LayerOutputs& outputs, const std::vector<float>& quantiles, int32_t numBins)
   : m_Data(data)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Avg(avg)
-  , m_Std(std)
-  , m_Var(var)
-  , m_StartPoints(startPoints)
-  , m_Stride(stride)
-  , m_Dims(dims)
+  , m_Geometry(geometry)
+  , m_Outputs(outputs)
+  , m_Quantiles(quantiles)
+  , m_NumBins(numBins)
   {
   }
-  virtual ~CalcLayerStatsImpl() = default;
 
-  void convert(size_t start, size_t end) const
+  ~LayerStatisticsKernelImpl() override = default;
+
+  void computeLayers(size_t start, size_t end) const override
   {
-    size_t shift = 0;
-    size_t count = 0;
-    size_t point = 0, newPoint = 0;
-    T val = static_cast<T>(0);
-    for(size_t i = start; i < end; i++)
+    const size_t tileSize = end - start;
+    const size_t rowLength = m_Geometry.dims[0];
+    const bool collectValues = (m_Outputs.percentiles != nullptr || m_Outputs.histogram != nullptr);
+    const bool contiguousRows = (m_Geometry.stride[0] == 1);
+
+    std::vector<LayerMoments> moments(tileSize);
+    std::vector<std::vector<T>> values(collectValues ? tileSize : 0);
+    std::vector<T> rows(contiguousRows ? 0 : tileSize * rowLength);
+    for(size_t k = 0; k < m_Geometry.dims[1]; k++)
     {
-      count = 0;
-      point = m_StartPoints[i];
-      for(size_t k = 0; k < m_Dims[1]; k++)
+      const size_t rowStart = k * m_Geometry.stride[1];
+      if(!contiguousRows)
       {
-        shift = k * m_Stride[1];
-        for(size_t j = 0; j < m_Dims[0]; j++)
+        // The rows run across the layers (YZ plane), so the layers of the tile are adjacent voxels
+        for(size_t j = 0; j < rowLength; j++)
         {
-          newPoint = static_cast<int32_t>(point + shift + (j * m_Stride[0]));
-          val = m_Data[newPoint];
-          if(val > 0.0)
+          const T* run = m_Data + rowStart + j * m_Geometry.stride[0] + start * m_Geometry.layerStride;
+          for(size_t l = 0; l < tileSize; l++)
           {
-            if(val < m_Min[i])
-            {
-              m_Min[i] = val;
-            }
-            if(val > m_Max[i])
-            {
-              m_Max[i] = val;
-            }
-            m_Avg[i] += val;
-            count++;
+            rows[l * rowLength + j] = run[l];
           }
         }
       }
-      m_Avg[i] /= count;
-      for(size_t k = 0; k < m_Dims[1]; k++)
+
+      for(size_t l = 0; l < tileSize; l++)
       {
-        shift = k * m_Stride[1];
-        for(size_t j = 0; j < m_Dims[0]; j++)
+        const T* row = contiguousRows ? m_Data + (start + l) * m_Geometry.layerStride + rowStart : rows.data() + l * rowLength;
+        summarizeRow(row, rowLength, moments[l], collectValues ? &values[l] : nullptr);
+      }
+    }
+
+    for(size_t l = 0; l < tileSize; l++)
+    {
+      writeLayer(start + l, moments[l], collectValues ? &values[l] : nullptr);
+    }
+  }
+
+private:
+  const T* m_Data = nullptr;
+  LayerGeometry m_Geometry;
+  LayerOutputs m_Outputs;
+  std::vector<float> m_Quantiles;
+  int32_t m_NumBins = 0;
+
+  static void summarizeRow(const T* row, size_t rowLength, LayerMoments& moments, std::vector<T>* values)
+  {
+    size_t count = 0;
+    double sum = 0.0;
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    for(size_t j = 0; j < rowLength; j++)
+    {
+      const T value = row[j];
+      if(value > static_cast<T>(0))
+      {
+        count++;
+        sum += static_cast<double>(value);
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+    if(count == 0)
+    {
+      return;
+    }
+
+    const double mean = sum / static_cast<double>(count);
+    double m2 = 0.0;
+    for(size_t j = 0; j < rowLength; j++)
+    {
+      if(row[j] > static_cast<T>(0))
+      {
+        const double delta = static_cast<double>(row[j]) - mean;
+        m2 += delta * delta;
+      }
+    }
+    if(values != nullptr)
+    {
+      std::copy_if(row, row + rowLength, std::back_inserter(*values), [](T value) { return value > static_cast<T>(0); });
+    }
+    moments.merge(count, mean, m2, static_cast<double>(min), static_cast<double>(max));
+  }
+
+  void writeLayer(size_t layer, const LayerMoments& moments, std::vector<T>* values) const
+  {
+    const double variance = (moments.count > 0) ? moments.m2 / static_cast<double>(moments.count) : 0.0;
+    m_Outputs.min[layer] = static_cast<float>(moments.min);
+    m_Outputs.max[layer] = static_cast<float>(moments.max);
+    m_Outputs.avg[layer] = static_cast<float>(moments.mean);
+    m_Outputs.var[layer] = static_cast<float>(variance);
+    m_Outputs.std[layer] = static_cast<float>(std::sqrt(variance));
+
+    if(m_Outputs.histogram != nullptr)
+    {
+      // The bins span the range of the layer's own values; the maximum falls in the last bin
+      float* histogram = m_Outputs.histogram + layer * m_NumBins;
+      std::fill(histogram, histogram + m_NumBins, 0.0f);
+      const double range = moments.max - moments.min;
+      for(T value : *values)
+      {
+        size_t bin = 0;
+        if(range > 0.0)
         {
-          newPoint = static_cast<int32_t>(point + shift + (j * m_Stride[0]));
-          val = m_Data[newPoint];
-          if(val > 0.0)
-          {
-            m_Std[i] += ((val - m_Avg[i]) * (val - m_Avg[i]));
-          }
+          bin = std::min(static_cast<size_t>((static_cast<double>(value) - moments.min) / range * m_NumBins), static_cast<size_t>(m_NumBins - 1));
         }
+        histogram[bin]++;
       }
-      m_Std[i] /= count;
-      m_Var[i] = m_Std[i];
-      m_Std[i] = std::sqrt(m_Std[i]);
     }
+
+    if(m_Outputs.percentiles != nullptr)
+    {
+      std::vector<float> percentiles = StatisticsHelpers::findPercentilesInPlace(values->begin(), values->end(), m_Quantiles);
+      std::copy(percentiles.begin(), percentiles.end(), m_Outputs.percentiles + layer * m_Quantiles.size());
+    }
+  }
+};
+
+/**
+ * @brief The ComputeLayerTilesImpl class computes a range of layer tiles for every quantified array, and fills in
+ * the Layer Ids of the tile voxels.
+ */
+class ComputeLayerTilesImpl
+{
+public:
+  ComputeLayerTilesImpl(const std::vector<std::unique_ptr<LayerStatisticsKernel>>& kernels, const LayerGeometry& geometry, size_t tileSize, int32_t* layerIds)
+  : m_Kernels(kernels)
+  , m_Geometry(geometry)
+  , m_TileSize(tileSize)
+  , m_LayerIds(layerIds)
+  {
   }
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void operator()(const SIMPLRange& range) const
   {
-    convert(r.begin(), r.end());
+    for(size_t tile = range.min(); tile < range.max(); tile++)
+    {
+      const size_t start = tile * m_TileSize;
+      const size_t end = std::min(start + m_TileSize, m_Geometry.numLayers);
+      for(const auto& kernel : m_Kernels)
+      {
+        kernel->computeLayers(start, end);
+      }
+      for(size_t k = 0; k < m_Geometry.dims[1]; k++)
+      {
+        for(size_t j = 0; j < m_Geometry.dims[0]; j++)
+        {
+          const size_t base = j * m_Geometry.stride[0] + k * m_Geometry.stride[1];
+          for(size_t l = start; l < end; l++)
+          {
+            m_LayerIds[base + l * m_Geometry.layerStride] = static_cast<int32_t>(l);
+          }
+        }
+      }
+    }
   }
-#endif
+
 private:
-  T* m_Data = nullptr;
-  float* m_Min = nullptr;
-  float* m_Max = nullptr;
-  float* m_Avg = nullptr;
-  float* m_Std = nullptr;
-  float* m_Var = nullptr;
-  int32_t* m_StartPoints = nullptr;
-  size_t* m_Stride = nullptr;
-  size_t* m_Dims = nullptr;
+  const std::vector<std::unique_ptr<LayerStatisticsKernel>>& m_Kernels;
+  LayerGeometry m_Geometry;
+  size_t m_TileSize = 1;
+  int32_t* m_LayerIds = nullptr;
 };
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void createLayerStatisticsKernel(IDataArray::Pointer inputArray, const LayerGeometry& geometry, const LayerOutputs& outputs, const std::vector<float>& quantiles, int32_t numBins,
+                                 std::vector<std::unique_ptr<LayerStatisticsKernel>>& kernels)
+{
+  if constexpr(std::is_same_v<T, bool>)
+  {
+    // Boolean arrays are rejected by dataCheck()
+    return;
+  }
+  else
+  {
+    typename DataArray<T>::Pointer array = std::dynamic_pointer_cast<DataArray<T>>(inputArray);
+    kernels.push_back(std::make_unique<LayerStatisticsKernelImpl<T>>(array->getPointer(0), geometry, outputs, quantiles, numBins));
+  }
+}
+
+// -----------------------------------------------------------------------------
+QString findLayerArrayName(const DataArrayPath& inputPath, const QString& statisticName, bool primary)
+{
+  // The statistics of the primary array keep their plain names; those of the additional arrays are prefixed with the array name
+  return primary ? statisticName : inputPath.getDataArrayName() + statisticName;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -161,10 +369,18 @@ void FindLayerStatistics::setupFilterParameters()
     parameter->setCategory(FilterParameter::Category::Parameter);
     parameters.push_back(parameter);
   }
+  std::vector<QString> linkedProps;
+  linkedProps.push_back("Percentiles");
+  linkedProps.push_back("LayerPercentilesArrayName");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Percentiles", FindPercentiles, FilterParameter::Category::Parameter, FindLayerStatistics, linkedProps));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Percentiles", Percentiles, FilterParameter::Category::Parameter, FindLayerStatistics));
+  linkedProps.clear();
+  linkedProps.push_back("NumBins");
+  linkedProps.push_back("LayerHistogramArrayName");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Histogram", FindHistogram, FilterParameter::Category::Parameter, FindLayerStatistics, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of Bins", NumBins, FilterParameter::Category::Parameter, FindLayerStatistics));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
-    DataArraySelectionFilterParameter::RequirementType req =
-        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     std::vector<QString> daTypes;
     daTypes.push_back(SIMPL::TypeNames::Int8);
     daTypes.push_back(SIMPL::TypeNames::Int16);
@@ -176,8 +392,14 @@ void FindLayerStatistics::setupFilterParameters()
     daTypes.push_back(SIMPL::TypeNames::UInt64);
     daTypes.push_back(SIMPL::TypeNames::Float);
     daTypes.push_back(SIMPL::TypeNames::Double);
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     req.daTypes = daTypes;
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Quantify", SelectedArrayPath, FilterParameter::Category::RequiredArray, FindLayerStatistics, req));
+    MultiDataArraySelectionFilterParameter::RequirementType multiReq =
+        MultiDataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    multiReq.daTypes = daTypes;
+    parameters.push_back(SIMPL_NEW_MDA_SELECTION_FP("Additional Attribute Arrays to Quantify", AdditionalArrayPaths, FilterParameter::Category::RequiredArray, FindLayerStatistics, multiReq));
   }
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Layer Attribute Matrix", LayerAttributeMatrixName, SelectedArrayPath, FilterParameter::Category::CreatedArray, FindLayerStatistics));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::CreatedArray));
@@ -188,6 +410,10 @@ void FindLayerStatistics::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Layer Avg", LayerAvgArrayName, SelectedArrayPath, LayerAttributeMatrixName, FilterParameter::Category::CreatedArray, FindLayerStatistics));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Layer Std", LayerStdArrayName, SelectedArrayPath, LayerAttributeMatrixName, FilterParameter::Category::CreatedArray, FindLayerStatistics));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Layer Var", LayerVarArrayName, SelectedArrayPath, LayerAttributeMatrixName, FilterParameter::Category::CreatedArray, FindLayerStatistics));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Layer Percentiles", LayerPercentilesArrayName, SelectedArrayPath, LayerAttributeMatrixName, FilterParameter::Category::CreatedArray,
+                                                      FindLayerStatistics));
+  parameters.push_back(
+      SIMPL_NEW_DA_WITH_LINKED_AM_FP("Layer Histogram", LayerHistogramArrayName, SelectedArrayPath, LayerAttributeMatrixName, FilterParameter::Category::CreatedArray, FindLayerStatistics));
   setFilterParameters(parameters);
 }
 
@@ -204,6 +430,13 @@ void FindLayerStatistics::readFilterParameters(AbstractFilterParametersReader* r
   setLayerMinArrayName(reader->readString("LayerMinArrayName", getLayerMinArrayName()));
   setSelectedArrayPath(reader->readDataArrayPath("SelectedArrayPath", getSelectedArrayPath()));
   setPlane(reader->readValue("Plane", getPlane()));
+  setAdditionalArrayPaths(reader->readDataArrayPathVector("AdditionalArrayPaths", getAdditionalArrayPaths()));
+  setFindPercentiles(reader->readValue("FindPercentiles", getFindPercentiles()));
+  setPercentiles(reader->readString("Percentiles", getPercentiles()));
+  setLayerPercentilesArrayName(reader->readString("LayerPercentilesArrayName", getLayerPercentilesArrayName()));
+  setFindHistogram(reader->readValue("FindHistogram", getFindHistogram()));
+  setNumBins(reader->readValue("NumBins", getNumBins()));
+  setLayerHistogramArrayName(reader->readString("LayerHistogramArrayName", getLayerHistogramArrayName()));
   reader->closeFilterGroup();
 }
 
@@ -234,6 +467,61 @@ void FindLayerStatistics::dataCheck()
     }
   }
 
+  std::vector<DataArrayPath> inputPaths = {getSelectedArrayPath()};
+  for(const DataArrayPath& path : getAdditionalArrayPaths())
+  {
+    IDataArray::Pointer array = getDataContainerArray()->getPrereqIDataArrayFromPath(this, path);
+    if(nullptr != array)
+    {
+      if(TemplateHelpers::CanDynamicCast<BoolArrayType>()(array))
+      {
+        QString ss = QObject::tr("Selected array cannot be of type bool.  The path is %1").arg(path.serialize());
+        setErrorCondition(-11001, ss);
+      }
+      if(array->getNumberOfComponents() != 1)
+      {
+        QString ss = QObject::tr("All Attribute Arrays to quantify must be scalar arrays, but %1 has %2 total components").arg(path.serialize()).arg(array->getNumberOfComponents());
+        setErrorCondition(-11002, ss);
+      }
+    }
+    inputPaths.push_back(path);
+  }
+
+  m_Quantiles.clear();
+  if(getFindPercentiles())
+  {
+    QStringList tokens = getPercentiles().split(',');
+    for(const QString& token : tokens)
+    {
+      if(token.trimmed().isEmpty())
+      {
+        continue;
+      }
+      bool ok = false;
+      double percentile = token.trimmed().toDouble(&ok);
+      if(!ok || percentile < 0.0 || percentile > 100.0)
+      {
+        QString ss = QObject::tr("Percentiles must be a comma separated list of values between 0 and 100, but \"%1\" is not").arg(token.trimmed());
+        setErrorCondition(-11003, ss);
+        return;
+      }
+      m_Quantiles.push_back(static_cast<float>(percentile / 100.0));
+    }
+    if(m_Quantiles.empty())
+    {
+      QString ss = QObject::tr("At least one percentile must be given to find percentiles");
+      setErrorCondition(-11003, ss);
+      return;
+    }
+  }
+
+  if(getFindHistogram() && getNumBins() < 1)
+  {
+    QString ss = QObject::tr("The number of histogram bins must be at least 1");
+    setErrorCondition(-11004, ss);
+    return;
+  }
+
   ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getSelectedArrayPath().getDataContainerName());
   if(getErrorCode() < 0)
   {
@@ -271,40 +559,29 @@ void FindLayerStatistics::dataCheck()
     m_LayerIDs = m_LayerIDsPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), getLayerMinArrayName());
-  m_LayerMinPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
-  if(nullptr != m_LayerMinPtr.lock())
+  QVector<QString> statisticNames = {getLayerMinArrayName(), getLayerMaxArrayName(), getLayerAvgArrayName(), getLayerStdArrayName(), getLayerVarArrayName()};
+  for(size_t i = 0; i < inputPaths.size(); i++)
   {
-    m_LayerMin = m_LayerMinPtr.lock()->getPointer(0);
-  } /* Now assign the raw pointer to data from the DataArray<T> object */
-
-  tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), getLayerMaxArrayName());
-  m_LayerMaxPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
-  if(nullptr != m_LayerMaxPtr.lock())
-  {
-    m_LayerMax = m_LayerMaxPtr.lock()->getPointer(0);
-  } /* Now assign the raw pointer to data from the DataArray<T> object */
-
-  tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), getLayerAvgArrayName());
-  m_LayerAvgPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
-  if(nullptr != m_LayerAvgPtr.lock())
-  {
-    m_LayerAvg = m_LayerAvgPtr.lock()->getPointer(0);
-  } /* Now assign the raw pointer to data from the DataArray<T> object */
-
-  tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), getLayerStdArrayName());
-  m_LayerStdPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
-  if(nullptr != m_LayerStdPtr.lock())
-  {
-    m_LayerStd = m_LayerStdPtr.lock()->getPointer(0);
-  } /* Now assign the raw pointer to data from the DataArray<T> object */
+    for(const QString& statisticName : statisticNames)
+    {
+      tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), findLayerArrayName(inputPaths[i], statisticName, i == 0));
+      getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
+    }
+    if(getFindPercentiles())
+    {
+      std::vector<size_t> percentileDims(1, m_Quantiles.size());
+      tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), findLayerArrayName(inputPaths[i], getLayerPercentilesArrayName(), i == 0));
+      getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, percentileDims);
+    }
+    if(getFindHistogram())
+    {
+      std::vector<size_t> histogramDims(1, static_cast<size_t>(getNumBins()));
+      tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), findLayerArrayName(inputPaths[i], getLayerHistogramArrayName(), i == 0));
+      getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, histogramDims);
+    }
+  }
 
-  tempPath.update(getSelectedArrayPath().getDataContainerName(), getLayerAttributeMatrixName(), getLayerVarArrayName());
-  m_LayerVarPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
-  if(nullptr != m_LayerVarPtr.lock())
-  {
-    m_LayerVar = m_LayerVarPtr.lock()->getPointer(0);
-  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  getDataContainerArray()->validateNumberOfTuples(this, inputPaths);
 }
 
 // -----------------------------------------------------------------------------
@@ -319,241 +596,83 @@ void FindLayerStatistics::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getSelectedArrayPath().getDataContainerName());
+  AttributeMatrix::Pointer layerAttrMat = m->getAttributeMatrix(getLayerAttributeMatrixName());
 
   SizeVec3Type dimsP = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  Int32ArrayType::Pointer startingPoints = Int32ArrayType::CreateArray(0, std::string("_INTERNAL_USE_ONLY_startingPoints"), true);
-  int32_t* startPoints = nullptr;
-  size_t stride[2];
-  size_t dims[2];
-  // size_t yStride = 0;
-  size_t depth = 0;
+  LayerGeometry geometry;
   if(m_Plane == 0)
   {
-    startingPoints->resizeTuples(dimsP[2]);
-    startPoints = startingPoints->getPointer(0);
-    stride[0] = 1;
-    stride[1] = dimsP[0];
-    dims[0] = dimsP[0];
-    dims[1] = dimsP[1];
-    depth = dimsP[2];
-    for(size_t i = 0; i < dimsP[2]; i++)
-    {
-      startPoints[i] = i * (dimsP[0] * dimsP[1]);
-    }
+    geometry.numLayers = dimsP[2];
+    geometry.layerStride = dimsP[0] * dimsP[1];
+    geometry.dims = {dimsP[0], dimsP[1]};
+    geometry.stride = {1, dimsP[0]};
   }
-  if(m_Plane == 1)
+  else if(m_Plane == 1)
   {
-    startingPoints->resizeTuples(dimsP[1]);
-    startPoints = startingPoints->getPointer(0);
-    stride[0] = 1;
-    stride[1] = (dimsP[0] * dimsP[1]);
-    dims[0] = dimsP[0];
-    dims[1] = dimsP[2];
-    depth = dimsP[1];
-    for(size_t i = 0; i < dimsP[1]; i++)
-    {
-      startPoints[i] = i * dimsP[0];
-    }
+    geometry.numLayers = dimsP[1];
+    geometry.layerStride = dimsP[0];
+    geometry.dims = {dimsP[0], dimsP[2]};
+    geometry.stride = {1, dimsP[0] * dimsP[1]};
   }
-  if(m_Plane == 2)
+  else if(m_Plane == 2)
   {
-    startingPoints->resizeTuples(dimsP[0]);
-    startPoints = startingPoints->getPointer(0);
-    stride[0] = dimsP[0];
-    stride[1] = (dimsP[0] * dimsP[1]);
-    dims[0] = dimsP[1];
-    dims[1] = dimsP[2];
-    depth = dimsP[0];
-    for(size_t i = 0; i < dimsP[0]; i++)
-    {
-      startPoints[i] = i;
-    }
+    geometry.numLayers = dimsP[0];
+    geometry.layerStride = 1;
+    geometry.dims = {dimsP[1], dimsP[2]};
+    geometry.stride = {dimsP[0], dimsP[0] * dimsP[1]};
   }
-
-  if(nullptr == startPoints)
+  else
   {
     QString ss = QObject::tr("Unable to establish starting location for supplied plane. The plane is %1").arg(m_Plane);
     setErrorCondition(-11001, ss);
     return;
   }
 
-  if(TemplateHelpers::CanDynamicCast<Int8ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int8ArrayType>(m_InDataPtr.lock());
-    int8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
+  std::vector<DataArrayPath> inputPaths = {getSelectedArrayPath()};
+  inputPaths.insert(inputPaths.end(), m_AdditionalArrayPaths.begin(), m_AdditionalArrayPaths.end());
+  std::vector<std::unique_ptr<LayerStatisticsKernel>> kernels;
+  for(size_t i = 0; i < inputPaths.size(); i++)
+  {
+    auto findOutput = [&](const QString& statisticName) {
+      FloatArrayType::Pointer array = layerAttrMat->getAttributeArrayAs<FloatArrayType>(findLayerArrayName(inputPaths[i], statisticName, i == 0));
+      return (nullptr != array) ? array->getPointer(0) : nullptr;
+    };
+    LayerOutputs outputs;
+    outputs.min = findOutput(getLayerMinArrayName());
+    outputs.max = findOutput(getLayerMaxArrayName());
+    outputs.avg = findOutput(getLayerAvgArrayName());
+    outputs.std = findOutput(getLayerStdArrayName());
+    outputs.var = findOutput(getLayerVarArrayName());
+    outputs.percentiles = m_FindPercentiles ? findOutput(getLayerPercentilesArrayName()) : nullptr;
+    outputs.histogram = m_FindHistogram ? findOutput(getLayerHistogramArrayName()) : nullptr;
+
+    IDataArray::Pointer inputArray = getDataContainerArray()->getAttributeMatrix(inputPaths[i])->getAttributeArray(inputPaths[i].getDataArrayName());
+    EXECUTE_FUNCTION_TEMPLATE(this, createLayerStatisticsKernel, inputArray, inputArray, geometry, outputs, m_Quantiles, m_NumBins, kernels)
+    if(getErrorCode() < 0)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int8_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int8_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
+      return;
     }
   }
-  else if(TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt8ArrayType>(m_InDataPtr.lock());
-    uint8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint8_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint8_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<Int16ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int16ArrayType>(m_InDataPtr.lock());
-    int16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int16_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int16_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt16ArrayType>(m_InDataPtr.lock());
-    uint16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint16_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint16_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<Int32ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int32ArrayType>(m_InDataPtr.lock());
-    int32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int32_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int32_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt32ArrayType>(m_InDataPtr.lock());
-    uint32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint32_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint32_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<Int64ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int64ArrayType>(m_InDataPtr.lock());
-    int64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int64_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int64_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt64ArrayType>(m_InDataPtr.lock());
-    uint64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint64_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint64_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<FloatArrayType>()(m_InDataPtr.lock()))
-  {
-    FloatArrayType::Pointer cellArray = std::dynamic_pointer_cast<FloatArrayType>(m_InDataPtr.lock());
-    float* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<float>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<float> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<DoubleArrayType>()(m_InDataPtr.lock()))
+
+  // Layers that are adjacent voxels (YZ plane) are computed in tiles so that each voxel row is read in contiguous
+  // runs; the tile is kept small enough that the values gathered for percentiles and histograms stay bounded
+  size_t tileSize = 1;
+  if(geometry.layerStride == 1)
   {
-    DoubleArrayType::Pointer cellArray = std::dynamic_pointer_cast<DoubleArrayType>(m_InDataPtr.lock());
-    double* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
+    constexpr size_t k_MaxTileSize = 16;
+    constexpr size_t k_MaxTileValues = 1ULL << 24;
+    tileSize = k_MaxTileSize;
+    if(m_FindPercentiles || m_FindHistogram)
     {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<double>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<double> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
+      tileSize = std::max<size_t>(std::min(k_MaxTileSize, k_MaxTileValues / (geometry.dims[0] * geometry.dims[1])), 1);
     }
   }
-  else
-  {
-    QString ss = QObject::tr("Selected array is of unsupported type. The type is %1").arg(m_InDataPtr.lock()->getTypeAsString());
-    setErrorCondition(-11001, ss);
-    return;
-  }
+  const size_t numTiles = (geometry.numLayers + tileSize - 1) / tileSize;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTiles);
+  dataAlg.execute(ComputeLayerTilesImpl(kernels, geometry, tileSize, m_LayerIDs));
 
   notifyStatusMessage("Complete");
 }
@@ -683,6 +802,90 @@ unsigned int FindLayerStatistics::getPlane() const
   return m_Plane;
 }
 
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setAdditionalArrayPaths(const std::vector<DataArrayPath>& value)
+{
+  m_AdditionalArrayPaths = value;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<DataArrayPath> FindLayerStatistics::getAdditionalArrayPaths() const
+{
+  return m_AdditionalArrayPaths;
+}
+
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setFindPercentiles(bool value)
+{
+  m_FindPercentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindLayerStatistics::getFindPercentiles() const
+{
+  return m_FindPercentiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setPercentiles(const QString& value)
+{
+  m_Percentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindLayerStatistics::getPercentiles() const
+{
+  return m_Percentiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setFindHistogram(bool value)
+{
+  m_FindHistogram = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindLayerStatistics::getFindHistogram() const
+{
+  return m_FindHistogram;
+}
+
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setNumBins(int32_t value)
+{
+  m_NumBins = value;
+}
+
+// -----------------------------------------------------------------------------
+int32_t FindLayerStatistics::getNumBins() const
+{
+  return m_NumBins;
+}
+
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setLayerPercentilesArrayName(const QString& value)
+{
+  m_LayerPercentilesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindLayerStatistics::getLayerPercentilesArrayName() const
+{
+  return m_LayerPercentilesArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindLayerStatistics::setLayerHistogramArrayName(const QString& value)
+{
+  m_LayerHistogramArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindLayerStatistics::getLayerHistogramArrayName() const
+{
+  return m_LayerHistogramArrayName;
+}
+
 // -----------------------------------------------------------------------------
 void FindLayerStatistics::setLayerIDsArrayName(const QString& value)
 {
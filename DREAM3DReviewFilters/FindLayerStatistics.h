@@ -15,6 +15,7 @@
 #define _findlayerstatistics_h_
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -74,6 +75,61 @@ public:
   unsigned int getPlane() const;
   Q_PROPERTY(unsigned int Plane READ getPlane WRITE setPlane)
 
+  /**
+   * @brief Setter property for AdditionalArrayPaths
+   */
+  void setAdditionalArrayPaths(const std::vector<DataArrayPath>& value);
+  /**
+   * @brief Getter property for AdditionalArrayPaths
+   * @return Value of AdditionalArrayPaths
+   */
+  std::vector<DataArrayPath> getAdditionalArrayPaths() const;
+  Q_PROPERTY(std::vector<DataArrayPath> AdditionalArrayPaths READ getAdditionalArrayPaths WRITE setAdditionalArrayPaths)
+
+  /**
+   * @brief Setter property for FindPercentiles
+   */
+  void setFindPercentiles(bool value);
+  /**
+   * @brief Getter property for FindPercentiles
+   * @return Value of FindPercentiles
+   */
+  bool getFindPercentiles() const;
+  Q_PROPERTY(bool FindPercentiles READ getFindPercentiles WRITE setFindPercentiles)
+
+  /**
+   * @brief Setter property for Percentiles
+   */
+  void setPercentiles(const QString& value);
+  /**
+   * @brief Getter property for Percentiles
+   * @return Value of Percentiles
+   */
+  QString getPercentiles() const;
+  Q_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+
+  /**
+   * @brief Setter property for FindHistogram
+   */
+  void setFindHistogram(bool value);
+  /**
+   * @brief Getter property for FindHistogram
+   * @return Value of FindHistogram
+   */
+  bool getFindHistogram() const;
+  Q_PROPERTY(bool FindHistogram READ getFindHistogram WRITE setFindHistogram)
+
+  /**
+   * @brief Setter property for NumBins
+   */
+  void setNumBins(int32_t value);
+  /**
+   * @brief Getter property for NumBins
+   * @return Value of NumBins
+   */
+  int32_t getNumBins() const;
+  Q_PROPERTY(int32_t NumBins READ getNumBins WRITE setNumBins)
+
   /**
    * @brief Setter property for LayerIDsArrayName
    */
@@ -151,6 +207,28 @@ public:
   QString getLayerVarArrayName() const;
   Q_PROPERTY(QString LayerVarArrayName READ getLayerVarArrayName WRITE setLayerVarArrayName)
 
+  /**
+   * @brief Setter property for LayerPercentilesArrayName
+   */
+  void setLayerPercentilesArrayName(const QString& value);
+  /**
+   * @brief Getter property for LayerPercentilesArrayName
+   * @return Value of LayerPercentilesArrayName
+   */
+  QString getLayerPercentilesArrayName() const;
+  Q_PROPERTY(QString LayerPercentilesArrayName READ getLayerPercentilesArrayName WRITE setLayerPercentilesArrayName)
+
+  /**
+   * @brief Setter property for LayerHistogramArrayName
+   */
+  void setLayerHistogramArrayName(const QString& value);
+  /**
+   * @brief Getter property for LayerHistogramArrayName
+   * @return Value of LayerHistogramArrayName
+   */
+  QString getLayerHistogramArrayName() const;
+  Q_PROPERTY(QString LayerHistogramArrayName READ getLayerHistogramArrayName WRITE setLayerHistogramArrayName)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -229,19 +307,14 @@ private:
 
   std::weak_ptr<DataArray<int32_t>> m_LayerIDsPtr;
   int32_t* m_LayerIDs = nullptr;
-  std::weak_ptr<DataArray<float>> m_LayerMinPtr;
-  float* m_LayerMin = nullptr;
-  std::weak_ptr<DataArray<float>> m_LayerMaxPtr;
-  float* m_LayerMax = nullptr;
-  std::weak_ptr<DataArray<float>> m_LayerAvgPtr;
-  float* m_LayerAvg = nullptr;
-  std::weak_ptr<DataArray<float>> m_LayerStdPtr;
-  float* m_LayerStd = nullptr;
-  std::weak_ptr<DataArray<float>> m_LayerVarPtr;
-  float* m_LayerVar = nullptr;
 
   DataArrayPath m_SelectedArrayPath = {"", "", ""};
   unsigned int m_Plane = {0};
+  std::vector<DataArrayPath> m_AdditionalArrayPaths = {};
+  bool m_FindPercentiles = {false};
+  QString m_Percentiles = {"5, 50, 95"};
+  bool m_FindHistogram = {false};
+  int32_t m_NumBins = {32};
   QString m_LayerIDsArrayName = {"LayerIDs"};
   QString m_LayerAttributeMatrixName = {""};
   QString m_LayerMinArrayName = {"LayerMin"};
@@ -249,6 +322,10 @@ private:
   QString m_LayerAvgArrayName = {"LayerAvg"};
   QString m_LayerStdArrayName = {"LayerStd"};
   QString m_LayerVarArrayName = {"LayerVar"};
+  QString m_LayerPercentilesArrayName = {"LayerPercentiles"};
+  QString m_LayerHistogramArrayName = {"LayerHistogram"};
+
+  std::vector<float> m_Quantiles;
 
   FindLayerStatistics(const FindLayerStatistics&) = delete; // Copy Constructor Not Implemented
   FindLayerStatistics(FindLayerStatistics&&) = delete;      // Move Constructor Not Implemented
@@ -14,7 +14,11 @@
 
 #include "FindNeighborListStatistics.h"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -153,14 +157,21 @@ void FindNeighborListStatistics::dataCheck()
 }
 
 // -----------------------------------------------------------------------------
+/**
+ * @brief The FindNeighborListStatisticsImpl class computes the statistics for a range of chunks of Features.  Each
+ * chunk copies its lists into one contiguous (CSR) segment of values, so every statistic runs over contiguous memory
+ * and the median is found with a partial sort of the segment instead of a sorted copy of each list.
+ */
 template <typename T>
 class FindNeighborListStatisticsImpl
 {
 public:
-  FindNeighborListStatisticsImpl(AbstractFilter* filter, IDataArray::Pointer& source, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray::Pointer>& arrays)
+  FindNeighborListStatisticsImpl(AbstractFilter* filter, IDataArray::Pointer& source, const std::vector<size_t>& offsets, const std::vector<size_t>& chunks, bool length, bool min, bool max,
+                                 bool mean, bool median, bool stdDeviation, bool summation, std::vector<IDataArray::Pointer>& arrays)
   : m_Filter(filter)
   , m_Source(source)
+  , m_Offsets(offsets)
+  , m_Chunks(chunks)
   , m_Length(length)
   , m_Min(min)
   , m_Max(max)
@@ -179,69 +190,30 @@ public:
     using NeighborListType = NeighborList<T>;
     typename NeighborListType::Pointer inputDataPtr = std::dynamic_pointer_cast<NeighborListType>(m_Source);
 
-    for(size_t i = start; i < end; i++)
+    std::vector<T> values;
+    for(size_t chunk = start; chunk < end; chunk++)
     {
       if(m_Filter->getCancel())
       {
         break;
       }
-      std::vector<T>& tmpList = (*inputDataPtr)[i];
+      const size_t firstFeature = m_Chunks[chunk];
+      const size_t lastFeature = m_Chunks[chunk + 1];
+      const size_t base = m_Offsets[firstFeature];
 
-      if(m_Length)
+      // Flatten the lists of the chunk; the offsets of the whole input give each list its segment
+      values.resize(m_Offsets[lastFeature] - base);
+      for(size_t i = firstFeature; i < lastFeature; i++)
       {
-        if(m_Arrays[0])
-        {
-          int64_t val = static_cast<int64_t>(tmpList.size());
-          m_Arrays[0]->initializeTuple(i, &val);
-        }
+        const std::vector<T>& tmpList = (*inputDataPtr)[i];
+        std::copy(tmpList.begin(), tmpList.end(), values.begin() + (m_Offsets[i] - base));
       }
-      if(m_Min)
-      {
-        if(m_Arrays[1])
-        {
-          T val = StatisticsHelpers::findMin(tmpList);
-          m_Arrays[1]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Max)
-      {
-        if(m_Arrays[2])
-        {
-          T val = StatisticsHelpers::findMax(tmpList);
-          m_Arrays[2]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Mean)
-      {
-        if(m_Arrays[3])
-        {
-          float val = StatisticsHelpers::findMean(tmpList);
-          m_Arrays[3]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Median)
-      {
-        if(m_Arrays[4])
-        {
-          float val = StatisticsHelpers::findMedian(tmpList);
-          m_Arrays[4]->initializeTuple(i, &val);
-        }
-      }
-      if(m_StdDeviation)
-      {
-        if(m_Arrays[5])
-        {
-          float val = StatisticsHelpers::findStdDeviation(tmpList);
-          m_Arrays[5]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Summation)
+
+      for(size_t i = firstFeature; i < lastFeature; i++)
       {
-        if(m_Arrays[6])
-        {
-          float val = StatisticsHelpers::findSummation(tmpList);
-          m_Arrays[6]->initializeTuple(i, &val);
-        }
+        auto first = values.begin() + (m_Offsets[i] - base);
+        auto last = values.begin() + (m_Offsets[i + 1] - base);
+        computeFeature(i, first, last);
       }
     }
   }
@@ -254,6 +226,8 @@ public:
 private:
   AbstractFilter* m_Filter = nullptr;
   IDataArray::Pointer m_Source;
+  const std::vector<size_t>& m_Offsets;
+  const std::vector<size_t>& m_Chunks;
   bool m_Length = false;
   bool m_Min = false;
   bool m_Max = false;
@@ -263,6 +237,68 @@ private:
   bool m_Summation = false;
 
   std::vector<IDataArray::Pointer>& m_Arrays;
+
+  void computeFeature(size_t i, typename std::vector<T>::iterator first, typename std::vector<T>::iterator last) const
+  {
+    const bool empty = (first == last);
+    if(m_Length)
+    {
+      if(m_Arrays[0])
+      {
+        int64_t val = static_cast<int64_t>(std::distance(first, last));
+        m_Arrays[0]->initializeTuple(i, &val);
+      }
+    }
+    if(m_Min)
+    {
+      if(m_Arrays[1])
+      {
+        T val = empty ? static_cast<T>(0) : *std::min_element(first, last);
+        m_Arrays[1]->initializeTuple(i, &val);
+      }
+    }
+    if(m_Max)
+    {
+      if(m_Arrays[2])
+      {
+        T val = empty ? static_cast<T>(0) : *std::max_element(first, last);
+        m_Arrays[2]->initializeTuple(i, &val);
+      }
+    }
+    if(m_Mean)
+    {
+      if(m_Arrays[3])
+      {
+        float val = StatisticsHelpers::findMean(first, last);
+        m_Arrays[3]->initializeTuple(i, &val);
+      }
+    }
+    if(m_StdDeviation)
+    {
+      if(m_Arrays[5])
+      {
+        float val = StatisticsHelpers::findStdDeviation(first, last);
+        m_Arrays[5]->initializeTuple(i, &val);
+      }
+    }
+    if(m_Summation)
+    {
+      if(m_Arrays[6])
+      {
+        float val = empty ? 0.0f : static_cast<float>(StatisticsHelpers::computeSum(first, last));
+        m_Arrays[6]->initializeTuple(i, &val);
+      }
+    }
+    // The median reorders the segment, so it comes last
+    if(m_Median)
+    {
+      if(m_Arrays[4])
+      {
+        float val = StatisticsHelpers::findMedianInPlace(first, last);
+        m_Arrays[4]->initializeTuple(i, &val);
+      }
+    }
+  }
 };
 
 // -----------------------------------------------------------------------------
@@ -270,11 +306,45 @@ template <typename T>
 void findStatistics(AbstractFilter* filter, IDataArray::Pointer source, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
                     std::vector<IDataArray::Pointer>& arrays)
 {
+  using NeighborListType = NeighborList<T>;
+  typename NeighborListType::Pointer inputDataPtr = std::dynamic_pointer_cast<NeighborListType>(source);
   size_t numTuples = source->getNumberOfTuples();
+
+  // CSR offsets: the values of Feature i are [offsets[i], offsets[i + 1]) of the flattened lists
+  std::vector<size_t> offsets(numTuples + 1, 0);
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    offsets[i + 1] = offsets[i] + (*inputDataPtr)[i].size();
+  }
+
+  // Chunks of consecutive Features holding about the same number of values, with several chunks per thread so that
+  // the scheduler can even out the load; a list larger than a chunk gets a chunk of its own
+  constexpr size_t k_ChunksPerThread = 8;
+  constexpr size_t k_MinChunkCost = 4096;
+  const size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  // Every Feature costs at least one unit, so many empty lists are still split
+  const size_t totalCost = offsets[numTuples] + numTuples;
+  const size_t chunkCost = std::max(totalCost / (numThreads * k_ChunksPerThread), k_MinChunkCost);
+  std::vector<size_t> chunks = {0};
+  size_t cost = 0;
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    cost += offsets[i + 1] - offsets[i] + 1;
+    if(cost >= chunkCost)
+    {
+      chunks.push_back(i + 1);
+      cost = 0;
+    }
+  }
+  if(chunks.back() != numTuples)
+  {
+    chunks.push_back(numTuples);
+  }
+
   // Allow data-based parallelization
   ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0, numTuples);
-  dataAlg.execute(FindNeighborListStatisticsImpl<T>(filter, source, length, min, max, mean, median, stdDeviation, summation, arrays));
+  dataAlg.setRange(0, chunks.size() - 1);
+  dataAlg.execute(FindNeighborListStatisticsImpl<T>(filter, source, offsets, chunks, length, min, max, mean, median, stdDeviation, summation, arrays));
 }
 
 // -----------------------------------------------------------------------------
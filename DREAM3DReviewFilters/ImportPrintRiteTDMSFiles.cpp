@@ -1176,7 +1176,7 @@ void ImportPrintRiteTDMSFiles::determinePointsForLeastSquares(const PRH::Polygon
         vertexList[v][1] = polygons.polygons[p].vertices[v].y;
         vertexList[v][2] = 0.0f;
       }
-      Delaunay2D::Pointer delaunay = Delaunay2D::New(vertexList, 1.0, 1e-05, 0.0);
+      Delaunay2D::Pointer delaunay = Delaunay2D::New(std::move(vertexList), 1.0, 1e-05, 0.0);
       QString ss = QObject::tr("Finding STL Region Convex Hulls || Region %1 of %2").arg(counter).arg(numValidPolys);
       notifyStatusMessage(ss);
       TriangleGeom::Pointer triangles = delaunay->triangulate();
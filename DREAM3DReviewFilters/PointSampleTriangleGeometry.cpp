@@ -34,12 +34,16 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "PointSampleTriangleGeometry.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -54,11 +58,13 @@
 #include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/FilterParameters/UInt64FilterParameter.h"
 #include "SIMPLib/Geometry/EdgeGeom.h"
 #include "SIMPLib/Geometry/IGeometry2D.h"
 #include "SIMPLib/Geometry/IGeometry3D.h"
 #include "SIMPLib/Geometry/IGeometryGrid.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
@@ -106,6 +112,9 @@ void PointSampleTriangleGeometry::setupFilterParameters()
   std::vector<QString> linkedProps;
   linkedProps.push_back("MaskArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, PointSampleTriangleGeometry, linkedProps));
+  linkedProps = {"RandomSeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Random Seed", UseRandomSeed, FilterParameter::Category::Parameter, PointSampleTriangleGeometry, linkedProps));
+  parameters.push_back(SIMPL_NEW_UINT64_FP("Random Seed Value", RandomSeedValue, FilterParameter::Category::Parameter, PointSampleTriangleGeometry));
   DataContainerSelectionFilterParameter::RequirementType dcsReq;
   IGeometry::Types geomTypes = {IGeometry::Type::Triangle};
   dcsReq.dcGeometryTypes = geomTypes;
@@ -143,6 +152,8 @@ void PointSampleTriangleGeometry::readFilterParameters(AbstractFilterParametersR
   setTriangleAreasArrayPath(reader->readDataArrayPath("TriangleAreasArrayPath", getTriangleAreasArrayPath()));
   setUseMask(reader->readValue("UseMask", getUseMask()));
   setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath()));
+  setUseRandomSeed(reader->readValue("UseRandomSeed", getUseRandomSeed()));
+  setRandomSeedValue(reader->readValue("RandomSeedValue", getRandomSeedValue()));
   reader->closeFilterGroup();
 }
 
@@ -299,45 +310,229 @@ void PointSampleTriangleGeometry::dataCheck()
   getDataContainerArray()->validateNumberOfTuples(this, dataArrays);
 }
 
+namespace
+{
 // -----------------------------------------------------------------------------
-//
+// Counter-based generator (SplitMix64 finalizer): the n-th draw depends only on
+// the seed and n, so every sample owns an independent stream and the output
+// does not depend on how the samples are partitioned across threads
 // -----------------------------------------------------------------------------
-template <typename T>
-void copyDataToPoints(IDataArray::Pointer source, IDataArray::Pointer dest, int64_t sourceIdx, int64_t destIdx)
+inline uint64_t counterRandom(uint64_t seed, uint64_t counter)
 {
-  typename DataArray<T>::Pointer sourcePtr = std::dynamic_pointer_cast<DataArray<T>>(source);
-  typename DataArray<T>::Pointer destPtr = std::dynamic_pointer_cast<DataArray<T>>(dest);
-  T* sPtr = sourcePtr->getPointer(0);
-  T* dPtr = destPtr->getPointer(0);
-
-  assert(sourcePtr->getNumberOfComponents() == destPtr->getNumberOfComponents());
-
-  std::memcpy(dPtr + (destIdx * destPtr->getNumberOfComponents()), sPtr + (sourceIdx * sourcePtr->getNumberOfComponents()), sizeof(T) * sourcePtr->getNumberOfComponents());
+  uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
 }
 
 // -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void PointSampleTriangleGeometry::sampleTriangle(float a[3], float b[3], float c[3], int64_t curVertex, VertexGeom::Pointer vertex, int64_t tri, std::mt19937_64& gen,
-                                                 std::uniform_real_distribution<>& dist)
+inline double counterUniform(uint64_t seed, uint64_t counter)
+{
+  return static_cast<double>(counterRandom(seed, counter) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief The TriangleAliasTable class is a Walker/Vose alias table over the sampleable
+ * Triangles, weighted by area.  Masked and zero area Triangles are never entered into
+ * the table, so drawing a Triangle is O(1) regardless of how many Triangles are masked.
+ */
+class TriangleAliasTable
 {
-  float* vertices = vertex->getVertexPointer(curVertex);
+public:
+  TriangleAliasTable(const double* areas, const bool* mask, int64_t numTris)
+  {
+    for(int64_t i = 0; i < numTris; i++)
+    {
+      if((mask == nullptr || mask[i]) && areas[i] > 0.0)
+      {
+        m_TriIds.push_back(i);
+      }
+    }
 
-  float r1 = dist(gen);
-  float r2 = dist(gen);
+    size_t numEntries = m_TriIds.size();
+    if(numEntries == 0)
+    {
+      return;
+    }
 
-  float prefactorA = 1.0f - sqrtf(r1);
-  float prefactorB = sqrtf(r1) * (1 - r2);
-  float prefactorC = sqrtf(r1) * r2;
+    double totalArea = 0.0;
+    for(const auto& id : m_TriIds)
+    {
+      totalArea += areas[id];
+    }
 
-  vertices[0] = (prefactorA * a[0]) + (prefactorB * b[0]) + (prefactorC * c[0]);
-  vertices[1] = (prefactorA * a[1]) + (prefactorB * b[1]) + (prefactorC * c[1]);
-  vertices[2] = (prefactorA * a[2]) + (prefactorB * b[2]) + (prefactorC * c[2]);
+    m_Probability.resize(numEntries);
+    m_Alias.resize(numEntries);
+    std::vector<double> scaled(numEntries);
+    std::vector<size_t> small;
+    std::vector<size_t> large;
 
-  for(std::vector<IDataArray::WeakPointer>::size_type i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+    for(size_t i = 0; i < numEntries; i++)
+    {
+      scaled[i] = areas[m_TriIds[i]] * static_cast<double>(numEntries) / totalArea;
+      if(scaled[i] < 1.0)
+      {
+        small.push_back(i);
+      }
+      else
+      {
+        large.push_back(i);
+      }
+    }
+
+    while(!small.empty() && !large.empty())
+    {
+      size_t s = small.back();
+      small.pop_back();
+      size_t l = large.back();
+      m_Probability[s] = scaled[s];
+      m_Alias[s] = l;
+      scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+      if(scaled[l] < 1.0)
+      {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+
+    // Anything left over is 1 up to round off
+    for(const auto& l : large)
+    {
+      m_Probability[l] = 1.0;
+      m_Alias[l] = l;
+    }
+    for(const auto& s : small)
+    {
+      m_Probability[s] = 1.0;
+      m_Alias[s] = s;
+    }
+  }
+
+  bool empty() const
   {
-    EXECUTE_FUNCTION_TEMPLATE(this, copyDataToPoints, m_SelectedWeakPtrVector[i].lock(), m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), tri, curVertex)
+    return m_TriIds.empty();
   }
+
+  int64_t sample(double u1, double u2) const
+  {
+    size_t column = std::min(static_cast<size_t>(u1 * static_cast<double>(m_TriIds.size())), m_TriIds.size() - 1);
+    return u2 < m_Probability[column] ? m_TriIds[column] : m_TriIds[m_Alias[column]];
+  }
+
+private:
+  std::vector<int64_t> m_TriIds;
+  std::vector<double> m_Probability;
+  std::vector<size_t> m_Alias;
+};
+
+/**
+ * @brief The SampleTrianglesImpl class draws the sample points for a range of sample indices.
+ */
+class SampleTrianglesImpl
+{
+public:
+  SampleTrianglesImpl(AbstractFilter* filter, const TriangleAliasTable& table, const MeshIndexType* tris, const float* triVerts, float* sampleVerts, int64_t* sampleTriIds, uint64_t seed)
+  : m_Filter(filter)
+  , m_Table(table)
+  , m_Tris(tris)
+  , m_TriVerts(triVerts)
+  , m_SampleVerts(sampleVerts)
+  , m_SampleTriIds(sampleTriIds)
+  , m_Seed(seed)
+  {
+  }
+
+  void compute(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+
+      uint64_t counter = 4 * static_cast<uint64_t>(i);
+      int64_t tri = m_Table.sample(counterUniform(m_Seed, counter), counterUniform(m_Seed, counter + 1));
+      m_SampleTriIds[i] = tri;
+
+      float r1 = sqrtf(static_cast<float>(counterUniform(m_Seed, counter + 2)));
+      float r2 = static_cast<float>(counterUniform(m_Seed, counter + 3));
+
+      float prefactorA = 1.0f - r1;
+      float prefactorB = r1 * (1 - r2);
+      float prefactorC = r1 * r2;
+
+      const float* a = m_TriVerts + 3 * m_Tris[3 * tri + 0];
+      const float* b = m_TriVerts + 3 * m_Tris[3 * tri + 1];
+      const float* c = m_TriVerts + 3 * m_Tris[3 * tri + 2];
+      float* vertices = m_SampleVerts + 3 * i;
+
+      vertices[0] = (prefactorA * a[0]) + (prefactorB * b[0]) + (prefactorC * c[0]);
+      vertices[1] = (prefactorA * a[1]) + (prefactorB * b[1]) + (prefactorC * c[1]);
+      vertices[2] = (prefactorA * a[2]) + (prefactorB * b[2]) + (prefactorC * c[2]);
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    compute(range.min(), range.max());
+  }
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  const TriangleAliasTable& m_Table;
+  const MeshIndexType* m_Tris = nullptr;
+  const float* m_TriVerts = nullptr;
+  float* m_SampleVerts = nullptr;
+  int64_t* m_SampleTriIds = nullptr;
+  uint64_t m_Seed = 0;
+};
+
+/**
+ * @brief The GatherTuplesImpl class copies the source tuple of every sample point into the destination array.
+ */
+template <typename T>
+class GatherTuplesImpl
+{
+public:
+  GatherTuplesImpl(const T* source, T* dest, size_t numComps, const int64_t* sampleTriIds)
+  : m_Source(source)
+  , m_Dest(dest)
+  , m_NumComps(numComps)
+  , m_SampleTriIds(sampleTriIds)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      std::copy_n(m_Source + m_SampleTriIds[i] * m_NumComps, m_NumComps, m_Dest + i * m_NumComps);
+    }
+  }
+
+private:
+  const T* m_Source = nullptr;
+  T* m_Dest = nullptr;
+  size_t m_NumComps = 0;
+  const int64_t* m_SampleTriIds = nullptr;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void copyDataToPoints(IDataArray::Pointer source, IDataArray::Pointer dest, const std::vector<int64_t>& sampleTriIds)
+{
+  typename DataArray<T>::Pointer sourcePtr = std::dynamic_pointer_cast<DataArray<T>>(source);
+  typename DataArray<T>::Pointer destPtr = std::dynamic_pointer_cast<DataArray<T>>(dest);
+
+  assert(sourcePtr->getNumberOfComponents() == destPtr->getNumberOfComponents());
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, sampleTriIds.size());
+  dataAlg.execute(GatherTuplesImpl<T>(sourcePtr->getPointer(0), destPtr->getPointer(0), sourcePtr->getNumberOfComponents(), sampleTriIds.data()));
 }
 
 // -----------------------------------------------------------------------------
@@ -354,6 +549,14 @@ void PointSampleTriangleGeometry::execute()
   TriangleGeom::Pointer triangle = getDataContainerArray()->getDataContainer(m_TriangleGeometry)->getGeometryAs<TriangleGeom>();
   int64_t numTris = triangle->getNumberOfTris();
 
+  TriangleAliasTable aliasTable(m_TriangleAreas, m_UseMask ? m_Mask : nullptr, numTris);
+  if(aliasTable.empty())
+  {
+    QString ss = QObject::tr("There are no Triangles with positive area available to sample");
+    setErrorCondition(-702, ss);
+    return;
+  }
+
   AttributeMatrix::Pointer attrMat = getDataContainerArray()->getDataContainer(m_VertexGeometry)->getAttributeMatrix(m_VertexAttributeMatrixName);
   std::vector<size_t> tDims(1, m_NumSamples);
   attrMat->resizeAttributeArrays(tDims);
@@ -361,70 +564,32 @@ void PointSampleTriangleGeometry::execute()
   VertexGeom::Pointer vertex = getDataContainerArray()->getDataContainer(m_VertexGeometry)->getGeometryAs<VertexGeom>();
   vertex->resizeVertexList(m_NumSamples);
 
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  std::mt19937_64 generator(seed);
-  std::uniform_real_distribution<> distribution(0.0f, 1.0f);
-
-  std::vector<int64_t> triangleIds(numTris);
-  std::iota(std::begin(triangleIds), std::end(triangleIds), 0);
-
-  std::vector<double> triangleWeights(numTris);
-  std::memcpy(triangleWeights.data(), m_TriangleAreas, sizeof(double) * numTris);
+  uint64_t seed = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+  if(m_UseRandomSeed)
+  {
+    seed = m_RandomSeedValue;
+  }
 
-  // VS2013 does not implement the iterator contructor for std::discrete_distribution<>, which
-  // really is a massively idiotic oversight; hack the equivalent using the unary_op constructor
-  std::discrete_distribution<size_t> triangle_distribution(triangleWeights.size(), -0.5, -0.5 + triangleWeights.size(),
-                                                           [&triangleWeights](double index) { return triangleWeights[static_cast<size_t>(index)]; });
+  assert(m_SelectedWeakPtrVector.size() == m_CreatedWeakPtrVector.size());
 
-  int64_t progIncrement = m_NumSamples / 100;
-  int64_t prog = 1;
-  int64_t progressInt = 0;
-  int64_t counter = 0;
+  notifyStatusMessage("Sampling Triangles...");
 
-  float a[3] = {0.0f, 0.0f, 0.0f};
-  float b[3] = {0.0f, 0.0f, 0.0f};
-  float c[3] = {0.0f, 0.0f, 0.0f};
+  std::vector<int64_t> sampleTriIds(m_NumSamples, 0);
 
-  assert(m_SelectedWeakPtrVector.size() == m_CreatedWeakPtrVector.size());
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(m_NumSamples));
+  dataAlg.execute(SampleTrianglesImpl(this, aliasTable, triangle->getTriPointer(0), triangle->getVertexPointer(0), vertex->getVertexPointer(0), sampleTriIds.data(), seed));
 
-  for(int64_t i = 0; i < m_NumSamples; i++)
+  if(getCancel())
   {
-    if(getCancel())
-    {
-      return;
-    }
-
-    int64_t randomTri = 0;
-
-    if(m_UseMask)
-    {
-      while(true)
-      {
-        randomTri = triangle_distribution(generator);
-        assert(randomTri < numTris && randomTri >= 0);
-        if(m_Mask[randomTri])
-        {
-          break;
-        }
-      }
-    }
-    else
-    {
-      randomTri = triangle_distribution(generator);
-      assert(randomTri < numTris && randomTri >= 0);
-    }
+    return;
+  }
 
-    triangle->getVertCoordsAtTri(randomTri, a, b, c);
-    sampleTriangle(a, b, c, i, vertex, randomTri, generator, distribution);
+  notifyStatusMessage("Transferring Attribute Arrays...");
 
-    if(counter > prog)
-    {
-      progressInt = static_cast<int64_t>((static_cast<float>(counter) / m_NumSamples) * 100.0f);
-      QString ss = QObject::tr("Sampling Triangles || %1% Completed").arg(progressInt);
-      notifyStatusMessage(ss);
-      prog = prog + progIncrement;
-    }
-    counter++;
+  for(std::vector<IDataArray::WeakPointer>::size_type i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+  {
+    EXECUTE_FUNCTION_TEMPLATE(this, copyDataToPoints, m_SelectedWeakPtrVector[i].lock(), m_SelectedWeakPtrVector[i].lock(), m_CreatedWeakPtrVector[i].lock(), sampleTriIds)
   }
 }
 
@@ -637,6 +802,30 @@ DataArrayPath PointSampleTriangleGeometry::getMaskArrayPath() const
   return m_MaskArrayPath;
 }
 
+// -----------------------------------------------------------------------------
+void PointSampleTriangleGeometry::setUseRandomSeed(bool value)
+{
+  m_UseRandomSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PointSampleTriangleGeometry::getUseRandomSeed() const
+{
+  return m_UseRandomSeed;
+}
+
+// -----------------------------------------------------------------------------
+void PointSampleTriangleGeometry::setRandomSeedValue(uint64_t value)
+{
+  m_RandomSeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+uint64_t PointSampleTriangleGeometry::getRandomSeedValue() const
+{
+  return m_RandomSeedValue;
+}
+
 // -----------------------------------------------------------------------------
 void PointSampleTriangleGeometry::setSelectedDataArrayPaths(const std::vector<DataArrayPath>& value)
 {
@@ -37,8 +37,6 @@
 
 #include <memory>
 
-#include <random>
-
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
@@ -68,6 +66,8 @@ class DREAM3DReview_EXPORT PointSampleTriangleGeometry : public AbstractFilter
   PYB11_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
   PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
   PYB11_PROPERTY(std::vector<DataArrayPath> SelectedDataArrayPaths READ getSelectedDataArrayPaths WRITE setSelectedDataArrayPaths)
+  PYB11_PROPERTY(bool UseRandomSeed READ getUseRandomSeed WRITE setUseRandomSeed)
+  PYB11_PROPERTY(uint64_t RandomSeedValue READ getRandomSeedValue WRITE setRandomSeedValue)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -191,6 +191,28 @@ public:
   DataArrayPath getMaskArrayPath() const;
   Q_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
 
+  /**
+   * @brief Setter property for UseRandomSeed
+   */
+  void setUseRandomSeed(bool value);
+  /**
+   * @brief Getter property for UseRandomSeed
+   * @return Value of UseRandomSeed
+   */
+  bool getUseRandomSeed() const;
+  Q_PROPERTY(bool UseRandomSeed READ getUseRandomSeed WRITE setUseRandomSeed)
+
+  /**
+   * @brief Setter property for RandomSeedValue
+   */
+  void setRandomSeedValue(uint64_t value);
+  /**
+   * @brief Getter property for RandomSeedValue
+   * @return Value of RandomSeedValue
+   */
+  uint64_t getRandomSeedValue() const;
+  Q_PROPERTY(uint64_t RandomSeedValue READ getRandomSeedValue WRITE setRandomSeedValue)
+
   /**
    * @brief Setter property for SelectedDataArrayPaths
    */
@@ -265,8 +287,6 @@ public:
 protected:
   PointSampleTriangleGeometry();
 
-  void sampleTriangle(float a[3], float b[3], float c[3], int64_t curVertex, VertexGeom::Pointer vertex, int64_t tri, std::mt19937_64& gen, std::uniform_real_distribution<>& dist);
-
   /**
    * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
    */
@@ -292,6 +312,8 @@ private:
   DataArrayPath m_TriangleAreasArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceAreas};
   bool m_UseMask = {false};
   DataArrayPath m_MaskArrayPath = {"", "", ""};
+  bool m_UseRandomSeed = {false};
+  uint64_t m_RandomSeedValue = {0};
   std::vector<DataArrayPath> m_SelectedDataArrayPaths = {};
 
   std::vector<IDataArray::WeakPointer> m_SelectedWeakPtrVector;
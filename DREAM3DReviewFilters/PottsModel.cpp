@@ -34,22 +34,35 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "PottsModel.h"
 
+#include <atomic>
 #include <chrono>
-#include <deque>
 #include <exception>
+#include <fstream>
+#include <limits>
 #include <random>
+#include <sstream>
+#include <string>
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
+#include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/UInt64FilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
@@ -60,12 +73,129 @@ using Neighborhood = std::vector<std::array<int8_t, 3>>;
 
 const double BOLTZMANN = 1.38064852e-23;
 
+constexpr int32_t k_RandomSiteScheme = 0;
+constexpr int32_t k_CheckerboardScheme = 1;
+constexpr int32_t k_BoundarySiteScheme = 2;
+
+constexpr size_t k_MaxNeighbors = 26;
+using NeighborList = std::array<size_t, k_MaxNeighbors>;
+
 enum class Dimension : uint8_t
 {
   Two,
   Three
 };
 
+/**
+ * @brief The CounterGenerator class is a SplitMix64 stream keyed on a seed and a stream id. Keying each
+ * site visit on (seed, sweep, site) makes the random numbers independent of how the sweep is split into
+ * threads, so parallel runs are reproducible for a given seed.
+ */
+class CounterGenerator
+{
+public:
+  using result_type = uint64_t;
+
+  CounterGenerator(uint64_t seed, uint64_t stream)
+  : state_(mix(seed + mix(stream)))
+  {
+  }
+
+  static constexpr result_type min()
+  {
+    return 0;
+  }
+
+  static constexpr result_type max()
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()()
+  {
+    state_ += 0x9E3779B97F4A7C15ULL;
+    return mix(state_);
+  }
+
+private:
+  static uint64_t mix(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t state_;
+};
+
+/**
+ * @brief The ActiveSiteSet class is a sparse set of lattice sites with O(1) insertion, removal, membership
+ * test and uniform random access.
+ */
+class ActiveSiteSet
+{
+public:
+  explicit ActiveSiteSet(size_t numSites)
+  : positions_(numSites, k_NotInSet)
+  {
+  }
+
+  void update(size_t site, bool active)
+  {
+    bool contained = positions_[site] != k_NotInSet;
+    if(active && !contained)
+    {
+      positions_[site] = sites_.size();
+      sites_.push_back(site);
+    }
+    else if(!active && contained)
+    {
+      size_t last = sites_.back();
+      sites_[positions_[site]] = last;
+      positions_[last] = positions_[site];
+      sites_.pop_back();
+      positions_[site] = k_NotInSet;
+    }
+  }
+
+  size_t size() const
+  {
+    return sites_.size();
+  }
+
+  size_t operator[](size_t i) const
+  {
+    return sites_[i];
+  }
+
+  const std::vector<size_t>& sites() const
+  {
+    return sites_;
+  }
+
+  /**
+   * @brief Replaces the contents of the set with the given sites, keeping their order
+   */
+  void assign(const std::vector<size_t>& sites)
+  {
+    for(const auto& site : sites_)
+    {
+      positions_[site] = k_NotInSet;
+    }
+    sites_ = sites;
+    for(size_t i = 0; i < sites_.size(); i++)
+    {
+      positions_[sites_[i]] = i;
+    }
+  }
+
+private:
+  static constexpr size_t k_NotInSet = std::numeric_limits<size_t>::max();
+
+  std::vector<size_t> sites_;
+  std::vector<size_t> positions_;
+};
+
 class SpinLattice
 {
 public:
@@ -81,53 +211,167 @@ public:
 
   virtual ~SpinLattice() = default;
 
-  void attempt_flip(size_t index)
+  /**
+   * @brief Attempts to flip the spin at index to the spin of a random valid neighbor
+   * @param index
+   * @param gen
+   * @return Whether the spin was flipped
+   */
+  template <typename Generator>
+  bool attempt_flip(size_t index, Generator& gen)
   {
     int32_t spin = fIds_[index];
-    std::deque<size_t> neighbors = valid_neighbor_query(index);
+    NeighborList neighbors;
+    size_t numNeighbors = valid_neighbor_query(index, neighbors);
 
-    auto same = std::count_if(std::begin(neighbors), std::end(neighbors), [&](size_t& idx) { return spin == fIds_[idx]; });
+    auto same = std::count_if(neighbors.begin(), neighbors.begin() + numNeighbors, [&](size_t idx) { return spin == fIds_[idx]; });
 
-    if(same == neighbors.size())
+    if(static_cast<size_t>(same) == numNeighbors)
     {
-      return;
+      return false;
     }
 
-    size_t rand_neighbor = random_neighbor(neighbors);
-    int32_t candidate = fIds_[rand_neighbor];
+    std::uniform_int_distribution<size_t> ndist(0, numNeighbors - 1);
+    int32_t candidate = fIds_[neighbors[ndist(gen)]];
 
-    if(candidate == 0)
+    if(candidate == 0 || spin == candidate)
     {
-      return;
+      return false;
     }
 
-    if(spin != candidate)
+    double dE = 0.0;
+    for(size_t n = 0; n < numNeighbors; n++)
     {
-      double dE = 0.0;
-      for(auto&& neighbor : neighbors)
+      int32_t neighbor = fIds_[neighbors[n]];
+      double a = (neighbor != candidate) ? 1.0 : 0.0;
+      double b = (neighbor != spin) ? 1.0 : 0.0;
+      dE += (a - b);
+    }
+    dE *= 0.5;
+    if(dE > 0.0)
+    {
+      std::uniform_real_distribution<double> dist(0.0, 1.0);
+      if(dist(gen) >= std::exp(-dE / kT_))
       {
-        int32_t n = fIds_[neighbor];
-        double a = (n != candidate) ? 1.0 : 0.0;
-        double b = (n != spin) ? 1.0 : 0.0;
-        dE += (a - b);
+        return false;
       }
-      dE *= 0.5;
-      if(dE <= 0.0)
+    }
+
+    fIds_[index] = candidate;
+    return true;
+  }
+
+  /**
+   * @brief Visits every active site of one sublattice color in the rows [rowStart, rowEnd). No two sites of the
+   * same color are neighbors, so disjoint row ranges of one color may be swept concurrently.
+   * @param color
+   * @param sweep
+   * @param seed
+   * @param rowStart
+   * @param rowEnd
+   * @return Number of flipped spins
+   */
+  size_t sweep_color(size_t color, uint64_t sweep, uint64_t seed, size_t rowStart, size_t rowEnd)
+  {
+    const size_t cx = color % num_axis_colors_[0];
+    const size_t cy = (color / num_axis_colors_[0]) % num_axis_colors_[1];
+    const size_t cz = color / (num_axis_colors_[0] * num_axis_colors_[1]);
+    const uint64_t numSites = dims_[0] * dims_[1] * dims_[2];
+
+    size_t flips = 0;
+    for(size_t row = rowStart; row < rowEnd; row++)
+    {
+      size_t y = row % dims_[1];
+      size_t z = row / dims_[1];
+      if(axis_color(y, 1) != cy || axis_color(z, 2) != cz)
       {
-        fIds_[index] = candidate;
-        total_flips_++;
+        continue;
       }
-      else
+      size_t rowIndex = row * dims_[0];
+      for(size_t x = (cx == 2) ? dims_[0] - 1 : cx; x < dims_[0]; x += 2)
       {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double r = dist(gen_);
-        if(r < std::exp(-dE / kT_))
+        size_t index = rowIndex + x;
+        if(axis_color(x, 0) != cx || fIds_[index] == 0 || (mask_ != nullptr && !mask_[index]))
+        {
+          continue;
+        }
+        CounterGenerator gen(seed, sweep * numSites + index);
+        if(attempt_flip(index, gen))
         {
-          fIds_[index] = candidate;
-          total_flips_++;
+          flips++;
         }
       }
     }
+    return flips;
+  }
+
+  /**
+   * @brief Returns whether the site at index could flip, i.e. it takes part in the simulation and at least
+   * one of its valid neighbors has a different spin
+   */
+  bool is_active(size_t index) const
+  {
+    if(fIds_[index] == 0 || (mask_ != nullptr && !mask_[index]))
+    {
+      return false;
+    }
+    NeighborList neighbors;
+    size_t numNeighbors = valid_neighbor_query(index, neighbors);
+    return std::any_of(neighbors.begin(), neighbors.begin() + numNeighbors, [&](size_t idx) { return fIds_[idx] != fIds_[index]; });
+  }
+
+  /**
+   * @brief Fills the set with all active sites and returns the number of sites that take part in the simulation
+   */
+  size_t collect_active_sites(ActiveSiteSet& active) const
+  {
+    const size_t numSites = dims_[0] * dims_[1] * dims_[2];
+    size_t numEligible = 0;
+    for(size_t index = 0; index < numSites; index++)
+    {
+      if(fIds_[index] == 0 || (mask_ != nullptr && !mask_[index]))
+      {
+        continue;
+      }
+      numEligible++;
+      active.update(index, is_active(index));
+    }
+    return numEligible;
+  }
+
+  /**
+   * @brief Refreshes the active state of a flipped site and of its neighbors, the only sites a flip can affect
+   */
+  void update_active_sites(size_t index, ActiveSiteSet& active) const
+  {
+    NeighborList neighbors;
+    size_t numNeighbors = valid_neighbor_query(index, neighbors);
+    active.update(index, is_active(index));
+    for(size_t n = 0; n < numNeighbors; n++)
+    {
+      active.update(neighbors[n], is_active(neighbors[n]));
+    }
+  }
+
+  /**
+   * @brief Returns the number of sublattice colors needed so that no two neighboring sites share a color
+   */
+  size_t num_colors() const
+  {
+    return num_axis_colors_[0] * num_axis_colors_[1] * num_axis_colors_[2];
+  }
+
+  /**
+   * @brief Returns the number of lattice rows along X
+   */
+  size_t num_rows() const
+  {
+    return dims_[1] * dims_[2];
+  }
+
+  void add_flips(size_t flips)
+  {
+    total_flips_ += flips;
   }
 
   size_t total_flips()
@@ -141,66 +385,76 @@ public:
   }
 
 private:
-  size_t random_neighbor(std::deque<size_t>& neighbors)
+  /**
+   * @brief Fills neighbors with the valid neighbors of index and returns how many there are. Interior sites
+   * use the precomputed stencil offsets; only sites on the lattice surface need the boundary handling.
+   */
+  size_t valid_neighbor_query(size_t index, NeighborList& neighbors) const
   {
-    std::uniform_int_distribution<size_t> dist(0, neighbors.size() - 1);
-    return neighbors[dist(gen_)];
-  }
-
-  std::deque<size_t> valid_neighbor_query(size_t index)
-  {
-    std::deque<size_t> neighbors;
+    size_t count = 0;
 
     size_t x = index % dims_[0];
     size_t y = (index / dims_[0]) % dims_[1];
     size_t z = index / (dims_[0] * dims_[1]);
 
+    bool interior = (x > 0 && x + 1 < dims_[0]) && (y > 0 && y + 1 < dims_[1]) && (dim_type_ == Dimension::Two || (z > 0 && z + 1 < dims_[2]));
+    if(interior)
+    {
+      for(size_t n = 0; n < neighborhood_.size(); n++)
+      {
+        size_t neigh = static_cast<size_t>(static_cast<int64_t>(index) + stencil_[n]);
+        if(mask_ == nullptr || mask_[neigh])
+        {
+          neighbors[count++] = neigh;
+        }
+      }
+      return count;
+    }
+
     for(auto&& neighbor : neighborhood_)
     {
+      size_t neigh = 0;
       if(periodic_)
       {
         size_t modx = apply_modular_operation(x, neighbor[0], dims_[0]);
         size_t mody = apply_modular_operation(y, neighbor[1], dims_[1]);
         size_t modz = apply_modular_operation(z, neighbor[2], dims_[2]);
-        size_t neigh = neighbor_index(modx, mody, modz);
-        if(mask_ != nullptr)
-        {
-          if(mask_[neigh])
-          {
-            neighbors.push_back(neigh);
-          }
-        }
-        else
-        {
-          neighbors.push_back(neigh);
-        }
+        neigh = neighbor_index(modx, mody, modz);
       }
       else
       {
         int64_t modx = static_cast<int64_t>(x) + neighbor[0];
         int64_t mody = static_cast<int64_t>(y) + neighbor[1];
         int64_t modz = static_cast<int64_t>(z) + neighbor[2];
-        if((modx >= 0 && modx < static_cast<int64_t>(dims_[0])) && (mody >= 0 && mody < static_cast<int64_t>(dims_[1])) && (modz >= 0 && modz < static_cast<int64_t>(dims_[2])))
+        if(modx < 0 || modx >= static_cast<int64_t>(dims_[0]) || mody < 0 || mody >= static_cast<int64_t>(dims_[1]) || modz < 0 || modz >= static_cast<int64_t>(dims_[2]))
         {
-          size_t neigh = neighbor_index(modx, mody, modz);
-          if(mask_ != nullptr)
-          {
-            if(mask_[neigh])
-            {
-              neighbors.push_back(neigh);
-            }
-          }
-          else
-          {
-            neighbors.push_back(neigh);
-          }
+          continue;
         }
+        neigh = neighbor_index(modx, mody, modz);
+      }
+      if(mask_ == nullptr || mask_[neigh])
+      {
+        neighbors[count++] = neigh;
       }
     }
-    return neighbors;
+    return count;
+  }
+
+  /**
+   * @brief Returns the sublattice color of a coordinate along one axis. Alternating coordinates get colors 0
+   * and 1; with periodic boundaries and an odd dimension the last layer wraps onto the first one, so it gets
+   * its own color 2.
+   */
+  size_t axis_color(size_t coord, size_t axis) const
+  {
+    if(num_axis_colors_[axis] == 3 && coord == dims_[axis] - 1)
+    {
+      return 2;
+    }
+    return coord % 2;
   }
 
-  size_t modular_subtraction(size_t a, size_t b, size_t m)
+  size_t modular_subtraction(size_t a, size_t b, size_t m) const
   {
     if(a >= b)
     {
@@ -210,7 +464,7 @@ private:
     return m - b + a;
   }
 
-  size_t modular_addition(size_t a, size_t b, size_t m)
+  size_t modular_addition(size_t a, size_t b, size_t m) const
   {
     if(b == 0)
     {
@@ -225,7 +479,7 @@ private:
     return m - b + a;
   }
 
-  size_t apply_modular_operation(size_t a, int8_t b, size_t m)
+  size_t apply_modular_operation(size_t a, int8_t b, size_t m) const
   {
     if(b < 0)
     {
@@ -238,7 +492,7 @@ private:
   }
 
   template <typename T>
-  size_t neighbor_index(T x, T y, T z)
+  size_t neighbor_index(T x, T y, T z) const
   {
     size_t neigh = 0;
     switch(dim_type_)
@@ -263,10 +517,9 @@ private:
   {
     determine_dimensionality();
     generate_neighborhood();
+    generate_stencil();
     kT_ = BOLTZMANN * temperature_;
     total_flips_ = 0;
-    seed_ = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    gen_.seed(seed_);
   }
 
   // -----------------------------------------------------------------------------
@@ -306,6 +559,18 @@ private:
         dims_[2] = 1;
       }
     }
+
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      if(dims_[axis] == 1)
+      {
+        num_axis_colors_[axis] = 1;
+      }
+      else
+      {
+        num_axis_colors_[axis] = (periodic_ && dims_[axis] % 2 == 1) ? 3 : 2;
+      }
+    }
   }
 
   void generate_neighborhood()
@@ -328,19 +593,180 @@ private:
     }
   }
 
+  void generate_stencil()
+  {
+    const int64_t strides[3] = {1, static_cast<int64_t>(dims_[0]), static_cast<int64_t>(dims_[0] * dims_[1])};
+    for(size_t n = 0; n < neighborhood_.size(); n++)
+    {
+      stencil_[n] = neighborhood_[n][0] * strides[0] + neighborhood_[n][1] * strides[1] + neighborhood_[n][2] * strides[2];
+    }
+  }
+
   ImageGeom::Pointer image_;
   double temperature_;
   double kT_{};
   bool periodic_;
   Neighborhood neighborhood_;
+  std::array<int64_t, k_MaxNeighbors> stencil_{};
   int32_t* fIds_;
   bool* mask_;
   size_t dims_[3]{};
+  size_t num_axis_colors_[3]{};
   Dimension dim_type_;
-  size_t total_flips_{};
-  std::mt19937_64::result_type seed_{};
-  std::mt19937_64 gen_;
+  std::atomic<size_t> total_flips_{};
+};
+
+/**
+ * @brief The CheckerboardSweepImpl class sweeps one sublattice color over a range of lattice rows
+ */
+class CheckerboardSweepImpl
+{
+public:
+  CheckerboardSweepImpl(SpinLattice& lattice, size_t color, uint64_t sweep, uint64_t seed)
+  : m_Lattice(lattice)
+  , m_Color(color)
+  , m_Sweep(sweep)
+  , m_Seed(seed)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t flips = m_Lattice.sweep_color(m_Color, m_Sweep, m_Seed, range.min(), range.max());
+    m_Lattice.add_flips(flips);
+  }
+
+private:
+  SpinLattice& m_Lattice;
+  size_t m_Color = 0;
+  uint64_t m_Sweep = 0;
+  uint64_t m_Seed = 0;
 };
+
+/**
+ * @brief The PottsCheckpoint struct holds everything besides the Feature Ids that is needed to continue a
+ * simulation exactly where it stopped
+ */
+struct PottsCheckpoint
+{
+  int32_t updateScheme = 0;
+  uint64_t seed = 0;
+  int64_t completedIterations = 0;
+  uint64_t totalFlips = 0;
+  std::string generatorState;
+  std::vector<size_t> activeSites;
+};
+
+const char k_CheckpointMagic[8] = {'D', '3', 'D', 'P', 'O', 'T', 'T', 'S'};
+constexpr uint32_t k_CheckpointVersion = 1;
+
+/**
+ * @brief Writes the checkpoint and the Feature Ids to a binary file. The file is written under a temporary
+ * name first and then renamed, so an interrupted write never replaces the previous checkpoint.
+ * @return Whether the file was written
+ */
+bool WriteCheckpoint(const QString& filePath, const PottsCheckpoint& checkpoint, const int32_t* featureIds, size_t numSites)
+{
+  QFileInfo fi(filePath);
+  QDir parentPath(fi.path());
+  if(!parentPath.mkpath("."))
+  {
+    return false;
+  }
+
+  QString tempFilePath = filePath + ".tmp";
+  {
+    std::ofstream outFile(tempFilePath.toStdString(), std::ios_base::binary | std::ios_base::trunc);
+    if(!outFile.is_open())
+    {
+      return false;
+    }
+    uint64_t numSites64 = numSites;
+    uint64_t stateLength = checkpoint.generatorState.size();
+    uint64_t numActive = checkpoint.activeSites.size();
+    outFile.write(k_CheckpointMagic, sizeof(k_CheckpointMagic));
+    outFile.write(reinterpret_cast<const char*>(&k_CheckpointVersion), sizeof(k_CheckpointVersion));
+    outFile.write(reinterpret_cast<const char*>(&numSites64), sizeof(numSites64));
+    outFile.write(reinterpret_cast<const char*>(&checkpoint.updateScheme), sizeof(checkpoint.updateScheme));
+    outFile.write(reinterpret_cast<const char*>(&checkpoint.seed), sizeof(checkpoint.seed));
+    outFile.write(reinterpret_cast<const char*>(&checkpoint.completedIterations), sizeof(checkpoint.completedIterations));
+    outFile.write(reinterpret_cast<const char*>(&checkpoint.totalFlips), sizeof(checkpoint.totalFlips));
+    outFile.write(reinterpret_cast<const char*>(&stateLength), sizeof(stateLength));
+    outFile.write(checkpoint.generatorState.data(), stateLength);
+    outFile.write(reinterpret_cast<const char*>(&numActive), sizeof(numActive));
+    for(const auto& site : checkpoint.activeSites)
+    {
+      uint64_t site64 = site;
+      outFile.write(reinterpret_cast<const char*>(&site64), sizeof(site64));
+    }
+    outFile.write(reinterpret_cast<const char*>(featureIds), numSites * sizeof(int32_t));
+    if(!outFile.good())
+    {
+      return false;
+    }
+  }
+
+  QFile::remove(filePath);
+  return QFile::rename(tempFilePath, filePath);
+}
+
+/**
+ * @brief Reads a checkpoint written by WriteCheckpoint and restores the Feature Ids from it
+ * @return Whether the file was read and matches the number of lattice sites
+ */
+bool ReadCheckpoint(const QString& filePath, PottsCheckpoint& checkpoint, int32_t* featureIds, size_t numSites)
+{
+  std::ifstream inFile(filePath.toStdString(), std::ios_base::binary);
+  if(!inFile.is_open())
+  {
+    return false;
+  }
+
+  char magic[8] = {0};
+  uint32_t version = 0;
+  uint64_t numSites64 = 0;
+  inFile.read(magic, sizeof(magic));
+  inFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+  inFile.read(reinterpret_cast<char*>(&numSites64), sizeof(numSites64));
+  if(!inFile.good() || !std::equal(std::begin(magic), std::end(magic), std::begin(k_CheckpointMagic)) || version != k_CheckpointVersion || numSites64 != numSites)
+  {
+    return false;
+  }
+
+  uint64_t stateLength = 0;
+  inFile.read(reinterpret_cast<char*>(&checkpoint.updateScheme), sizeof(checkpoint.updateScheme));
+  inFile.read(reinterpret_cast<char*>(&checkpoint.seed), sizeof(checkpoint.seed));
+  inFile.read(reinterpret_cast<char*>(&checkpoint.completedIterations), sizeof(checkpoint.completedIterations));
+  inFile.read(reinterpret_cast<char*>(&checkpoint.totalFlips), sizeof(checkpoint.totalFlips));
+  inFile.read(reinterpret_cast<char*>(&stateLength), sizeof(stateLength));
+  if(!inFile.good())
+  {
+    return false;
+  }
+  checkpoint.generatorState.resize(stateLength);
+  inFile.read(&checkpoint.generatorState[0], stateLength);
+
+  uint64_t numActive = 0;
+  inFile.read(reinterpret_cast<char*>(&numActive), sizeof(numActive));
+  if(!inFile.good() || numActive > numSites)
+  {
+    return false;
+  }
+  checkpoint.activeSites.resize(numActive);
+  for(auto& site : checkpoint.activeSites)
+  {
+    uint64_t site64 = 0;
+    inFile.read(reinterpret_cast<char*>(&site64), sizeof(site64));
+    if(site64 >= numSites)
+    {
+      return false;
+    }
+    site = site64;
+  }
+
+  inFile.read(reinterpret_cast<char*>(featureIds), numSites * sizeof(int32_t));
+  return inFile.good();
+}
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -375,7 +801,28 @@ void PottsModel::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Iterations", Iterations, FilterParameter::Category::Parameter, PottsModel));
   parameters.push_back(SIMPL_NEW_DOUBLE_FP("Temperature", Temperature, FilterParameter::Category::Parameter, PottsModel));
   parameters.push_back(SIMPL_NEW_BOOL_FP("Periodic Boundaries", PeriodicBoundaries, FilterParameter::Category::Parameter, PottsModel));
-  std::vector<QString> linkedProps = {"MaskArrayPath"};
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Update Scheme");
+    parameter->setPropertyName("UpdateScheme");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(PottsModel, this, UpdateScheme));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(PottsModel, this, UpdateScheme));
+    std::vector<QString> choices = {"Random Site", "Checkerboard (Parallel)", "Boundary Sites Only"};
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
+  std::vector<QString> linkedProps = {"RandomSeedValue"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Random Seed", UseRandomSeed, FilterParameter::Category::Parameter, PottsModel, linkedProps));
+  parameters.push_back(SIMPL_NEW_UINT64_FP("Random Seed Value", RandomSeedValue, FilterParameter::Category::Parameter, PottsModel));
+  linkedProps = {"CheckpointInterval", "CheckpointFile"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Write Checkpoints", WriteCheckpoints, FilterParameter::Category::Parameter, PottsModel, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Checkpoint Interval (Iterations)", CheckpointInterval, FilterParameter::Category::Parameter, PottsModel));
+  parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Checkpoint File", CheckpointFile, FilterParameter::Category::Parameter, PottsModel, "*.ckpt", "Potts Model Checkpoint"));
+  linkedProps = {"ResumeCheckpointFile"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Resume From Checkpoint", ResumeFromCheckpoint, FilterParameter::Category::Parameter, PottsModel, linkedProps));
+  parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Resume Checkpoint File", ResumeCheckpointFile, FilterParameter::Category::Parameter, PottsModel, "*.ckpt"));
+  linkedProps = {"MaskArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask", UseMask, FilterParameter::Category::Parameter, PottsModel, linkedProps));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -406,6 +853,37 @@ void PottsModel::dataCheck()
     setErrorCondition(-5555, ss);
   }
 
+  if(getUpdateScheme() < k_RandomSiteScheme || getUpdateScheme() > k_BoundarySiteScheme)
+  {
+    QString ss = QObject::tr("Invalid update scheme selected");
+    setErrorCondition(-5556, ss);
+  }
+
+  if(getWriteCheckpoints())
+  {
+    if(getCheckpointInterval() < 1)
+    {
+      QString ss = QObject::tr("Checkpoint interval must be greater than 0");
+      setErrorCondition(-5557, ss);
+    }
+    FileSystemPathHelper::CheckOutputFile(this, "Checkpoint File", getCheckpointFile(), true);
+  }
+
+  if(getResumeFromCheckpoint())
+  {
+    QFileInfo fi(getResumeCheckpointFile());
+    if(getResumeCheckpointFile().isEmpty())
+    {
+      QString ss = QObject::tr("The checkpoint file to resume from must be set");
+      setErrorCondition(-5558, ss);
+    }
+    else if(!fi.exists() || !fi.isFile())
+    {
+      QString ss = QObject::tr("The checkpoint file to resume from does not exist");
+      setErrorCondition(-5559, ss);
+    }
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getFeatureIdsArrayPath().getDataContainerName());
 
   if(getErrorCode() < 0)
@@ -459,13 +937,16 @@ void PottsModel::execute()
   ImageGeom::Pointer image = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getGeometryAs<ImageGeom>();
 
   size_t numTuples = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  const size_t numSites = numTuples;
   size_t rangeMin = 0;
   size_t rangeMax = numTuples - 1;
-  size_t numNeighbors = 5;
   std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
+  if(m_UseRandomSeed)
+  {
+    seed = static_cast<std::mt19937_64::result_type>(m_RandomSeedValue);
+  }
   std::mt19937_64 gen(seed);
   std::uniform_int_distribution<size_t> dist(rangeMin, rangeMax);
-  std::uniform_int_distribution<size_t> ndist(rangeMin, numNeighbors);
 
   if(m_UseMask)
   {
@@ -482,58 +963,163 @@ void PottsModel::execute()
 
   SpinLattice lattice(image, m_Temperature, m_PeriodicBoundaries, m_FeatureIds, m_Mask);
 
-  int64_t iter = 0;
+  int64_t startIter = 0;
+  PottsCheckpoint checkpoint;
+  if(m_ResumeFromCheckpoint)
+  {
+    if(!ReadCheckpoint(getResumeCheckpointFile(), checkpoint, m_FeatureIds, numSites))
+    {
+      QString ss = QObject::tr("Could not read checkpoint file '%1', or it does not match the selected Feature Ids").arg(getResumeCheckpointFile());
+      setErrorCondition(-5562, ss);
+      return;
+    }
+    if(checkpoint.updateScheme != m_UpdateScheme)
+    {
+      QString ss = QObject::tr("Checkpoint file '%1' was written with a different update scheme").arg(getResumeCheckpointFile());
+      setErrorCondition(-5563, ss);
+      return;
+    }
+    seed = checkpoint.seed;
+    std::istringstream generatorState(checkpoint.generatorState);
+    generatorState >> gen;
+    startIter = checkpoint.completedIterations;
+    lattice.add_flips(checkpoint.totalFlips);
+  }
+
+  ActiveSiteSet active(m_UpdateScheme == k_BoundarySiteScheme ? numSites : 0);
+  // Picking uniformly among all eligible sites only changes a spin when the pick lands on a boundary site,
+  // so the boundary site scheme draws from the boundary sites directly and advances the time by the expected
+  // number of picks that the random site scheme would have needed to hit one
+  double timeScale = 1.0;
+  if(m_UpdateScheme == k_BoundarySiteScheme)
+  {
+    size_t numEligible = lattice.collect_active_sites(active);
+    timeScale = static_cast<double>(numEligible) / static_cast<double>(numTuples);
+    if(m_ResumeFromCheckpoint)
+    {
+      // Restore the order of the list as well, so that the resumed run draws the same sites
+      active.assign(checkpoint.activeSites);
+    }
+  }
+
+  auto saveCheckpoint = [&](int64_t completedIterations) {
+    checkpoint.updateScheme = m_UpdateScheme;
+    checkpoint.seed = seed;
+    checkpoint.completedIterations = completedIterations;
+    checkpoint.totalFlips = lattice.total_flips();
+    std::ostringstream generatorState;
+    generatorState << gen;
+    checkpoint.generatorState = generatorState.str();
+    checkpoint.activeSites = active.sites();
+    if(!WriteCheckpoint(getCheckpointFile(), checkpoint, m_FeatureIds, numSites))
+    {
+      QString ss = QObject::tr("Could not write checkpoint file '%1'").arg(getCheckpointFile());
+      setErrorCondition(-5564, ss);
+      return false;
+    }
+    return true;
+  };
+
   int64_t progPercent = (lattice.dimension() == Dimension::Two) ? 10 : 100;
   int64_t progIncrement = numTuples / progPercent;
 
-  while(iter < m_Iterations)
+  for(int64_t iter = startIter; iter < m_Iterations; iter++)
   {
     if(getCancel())
     {
+      // Cancelling only happens between iterations, so the saved state resumes exactly where this run stopped
+      if(m_WriteCheckpoints)
+      {
+        saveCheckpoint(iter);
+      }
       return;
     }
 
-    int64_t prog = 1;
-    int64_t progressInt = 0;
-    int64_t counter = 0;
-
-    for(size_t i = 0; i < numTuples; i++)
+    if(m_UpdateScheme == k_CheckerboardScheme)
     {
-      size_t current = 0;
+      // Each iteration visits every active site once, one sublattice color at a time
+      for(size_t color = 0; color < lattice.num_colors(); color++)
+      {
+        ParallelDataAlgorithm dataAlg;
+        dataAlg.setRange(0, lattice.num_rows());
+        dataAlg.execute(CheckerboardSweepImpl(lattice, color, static_cast<uint64_t>(iter), seed));
+      }
 
-      while(true)
+      QString ss = QObject::tr("Iteration %1 of %2 || %3 Total Flips").arg(iter + 1).arg(m_Iterations).arg(lattice.total_flips());
+      notifyStatusMessage(ss);
+    }
+    else if(m_UpdateScheme == k_BoundarySiteScheme)
+    {
+      double time = 0.0;
+      while(time < 1.0 && active.size() > 0)
       {
-        current = dist(gen);
-        if(m_FeatureIds[current] == 0)
+        std::uniform_int_distribution<size_t> adist(0, active.size() - 1);
+        size_t current = active[adist(gen)];
+        time += timeScale / static_cast<double>(active.size());
+        if(lattice.attempt_flip(current, gen))
         {
-          continue;
+          lattice.add_flips(1);
+          lattice.update_active_sites(current, active);
         }
-        if(m_UseMask)
+      }
+
+      QString ss = QObject::tr("Iteration %1 of %2 || %3 Boundary Sites || %4 Total Flips").arg(iter + 1).arg(m_Iterations).arg(active.size()).arg(lattice.total_flips());
+      notifyStatusMessage(ss);
+    }
+    else
+    {
+      int64_t prog = 1;
+      int64_t progressInt = 0;
+      int64_t counter = 0;
+
+      for(size_t i = 0; i < numTuples; i++)
+      {
+        size_t current = 0;
+
+        while(true)
         {
-          if(!m_Mask[current])
+          current = dist(gen);
+          if(m_FeatureIds[current] == 0)
           {
             continue;
           }
+          if(m_UseMask)
+          {
+            if(!m_Mask[current])
+            {
+              continue;
+            }
+          }
+          break;
         }
-        break;
-      }
 
-      lattice.attempt_flip(current);
+        if(lattice.attempt_flip(current, gen))
+        {
+          lattice.add_flips(1);
+        }
 
-      if(counter > prog)
-      {
-        progressInt = static_cast<int64_t>((static_cast<float>(counter) / numTuples) * static_cast<float>(progPercent));
-        if(lattice.dimension() == Dimension::Two)
+        if(counter > prog)
         {
-          progressInt *= 10;
+          progressInt = static_cast<int64_t>((static_cast<float>(counter) / numTuples) * static_cast<float>(progPercent));
+          if(lattice.dimension() == Dimension::Two)
+          {
+            progressInt *= 10;
+          }
+          QString ss = QObject::tr("Iteration %1 of %2 || %3% Completed || %4 Total Flips").arg(iter + 1).arg(m_Iterations).arg(progressInt).arg(lattice.total_flips());
+          notifyStatusMessage(ss);
+          prog = prog + progIncrement;
         }
-        QString ss = QObject::tr("Iteration %1 of %2 || %3% Completed || %4 Total Flips").arg(iter + 1).arg(m_Iterations).arg(progressInt).arg(lattice.total_flips());
-        notifyStatusMessage(ss);
-        prog = prog + progIncrement;
+        counter++;
+      }
+    }
+
+    if(m_WriteCheckpoints && ((iter + 1) % m_CheckpointInterval == 0 || iter + 1 == m_Iterations))
+    {
+      if(!saveCheckpoint(iter + 1))
+      {
+        return;
       }
-      counter++;
     }
-    iter++;
   }
 }
 
@@ -674,6 +1260,102 @@ bool PottsModel::getPeriodicBoundaries() const
   return m_PeriodicBoundaries;
 }
 
+// -----------------------------------------------------------------------------
+void PottsModel::setUpdateScheme(int value)
+{
+  m_UpdateScheme = value;
+}
+
+// -----------------------------------------------------------------------------
+int PottsModel::getUpdateScheme() const
+{
+  return m_UpdateScheme;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setUseRandomSeed(bool value)
+{
+  m_UseRandomSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PottsModel::getUseRandomSeed() const
+{
+  return m_UseRandomSeed;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setRandomSeedValue(uint64_t value)
+{
+  m_RandomSeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+uint64_t PottsModel::getRandomSeedValue() const
+{
+  return m_RandomSeedValue;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setWriteCheckpoints(bool value)
+{
+  m_WriteCheckpoints = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PottsModel::getWriteCheckpoints() const
+{
+  return m_WriteCheckpoints;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setCheckpointInterval(int value)
+{
+  m_CheckpointInterval = value;
+}
+
+// -----------------------------------------------------------------------------
+int PottsModel::getCheckpointInterval() const
+{
+  return m_CheckpointInterval;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setCheckpointFile(const QString& value)
+{
+  m_CheckpointFile = value;
+}
+
+// -----------------------------------------------------------------------------
+QString PottsModel::getCheckpointFile() const
+{
+  return m_CheckpointFile;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setResumeFromCheckpoint(bool value)
+{
+  m_ResumeFromCheckpoint = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PottsModel::getResumeFromCheckpoint() const
+{
+  return m_ResumeFromCheckpoint;
+}
+
+// -----------------------------------------------------------------------------
+void PottsModel::setResumeCheckpointFile(const QString& value)
+{
+  m_ResumeCheckpointFile = value;
+}
+
+// -----------------------------------------------------------------------------
+QString PottsModel::getResumeCheckpointFile() const
+{
+  return m_ResumeCheckpointFile;
+}
+
 // -----------------------------------------------------------------------------
 void PottsModel::setUseMask(bool value)
 {
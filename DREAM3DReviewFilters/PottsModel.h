@@ -63,6 +63,14 @@ class DREAM3DReview_EXPORT PottsModel : public AbstractFilter
   PYB11_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
+  PYB11_PROPERTY(int UpdateScheme READ getUpdateScheme WRITE setUpdateScheme)
+  PYB11_PROPERTY(bool UseRandomSeed READ getUseRandomSeed WRITE setUseRandomSeed)
+  PYB11_PROPERTY(uint64_t RandomSeedValue READ getRandomSeedValue WRITE setRandomSeedValue)
+  PYB11_PROPERTY(bool WriteCheckpoints READ getWriteCheckpoints WRITE setWriteCheckpoints)
+  PYB11_PROPERTY(int CheckpointInterval READ getCheckpointInterval WRITE setCheckpointInterval)
+  PYB11_PROPERTY(QString CheckpointFile READ getCheckpointFile WRITE setCheckpointFile)
+  PYB11_PROPERTY(bool ResumeFromCheckpoint READ getResumeFromCheckpoint WRITE setResumeFromCheckpoint)
+  PYB11_PROPERTY(QString ResumeCheckpointFile READ getResumeCheckpointFile WRITE setResumeCheckpointFile)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -122,6 +130,94 @@ public:
   bool getPeriodicBoundaries() const;
   Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+  /**
+   * @brief Setter property for UpdateScheme
+   */
+  void setUpdateScheme(int value);
+  /**
+   * @brief Getter property for UpdateScheme
+   * @return Value of UpdateScheme
+   */
+  int getUpdateScheme() const;
+  Q_PROPERTY(int UpdateScheme READ getUpdateScheme WRITE setUpdateScheme)
+
+  /**
+   * @brief Setter property for UseRandomSeed
+   */
+  void setUseRandomSeed(bool value);
+  /**
+   * @brief Getter property for UseRandomSeed
+   * @return Value of UseRandomSeed
+   */
+  bool getUseRandomSeed() const;
+  Q_PROPERTY(bool UseRandomSeed READ getUseRandomSeed WRITE setUseRandomSeed)
+
+  /**
+   * @brief Setter property for RandomSeedValue
+   */
+  void setRandomSeedValue(uint64_t value);
+  /**
+   * @brief Getter property for RandomSeedValue
+   * @return Value of RandomSeedValue
+   */
+  uint64_t getRandomSeedValue() const;
+  Q_PROPERTY(uint64_t RandomSeedValue READ getRandomSeedValue WRITE setRandomSeedValue)
+
+  /**
+   * @brief Setter property for WriteCheckpoints
+   */
+  void setWriteCheckpoints(bool value);
+  /**
+   * @brief Getter property for WriteCheckpoints
+   * @return Value of WriteCheckpoints
+   */
+  bool getWriteCheckpoints() const;
+  Q_PROPERTY(bool WriteCheckpoints READ getWriteCheckpoints WRITE setWriteCheckpoints)
+
+  /**
+   * @brief Setter property for CheckpointInterval
+   */
+  void setCheckpointInterval(int value);
+  /**
+   * @brief Getter property for CheckpointInterval
+   * @return Value of CheckpointInterval
+   */
+  int getCheckpointInterval() const;
+  Q_PROPERTY(int CheckpointInterval READ getCheckpointInterval WRITE setCheckpointInterval)
+
+  /**
+   * @brief Setter property for CheckpointFile
+   */
+  void setCheckpointFile(const QString& value);
+  /**
+   * @brief Getter property for CheckpointFile
+   * @return Value of CheckpointFile
+   */
+  QString getCheckpointFile() const;
+  Q_PROPERTY(QString CheckpointFile READ getCheckpointFile WRITE setCheckpointFile)
+
+  /**
+   * @brief Setter property for ResumeFromCheckpoint
+   */
+  void setResumeFromCheckpoint(bool value);
+  /**
+   * @brief Getter property for ResumeFromCheckpoint
+   * @return Value of ResumeFromCheckpoint
+   */
+  bool getResumeFromCheckpoint() const;
+  Q_PROPERTY(bool ResumeFromCheckpoint READ getResumeFromCheckpoint WRITE setResumeFromCheckpoint)
+
+  /**
+   * @brief Setter property for ResumeCheckpointFile
+   */
+  void setResumeCheckpointFile(const QString& value);
+  /**
+   * @brief Getter property for ResumeCheckpointFile
+   * @return Value of ResumeCheckpointFile
+   */
+  QString getResumeCheckpointFile() const;
+  Q_PROPERTY(QString ResumeCheckpointFile READ getResumeCheckpointFile WRITE setResumeCheckpointFile)
+
   /**
    * @brief Setter property for UseMask
    */
@@ -232,6 +328,14 @@ private:
   int m_Iterations = {100};
   double m_Temperature = {273.0};
   bool m_PeriodicBoundaries = {false};
+  int m_UpdateScheme = {0};
+  bool m_UseRandomSeed = {false};
+  uint64_t m_RandomSeedValue = {0};
+  bool m_WriteCheckpoints = {false};
+  int m_CheckpointInterval = {100};
+  QString m_CheckpointFile = {""};
+  bool m_ResumeFromCheckpoint = {false};
+  QString m_ResumeCheckpointFile = {""};
   bool m_UseMask = {false};
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   DataArrayPath m_MaskArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask};
@@ -34,6 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "RobustAutomaticThreshold.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -43,6 +47,9 @@
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
@@ -75,6 +82,8 @@ void RobustAutomaticThreshold::setupFilterParameters()
   FilterParameterVectorType parameters;
   DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Threshold", InputArrayPath, FilterParameter::Category::RequiredArray, RobustAutomaticThreshold, dasReq));
+  std::vector<QString> linkedProps = {"GradientMagnitudeArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Gradient Magnitude Array", UseGradientMagnitudeArray, FilterParameter::Category::Parameter, RobustAutomaticThreshold, linkedProps));
   dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Gradient Magnitude", GradientMagnitudeArrayPath, FilterParameter::Category::RequiredArray, RobustAutomaticThreshold, dasReq));
   DataArrayCreationFilterParameter::RequirementType dacReq = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Type::Any, IGeometry::Type::Any);
@@ -90,6 +99,7 @@ void RobustAutomaticThreshold::readFilterParameters(AbstractFilterParametersRead
   reader->openFilterGroup(this, index);
   setInputArrayPath(reader->readDataArrayPath("InputArrayPath", getInputArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
+  setUseGradientMagnitudeArray(reader->readValue("UseGradientMagnitudeArray", getUseGradientMagnitudeArray()));
   setGradientMagnitudeArrayPath(reader->readDataArrayPath("GradientMagnitudeArrayPath", getGradientMagnitudeArrayPath()));
   reader->closeFilterGroup();
 }
@@ -132,14 +142,34 @@ void RobustAutomaticThreshold::dataCheck()
     dataArrayPaths.push_back(getInputArrayPath());
   }
 
-  m_GradientMagnitudePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getGradientMagnitudeArrayPath(), cDims);
-  if(m_GradientMagnitudePtr.lock())
+  if(m_UseGradientMagnitudeArray)
   {
-    m_GradientMagnitude = m_GradientMagnitudePtr.lock()->getPointer(0);
+    m_GradientMagnitudePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getGradientMagnitudeArrayPath(), cDims);
+    if(m_GradientMagnitudePtr.lock())
+    {
+      m_GradientMagnitude = m_GradientMagnitudePtr.lock()->getPointer(0);
+    }
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getGradientMagnitudeArrayPath());
+    }
   }
-  if(getErrorCode() >= 0)
+  else
   {
-    dataArrayPaths.push_back(getGradientMagnitudeArrayPath());
+    // The gradient is computed on the Image Geometry, so the input must hold one value per Cell
+    ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getInputArrayPath().getDataContainerName());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    if(m_InputArrayPtr.lock()->getNumberOfTuples() != image->getNumberOfElements())
+    {
+      QString ss = QObject::tr("Computing the gradient magnitude requires one value of the input Attribute Array per Cell of the Image Geometry, but the array has %1 tuples and the Image "
+                               "Geometry has %2 Cells")
+                       .arg(m_InputArrayPtr.lock()->getNumberOfTuples())
+                       .arg(image->getNumberOfElements());
+      setErrorCondition(-11002, ss);
+    }
   }
 
   m_FeatureIdsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>>(this, getFeatureIdsArrayPath(), false, cDims, "", DataArrayID31);
@@ -158,37 +188,177 @@ void RobustAutomaticThreshold::dataCheck()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
+namespace
+{
+constexpr size_t k_TuplesPerChunk = 65536;
+
+/**
+ * @brief The FindWeightedSumsImpl class sums, over a range of chunks of tuples, the input weighted by its gradient
+ * magnitude and the gradient magnitude itself.  Each chunk keeps its own partial sums, which are added up in chunk
+ * order afterwards, so the threshold does not depend on the number of threads.  Without a gradient magnitude array
+ * the gradient is found on the fly from central differences on the Image Geometry, one-sided at its edges; the
+ * chunks then hold whole rows of Cells.
+ */
 template <typename T>
-void findThreshold(IDataArray::Pointer inputPtr, const FloatArrayType::Pointer& gradMagPtr, const BoolArrayType::Pointer& maskPtr)
+class FindWeightedSumsImpl
 {
-  typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(inputPtr);
-  T* iPtr = input->getPointer(0);
-  float* gradMag = gradMagPtr->getPointer(0);
-  bool* mask = maskPtr->getPointer(0);
-
-  size_t numTuples = input->getNumberOfTuples();
-  float numerator = 0;
-  float denominator = 0;
-
-  for(size_t i = 0; i < numTuples; i++)
+public:
+  FindWeightedSumsImpl(const T* input, const float* gradientMagnitude, const SizeVec3Type& dims, const FloatVec3Type& spacing, size_t numTuples, size_t chunkSize, std::vector<double>& numerators,
+                       std::vector<double>& denominators)
+  : m_Input(input)
+  , m_GradientMagnitude(gradientMagnitude)
+  , m_Dims(dims)
+  , m_Spacing(spacing)
+  , m_NumTuples(numTuples)
+  , m_ChunkSize(chunkSize)
+  , m_Numerators(numerators)
+  , m_Denominators(denominators)
   {
-    numerator += (iPtr[i] * gradMag[i]);
-    denominator += gradMag[i];
   }
 
-  float threshold = numerator / denominator;
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      const size_t start = chunk * m_ChunkSize;
+      const size_t end = std::min(start + m_ChunkSize, m_NumTuples);
+      double numerator = 0.0;
+      double denominator = 0.0;
+      if(m_GradientMagnitude != nullptr)
+      {
+        for(size_t i = start; i < end; i++)
+        {
+          numerator += static_cast<double>(m_Input[i]) * static_cast<double>(m_GradientMagnitude[i]);
+          denominator += static_cast<double>(m_GradientMagnitude[i]);
+        }
+      }
+      else
+      {
+        const size_t sliceSize = m_Dims[0] * m_Dims[1];
+        for(size_t rowStart = start; rowStart < end; rowStart += m_Dims[0])
+        {
+          const size_t y = (rowStart / m_Dims[0]) % m_Dims[1];
+          const size_t z = rowStart / sliceSize;
+          for(size_t x = 0; x < m_Dims[0]; x++)
+          {
+            const size_t i = rowStart + x;
+            const double dx = findDerivative(i, x, m_Dims[0], 1, m_Spacing[0]);
+            const double dy = findDerivative(i, y, m_Dims[1], m_Dims[0], m_Spacing[1]);
+            const double dz = findDerivative(i, z, m_Dims[2], sliceSize, m_Spacing[2]);
+            const double gradientMagnitude = std::sqrt(dx * dx + dy * dy + dz * dz);
+            numerator += static_cast<double>(m_Input[i]) * gradientMagnitude;
+            denominator += gradientMagnitude;
+          }
+        }
+      }
+      m_Numerators[chunk] = numerator;
+      m_Denominators[chunk] = denominator;
+    }
+  }
 
-  for(size_t i = 0; i < numTuples; i++)
+private:
+  const T* m_Input = nullptr;
+  const float* m_GradientMagnitude = nullptr;
+  SizeVec3Type m_Dims;
+  FloatVec3Type m_Spacing;
+  size_t m_NumTuples = 0;
+  size_t m_ChunkSize = 0;
+  std::vector<double>& m_Numerators;
+  std::vector<double>& m_Denominators;
+
+  /**
+   * @brief findDerivative Returns the derivative along one axis at a Cell, from its neighbors on either side, or
+   * from the Cell itself and its one neighbor at the edges
+   */
+  double findDerivative(size_t index, size_t coord, size_t dim, size_t stride, float spacing) const
   {
-    if(iPtr[i] < threshold)
+    if(dim < 2)
     {
-      mask[i] = false;
+      return 0.0;
     }
-    else
+    const size_t lower = (coord > 0) ? index - stride : index;
+    const size_t upper = (coord + 1 < dim) ? index + stride : index;
+    const double distance = static_cast<double>((upper - lower) / stride) * static_cast<double>(spacing);
+    return (static_cast<double>(m_Input[upper]) - static_cast<double>(m_Input[lower])) / distance;
+  }
+};
+
+/**
+ * @brief The ApplyThresholdImpl class sets the mask to false where the input is below the threshold
+ */
+template <typename T>
+class ApplyThresholdImpl
+{
+public:
+  ApplyThresholdImpl(const T* input, float threshold, bool* mask)
+  : m_Input(input)
+  , m_Threshold(threshold)
+  , m_Mask(mask)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      mask[i] = true;
+      m_Mask[i] = !(m_Input[i] < m_Threshold);
     }
   }
+
+private:
+  const T* m_Input = nullptr;
+  float m_Threshold = 0.0f;
+  bool* m_Mask = nullptr;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void findThreshold(IDataArray::Pointer inputPtr, const FloatArrayType::Pointer& gradMagPtr, const BoolArrayType::Pointer& maskPtr, const ImageGeom::Pointer& image)
+{
+  typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(inputPtr);
+  T* iPtr = input->getPointer(0);
+  float* gradMag = (gradMagPtr != nullptr) ? gradMagPtr->getPointer(0) : nullptr;
+  bool* mask = maskPtr->getPointer(0);
+
+  size_t numTuples = input->getNumberOfTuples();
+  SizeVec3Type dims = {numTuples, 1, 1};
+  FloatVec3Type spacing = {1.0f, 1.0f, 1.0f};
+  size_t chunkSize = k_TuplesPerChunk;
+  if(gradMag == nullptr)
+  {
+    dims = image->getDimensions();
+    spacing = image->getSpacing();
+    chunkSize = std::max<size_t>(k_TuplesPerChunk / std::max<size_t>(dims[0], 1), 1) * dims[0];
+  }
+  if(numTuples == 0 || chunkSize == 0)
+  {
+    return;
+  }
+
+  // Partial sums per chunk, in double so that large arrays do not lose the small contributions
+  const size_t numChunks = (numTuples + chunkSize - 1) / chunkSize;
+  std::vector<double> numerators(numChunks, 0.0);
+  std::vector<double> denominators(numChunks, 0.0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute(FindWeightedSumsImpl<T>(iPtr, gradMag, dims, spacing, numTuples, chunkSize, numerators, denominators));
+
+  double numerator = 0.0;
+  double denominator = 0.0;
+  for(size_t chunk = 0; chunk < numChunks; chunk++)
+  {
+    numerator += numerators[chunk];
+    denominator += denominators[chunk];
+  }
+
+  float threshold = static_cast<float>(numerator / denominator);
+
+  ParallelDataAlgorithm thresholdAlg;
+  thresholdAlg.setRange(0, numTuples);
+  thresholdAlg.execute(ApplyThresholdImpl<T>(iPtr, threshold, mask));
 }
 
 // -----------------------------------------------------------------------------
@@ -203,9 +373,14 @@ void RobustAutomaticThreshold::execute()
     return;
   }
 
-  // float threshold = 0.0f;
+  FloatArrayType::Pointer gradientMagnitude = m_UseGradientMagnitudeArray ? m_GradientMagnitudePtr.lock() : FloatArrayType::NullPointer();
+  ImageGeom::Pointer image = ImageGeom::NullPointer();
+  if(!m_UseGradientMagnitudeArray)
+  {
+    image = getDataContainerArray()->getDataContainer(getInputArrayPath().getDataContainerName())->getGeometryAs<ImageGeom>();
+  }
 
-  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(DataArray, this, findThreshold, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), m_GradientMagnitudePtr.lock(), m_FeatureIdsPtr.lock())
+  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(DataArray, this, findThreshold, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), gradientMagnitude, m_FeatureIdsPtr.lock(), image)
 }
 
 // -----------------------------------------------------------------------------
@@ -344,3 +519,15 @@ DataArrayPath RobustAutomaticThreshold::getGradientMagnitudeArrayPath() const
 {
   return m_GradientMagnitudeArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void RobustAutomaticThreshold::setUseGradientMagnitudeArray(bool value)
+{
+  m_UseGradientMagnitudeArray = value;
+}
+
+// -----------------------------------------------------------------------------
+bool RobustAutomaticThreshold::getUseGradientMagnitudeArray() const
+{
+  return m_UseGradientMagnitudeArray;
+}
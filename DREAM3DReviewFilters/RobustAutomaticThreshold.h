@@ -61,6 +61,7 @@ class DREAM3DReview_EXPORT RobustAutomaticThreshold : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath InputArrayPath READ getInputArrayPath WRITE setInputArrayPath)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath GradientMagnitudeArrayPath READ getGradientMagnitudeArrayPath WRITE setGradientMagnitudeArrayPath)
+  PYB11_PROPERTY(bool UseGradientMagnitudeArray READ getUseGradientMagnitudeArray WRITE setUseGradientMagnitudeArray)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -118,6 +119,17 @@ public:
   DataArrayPath getGradientMagnitudeArrayPath() const;
   Q_PROPERTY(DataArrayPath GradientMagnitudeArrayPath READ getGradientMagnitudeArrayPath WRITE setGradientMagnitudeArrayPath)
 
+  /**
+   * @brief Setter property for UseGradientMagnitudeArray
+   */
+  void setUseGradientMagnitudeArray(bool value);
+  /**
+   * @brief Getter property for UseGradientMagnitudeArray
+   * @return Value of UseGradientMagnitudeArray
+   */
+  bool getUseGradientMagnitudeArray() const;
+  Q_PROPERTY(bool UseGradientMagnitudeArray READ getUseGradientMagnitudeArray WRITE setUseGradientMagnitudeArray)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -203,6 +215,7 @@ private:
   DataArrayPath m_InputArrayPath = {"", "", ""};
   DataArrayPath m_FeatureIdsArrayPath = {"", "", "Mask"};
   DataArrayPath m_GradientMagnitudeArrayPath = {"", "", ""};
+  bool m_UseGradientMagnitudeArray = {true};
 
 public:
   RobustAutomaticThreshold(const RobustAutomaticThreshold&) = delete;            // Copy Constructor Not Implemented
@@ -37,7 +37,8 @@
 #include "TesselateFarFieldGrains.h"
 
 #include <algorithm>
-#include <fstream>
+
+#include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
@@ -45,6 +46,7 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -56,6 +58,8 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/Orientation.hpp"
@@ -65,11 +69,9 @@
 
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range3d.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
+#include "DREAM3DReview/DREAM3DReviewFilters/util/FarFieldSlabReader.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/MajorityGapFiller.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ShapeRasterizer.hpp"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -89,169 +91,127 @@ enum createdPathID : RenameDataPath::DataID_t
 //// Macro to determine if we are going to show the Debugging Output files
 #define PPP_SHOW_DEBUG_OUTPUTS 0
 
+namespace
+{
+using FarFieldSlabReader::FarFieldGrain;
+using FarFieldSlabReader::FarFieldSlab;
+using FarFieldSlabReader::LoadSlabImpl;
+
 /**
- * @brief
+ * @brief The FillSlabFeaturesImpl class writes the Feature level arrays for a range of the loaded Features.  Every
+ * slab owns a contiguous block of Feature Ids starting at its offset.
  */
-class AssignVoxelsImpl
-{
-  int64_t dims[3];
-  float Invradcur[3];
-  float res[3];
-  float xc;
-  float yc;
-  float zc;
-  ShapeOps::Pointer m_EllipsoidOps;
-  float ga[3][3];
-  int curFeature;
-  Int32ArrayType::Pointer newownersPtr;
-  FloatArrayType::Pointer ellipfuncsPtr;
-
+class FillSlabFeaturesImpl
+{
 public:
-  AssignVoxelsImpl(int64_t* dimensions, float* resolution, float* radCur, float* xx, ShapeOps::Pointer ellipsoidOps, float gA[3][3], float* size, int cur_feature, Int32ArrayType::Pointer newowners,
-                   FloatArrayType::Pointer ellipfuncs)
-  : m_EllipsoidOps(ellipsoidOps)
-  , curFeature(cur_feature)
+  struct FeatureArrays
+  {
+    int32_t* slabId;
+    float* centroids;
+    float* volumes;
+    float* equivalentDiameters;
+    float* axisLengths;
+    float* axisEulerAngles;
+    float* omega3s;
+    int32_t* featurePhases;
+    float* featureEulerAngles;
+    float* elasticStrains;
+  };
+
+  FillSlabFeaturesImpl(const std::vector<FarFieldSlab>& slabs, const std::vector<size_t>& offsets, float xShift, float yShift, const FeatureArrays& arrays)
+  : m_Slabs(slabs)
+  , m_Offsets(offsets)
+  , m_XShift(xShift)
+  , m_YShift(yShift)
+  , m_Arrays(arrays)
   {
-    dims[0] = dimensions[0];
-    dims[1] = dimensions[1];
-    dims[2] = dimensions[2];
-    Invradcur[0] = 1.0 / radCur[0];
-    Invradcur[1] = 1.0 / radCur[1];
-    Invradcur[2] = 1.0 / radCur[2];
-
-    res[0] = resolution[0];
-    res[1] = resolution[1];
-    res[2] = resolution[2];
-
-    xc = xx[0];
-    yc = xx[1];
-    zc = xx[2];
-
-    ga[0][0] = gA[0][0];
-    ga[0][1] = gA[0][1];
-    ga[0][2] = gA[0][2];
-    ga[1][0] = gA[1][0];
-    ga[1][1] = gA[1][1];
-    ga[1][2] = gA[1][2];
-    ga[2][0] = gA[2][0];
-    ga[2][1] = gA[2][1];
-    ga[2][2] = gA[2][2];
-
-    newownersPtr = newowners;
-    ellipfuncsPtr = ellipfuncs;
   }
-  virtual ~AssignVoxelsImpl() = default;
 
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  void convert(int zStart, int zEnd, int yStart, int yEnd, int xStart, int xEnd) const
+  void operator()(const SIMPLRange& range) const
   {
+    const float fourThirds = 4.0f / 3.0f;
+    float mat[3][3];
+    float rt[3][3];
+    float rtInv[3][3];
+    float rtMult[3][3];
+    float rtAvg[3][3];
+    float eps[3][3];
+    float epsT[3][3];
+    float epsAdd[3][3];
+    float epsMult[3][3];
+    float identity[3][3];
+    float flst[3][3];
+    MatrixMath::Identity3x3(identity);
 
-    int column = 0;
-    int row = 0;
-    int plane = 0;
-    int index = 0;
-    float gaCopy[3][3];
-    float gaT[3][3];
-    float coords[3] = {0.0f, 0.0f, 0.0f};
-    float inside = 0.0f;
-    //   float dist = 0.0f;
-    //   float radcur1squared = 1.0/(Invradcur[0]*Invradcur[0]);
-    float coordsRotated[3] = {0.0f, 0.0f, 0.0f};
-    int32_t* newowners = newownersPtr->getPointer(0);
-    float* ellipfuncs = ellipfuncsPtr->getPointer(0);
-
-    // making a copy because the transpose function used later can't deal with the const nature of ga
-    for(int i = 0; i < 3; i++)
+    size_t slab = std::upper_bound(m_Offsets.begin(), m_Offsets.end(), range.min()) - m_Offsets.begin() - 1;
+    std::copy(&m_Slabs[slab].referenceRootTensor[0][0], &m_Slabs[slab].referenceRootTensor[0][0] + 9, &rtAvg[0][0]);
+    for(size_t currentFeature = range.min(); currentFeature < range.max(); currentFeature++)
     {
-      for(int j = 0; j < 3; j++)
+      if(currentFeature >= m_Offsets[slab + 1])
       {
-        gaCopy[i][j] = ga[i][j];
+        while(currentFeature >= m_Offsets[slab + 1])
+        {
+          slab++;
+        }
+        std::copy(&m_Slabs[slab].referenceRootTensor[0][0], &m_Slabs[slab].referenceRootTensor[0][0] + 9, &rtAvg[0][0]);
       }
-    }
+      const FarFieldSlab& slabData = m_Slabs[slab];
+      const FarFieldGrain& grain = slabData.grains[currentFeature - m_Offsets[slab]];
 
-    int64_t dim0_dim_1 = dims[0] * dims[1];
-    for(int64_t iter1 = xStart; iter1 < xEnd; iter1++)
-    {
-      column = iter1;
-      if(iter1 < 0)
-      {
-        column = iter1 + dims[0];
-      }
-      else if(iter1 > dims[0] - 1)
+      m_Arrays.slabId[currentFeature] = static_cast<int32_t>(slab + 1);
+
+      m_Arrays.centroids[3 * currentFeature + 0] = grain.centroid[0] + m_XShift;
+      m_Arrays.centroids[3 * currentFeature + 1] = grain.centroid[1] + m_YShift;
+      m_Arrays.centroids[3 * currentFeature + 2] = grain.centroid[2] + (slabData.globalZPos - slabData.beamCenter);
+
+      const float eqRad = grain.equivalentRadius;
+      m_Arrays.volumes[currentFeature] = fourThirds * SIMPLib::Constants::k_PiD * eqRad * eqRad * eqRad;
+      m_Arrays.equivalentDiameters[currentFeature] = eqRad * 2.0;
+      m_Arrays.axisLengths[3 * currentFeature + 0] = 1.0;
+      m_Arrays.axisLengths[3 * currentFeature + 1] = 1.0;
+      m_Arrays.axisLengths[3 * currentFeature + 2] = 1.0;
+      m_Arrays.axisEulerAngles[3 * currentFeature + 0] = 0.0;
+      m_Arrays.axisEulerAngles[3 * currentFeature + 1] = 0.0;
+      m_Arrays.axisEulerAngles[3 * currentFeature + 2] = 0.0;
+      m_Arrays.omega3s[currentFeature] = 1.0;
+
+      m_Arrays.featurePhases[currentFeature] = grain.phase;
+
+      for(size_t j = 0; j < 9; j++)
       {
-        column = iter1 - dims[0];
+        mat[j / 3][j % 3] = grain.orientationMatrix[j];
       }
-
-      for(int64_t iter2 = yStart; iter2 < yEnd; iter2++)
+      OrientationF eu(m_Arrays.featureEulerAngles + (3 * currentFeature), 3);
+      eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(mat));
+
+      float alpha = grain.latticeParameters[3] * SIMPLib::Constants::k_PiOver180D;
+      float beta = grain.latticeParameters[4] * SIMPLib::Constants::k_PiOver180D;
+      float gamma = grain.latticeParameters[5] * SIMPLib::Constants::k_PiOver180D;
+      OrientationMath::RootTensorFromLatticeParameters(grain.latticeParameters[0], grain.latticeParameters[1], grain.latticeParameters[2], alpha, beta, gamma, rt);
+      MatrixMath::Invert3x3(rt, rtInv);
+      MatrixMath::Multiply3x3with3x3(rtInv, rtAvg, rtMult);
+      MatrixMath::Subtract3x3s(rtMult, identity, eps);
+      MatrixMath::Transpose3x3(eps, epsT);
+      MatrixMath::Multiply3x3with3x3(epsT, eps, epsMult);
+      MatrixMath::Add3x3s(eps, epsT, epsAdd);
+      MatrixMath::Add3x3s(epsAdd, epsMult, flst);
+      MatrixMath::Multiply3x3withConstant(flst, 0.5f);
+
+      for(size_t j = 0; j < 9; j++)
       {
-        row = iter2;
-        if(iter2 < 0)
-        {
-          row = iter2 + dims[1];
-        }
-        else if(iter2 > dims[1] - 1)
-        {
-          row = iter2 - dims[1];
-        }
-        size_t row_dim = row * dims[0];
-
-        for(int64_t iter3 = zStart; iter3 < zEnd; iter3++)
-        {
-          plane = iter3;
-          if(iter3 < 0)
-          {
-            plane = iter3 + dims[2];
-          }
-          else if(iter3 > dims[2] - 1)
-          {
-            plane = iter3 - dims[2];
-          }
-
-          index = static_cast<int>((plane * dim0_dim_1) + (row_dim) + column);
-
-          inside = -1;
-          coords[0] = float(iter1) * res[0];
-          coords[1] = float(iter2) * res[1];
-          coords[2] = float(iter3) * res[2];
-
-          coords[0] = coords[0] - xc;
-          coords[1] = coords[1] - yc;
-          coords[2] = coords[2] - zc;
-          MatrixMath::Transpose3x3(gaCopy, gaT);
-          MatrixMath::Multiply3x3with3x1(gaT, coords, coordsRotated);
-          float axis1comp = coordsRotated[0] * Invradcur[0];
-          float axis2comp = coordsRotated[1] * Invradcur[1];
-          float axis3comp = coordsRotated[2] * Invradcur[2];
-          inside = m_EllipsoidOps->inside(axis1comp, axis2comp, axis3comp);
-          // if (inside >= 0 && newowners[index] > 0)
-          if(inside >= 0 && newowners[index] > 0 && inside > ellipfuncs[index])
-          {
-            newowners[index] = curFeature;
-            ellipfuncs[index] = inside;
-            // newowners[index] = -2;
-            // ellipfuncs[index] = inside;
-          }
-          else if(inside >= 0 && newowners[index] == -1)
-          {
-            newowners[index] = curFeature;
-            ellipfuncs[index] = inside;
-          }
-        }
+        m_Arrays.elasticStrains[9 * currentFeature + j] = flst[j / 3][j % 3];
       }
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range3d<int, int, int>& r) const
-  {
-    convert(r.pages().begin(), r.pages().end(), r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-  }
-#endif
-
 private:
+  const std::vector<FarFieldSlab>& m_Slabs;
+  const std::vector<size_t>& m_Offsets;
+  float m_XShift;
+  float m_YShift;
+  FeatureArrays m_Arrays;
 };
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -288,6 +248,7 @@ void TesselateFarFieldGrains::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_FILELISTINFO_FP("Feature Input File List", FeatureInputFileListInfo, FilterParameter::Category::Parameter, TesselateFarFieldGrains));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Cache Parsed Files", UseBinaryCache, FilterParameter::Category::Parameter, TesselateFarFieldGrains));
 
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
@@ -342,6 +303,7 @@ void TesselateFarFieldGrains::readFilterParameters(AbstractFilterParametersReade
   setElasticStrainsArrayName(reader->readString("ElasticStrainsArrayName", getElasticStrainsArrayName()));
   setCrystalStructuresArrayName(reader->readString("CrystalStructuresArrayName", getCrystalStructuresArrayName()));
   setMaskArrayPath(reader->readDataArrayPath("MaskArrayPath", getMaskArrayPath()));
+  setUseBinaryCache(reader->readValue("UseBinaryCache", getUseBinaryCache()));
   reader->closeFilterGroup();
 }
 
@@ -414,7 +376,6 @@ void TesselateFarFieldGrains::updateEnsembleInstancePointers()
 // -----------------------------------------------------------------------------
 void TesselateFarFieldGrains::initialize()
 {
-  m_Neighbors = nullptr;
   m_BoundaryCells = nullptr;
 
   m_RandomSeed = QDateTime::currentMSecsSinceEpoch();
@@ -680,169 +641,61 @@ void TesselateFarFieldGrains::load_features()
   QVector<QString> fileList = FilePathGenerator::GenerateFileList(m_FeatureInputFileListInfo.StartIndex, m_FeatureInputFileListInfo.EndIndex, m_FeatureInputFileListInfo.IncrementIndex,
                                                                   hasMissingFiles, orderAscending, m_FeatureInputFileListInfo.InputPath, m_FeatureInputFileListInfo.FilePrefix,
                                                                   m_FeatureInputFileListInfo.FileSuffix, m_FeatureInputFileListInfo.FileExtension, m_FeatureInputFileListInfo.PaddingDigits);
-  std::ifstream inFile;
-
-  int slabCount = 0;
-  size_t currentFeature = 1;
 
-  SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
-  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
-  float xShift = spacing[0] * float(dims[0] / 2.0f);
-  float yShift = spacing[1] * float(dims[1] / 2.0f);
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
+  // Parse every slab file up front so that the Feature arrays are sized exactly once
+  QString ss = QObject::tr("Importing %1 files").arg(fileList.size());
+  notifyStatusMessage(ss);
+  std::vector<FarFieldSlab> slabs(fileList.size());
   {
-    slabCount++;
-    QString fName = *filepath;
-    QString ss = QObject::tr("Importing file %1").arg(fName);
-    notifyStatusMessage(ss);
-
-    inFile.open(fName.toLatin1().data(), std::ios_base::binary);
-    if(!inFile)
+    ParallelTaskAlgorithm taskRunner;
+    taskRunner.setParallelizationEnabled(true);
+    for(int32_t i = 0; i < fileList.size(); i++)
     {
-      QString ss = QObject::tr("Failed to open: %1").arg(fName);
-      setErrorCondition(-1, ss);
+      taskRunner.execute(LoadSlabImpl(fileList[i], m_UseBinaryCache, slabs[i]));
     }
+    taskRunner.wait();
+  }
 
-    // variable for holding meta data
-    int numPhases = 1;
-    int numFeatures = 0;
-    unsigned int cStruct = EbsdLib::CrystalStructure::UnknownCrystalStructure;
-    float beamCenter = 0.0f, beamThickness = 0.0f, globalZPos = 0.0f;
-    std::string keywordStr, phaseName, crystruct;
-    float aRef = 0.0f, bRef = 0.0f, cRef = 0.0f, alphaRef = 0.0f, betaRef = 0.0f, gammaRef = 0.0f;
-
-    inFile >> keywordStr >> numFeatures;
-    if(0 == numFeatures)
+  std::vector<size_t> offsets(slabs.size() + 1, 1);
+  for(size_t i = 0; i < slabs.size(); i++)
+  {
+    if(slabs[i].errorCode < 0)
     {
-      setErrorCondition(-600, "The number of features is Zero and should be greater than Zero");
+      setErrorCondition(slabs[i].errorCode, slabs[i].errorMessage);
+      return;
     }
-    std::vector<size_t> tDims(1, currentFeature + numFeatures);
-    cellFeatureAttrMat->setTupleDimensions(tDims);
-    updateFeatureInstancePointers();
-
-    inFile >> keywordStr >> beamCenter;
-    inFile >> keywordStr >> beamThickness;
-    inFile >> keywordStr >> globalZPos;
-    inFile >> keywordStr >> numPhases;
-
-    tDims[0] = numPhases + 1;
-    cellEnsembleAttrMat->setTupleDimensions(tDims);
-    updateEnsembleInstancePointers();
-    for(int i = 1; i <= numPhases; i++)
+    if(slabs[i].cacheWriteFailed)
     {
-      inFile >> phaseName >> crystruct >> aRef >> bRef >> cRef >> alphaRef >> betaRef >> gammaRef;
-      if(crystruct == "Cubic")
-      {
-        cStruct = EbsdLib::CrystalStructure::Cubic_High;
-      }
-      else if(crystruct == "Hexagonal")
-      {
-        cStruct = EbsdLib::CrystalStructure::Hexagonal_High;
-      }
-      else if(crystruct == "Tetragonal")
-      {
-        cStruct = EbsdLib::CrystalStructure::Tetragonal_High;
-      }
-      else if(crystruct == "Orthorhombic")
-      {
-        cStruct = EbsdLib::CrystalStructure::OrthoRhombic;
-      }
-      else if(crystruct == "Trigonal")
-      {
-        cStruct = EbsdLib::CrystalStructure::Trigonal_High;
-      }
-      else if(crystruct == "Monoclinic")
-      {
-        cStruct = EbsdLib::CrystalStructure::Monoclinic;
-      }
-      else if(crystruct == "Triclinic")
-      {
-        cStruct = EbsdLib::CrystalStructure::Triclinic;
-      }
-      m_CrystalStructures[i] = cStruct;
+      ss = QObject::tr("Failed to write the binary cache for: %1").arg(fileList[static_cast<int32_t>(i)]);
+      setWarningCondition(-602, ss);
     }
+    offsets[i + 1] = offsets[i] + slabs[i].grains.size();
+  }
+  if(slabs.empty() || getCancel())
+  {
+    return;
+  }
 
-    size_t fId;
-    int phase = 1;
-    float xC = 0.0f, yC = 0.0f, zC = 0.0f;
-    float a = 0.0f, b = 0.0f, c = 0.0f, alpha = 0.0f, beta = 0.0f, gamma = 0.0f;
-    float vol = 0.0f, eqRad = 0.0f;
-    float conf = 0.0f;
-    float dummy1 = 0.0f, dummy2 = 0.0f, dummy3 = 0.0f;
-    float mat[3][3];
-    float rt[3][3];
-    float rtInv[3][3];
-    float rtMult[3][3];
-    float rtAvg[3][3];
-    float eps[3][3];
-    float epsT[3][3];
-    float epsAdd[3][3];
-    float epsMult[3][3];
-    float identity[3][3];
-    float flst[3][3];
-    const float fourThirds = 4.0f / 3.0f;
+  std::vector<size_t> tDims(1, offsets.back());
+  cellFeatureAttrMat->setTupleDimensions(tDims);
+  updateFeatureInstancePointers();
 
-    alphaRef *= SIMPLib::Constants::k_PiOver180D;
-    betaRef *= SIMPLib::Constants::k_PiOver180D;
-    gammaRef *= SIMPLib::Constants::k_PiOver180D;
-    OrientationMath::RootTensorFromLatticeParameters(aRef, bRef, cRef, alphaRef, betaRef, gammaRef, rtAvg);
-    MatrixMath::Identity3x3(identity);
-    for(int i = 0; i < numFeatures; i++)
-    {
-      inFile >> fId >> phase >> mat[0][0] >> mat[0][1] >> mat[0][2] >> mat[1][0] >> mat[1][1] >> mat[1][2] >> mat[2][0] >> mat[2][1] >> mat[2][2] >> xC >> yC >> zC >> a >> b >> c >> alpha >> beta >>
-          gamma >> dummy1 >> dummy2 >> dummy3 >> eqRad >> conf;
+  // Every slab lists all of the phases, so the Ensemble data is taken from the last one
+  const FarFieldSlab& lastSlab = slabs.back();
+  tDims[0] = lastSlab.crystalStructures.size() + 1;
+  cellEnsembleAttrMat->setTupleDimensions(tDims);
+  updateEnsembleInstancePointers();
+  std::copy(lastSlab.crystalStructures.begin(), lastSlab.crystalStructures.end(), m_CrystalStructures + 1);
 
-      //      if(fabs(zC-beamCenter) <= (beamThickness/2.0))
-      {
-        m_SlabId[currentFeature] = slabCount;
-
-        m_Centroids[3 * currentFeature + 0] = xC + xShift;
-        m_Centroids[3 * currentFeature + 1] = yC + yShift;
-        m_Centroids[3 * currentFeature + 2] = zC + (globalZPos - beamCenter);
-
-        vol = fourThirds * SIMPLib::Constants::k_PiD * eqRad * eqRad * eqRad;
-        m_Volumes[currentFeature] = vol;
-        m_EquivalentDiameters[currentFeature] = eqRad * 2.0;
-        m_AxisLengths[3 * currentFeature + 0] = 1.0;
-        m_AxisLengths[3 * currentFeature + 1] = 1.0;
-        m_AxisLengths[3 * currentFeature + 2] = 1.0;
-        m_AxisEulerAngles[3 * currentFeature + 0] = 0.0;
-        m_AxisEulerAngles[3 * currentFeature + 1] = 0.0;
-        m_AxisEulerAngles[3 * currentFeature + 2] = 0.0;
-        m_Omega3s[currentFeature] = 1.0;
-
-        m_FeaturePhases[currentFeature] = phase;
-
-        OrientationF eu(m_FeatureEulerAngles + (3 * i), 3);
-        eu = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(mat));
-
-        alpha *= SIMPLib::Constants::k_PiOver180D;
-        beta *= SIMPLib::Constants::k_PiOver180D;
-        gamma *= SIMPLib::Constants::k_PiOver180D;
-        OrientationMath::RootTensorFromLatticeParameters(a, b, c, alpha, beta, gamma, rt);
-        MatrixMath::Invert3x3(rt, rtInv);
-        MatrixMath::Multiply3x3with3x3(rtInv, rtAvg, rtMult);
-        MatrixMath::Subtract3x3s(rtMult, identity, eps);
-        MatrixMath::Transpose3x3(eps, epsT);
-        MatrixMath::Multiply3x3with3x3(epsT, eps, epsMult);
-        MatrixMath::Add3x3s(eps, epsT, epsAdd);
-        MatrixMath::Add3x3s(epsAdd, epsMult, flst);
-        MatrixMath::Multiply3x3withConstant(flst, 0.5f);
-
-        m_ElasticStrains[9 * currentFeature + 0] = flst[0][0];
-        m_ElasticStrains[9 * currentFeature + 1] = flst[0][1];
-        m_ElasticStrains[9 * currentFeature + 2] = flst[0][2];
-        m_ElasticStrains[9 * currentFeature + 3] = flst[1][0];
-        m_ElasticStrains[9 * currentFeature + 4] = flst[1][1];
-        m_ElasticStrains[9 * currentFeature + 5] = flst[1][2];
-        m_ElasticStrains[9 * currentFeature + 6] = flst[2][0];
-        m_ElasticStrains[9 * currentFeature + 7] = flst[2][1];
-        m_ElasticStrains[9 * currentFeature + 8] = flst[2][2];
-        currentFeature++;
-      }
-    }
-    inFile.close();
-  }
+  SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
+  float xShift = spacing[0] * float(dims[0] / 2.0f);
+  float yShift = spacing[1] * float(dims[1] / 2.0f);
+
+  FillSlabFeaturesImpl::FeatureArrays arrays = {m_SlabId, m_Centroids, m_Volumes, m_EquivalentDiameters, m_AxisLengths, m_AxisEulerAngles, m_Omega3s, m_FeaturePhases, m_FeatureEulerAngles, m_ElasticStrains};
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, offsets.back());
+  dataAlg.execute(FillSlabFeaturesImpl(slabs, offsets, xShift, yShift, arrays));
 }
 
 // -----------------------------------------------------------------------------
@@ -864,7 +717,7 @@ void TesselateFarFieldGrains::assign_voxels()
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t dims[3] = {
+  const std::array<int64_t, 3> dims = {
       static_cast<int64_t>(udims[0]),
       static_cast<int64_t>(udims[1]),
       static_cast<int64_t>(udims[2]),
@@ -872,11 +725,11 @@ void TesselateFarFieldGrains::assign_voxels()
 
   int64_t column, row, plane;
   float xc, yc, zc;
-  float size[3] = {m_SizeX, m_SizeY, m_SizeZ};
 
   int64_t xmin, xmax, ymin, ymax, zmin, zmax;
 
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
+  const std::array<float, 3> res = {spacing[0], spacing[1], spacing[2]};
 
   Int32ArrayType::Pointer newownersPtr = Int32ArrayType::CreateArray(totalPoints, std::string("newowners"), true);
   newownersPtr->initializeWithValue(-1);
@@ -964,17 +817,12 @@ void TesselateFarFieldGrains::assign_voxels()
       zmax = dims[2] - 1;
     }
 
-    float radCur[3] = {radcur1, radcur2, radcur3};
-    float xx[3] = {xc, yc, zc};
-
-//#if 0
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range3d<int, int, int>(zmin, zmax + 1, ymin, ymax + 1, xmin, xmax + 1),
-                      AssignVoxelsImpl(dims, spacing.data(), radCur, xx, m_EllipsoidOps, ga, size, i, newownersPtr, ellipfuncsPtr), tbb::auto_partitioner());
-#else
-    AssignVoxelsImpl serial(dims, spacing.data(), radCur, xx, m_EllipsoidOps, ga, size, i, newownersPtr, ellipfuncsPtr);
-    serial.convert(zmin, zmax + 1, ymin, ymax + 1, xmin, xmax + 1);
-#endif
+    ShapeRasterizer::Shape shape;
+    shape.center = {xc, yc, zc};
+    MatrixMath::Transpose3x3(ga, shape.axes);
+    shape.invRadii = {static_cast<float>(1.0 / radcur1), static_cast<float>(1.0 / radcur2), static_cast<float>(1.0 / radcur3)};
+    shape.shapeOps = m_EllipsoidOps.get();
+    ShapeRasterizer::RasterizeShape(shape, static_cast<int32_t>(i), dims, res, {xmin, xmax, ymin, ymax, zmin, zmax}, newowners, ellipfuncs);
   }
 
   QVector<bool> activeObjects(totalFeatures, false);
@@ -1031,157 +879,21 @@ void TesselateFarFieldGrains::assign_gaps_only()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixName().getDataContainerName());
 
-  int featurename, feature;
-  int current = 0;
-  int most = 0;
-  int count = 1;
-  int fixedCount = 1;
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  std::array<int64_t, 3> dims = {static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2])};
+
+  // Grow the Features into the gaps one voxel layer at a time, only visiting the gap voxels on the frontier
+  MajorityGapFiller gapFiller(dims, m_FeatureIds);
   int counter = 0;
-  int neighpoint;
-  int good;
-  int neighbor;
-
-  int xPoints = static_cast<int>(m->getGeometryAs<ImageGeom>()->getXPoints());
-  int yPoints = static_cast<int>(m->getGeometryAs<ImageGeom>()->getYPoints());
-  int zPoints = static_cast<int>(m->getGeometryAs<ImageGeom>()->getZPoints());
-  size_t totalPoints = m->getAttributeMatrix(m_OutputCellAttributeMatrixName.getAttributeMatrixName())->getNumberOfTuples();
-  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
-
-  int neighpoints[6];
-  neighpoints[0] = -xPoints * yPoints;
-  neighpoints[1] = -xPoints;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xPoints;
-  neighpoints[5] = xPoints * yPoints;
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(m->getGeometryAs<ImageGeom>()->getNumberOfElements(), std::string("Neighbors"), true);
-  neighborsPtr->initializeWithValue(-1);
-  m_Neighbors = neighborsPtr->getPointer(0);
-
-  QVector<int> n(totalFeatures + 1, 0);
-  // uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  // uint64_t currentMillis = millis;
-
-  while(count != 0)
+  while(gapFiller.getFrontierSize() > 0)
   {
     counter++;
-    count = 0;
-    fixedCount = 0;
-    int zStride, yStride;
-    for(int i = 0; i < zPoints; i++)
-    {
-      zStride = i * xPoints * yPoints;
-      for(int j = 0; j < yPoints; j++)
-      {
-        yStride = j * xPoints;
-        for(int k = 0; k < xPoints; k++)
-        {
-          featurename = m_FeatureIds[zStride + yStride + k];
-          if(featurename < 0)
-          {
-            count++;
-            current = 0;
-            most = 0;
-            for(int l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[zStride + yStride + k] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = zStride + yStride + k + neighpoints[l];
-              if(l == 0 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && i == (zPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (yPoints - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && k == (xPoints - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature > 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
-      {
-        m_FeatureIds[j] = m_FeatureIds[neighbor];
-        m_CellPhases[j] = m_FeaturePhases[m_FeatureIds[neighbor]];
-        fixedCount++;
-      }
-    }
-    if(counter >= 1)
+    QString ss = QObject::tr("Assign Gaps|| Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(counter).arg(gapFiller.getRemainingGaps());
+    notifyStatusMessage(ss);
+    gapFiller.fillNextLayer(m_CellPhases, m_FeaturePhases);
+    if(getCancel())
     {
-      QString ss = QObject::tr("Assign Gaps|| Cycle#: %1 || Remaining Unassigned Voxel Count: %2").arg(counter).arg(count);
-      notifyStatusMessage(ss);
+      return;
     }
   }
 }
@@ -1503,3 +1215,15 @@ StackFileListInfo TesselateFarFieldGrains::getFeatureInputFileListInfo() const
 {
   return m_FeatureInputFileListInfo;
 }
+
+// -----------------------------------------------------------------------------
+void TesselateFarFieldGrains::setUseBinaryCache(bool value)
+{
+  m_UseBinaryCache = value;
+}
+
+// -----------------------------------------------------------------------------
+bool TesselateFarFieldGrains::getUseBinaryCache() const
+{
+  return m_UseBinaryCache;
+}
@@ -89,6 +89,7 @@ class DREAM3DReview_EXPORT TesselateFarFieldGrains : public AbstractFilter
   PYB11_PROPERTY(QString CrystalStructuresArrayName READ getCrystalStructuresArrayName WRITE setCrystalStructuresArrayName)
   PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
   PYB11_PROPERTY(StackFileListInfo FeatureInputFileListInfo READ getFeatureInputFileListInfo WRITE setFeatureInputFileListInfo)
+  PYB11_PROPERTY(bool UseBinaryCache READ getUseBinaryCache WRITE setUseBinaryCache)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -312,6 +313,17 @@ public:
   StackFileListInfo getFeatureInputFileListInfo() const;
   Q_PROPERTY(StackFileListInfo FeatureInputFileListInfo READ getFeatureInputFileListInfo WRITE setFeatureInputFileListInfo)
 
+  /**
+   * @brief Setter property for UseBinaryCache
+   */
+  void setUseBinaryCache(bool value);
+  /**
+   * @brief Getter property for UseBinaryCache
+   * @return Value of UseBinaryCache
+   */
+  bool getUseBinaryCache() const;
+  Q_PROPERTY(bool UseBinaryCache READ getUseBinaryCache WRITE setUseBinaryCache)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -440,8 +452,8 @@ private:
   QString m_CrystalStructuresArrayName = {SIMPL::EnsembleData::CrystalStructures};
   DataArrayPath m_MaskArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask};
   StackFileListInfo m_FeatureInputFileListInfo = {};
+  bool m_UseBinaryCache = {false};
 
-  int32_t* m_Neighbors;
 
   // Cell Data - make sure these are all initialized to nullptr in the constructor
 
@@ -1,14 +1,77 @@
 #include "Delaunay2D.h"
 
+#include <numeric>
+#include <thread>
+
 #include <Eigen/Dense>
 
 #include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
+
+#include "DREAM3DReviewFilters/util/DivideAndConquerDelaunay2D.hpp"
+#include "DREAM3DReviewFilters/util/SpatialSort.hpp"
+
+namespace
+{
+// Strips smaller than this are not worth a task of their own
+constexpr size_t k_MinStripSize = 16384;
+
+// Progress is only reported for triangulations with at least this many vertices, so that many
+// small concurrent triangulations do not flood the observer
+constexpr size_t k_MinProgressVertices = 10000;
+
+/**
+ * @brief The TriangulateStripImpl class triangulates one strip of a DivideAndConquerDelaunay2D
+ */
+class TriangulateStripImpl
+{
+public:
+  TriangulateStripImpl(DivideAndConquerDelaunay2D& triangulator, size_t strip)
+  : m_Triangulator(triangulator)
+  , m_Strip(strip)
+  {
+  }
+
+  void operator()() const
+  {
+    m_Triangulator.triangulateStrip(m_Strip);
+  }
+
+private:
+  DivideAndConquerDelaunay2D& m_Triangulator;
+  size_t m_Strip = 0;
+};
+
+/**
+ * @brief The MergeStripsImpl class merges two neighboring groups of strips of a DivideAndConquerDelaunay2D
+ */
+class MergeStripsImpl
+{
+public:
+  MergeStripsImpl(DivideAndConquerDelaunay2D& triangulator, size_t left, size_t stride)
+  : m_Triangulator(triangulator)
+  , m_Left(left)
+  , m_Stride(stride)
+  {
+  }
+
+  void operator()() const
+  {
+    m_Triangulator.mergeStrips(m_Left, m_Stride);
+  }
+
+private:
+  DivideAndConquerDelaunay2D& m_Triangulator;
+  size_t m_Left = 0;
+  size_t m_Stride = 1;
+};
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 Delaunay2D::Delaunay2D(TriMesh::VertexCoordList vertices, double offset, double tolerance, double alpha, Observable* observable)
-: m_Vertices(vertices)
+: m_Vertices(std::move(vertices))
 , m_Offset(offset)
 , m_Tolerance(tolerance)
 , m_Alpha(alpha)
@@ -49,28 +112,17 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
 
   if(m_Observer != nullptr)
   {
-    connect(this, SIGNAL(filterGeneratedMessage(const PipelineMessage&)), m_Observer, SLOT(broadcastPipelineMessage(const PipelineMessage&)));
+    // Relay the status messages through the observer so that they reach whatever listens to it
+    connect(this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), m_Observer, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), Qt::UniqueConnection);
   }
 
   /* Eigen::Transform<double, 3, Eigen::Affine> transform = */ findProjectionPlane();
 
-  TriMesh::VertexCoordList projectedVertices(m_Vertices);
-
+  // The projection onto the best fit plane is currently disabled, so the input
+  // vertices are triangulated in place rather than copied into a projected list
   auto numVerts = m_Vertices.size();
 
-  for(size_t v = 0; v < numVerts; v++)
-  {
-    Eigen::Vector3d point(m_Vertices[v][0], m_Vertices[v][1], m_Vertices[v][2]);
-    // Eigen::Vector3d transformedPoint = transform * point;
-    // projectedVertices[v][0] = transformedPoint(0);
-    // projectedVertices[v][1] = transformedPoint(1);
-    // projectedVertices[v][2] = transformedPoint(2);
-    projectedVertices[v][0] = point(0);
-    projectedVertices[v][1] = point(1);
-    projectedVertices[v][2] = point(2);
-  }
-
-  findPointBounds(projectedVertices);
+  findPointBounds(m_Vertices);
 
   double center[3];
   center[0] = (m_PointBounds[0] + m_PointBounds[1]) / 2.0;
@@ -89,17 +141,36 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
   double radius = m_Offset * tol;
   tol *= m_Tolerance;
 
+  if(m_Algorithm == Algorithm::DivideAndConquer)
+  {
+    return triangulateDivideAndConquer(tol);
+  }
+
   double x[3];
 
+  m_Delaunay = TriMesh::New(m_Vertices);
+
+  // Inserting in a spatially coherent order keeps the walk in findTriangle short;
+  // the vertex ids written into the mesh are always the original ones
+  std::vector<int64_t> insertionOrder;
+  if(m_InsertionOrder == InsertionOrder::SpatiallySorted)
+  {
+    insertionOrder = SpatialSort::BiasedRandomizedInsertionOrder(m_Vertices);
+  }
+  else
+  {
+    insertionOrder.resize(numVerts);
+    std::iota(insertionOrder.begin(), insertionOrder.end(), 0);
+  }
+
   for(size_t ptId = 0; ptId < 8; ptId++)
   {
     x[0] = center[0] + radius * cos(ptId * 45.0 * SIMPLib::Constants::k_PiOver180D);
     x[1] = center[1] + radius * sin(ptId * 45.0 * SIMPLib::Constants::k_PiOver180D);
     x[2] = center[2];
-    projectedVertices.emplace_back(std::initializer_list<float>{float(x[0]), float(x[1]), float(x[2])});
+    m_Delaunay->addVertex(float(x[0]), float(x[1]), float(x[2]));
   }
 
-  m_Delaunay = TriMesh::New(projectedVertices);
   m_Delaunay->addTriangle(numVerts + 0, numVerts + 1, numVerts + 2);
   m_Delaunay->addTriangle(numVerts + 2, numVerts + 3, numVerts + 4);
   m_Delaunay->addTriangle(numVerts + 4, numVerts + 5, numVerts + 6);
@@ -118,15 +189,20 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
   tri[0] = 0;
 
   int64_t progIncrement = static_cast<int64_t>(numVerts / 100);
-  int64_t prog = 1;
+  int64_t prog = numVerts >= k_MinProgressVertices ? 1 : std::numeric_limits<int64_t>::max();
   int64_t progressInt = 0;
   int64_t counter = 0;
 
-  for(int64_t ptId = 0; ptId < int64_t(numVerts); ptId++)
+  for(const auto& ptId : insertionOrder)
   {
-    x[0] = projectedVertices[ptId][0];
-    x[1] = projectedVertices[ptId][1];
-    x[2] = projectedVertices[ptId][2];
+    if(counter % 1024 == 0 && isCanceled())
+    {
+      return TriangleGeom::NullPointer();
+    }
+
+    x[0] = m_Vertices[ptId][0];
+    x[1] = m_Vertices[ptId][1];
+    x[2] = m_Vertices[ptId][2];
 
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -232,8 +308,7 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
 
   for(int64_t ptId = numVerts; ptId < int64_t((numVerts + 8)); ptId++)
   {
-    std::vector<int64_t> neighborTris = m_Delaunay->getTrianglesToVertex(ptId);
-    for(auto&& neighbor : neighborTris)
+    for(const auto& neighbor : m_Delaunay->getTriangleLinks(ptId))
     {
       triUse[neighbor] = 0;
     }
@@ -371,14 +446,7 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
   //}
   ////alpha end
 
-  fixupBoundaryTriangles(numVerts, projectedVertices, triUse);
-
-  // Remove the 8 bounding triangle vertices
-  TriMesh::VertexList delVerts = m_Delaunay->getVertices();
-  for(size_t i = numVerts; i < 8; i++)
-  {
-    delVerts.pop_back();
-  }
+  fixupBoundaryTriangles(numVerts, triUse);
 
   // std::vector<int64_t> vertsToRemove(8);
   // std::iota(vertsToRemove.begin(), vertsToRemove.end(), numVerts);
@@ -394,18 +462,13 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
     }
   }
 
-  std::vector<std::vector<float>> untransformedVerts;
-  for(auto i = 0; i < numVerts; i++)
-  {
-    untransformedVerts.push_back(delVerts[i].vert);
-  }
-
-  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(untransformedVerts.size());
+  // The 8 bounding vertices are the last ones in the mesh, so only the first numVerts are kept
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(numVerts);
   TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(numGoodTris, vertices, SIMPL::Geometry::TriangleGeometry);
   float* vertPtr = triangles->getVertexPointer(0);
   size_t* triPtr = triangles->getTriPointer(0);
 
-  TriMesh::TriList triList = m_Delaunay->getTriangles();
+  const TriMesh::TriList& triList = m_Delaunay->getTriangles();
 
   size_t triIter = 0;
   int64_t triVerts[3];
@@ -422,16 +485,11 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
     }
   }
 
-  for(auto i = 0; i < untransformedVerts.size(); i++)
+  for(size_t i = 0; i < numVerts; i++)
   {
-    Eigen::Vector3d point(untransformedVerts[i][0], untransformedVerts[i][1], untransformedVerts[i][2]);
+    // Eigen::Vector3d point(vertPtr[3 * i + 0], vertPtr[3 * i + 1], vertPtr[3 * i + 2]);
     // Eigen::Vector3d transformedPoint = transform.inverse() * point;
-    // vertPtr[3 * i + 0] = transformedPoint(0);
-    // vertPtr[3 * i + 1] = transformedPoint(1);
-    // vertPtr[3 * i + 2] = transformedPoint(2);
-    vertPtr[3 * i + 0] = point(0);
-    vertPtr[3 * i + 1] = point(1);
-    vertPtr[3 * i + 2] = point(2);
+    m_Delaunay->getVertexCoordinates(i, vertPtr + 3 * i);
   }
 
   return triangles;
@@ -440,87 +498,175 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t Delaunay2D::findTriangle(double x[3], int64_t tri, double tol, int64_t nei[3], int64_t pts[3])
+TriangleGeom::Pointer Delaunay2D::triangulateDivideAndConquer(double tol)
 {
-  int i, j, ir, ic, inside, i2, i3;
-  int64_t newNei;
-  double p[3][3], n[2], vp[2], vx[2], dp, minProj;
+  size_t numVerts = m_Vertices.size();
+  size_t numStrips = std::max(std::thread::hardware_concurrency(), 1U);
+  numStrips = std::min(numStrips, std::max<size_t>(numVerts / k_MinStripSize, 1));
 
-  m_Delaunay->getTriangleVertices(tri, pts);
-  m_Delaunay->getVertexCoordinates(pts[0], p[0]);
-  m_Delaunay->getVertexCoordinates(pts[1], p[1]);
-  m_Delaunay->getVertexCoordinates(pts[2], p[2]);
+  DivideAndConquerDelaunay2D triangulator(m_Vertices, tol, numStrips);
+  m_NumDuplicatePoints = triangulator.getNumberOfDuplicatePoints();
+  numStrips = triangulator.getNumberOfStrips();
+  bool reportProgress = (numVerts >= k_MinProgressVertices);
 
-  srand(tri);
-  ir = rand() % 3;
-  const double del2D_tolerance = 1.0e-014;
+  if(reportProgress)
+  {
+    notifyStatusMessage(m_MessageTitle + QObject::tr(" || Triangulating %1 Strips").arg(numStrips));
+  }
 
-  for(inside = 1, minProj = del2D_tolerance, ic = 0; ic < 3; ic++)
   {
-    i = (ir + ic) % 3;
-    i2 = (i + 1) % 3;
-    i3 = (i + 2) % 3;
-
-    // create a 2D edge normal to define a "half-space"; evaluate points (i.e.,
-    // candidate point and other triangle vertex not on this edge).
-    n[0] = -(p[i2][1] - p[i][1]);
-    n[1] = p[i2][0] - p[i][0];
-    Normalize2x1(n);
-
-    // compute local vectors
-    for(j = 0; j < 2; j++)
+    ParallelTaskAlgorithm taskRunner;
+    taskRunner.setParallelizationEnabled(true);
+    for(size_t strip = 0; strip < numStrips; strip++)
     {
-      vp[j] = p[i3][j] - p[i][j];
-      vx[j] = x[j] - p[i][j];
+      taskRunner.execute(TriangulateStripImpl(triangulator, strip));
     }
+    taskRunner.wait();
+  }
 
-    // check for duplicate point
-    Normalize2x1(vp);
-    if(Normalize2x1(vx) <= tol)
+  // Merge neighboring strips pairwise; the merges of one level are independent
+  for(size_t stride = 1; stride < numStrips; stride *= 2)
+  {
+    if(isCanceled())
     {
-      m_NumDuplicatePoints++;
-      return -1;
+      return TriangleGeom::NullPointer();
+    }
+    if(reportProgress)
+    {
+      notifyStatusMessage(m_MessageTitle + QObject::tr(" || Merging %1 Strips").arg(numStrips / stride));
     }
 
-    // see if two points are in opposite half spaces
-    dp = Dot2D(n, vx) * (Dot2D(n, vp) < 0 ? -1.0 : 1.0);
-    if(dp < del2D_tolerance)
+    ParallelTaskAlgorithm taskRunner;
+    taskRunner.setParallelizationEnabled(true);
+    for(size_t left = 0; left < numStrips; left += 2 * stride)
     {
-      if(dp < minProj) // track edge most orthogonal to point direction
-      {
-        inside = 0;
-        nei[1] = pts[i];
-        nei[2] = pts[i2];
-        minProj = dp;
-      }
-    } // outside this edge
-  }   // for each edge
+      taskRunner.execute(MergeStripsImpl(triangulator, left, stride));
+    }
+    taskRunner.wait();
+  }
+
+  if(isCanceled())
+  {
+    return TriangleGeom::NullPointer();
+  }
+
+  std::vector<int64_t> triList = triangulator.getTriangles();
+  size_t numTris = triList.size() / 3;
 
-  if(inside != 0) // all edges have tested positive
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(numVerts);
+  TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(numTris, vertices, SIMPL::Geometry::TriangleGeometry);
+  float* vertPtr = triangles->getVertexPointer(0);
+  size_t* triPtr = triangles->getTriPointer(0);
+
+  for(size_t i = 0; i < triList.size(); i++)
   {
-    nei[0] = (-1);
-    return tri;
+    triPtr[i] = static_cast<size_t>(triList[i]);
   }
 
-  if(!inside && (fabs(minProj) < del2D_tolerance)) // on edge
+  for(size_t i = 0; i < numVerts; i++)
   {
-    nei[0] = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
-    return tri;
+    vertPtr[3 * i + 0] = m_Vertices[i][0];
+    vertPtr[3 * i + 1] = m_Vertices[i][1];
+    vertPtr[3 * i + 2] = m_Vertices[i][2];
   }
 
-  else // walk towards point
+  return triangles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool Delaunay2D::isCanceled() const
+{
+  return m_Filter != nullptr && m_Filter->getCancel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t Delaunay2D::findTriangle(double x[3], int64_t tri, double tol, int64_t nei[3], int64_t pts[3])
+{
+  int i, j, ir, ic, inside, i2, i3;
+  int64_t newNei;
+  double p[3][3], n[2], vp[2], vx[2], dp, minProj;
+  const double del2D_tolerance = 1.0e-014;
+
+  // Walk towards the point one triangle at a time; this is a loop rather than
+  // recursion since walks over sorted or clustered input can be very long
+  while(true)
   {
+    m_Delaunay->getTriangleVertices(tri, pts);
+    m_Delaunay->getVertexCoordinates(pts[0], p[0]);
+    m_Delaunay->getVertexCoordinates(pts[1], p[1]);
+    m_Delaunay->getVertexCoordinates(pts[2], p[2]);
+
+    // Pick the first edge to test from a hash of the triangle id, which avoids
+    // cycling during the walk without touching the global rand() state
+    ir = static_cast<int>((static_cast<uint64_t>(tri) * 0x9E3779B97F4A7C15ULL) >> 33) % 3;
+
+    for(inside = 1, minProj = del2D_tolerance, ic = 0; ic < 3; ic++)
+    {
+      i = (ir + ic) % 3;
+      i2 = (i + 1) % 3;
+      i3 = (i + 2) % 3;
+
+      // create a 2D edge normal to define a "half-space"; evaluate points (i.e.,
+      // candidate point and other triangle vertex not on this edge).
+      n[0] = -(p[i2][1] - p[i][1]);
+      n[1] = p[i2][0] - p[i][0];
+      Normalize2x1(n);
+
+      // compute local vectors
+      for(j = 0; j < 2; j++)
+      {
+        vp[j] = p[i3][j] - p[i][j];
+        vx[j] = x[j] - p[i][j];
+      }
+
+      // check for duplicate point
+      Normalize2x1(vp);
+      if(Normalize2x1(vx) <= tol)
+      {
+        m_NumDuplicatePoints++;
+        return -1;
+      }
+
+      // see if two points are in opposite half spaces
+      dp = Dot2D(n, vx) * (Dot2D(n, vp) < 0 ? -1.0 : 1.0);
+      if(dp < del2D_tolerance)
+      {
+        if(dp < minProj) // track edge most orthogonal to point direction
+        {
+          inside = 0;
+          nei[1] = pts[i];
+          nei[2] = pts[i2];
+          minProj = dp;
+        }
+      } // outside this edge
+    }   // for each edge
+
+    if(inside != 0) // all edges have tested positive
+    {
+      nei[0] = (-1);
+      return tri;
+    }
+
+    if(!inside && (fabs(minProj) < del2D_tolerance)) // on edge
+    {
+      nei[0] = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
+      return tri;
+    }
+
+    // walk towards point
     newNei = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
     if(newNei == nei[0])
     {
       m_NumDegeneracies++;
       return -1;
     }
-    else
-    {
-      nei[0] = tri;
-      return findTriangle(x, newNei, tol, nei, pts);
-    }
+
+    nei[0] = tri;
+    tri = newNei;
   }
 }
 
@@ -571,7 +717,7 @@ void Delaunay2D::checkEdge(int64_t point, double x[3], int64_t p1, int64_t p2, i
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Delaunay2D::findPointBounds(TriMesh::VertexCoordList& vertices)
+void Delaunay2D::findPointBounds(const TriMesh::VertexCoordList& vertices)
 {
   for(auto&& vert : vertices)
   {
@@ -605,7 +751,7 @@ void Delaunay2D::findPointBounds(TriMesh::VertexCoordList& vertices)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordList& points, std::vector<int64_t>& triUse)
+void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, std::vector<int64_t>& triUse)
 {
   bool isConnected;
   int64_t numSwaps = 0;
@@ -1056,6 +1202,22 @@ QString Delaunay2D::getMessageTitle() const
   return m_MessageTitle;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Delaunay2D::setInsertionOrder(const InsertionOrder& value)
+{
+  m_InsertionOrder = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Delaunay2D::InsertionOrder Delaunay2D::getInsertionOrder() const
+{
+  return m_InsertionOrder;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1071,3 +1233,35 @@ Observable* Delaunay2D::getObserver() const
 {
   return m_Observer;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Delaunay2D::setAlgorithm(const Algorithm& value)
+{
+  m_Algorithm = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Delaunay2D::Algorithm Delaunay2D::getAlgorithm() const
+{
+  return m_Algorithm;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Delaunay2D::setFilter(AbstractFilter* value)
+{
+  m_Filter = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter* Delaunay2D::getFilter() const
+{
+  return m_Filter;
+}
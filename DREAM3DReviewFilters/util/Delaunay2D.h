@@ -2,6 +2,7 @@
 
 #include <Eigen/Geometry>
 
+#include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "DREAM3DReviewFilters/util/TriMesh.h"
@@ -21,9 +22,27 @@ public:
 
   ~Delaunay2D() override;
 
+  /**
+   * @brief The order in which the vertices are inserted into the triangulation
+   */
+  enum class InsertionOrder : int32_t
+  {
+    Input = 0,          //!< Insert the vertices in the order given
+    SpatiallySorted = 1 //!< Biased randomized insertion order with Hilbert curve sorted rounds
+  };
+
+  /**
+   * @brief The algorithm used to build the triangulation
+   */
+  enum class Algorithm : int32_t
+  {
+    Incremental = 0,     //!< Insert the vertices one at a time into a bounding triangulation
+    DivideAndConquer = 1 //!< Triangulate sorted strips concurrently and merge them (Guibas-Stolfi)
+  };
+
   static Pointer New(TriMesh::VertexCoordList vertices, double offset, double tolerance, double alpha, Observable* observable = nullptr)
   {
-    Pointer sharedPtr(new Delaunay2D(vertices, offset, tolerance, alpha, observable));
+    Pointer sharedPtr(new Delaunay2D(std::move(vertices), offset, tolerance, alpha, observable));
     return sharedPtr;
   }
 
@@ -93,6 +112,39 @@ public:
    */
   QString getMessageTitle() const;
 
+  /**
+   * @brief Setter property for InsertionOrder
+   */
+  void setInsertionOrder(const InsertionOrder& value);
+
+  /**
+   * @brief Getter property for InsertionOrder
+   * @return Value of InsertionOrder
+   */
+  InsertionOrder getInsertionOrder() const;
+
+  /**
+   * @brief Setter property for Algorithm
+   */
+  void setAlgorithm(const Algorithm& value);
+
+  /**
+   * @brief Getter property for Algorithm
+   * @return Value of Algorithm
+   */
+  Algorithm getAlgorithm() const;
+
+  /**
+   * @brief Setter property for Filter, which is polled for cancellation
+   */
+  void setFilter(AbstractFilter* value);
+
+  /**
+   * @brief Getter property for Filter
+   * @return Value of Filter
+   */
+  AbstractFilter* getFilter() const;
+
   /**
    * @brief Setter property for Observer
    */
@@ -104,6 +156,10 @@ public:
    */
   Observable* getObserver() const;
 
+  /**
+   * @brief triangulate Triangulates the XY projection of the vertices with the selected algorithm
+   * @return The triangulation, or a null pointer if the filter was canceled
+   */
   TriangleGeom::Pointer triangulate();
 
 protected:
@@ -116,7 +172,10 @@ private:
   double m_Alpha = {};
   QString m_MessagePrefix = {};
   QString m_MessageTitle = {};
+  InsertionOrder m_InsertionOrder = InsertionOrder::SpatiallySorted;
+  Algorithm m_Algorithm = Algorithm::Incremental;
   Observable* m_Observer = nullptr;
+  AbstractFilter* m_Filter = nullptr;
 
   double m_PointBounds[6];
   TriMesh::Pointer m_Delaunay;
@@ -125,13 +184,17 @@ private:
 
   void initialize();
 
+  bool isCanceled() const;
+
+  TriangleGeom::Pointer triangulateDivideAndConquer(double tol);
+
   int64_t findTriangle(double x[3], int64_t tri, double tol, int64_t nei[3], int64_t pts[3]);
 
   void checkEdge(int64_t point, double x[3], int64_t p1, int64_t p2, int64_t tri, bool recursive);
 
-  void findPointBounds(TriMesh::VertexCoordList& vertices);
+  void findPointBounds(const TriMesh::VertexCoordList& vertices);
 
-  void fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordList& points, std::vector<int64_t>& triUse);
+  void fixupBoundaryTriangles(int64_t numVerts, std::vector<int64_t>& triUse);
 
   double circumcircle(double a[2], double b[2], double c[2], double center[2]);
 
@@ -0,0 +1,447 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The DivideAndConquerDelaunay2D class computes the Delaunay triangulation of the XY projection of a
+ * set of points with the Guibas-Stolfi divide and conquer algorithm on a quad-edge structure.  The points are
+ * sorted by (x, y) and split into numStrips contiguous runs, which are vertical strips of the point set.  Each
+ * strip is triangulated independently by triangulateStrip(), so the strips may be triangulated concurrently,
+ * and neighboring strips are then stitched together pairwise by mergeStrips(); the merges of one level are
+ * also independent of each other.  The result covers the convex hull of the points, and the triangles always
+ * reference the original point ids.  Points that coincide, or that follow each other in the sorted order
+ * closer than the tolerance in both x and y, are triangulated only once.
+ *
+ * Each strip owns the storage of the edges it creates, and a merge allocates from the left strip's storage,
+ * so different strips, and different merges of one level, never touch the same storage.
+ */
+class DivideAndConquerDelaunay2D
+{
+public:
+  /**
+   * @brief Constructs the triangulator; the container only needs to support vertices[i][0] and vertices[i][1]
+   * @param vertices
+   * @param tolerance
+   * @param numStrips Requested number of strips; it is rounded down to a power of two and reduced until
+   * every strip has at least 4 points
+   */
+  template <typename VertexContainer>
+  DivideAndConquerDelaunay2D(const VertexContainer& vertices, double tolerance, size_t numStrips)
+  {
+    // The points are stored in sorted order, so that the recursion reads neighboring memory, and the
+    // quad-edges refer to sorted positions; m_Ids maps them back to the original point ids
+    const size_t numVerts = vertices.size();
+    std::vector<int64_t> order(numVerts);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&vertices](int64_t a, int64_t b) {
+      return vertices[a][0] < vertices[b][0] || (vertices[a][0] == vertices[b][0] && vertices[a][1] < vertices[b][1]);
+    });
+    auto last = std::unique(order.begin(), order.end(), [&vertices, tolerance](int64_t a, int64_t b) {
+      return std::abs(static_cast<double>(vertices[a][0]) - static_cast<double>(vertices[b][0])) <= tolerance &&
+             std::abs(static_cast<double>(vertices[a][1]) - static_cast<double>(vertices[b][1])) <= tolerance;
+    });
+    m_NumDuplicatePoints = static_cast<size_t>(order.end() - last);
+    order.erase(last, order.end());
+
+    m_Ids = std::move(order);
+    m_Coords.resize(2 * m_Ids.size());
+    for(size_t i = 0; i < m_Ids.size(); i++)
+    {
+      m_Coords[2 * i + 0] = static_cast<double>(vertices[m_Ids[i]][0]);
+      m_Coords[2 * i + 1] = static_cast<double>(vertices[m_Ids[i]][1]);
+    }
+
+    size_t strips = 1;
+    while(strips * 2 <= numStrips && m_Ids.size() >= strips * 2 * 4)
+    {
+      strips *= 2;
+    }
+    m_StripBegin.resize(strips + 1);
+    for(size_t s = 0; s <= strips; s++)
+    {
+      m_StripBegin[s] = s * m_Ids.size() / strips;
+    }
+    m_Storage.resize(strips);
+    m_Hulls.resize(strips, {nullptr, nullptr});
+  }
+
+  ~DivideAndConquerDelaunay2D() = default;
+
+  DivideAndConquerDelaunay2D(const DivideAndConquerDelaunay2D&) = delete;            // Copy Constructor Not Implemented
+  DivideAndConquerDelaunay2D(DivideAndConquerDelaunay2D&&) = delete;                 // Move Constructor Not Implemented
+  DivideAndConquerDelaunay2D& operator=(const DivideAndConquerDelaunay2D&) = delete; // Copy Assignment Not Implemented
+  DivideAndConquerDelaunay2D& operator=(DivideAndConquerDelaunay2D&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief getNumberOfStrips Returns the number of strips, which is always a power of two
+   * @return Number of strips
+   */
+  size_t getNumberOfStrips() const
+  {
+    return m_Hulls.size();
+  }
+
+  /**
+   * @brief getNumberOfDuplicatePoints Returns the number of points that were skipped as duplicates
+   * @return Number of duplicate points
+   */
+  size_t getNumberOfDuplicatePoints() const
+  {
+    return m_NumDuplicatePoints;
+  }
+
+  /**
+   * @brief triangulateStrip Triangulates the points of one strip
+   * @param strip
+   */
+  void triangulateStrip(size_t strip)
+  {
+    if(m_Ids.size() < 2)
+    {
+      return;
+    }
+    m_Hulls[strip] = triangulateRange(m_StripBegin[strip], m_StripBegin[strip + 1], m_Storage[strip]);
+  }
+
+  /**
+   * @brief mergeStrips Stitches the triangulation of the strips [left, left + stride) to that of the strips
+   * [left + stride, left + 2 * stride); the result is stored with the left strip.  Merging every left that is a
+   * multiple of 2 * stride for stride = 1, 2, 4, ... combines all strips into strip 0
+   * @param left
+   * @param stride
+   */
+  void mergeStrips(size_t left, size_t stride)
+  {
+    size_t right = left + stride;
+    if(right >= m_Hulls.size() || m_Hulls[left].first == nullptr)
+    {
+      return;
+    }
+    m_Hulls[left] = merge(m_Hulls[left], m_Hulls[right], m_Storage[left]);
+  }
+
+  /**
+   * @brief triangulate Triangulates and merges all strips serially
+   */
+  void triangulate()
+  {
+    for(size_t s = 0; s < m_Hulls.size(); s++)
+    {
+      triangulateStrip(s);
+    }
+    for(size_t stride = 1; stride < m_Hulls.size(); stride *= 2)
+    {
+      for(size_t left = 0; left < m_Hulls.size(); left += 2 * stride)
+      {
+        mergeStrips(left, stride);
+      }
+    }
+  }
+
+  /**
+   * @brief getTriangles Returns the counter-clockwise triangles as 3 original point ids each; all strips
+   * must have been merged
+   * @return Triangle point ids
+   */
+  std::vector<int64_t> getTriangles() const
+  {
+    std::vector<int64_t> triangles;
+    for(const auto& storage : m_Storage)
+    {
+      for(const auto& quadEdge : storage)
+      {
+        for(size_t i = 0; i < 4; i += 2)
+        {
+          const Edge* e = &quadEdge.e[i];
+          if(e->m_Origin < 0)
+          {
+            continue;
+          }
+          const Edge* e1 = e->lnext();
+          const Edge* e2 = e1->lnext();
+          if(e2->lnext() != e)
+          {
+            continue;
+          }
+          int64_t a = e->m_Origin;
+          int64_t b = e1->m_Origin;
+          int64_t c = e2->m_Origin;
+          // Each triangle is reported once, from its edge leaving the first point; the outer face of a
+          // three point hull is also a cycle of three edges but is clockwise
+          if(a < b && a < c && ccw(a, b, c))
+          {
+            triangles.push_back(m_Ids[a]);
+            triangles.push_back(m_Ids[b]);
+            triangles.push_back(m_Ids[c]);
+          }
+        }
+      }
+    }
+    return triangles;
+  }
+
+private:
+  struct Edge
+  {
+    Edge* m_Next = nullptr;
+    int64_t m_Origin = -1;
+    int32_t m_Index = 0;
+
+    Edge* rot()
+    {
+      return m_Index < 3 ? this + 1 : this - 3;
+    }
+    const Edge* rot() const
+    {
+      return m_Index < 3 ? this + 1 : this - 3;
+    }
+    Edge* invRot()
+    {
+      return m_Index > 0 ? this - 1 : this + 3;
+    }
+    const Edge* invRot() const
+    {
+      return m_Index > 0 ? this - 1 : this + 3;
+    }
+    Edge* sym()
+    {
+      return m_Index < 2 ? this + 2 : this - 2;
+    }
+    Edge* onext()
+    {
+      return m_Next;
+    }
+    Edge* oprev()
+    {
+      return rot()->onext()->rot();
+    }
+    Edge* lnext()
+    {
+      return invRot()->onext()->rot();
+    }
+    const Edge* lnext() const
+    {
+      return invRot()->m_Next->rot();
+    }
+    Edge* rprev()
+    {
+      return sym()->onext();
+    }
+    int64_t dest()
+    {
+      return sym()->m_Origin;
+    }
+  };
+
+  struct QuadEdge
+  {
+    Edge e[4];
+  };
+
+  using EdgeStorage = std::deque<QuadEdge>;
+  using Hull = std::pair<Edge*, Edge*>; // counter-clockwise edge out of the leftmost point, clockwise edge out of the rightmost point
+
+  std::vector<double> m_Coords;
+  std::vector<int64_t> m_Ids;
+  std::vector<size_t> m_StripBegin;
+  std::vector<EdgeStorage> m_Storage;
+  std::vector<Hull> m_Hulls;
+  size_t m_NumDuplicatePoints = 0;
+
+  static Edge* makeEdge(EdgeStorage& storage, int64_t origin, int64_t dest)
+  {
+    storage.emplace_back();
+    Edge* e = storage.back().e;
+    for(int32_t i = 0; i < 4; i++)
+    {
+      e[i].m_Index = i;
+    }
+    e[0].m_Next = &e[0];
+    e[1].m_Next = &e[3];
+    e[2].m_Next = &e[2];
+    e[3].m_Next = &e[1];
+    e[0].m_Origin = origin;
+    e[2].m_Origin = dest;
+    return e;
+  }
+
+  static void splice(Edge* a, Edge* b)
+  {
+    Edge* alpha = a->onext()->rot();
+    Edge* beta = b->onext()->rot();
+    std::swap(a->m_Next, b->m_Next);
+    std::swap(alpha->m_Next, beta->m_Next);
+  }
+
+  static Edge* connect(EdgeStorage& storage, Edge* a, Edge* b)
+  {
+    Edge* e = makeEdge(storage, a->dest(), b->m_Origin);
+    splice(e, a->lnext());
+    splice(e->sym(), b);
+    return e;
+  }
+
+  static void deleteEdge(Edge* e)
+  {
+    splice(e, e->oprev());
+    splice(e->sym(), e->sym()->oprev());
+    e->m_Origin = -1;
+    e->sym()->m_Origin = -1;
+  }
+
+  bool ccw(int64_t a, int64_t b, int64_t c) const
+  {
+    const double* pa = &m_Coords[2 * a];
+    const double* pb = &m_Coords[2 * b];
+    const double* pc = &m_Coords[2 * c];
+    return (pb[0] - pa[0]) * (pc[1] - pa[1]) - (pb[1] - pa[1]) * (pc[0] - pa[0]) > 0.0;
+  }
+
+  bool rightOf(int64_t x, Edge* e) const
+  {
+    return ccw(x, e->dest(), e->m_Origin);
+  }
+
+  bool leftOf(int64_t x, Edge* e) const
+  {
+    return ccw(x, e->m_Origin, e->dest());
+  }
+
+  /**
+   * @brief inCircle Returns true if d lies strictly inside the circle through the counter-clockwise a, b, c
+   */
+  bool inCircle(int64_t a, int64_t b, int64_t c, int64_t d) const
+  {
+    const double* pd = &m_Coords[2 * d];
+    double ax = m_Coords[2 * a] - pd[0];
+    double ay = m_Coords[2 * a + 1] - pd[1];
+    double bx = m_Coords[2 * b] - pd[0];
+    double by = m_Coords[2 * b + 1] - pd[1];
+    double cx = m_Coords[2 * c] - pd[0];
+    double cy = m_Coords[2 * c + 1] - pd[1];
+    double a2 = ax * ax + ay * ay;
+    double b2 = bx * bx + by * by;
+    double c2 = cx * cx + cy * cy;
+    return a2 * (bx * cy - by * cx) - b2 * (ax * cy - ay * cx) + c2 * (ax * by - ay * bx) > 0.0;
+  }
+
+  Hull triangulateRange(size_t begin, size_t end, EdgeStorage& storage)
+  {
+    const size_t count = end - begin;
+    if(count == 2)
+    {
+      Edge* a = makeEdge(storage, static_cast<int64_t>(begin), static_cast<int64_t>(begin + 1));
+      return {a, a->sym()};
+    }
+    if(count == 3)
+    {
+      int64_t s0 = static_cast<int64_t>(begin);
+      int64_t s1 = s0 + 1;
+      int64_t s2 = s0 + 2;
+      Edge* a = makeEdge(storage, s0, s1);
+      Edge* b = makeEdge(storage, s1, s2);
+      splice(a->sym(), b);
+      if(ccw(s0, s1, s2))
+      {
+        connect(storage, b, a);
+        return {a, b->sym()};
+      }
+      if(ccw(s0, s2, s1))
+      {
+        Edge* c = connect(storage, b, a);
+        return {c->sym(), c};
+      }
+      return {a, b->sym()};
+    }
+
+    size_t mid = begin + count / 2;
+    Hull left = triangulateRange(begin, mid, storage);
+    Hull right = triangulateRange(mid, end, storage);
+    return merge(left, right, storage);
+  }
+
+  Hull merge(Hull left, Hull right, EdgeStorage& storage)
+  {
+    Edge* ldo = left.first;
+    Edge* ldi = left.second;
+    Edge* rdi = right.first;
+    Edge* rdo = right.second;
+
+    // Lower common tangent of the two hulls
+    while(true)
+    {
+      if(leftOf(rdi->m_Origin, ldi))
+      {
+        ldi = ldi->lnext();
+      }
+      else if(rightOf(ldi->m_Origin, rdi))
+      {
+        rdi = rdi->rprev();
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    Edge* basel = connect(storage, rdi->sym(), ldi);
+    if(ldi->m_Origin == ldo->m_Origin)
+    {
+      ldo = basel->sym();
+    }
+    if(rdi->m_Origin == rdo->m_Origin)
+    {
+      rdo = basel;
+    }
+
+    // Zip the two triangulations together from the bottom up
+    while(true)
+    {
+      Edge* lcand = basel->sym()->onext();
+      if(rightOf(lcand->dest(), basel))
+      {
+        while(inCircle(basel->dest(), basel->m_Origin, lcand->dest(), lcand->onext()->dest()))
+        {
+          Edge* t = lcand->onext();
+          deleteEdge(lcand);
+          lcand = t;
+        }
+      }
+
+      Edge* rcand = basel->oprev();
+      if(rightOf(rcand->dest(), basel))
+      {
+        while(inCircle(basel->dest(), basel->m_Origin, rcand->dest(), rcand->oprev()->dest()))
+        {
+          Edge* t = rcand->oprev();
+          deleteEdge(rcand);
+          rcand = t;
+        }
+      }
+
+      bool lvalid = rightOf(lcand->dest(), basel);
+      bool rvalid = rightOf(rcand->dest(), basel);
+      if(!lvalid && !rvalid)
+      {
+        break;
+      }
+
+      if(!lvalid || (rvalid && inCircle(lcand->dest(), lcand->m_Origin, rcand->m_Origin, rcand->dest())))
+      {
+        basel = connect(storage, rcand, basel->sym());
+      }
+      else
+      {
+        basel = connect(storage, basel->sym(), lcand->sym());
+      }
+    }
+
+    return {ldo, rdo};
+  }
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief The EuclideanDistanceTransform namespace holds an exact, separable Euclidean distance transform
+ * for image geometries (Felzenszwalb & Huttenlocher, "Distance Transforms of Sampled Functions").  The
+ * squared distance is computed with one lower envelope of parabolas per grid line and per axis, so the
+ * whole transform is linear in the number of voxels and each axis pass is parallel over its lines.
+ */
+namespace EuclideanDistanceTransform
+{
+/**
+ * @brief LowerEnvelope1D Computes the 1D squared distance transform of a sampled function along one grid
+ * line and carries the nearest seed index along with it.  Samples with an infinite value are ignored; if every
+ * sample is infinite the output is infinite and the nearest seed is -1.
+ * @param f Input squared distances along the line
+ * @param seeds Nearest seed index of each input sample
+ * @param n Number of samples along the line
+ * @param spacing Physical distance between samples
+ * @param d Output squared distances
+ * @param nearest Output nearest seed indices
+ * @param v Scratch buffer of at least n entries
+ * @param z Scratch buffer of at least n + 1 entries
+ */
+inline void LowerEnvelope1D(const double* f, const int64_t* seeds, int64_t n, double spacing, double* d, int64_t* nearest, int64_t* v, double* z)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const double spacing2 = spacing * spacing;
+  auto intersection = [&](int64_t q, int64_t p) { return ((f[q] + spacing2 * q * q) - (f[p] + spacing2 * p * p)) / (2.0 * spacing2 * (q - p)); };
+
+  int64_t k = -1;
+  for(int64_t q = 0; q < n; q++)
+  {
+    if(f[q] == inf)
+    {
+      continue;
+    }
+    while(k >= 0 && intersection(q, v[k]) <= z[k])
+    {
+      k--;
+    }
+    if(k < 0)
+    {
+      k = 0;
+      z[0] = -inf;
+    }
+    else
+    {
+      double s = intersection(q, v[k]);
+      k++;
+      z[k] = s;
+    }
+    v[k] = q;
+    z[k + 1] = inf;
+  }
+
+  if(k < 0)
+  {
+    for(int64_t p = 0; p < n; p++)
+    {
+      d[p] = inf;
+      nearest[p] = -1;
+    }
+    return;
+  }
+
+  k = 0;
+  for(int64_t p = 0; p < n; p++)
+  {
+    while(z[k + 1] < static_cast<double>(p))
+    {
+      k++;
+    }
+    double delta = static_cast<double>(p - v[k]);
+    d[p] = spacing2 * delta * delta + f[v[k]];
+    nearest[p] = seeds[v[k]];
+  }
+}
+
+/**
+ * @brief The AxisPassImpl class runs the 1D transform over a range of the grid lines parallel to one axis.
+ * Each invocation gathers a line into contiguous scratch buffers, so the lines may be split freely between threads.
+ */
+class AxisPassImpl
+{
+public:
+  AxisPassImpl(const std::array<int64_t, 3>& dims, double spacing, size_t axis, double* sqDistances, int64_t* nearest)
+  : m_Dims(dims)
+  , m_Spacing(spacing)
+  , m_Axis(axis)
+  , m_SqDistances(sqDistances)
+  , m_Nearest(nearest)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const int64_t n = m_Dims[m_Axis];
+    const int64_t stride = (m_Axis == 0) ? 1 : ((m_Axis == 1) ? m_Dims[0] : m_Dims[0] * m_Dims[1]);
+
+    std::vector<double> f(n);
+    std::vector<int64_t> seeds(n);
+    std::vector<double> d(n);
+    std::vector<int64_t> nearest(n);
+    std::vector<int64_t> v(n);
+    std::vector<double> z(n + 1);
+
+    for(size_t line = range.min(); line < range.max(); line++)
+    {
+      int64_t base = 0;
+      int64_t lineIdx = static_cast<int64_t>(line);
+      if(m_Axis == 0)
+      {
+        base = lineIdx * m_Dims[0];
+      }
+      else if(m_Axis == 1)
+      {
+        base = (lineIdx / m_Dims[0]) * m_Dims[0] * m_Dims[1] + (lineIdx % m_Dims[0]);
+      }
+      else
+      {
+        base = lineIdx;
+      }
+
+      for(int64_t i = 0; i < n; i++)
+      {
+        f[i] = m_SqDistances[base + i * stride];
+        seeds[i] = m_Nearest[base + i * stride];
+      }
+      LowerEnvelope1D(f.data(), seeds.data(), n, m_Spacing, d.data(), nearest.data(), v.data(), z.data());
+      for(int64_t i = 0; i < n; i++)
+      {
+        m_SqDistances[base + i * stride] = d[i];
+        m_Nearest[base + i * stride] = nearest[i];
+      }
+    }
+  }
+
+private:
+  std::array<int64_t, 3> m_Dims;
+  double m_Spacing;
+  size_t m_Axis;
+  double* m_SqDistances;
+  int64_t* m_Nearest;
+};
+
+/**
+ * @brief ComputeSquaredDistanceMap Transforms a seed map into the exact squared Euclidean distance to the
+ * nearest seed.  On input, seed voxels hold 0 and their own index, and every other voxel holds infinity and -1.
+ * On output every voxel holds the squared physical distance to, and the index of, its nearest seed; both stay
+ * infinite/-1 if there are no seeds.
+ * @param dims Image dimensions
+ * @param spacing Image spacing
+ * @param sqDistances Squared distances, modified in place
+ * @param nearest Nearest seed indices, modified in place
+ */
+inline void ComputeSquaredDistanceMap(const std::array<int64_t, 3>& dims, const std::array<double, 3>& spacing, std::vector<double>& sqDistances, std::vector<int64_t>& nearest)
+{
+  const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  if(totalPoints == 0)
+  {
+    return;
+  }
+
+  for(size_t axis = 0; axis < 3; axis++)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, static_cast<size_t>(totalPoints / dims[axis]));
+    dataAlg.execute(AxisPassImpl(dims, spacing[axis], axis, sqDistances.data(), nearest.data()));
+  }
+}
+} // namespace EuclideanDistanceTransform
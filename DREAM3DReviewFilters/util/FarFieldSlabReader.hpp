@@ -0,0 +1,493 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/Constants.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/OrientationMath.h"
+
+/**
+ * @brief The FarFieldSlabReader namespace holds the reader for the far-field slab files of TesselateFarFieldGrains
+ * and for their optional binary cache
+ */
+namespace FarFieldSlabReader
+{
+const char k_SlabCacheMagic[8] = {'D', '3', 'D', 'F', 'F', 'G', '0', '1'};
+const QString k_SlabCacheExtension(".cache");
+
+/**
+ * @brief The FarFieldGrain struct holds the values of one grain row of a far-field slab file that the filter uses
+ */
+struct FarFieldGrain
+{
+  int32_t phase;
+  float orientationMatrix[9];
+  float centroid[3];
+  float latticeParameters[6];
+  float equivalentRadius;
+};
+static_assert(sizeof(FarFieldGrain) == 80, "FarFieldGrain is written to the slab cache as raw bytes and must not be padded");
+
+/**
+ * @brief The FarFieldSlab struct holds one far-field slab file after it has been parsed
+ */
+struct FarFieldSlab
+{
+  float beamCenter = 0.0f;
+  float beamThickness = 0.0f;
+  float globalZPos = 0.0f;
+  float referenceLattice[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  float referenceRootTensor[3][3];
+  std::vector<uint32_t> crystalStructures;
+  std::vector<FarFieldGrain> grains;
+  int32_t errorCode = 0;
+  QString errorMessage;
+  bool cacheWriteFailed = false;
+};
+
+/**
+ * @brief The SlabTokenizer class walks the whitespace separated tokens of a null terminated text buffer.  Numbers
+ * are parsed in place; a decimal with at most 15 digits and a small exponent is converted exactly through a double,
+ * anything else falls back to the classic locale stream conversion.
+ */
+class SlabTokenizer
+{
+public:
+  explicit SlabTokenizer(const char* text)
+  : m_Pos(text)
+  {
+  }
+
+  bool readToken(std::string& token)
+  {
+    skipWhitespace();
+    const char* start = m_Pos;
+    while(*m_Pos != '\0' && !isWhitespace(*m_Pos))
+    {
+      m_Pos++;
+    }
+    token.assign(start, m_Pos);
+    return m_Pos != start;
+  }
+
+  /**
+   * @brief Reads a decimal integer token.  A token that is not an integer or does not fit in T is rejected and
+   * left unread.
+   */
+  template <typename T>
+  bool readInteger(T& value)
+  {
+    static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "SlabTokenizer only reads signed integers");
+
+    skipWhitespace();
+    const char* pos = m_Pos;
+    bool negative = (*pos == '-');
+    if(*pos == '-' || *pos == '+')
+    {
+      pos++;
+    }
+    if(!isDigit(*pos))
+    {
+      return false;
+    }
+    // The magnitude of the most negative value is one more than the largest positive value
+    const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+    uint64_t magnitude = 0;
+    while(isDigit(*pos))
+    {
+      const uint64_t digit = static_cast<uint64_t>(*pos - '0');
+      if(magnitude > (limit - digit) / 10)
+      {
+        return false;
+      }
+      magnitude = magnitude * 10 + digit;
+      pos++;
+    }
+    if(*pos != '\0' && !isWhitespace(*pos))
+    {
+      return false;
+    }
+    value = (negative && magnitude > 0) ? static_cast<T>(-static_cast<T>(magnitude - 1) - 1) : static_cast<T>(magnitude);
+    m_Pos = pos;
+    return true;
+  }
+
+  bool readFloat(float& value)
+  {
+    static const double k_PowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                          1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    skipWhitespace();
+    const char* start = m_Pos;
+    const char* pos = m_Pos;
+    bool negative = (*pos == '-');
+    if(*pos == '-' || *pos == '+')
+    {
+      pos++;
+    }
+    uint64_t mantissa = 0;
+    int32_t numDigits = 0;
+    int32_t exponent = 0;
+    bool hasDigits = false;
+    while(isDigit(*pos))
+    {
+      hasDigits = true;
+      if(mantissa != 0 || *pos != '0')
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*pos - '0');
+        numDigits++;
+      }
+      pos++;
+    }
+    if(*pos == '.')
+    {
+      pos++;
+      while(isDigit(*pos))
+      {
+        hasDigits = true;
+        if(mantissa != 0 || *pos != '0')
+        {
+          mantissa = mantissa * 10 + static_cast<uint64_t>(*pos - '0');
+          numDigits++;
+        }
+        exponent--;
+        pos++;
+      }
+    }
+    if(!hasDigits)
+    {
+      return false;
+    }
+    if(*pos == 'e' || *pos == 'E')
+    {
+      pos++;
+      bool negativeExponent = (*pos == '-');
+      if(*pos == '-' || *pos == '+')
+      {
+        pos++;
+      }
+      if(!isDigit(*pos))
+      {
+        return false;
+      }
+      int32_t explicitExponent = 0;
+      while(isDigit(*pos))
+      {
+        if(explicitExponent < 10000)
+        {
+          explicitExponent = explicitExponent * 10 + (*pos - '0');
+        }
+        pos++;
+      }
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if(*pos != '\0' && !isWhitespace(*pos))
+    {
+      return false;
+    }
+    m_Pos = pos;
+
+    // Both the mantissa and the power of 10 are exact doubles, so a single multiply or divide is correctly rounded
+    if(numDigits <= 15 && exponent >= -22 && exponent <= 22)
+    {
+      double result = static_cast<double>(mantissa);
+      result = (exponent < 0) ? result / k_PowersOf10[-exponent] : result * k_PowersOf10[exponent];
+      value = static_cast<float>(negative ? -result : result);
+      return true;
+    }
+
+    std::istringstream fallback(std::string(start, pos));
+    fallback.imbue(std::locale::classic());
+    fallback >> value;
+    return !fallback.fail();
+  }
+
+private:
+  const char* m_Pos = nullptr;
+
+  static bool isWhitespace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  static bool isDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  void skipWhitespace()
+  {
+    while(isWhitespace(*m_Pos))
+    {
+      m_Pos++;
+    }
+  }
+};
+
+/**
+ * @brief The LoadSlabImpl class parses one far-field slab file, or reads its binary cache when the cache was
+ * written for the same version of the file.  Each slab is independent, so every file is loaded as its own task.
+ */
+class LoadSlabImpl
+{
+public:
+  LoadSlabImpl(const QString& filePath, bool useCache, FarFieldSlab& slab)
+  : m_FilePath(filePath)
+  , m_UseCache(useCache)
+  , m_Slab(slab)
+  {
+  }
+
+  void operator()() const
+  {
+    QFileInfo fileInfo(m_FilePath);
+    const uint64_t sourceSize = static_cast<uint64_t>(fileInfo.size());
+    const int64_t sourceModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    const QString cachePath = m_FilePath + k_SlabCacheExtension;
+
+    if(!m_UseCache || !readCache(cachePath, sourceSize, sourceModified))
+    {
+      if(!parseText())
+      {
+        return;
+      }
+      if(m_UseCache && !writeCache(cachePath, sourceSize, sourceModified))
+      {
+        m_Slab.cacheWriteFailed = true;
+      }
+    }
+
+    float alphaRef = m_Slab.referenceLattice[3] * SIMPLib::Constants::k_PiOver180D;
+    float betaRef = m_Slab.referenceLattice[4] * SIMPLib::Constants::k_PiOver180D;
+    float gammaRef = m_Slab.referenceLattice[5] * SIMPLib::Constants::k_PiOver180D;
+    OrientationMath::RootTensorFromLatticeParameters(m_Slab.referenceLattice[0], m_Slab.referenceLattice[1], m_Slab.referenceLattice[2], alphaRef, betaRef, gammaRef, m_Slab.referenceRootTensor);
+  }
+
+private:
+  QString m_FilePath;
+  bool m_UseCache = false;
+  FarFieldSlab& m_Slab;
+
+  void setError(int32_t code, const QString& message) const
+  {
+    m_Slab.errorCode = code;
+    m_Slab.errorMessage = message;
+  }
+
+  bool parseText() const
+  {
+    std::ifstream inFile(m_FilePath.toLatin1().data(), std::ios_base::binary | std::ios_base::ate);
+    if(!inFile)
+    {
+      setError(-1, QObject::tr("Failed to open: %1").arg(m_FilePath));
+      return false;
+    }
+    std::vector<char> text(static_cast<size_t>(inFile.tellg()) + 1, '\0');
+    inFile.seekg(0);
+    inFile.read(text.data(), static_cast<std::streamsize>(text.size() - 1));
+    inFile.close();
+
+    SlabTokenizer tokenizer(text.data());
+    std::string keywordStr;
+    int64_t numFeatures = 0;
+    int32_t numPhases = 0;
+    bool ok = tokenizer.readToken(keywordStr) && tokenizer.readInteger(numFeatures);
+    ok = ok && tokenizer.readToken(keywordStr) && tokenizer.readFloat(m_Slab.beamCenter);
+    ok = ok && tokenizer.readToken(keywordStr) && tokenizer.readFloat(m_Slab.beamThickness);
+    ok = ok && tokenizer.readToken(keywordStr) && tokenizer.readFloat(m_Slab.globalZPos);
+    ok = ok && tokenizer.readToken(keywordStr) && tokenizer.readInteger(numPhases);
+    // A phase takes 8 tokens and a feature 25, each at least one character and a separator, so larger counts
+    // cannot be in the file and would only exhaust memory
+    const uint64_t maxTokens = text.size() / 2;
+    if(!ok || numPhases < 0 || numFeatures < 0 || static_cast<uint64_t>(numPhases) > maxTokens / 8 || static_cast<uint64_t>(numFeatures) > maxTokens / 25)
+    {
+      setError(-601, QObject::tr("Failed to read the header of: %1").arg(m_FilePath));
+      return false;
+    }
+    if(0 == numFeatures)
+    {
+      setError(-600, "The number of features is Zero and should be greater than Zero");
+      return false;
+    }
+
+    std::string phaseName;
+    std::string crystruct;
+    uint32_t cStruct = EbsdLib::CrystalStructure::UnknownCrystalStructure;
+    m_Slab.crystalStructures.resize(numPhases);
+    for(int32_t i = 0; i < numPhases; i++)
+    {
+      ok = tokenizer.readToken(phaseName) && tokenizer.readToken(crystruct);
+      for(size_t j = 0; j < 6 && ok; j++)
+      {
+        ok = tokenizer.readFloat(m_Slab.referenceLattice[j]);
+      }
+      if(!ok)
+      {
+        setError(-601, QObject::tr("Failed to read phase %1 of: %2").arg(i + 1).arg(m_FilePath));
+        return false;
+      }
+      cStruct = findCrystalStructure(crystruct, cStruct);
+      m_Slab.crystalStructures[i] = cStruct;
+    }
+
+    int64_t fId = 0;
+    float dummy = 0.0f;
+    m_Slab.grains.resize(static_cast<size_t>(numFeatures));
+    for(FarFieldGrain& grain : m_Slab.grains)
+    {
+      ok = tokenizer.readInteger(fId) && tokenizer.readInteger(grain.phase);
+      for(size_t j = 0; j < 9 && ok; j++)
+      {
+        ok = tokenizer.readFloat(grain.orientationMatrix[j]);
+      }
+      for(size_t j = 0; j < 3 && ok; j++)
+      {
+        ok = tokenizer.readFloat(grain.centroid[j]);
+      }
+      for(size_t j = 0; j < 6 && ok; j++)
+      {
+        ok = tokenizer.readFloat(grain.latticeParameters[j]);
+      }
+      for(size_t j = 0; j < 3 && ok; j++)
+      {
+        ok = tokenizer.readFloat(dummy);
+      }
+      ok = ok && tokenizer.readFloat(grain.equivalentRadius) && tokenizer.readFloat(dummy);
+      if(!ok)
+      {
+        setError(-601, QObject::tr("Failed to read feature %1 of: %2").arg(&grain - m_Slab.grains.data() + 1).arg(m_FilePath));
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static uint32_t findCrystalStructure(const std::string& crystruct, uint32_t previous)
+  {
+    if(crystruct == "Cubic")
+    {
+      return EbsdLib::CrystalStructure::Cubic_High;
+    }
+    if(crystruct == "Hexagonal")
+    {
+      return EbsdLib::CrystalStructure::Hexagonal_High;
+    }
+    if(crystruct == "Tetragonal")
+    {
+      return EbsdLib::CrystalStructure::Tetragonal_High;
+    }
+    if(crystruct == "Orthorhombic")
+    {
+      return EbsdLib::CrystalStructure::OrthoRhombic;
+    }
+    if(crystruct == "Trigonal")
+    {
+      return EbsdLib::CrystalStructure::Trigonal_High;
+    }
+    if(crystruct == "Monoclinic")
+    {
+      return EbsdLib::CrystalStructure::Monoclinic;
+    }
+    if(crystruct == "Triclinic")
+    {
+      return EbsdLib::CrystalStructure::Triclinic;
+    }
+    return previous;
+  }
+
+  bool readCache(const QString& cachePath, uint64_t sourceSize, int64_t sourceModified) const
+  {
+    std::ifstream inFile(cachePath.toLatin1().data(), std::ios_base::binary | std::ios_base::ate);
+    if(!inFile)
+    {
+      return false;
+    }
+    // The counts are checked against the size of the cache, so a damaged cache cannot exhaust memory
+    const uint64_t cacheSize = static_cast<uint64_t>(inFile.tellg());
+    inFile.seekg(0);
+
+    char magic[8];
+    uint64_t cachedSize = 0;
+    int64_t cachedModified = 0;
+    inFile.read(magic, sizeof(magic));
+    inFile.read(reinterpret_cast<char*>(&cachedSize), sizeof(cachedSize));
+    inFile.read(reinterpret_cast<char*>(&cachedModified), sizeof(cachedModified));
+    if(!inFile || !std::equal(magic, magic + 8, k_SlabCacheMagic) || cachedSize != sourceSize || cachedModified != sourceModified)
+    {
+      return false;
+    }
+
+    uint32_t numPhases = 0;
+    uint64_t numFeatures = 0;
+    inFile.read(reinterpret_cast<char*>(&m_Slab.beamCenter), sizeof(float));
+    inFile.read(reinterpret_cast<char*>(&m_Slab.beamThickness), sizeof(float));
+    inFile.read(reinterpret_cast<char*>(&m_Slab.globalZPos), sizeof(float));
+    inFile.read(reinterpret_cast<char*>(m_Slab.referenceLattice), sizeof(m_Slab.referenceLattice));
+    inFile.read(reinterpret_cast<char*>(&numPhases), sizeof(numPhases));
+    if(!inFile || numPhases > cacheSize / sizeof(uint32_t))
+    {
+      return false;
+    }
+    m_Slab.crystalStructures.resize(numPhases);
+    inFile.read(reinterpret_cast<char*>(m_Slab.crystalStructures.data()), static_cast<std::streamsize>(numPhases * sizeof(uint32_t)));
+    inFile.read(reinterpret_cast<char*>(&numFeatures), sizeof(numFeatures));
+    if(!inFile || numFeatures == 0 || numFeatures > cacheSize / sizeof(FarFieldGrain))
+    {
+      return false;
+    }
+    m_Slab.grains.resize(numFeatures);
+    inFile.read(reinterpret_cast<char*>(m_Slab.grains.data()), static_cast<std::streamsize>(numFeatures * sizeof(FarFieldGrain)));
+    return static_cast<bool>(inFile);
+  }
+
+  bool writeCache(const QString& cachePath, uint64_t sourceSize, int64_t sourceModified) const
+  {
+    // Write next to the final file and rename, so that an interrupted write never leaves a cache that looks valid
+    const QString tempPath = cachePath + ".tmp";
+    {
+      std::ofstream outFile(tempPath.toLatin1().data(), std::ios_base::binary | std::ios_base::trunc);
+      if(!outFile)
+      {
+        return false;
+      }
+      const uint32_t numPhases = static_cast<uint32_t>(m_Slab.crystalStructures.size());
+      const uint64_t numFeatures = m_Slab.grains.size();
+      outFile.write(k_SlabCacheMagic, sizeof(k_SlabCacheMagic));
+      outFile.write(reinterpret_cast<const char*>(&sourceSize), sizeof(sourceSize));
+      outFile.write(reinterpret_cast<const char*>(&sourceModified), sizeof(sourceModified));
+      outFile.write(reinterpret_cast<const char*>(&m_Slab.beamCenter), sizeof(float));
+      outFile.write(reinterpret_cast<const char*>(&m_Slab.beamThickness), sizeof(float));
+      outFile.write(reinterpret_cast<const char*>(&m_Slab.globalZPos), sizeof(float));
+      outFile.write(reinterpret_cast<const char*>(m_Slab.referenceLattice), sizeof(m_Slab.referenceLattice));
+      outFile.write(reinterpret_cast<const char*>(&numPhases), sizeof(numPhases));
+      outFile.write(reinterpret_cast<const char*>(m_Slab.crystalStructures.data()), static_cast<std::streamsize>(numPhases * sizeof(uint32_t)));
+      outFile.write(reinterpret_cast<const char*>(&numFeatures), sizeof(numFeatures));
+      outFile.write(reinterpret_cast<const char*>(m_Slab.grains.data()), static_cast<std::streamsize>(numFeatures * sizeof(FarFieldGrain)));
+      if(!outFile)
+      {
+        outFile.close();
+        QFile::remove(tempPath);
+        return false;
+      }
+    }
+    QFile::remove(cachePath);
+    return QFile::rename(tempPath, cachePath);
+  }
+};
+
+} // namespace FarFieldSlabReader
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief The GlobalShiftCorrection class adapts the shifts found between neighboring sections to a criterion over the
+ * whole stack: either the trend of the cumulative shifts, fitted by least squares, or the cumulative shifts estimated
+ * from SEM images.  Every section pair has a ranked list of candidate shifts, and the best candidate of every pair is
+ * selected first.  Each iteration then finds, for every pair, the lower ranked candidates that reduce the error and
+ * picks among all of them the one whose score is the least worse than the best score of its pair, until the error
+ * stops improving or falls within the tolerance.
+ *
+ * The candidates are kept in flat arrays, and the cumulative shifts only enter the error through running sums over
+ * the stack, so swapping the candidate of one pair is evaluated in constant time instead of by a new pass over all
+ * the sections; an iteration costs one pass over the candidates plus one pass over the sections to update the sums.
+ */
+class GlobalShiftCorrection
+{
+public:
+  /**
+   * @brief The ScoreChange enum selects how the score of a candidate is compared to the best score of its pair
+   */
+  enum class ScoreChange
+  {
+    Ratio,
+    Difference
+  };
+
+  /**
+   * @brief The Timings struct holds the time spent in each stage of the correction
+   */
+  struct Timings
+  {
+    double setupMilliseconds = 0.0;
+    double correctionMilliseconds = 0.0;
+    uint64_t iterations = 0;
+  };
+
+  /**
+   * @brief GlobalShiftCorrection
+   * @param newxshift Candidate x-shifts of each section pair, best first; row 0 is not used
+   * @param newyshift Candidate y-shifts of each section pair, best first; row 0 is not used
+   * @param scores Scores of the candidate shifts, lower is better
+   * @param scoreChange How a candidate score is compared to the best score of its pair
+   */
+  GlobalShiftCorrection(const std::vector<std::vector<int64_t>>& newxshift, const std::vector<std::vector<int64_t>>& newyshift, const std::vector<std::vector<float>>& scores,
+                        ScoreChange scoreChange)
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    m_NumSections = static_cast<int64_t>(newxshift.size());
+    m_NumCandidates = (m_NumSections > 1) ? static_cast<int64_t>(newxshift[1].size()) : 0;
+    const size_t size = static_cast<size_t>(m_NumSections * m_NumCandidates);
+    m_ShiftsX.assign(size, 0);
+    m_ShiftsY.assign(size, 0);
+    m_ScoreChanges.assign(size, 0.0f);
+    for(int64_t iter = 1; iter < m_NumSections; iter++)
+    {
+      for(int64_t index = 0; index < m_NumCandidates; index++)
+      {
+        const int64_t position = iter * m_NumCandidates + index;
+        m_ShiftsX[position] = newxshift[iter][index];
+        m_ShiftsY[position] = newyshift[iter][index];
+        m_ScoreChanges[position] = findScoreChange(scores[iter][index], scores[iter][0], scoreChange);
+      }
+    }
+    m_Selection.assign(static_cast<size_t>(m_NumSections), 0);
+    m_Timings.setupMilliseconds += findMilliseconds(startTime);
+  }
+
+  ~GlobalShiftCorrection() = default;
+
+  GlobalShiftCorrection(const GlobalShiftCorrection&) = default;
+  GlobalShiftCorrection(GlobalShiftCorrection&&) noexcept = default;
+  GlobalShiftCorrection& operator=(const GlobalShiftCorrection&) = default;
+  GlobalShiftCorrection& operator=(GlobalShiftCorrection&&) noexcept = default;
+
+  /**
+   * @brief setTargetTrend Measures the error as the difference between the angles of the fitted trend of the
+   * cumulative shifts and of the given trend, |atan(xtrend) - atan(xneedtrend)| + |atan(ytrend) - atan(yneedtrend)|,
+   * with a tolerance of 1 / (number of section pairs)
+   * @param xneedtrend
+   * @param yneedtrend
+   */
+  void setTargetTrend(float xneedtrend, float yneedtrend)
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    m_UseTrend = true;
+    m_NeedTrendX = xneedtrend;
+    m_NeedTrendY = yneedtrend;
+    m_Tolerance = 1.0f / static_cast<float>(m_NumSections - 1);
+    updateSums();
+    m_Timings.setupMilliseconds += findMilliseconds(startTime);
+  }
+
+  /**
+   * @brief setTargetShifts Measures the error as the mean squared distance between the cumulative shifts and the
+   * cumulative sum of the given shifts, with a tolerance of 1
+   * @param xneedshifts Shift of each section pair estimated from the SEM images
+   * @param yneedshifts
+   */
+  void setTargetShifts(const std::vector<float>& xneedshifts, const std::vector<float>& yneedshifts)
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    m_UseTrend = false;
+    m_EstimatedX.assign(static_cast<size_t>(m_NumSections), 0.0f);
+    m_EstimatedY.assign(static_cast<size_t>(m_NumSections), 0.0f);
+    for(int64_t iter = 1; iter < m_NumSections; iter++)
+    {
+      m_EstimatedX[iter] = m_EstimatedX[iter - 1] + xneedshifts[iter - 1];
+      m_EstimatedY[iter] = m_EstimatedY[iter - 1] + yneedshifts[iter - 1];
+    }
+    m_Tolerance = 1.0f;
+    updateSums();
+    m_Timings.setupMilliseconds += findMilliseconds(startTime);
+  }
+
+  /**
+   * @brief needsCorrection Returns whether the error of the current selection is above the tolerance
+   */
+  bool needsCorrection() const
+  {
+    return m_Error > m_Tolerance;
+  }
+
+  /**
+   * @brief findCandidateError Returns the error the current selection would have with candidate index selected for
+   * section pair iter.  Only running sums are updated, so this takes constant time.
+   * @param iter Section pair, 1 and up
+   * @param index Candidate of the pair
+   * @return Error
+   */
+  float findCandidateError(int64_t iter, int64_t index) const
+  {
+    const int64_t current = iter * m_NumCandidates + static_cast<int64_t>(m_Selection[iter]);
+    const int64_t position = iter * m_NumCandidates + index;
+    return findError(iter, m_ShiftsX[position] - m_ShiftsX[current], m_ShiftsY[position] - m_ShiftsY[current]);
+  }
+
+  /**
+   * @brief iterate Swaps the candidate of at most one section pair
+   * @return Whether another iteration may still improve the error
+   */
+  bool iterate()
+  {
+    const auto startTime = std::chrono::steady_clock::now();
+    const float oldError = m_Error;
+    float minChangeScore = std::numeric_limits<float>::max() - 1;
+    float minChangeError = std::numeric_limits<float>::max();
+    int64_t minChangeIndex = 0;
+    int64_t minChangeIter = 0;
+    for(int64_t iter = 1; iter < m_NumSections; iter++)
+    {
+      // Best candidate of this pair: the lowest score change among the candidates that reduce the error
+      float changeError = std::numeric_limits<float>::max();
+      float changeScore = std::numeric_limits<float>::max();
+      int64_t changeIndex = 0;
+      for(int64_t index = static_cast<int64_t>(m_Selection[iter]) + 1; index < m_NumCandidates; index++)
+      {
+        const int64_t position = iter * m_NumCandidates + index;
+        const float error = findCandidateError(iter, index);
+        if(error < m_Error && m_ScoreChanges[position] < changeScore)
+        {
+          changeError = error;
+          changeIndex = index;
+          changeScore = m_ScoreChanges[position];
+        }
+      }
+
+      // Best candidate over all the pairs; equal score changes go to the smaller shift
+      if(changeError < m_Error &&
+         (changeScore < minChangeScore || (changeScore == minChangeScore && std::llabs(m_ShiftsX[iter * m_NumCandidates + changeIndex]) + std::llabs(m_ShiftsY[iter * m_NumCandidates + changeIndex]) <
+                                                                                std::llabs(m_ShiftsX[iter * m_NumCandidates + minChangeIndex]) + std::llabs(m_ShiftsY[iter * m_NumCandidates + minChangeIndex]))))
+      {
+        minChangeIter = iter;
+        minChangeIndex = changeIndex;
+        minChangeScore = changeScore;
+        minChangeError = changeError;
+      }
+    }
+
+    if(minChangeError < m_Error && minChangeError >= m_Tolerance)
+    {
+      m_Selection[minChangeIter] = static_cast<uint64_t>(minChangeIndex);
+      updateSums();
+    }
+    m_Timings.iterations++;
+    m_Timings.correctionMilliseconds += findMilliseconds(startTime);
+    return minChangeScore < std::numeric_limits<float>::max() - 1 && m_Error < oldError && m_Error > m_Tolerance;
+  }
+
+  /**
+   * @brief getSelection Returns the index of the selected candidate of every section pair
+   */
+  const std::vector<uint64_t>& getSelection() const
+  {
+    return m_Selection;
+  }
+
+  /**
+   * @brief getError Returns the error of the current selection
+   */
+  float getError() const
+  {
+    return m_Error;
+  }
+
+  /**
+   * @brief getTimings Returns the time spent so far in each stage
+   */
+  const Timings& getTimings() const
+  {
+    return m_Timings;
+  }
+
+private:
+  int64_t m_NumSections = 0;
+  int64_t m_NumCandidates = 0;
+  std::vector<int64_t> m_ShiftsX;
+  std::vector<int64_t> m_ShiftsY;
+  std::vector<float> m_ScoreChanges;
+  std::vector<uint64_t> m_Selection;
+
+  bool m_UseTrend = true;
+  float m_NeedTrendX = 0.0f;
+  float m_NeedTrendY = 0.0f;
+  std::vector<float> m_EstimatedX;
+  std::vector<float> m_EstimatedY;
+
+  // Trend: sums of the cumulative shifts X(i) and of i * X(i) over i = 1..n
+  int64_t m_SumX = 0;
+  int64_t m_SumY = 0;
+  int64_t m_SumIX = 0;
+  int64_t m_SumIY = 0;
+  // Estimated shifts: sums of the residuals X(i) - E(i) over i = iter..n, and the sum of their squares
+  std::vector<double> m_ResidualSumsX;
+  std::vector<double> m_ResidualSumsY;
+  double m_SquaredResiduals = 0.0;
+
+  float m_Error = 0.0f;
+  float m_Tolerance = 0.0f;
+  Timings m_Timings;
+
+  static double findMilliseconds(std::chrono::steady_clock::time_point startTime)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  /**
+   * @brief findScoreChange Returns how much worse a candidate score is than the best score of its pair.  A ratio
+   * against a best score of 0 treats the candidates that also score 0 as equal to the best and all others as
+   * infinitely worse, so they are never selected.
+   */
+  static float findScoreChange(float score, float bestScore, ScoreChange scoreChange)
+  {
+    if(scoreChange == ScoreChange::Difference)
+    {
+      return score - bestScore;
+    }
+    if(bestScore == 0.0f)
+    {
+      return (score == 0.0f) ? 1.0f : std::numeric_limits<float>::max();
+    }
+    return score / bestScore;
+  }
+
+  /**
+   * @brief updateSums Recomputes the running sums and the error of the current selection
+   */
+  void updateSums()
+  {
+    const int64_t n = m_NumSections - 1;
+    int64_t shiftX = 0;
+    int64_t shiftY = 0;
+    if(m_UseTrend)
+    {
+      m_SumX = m_SumY = m_SumIX = m_SumIY = 0;
+      for(int64_t i = 1; i <= n; i++)
+      {
+        shiftX += m_ShiftsX[i * m_NumCandidates + static_cast<int64_t>(m_Selection[i])];
+        shiftY += m_ShiftsY[i * m_NumCandidates + static_cast<int64_t>(m_Selection[i])];
+        m_SumX += shiftX;
+        m_SumY += shiftY;
+        m_SumIX += i * shiftX;
+        m_SumIY += i * shiftY;
+      }
+    }
+    else
+    {
+      std::vector<double> residualsX(static_cast<size_t>(n + 2), 0.0);
+      std::vector<double> residualsY(static_cast<size_t>(n + 2), 0.0);
+      m_SquaredResiduals = 0.0;
+      for(int64_t i = 1; i <= n; i++)
+      {
+        shiftX += m_ShiftsX[i * m_NumCandidates + static_cast<int64_t>(m_Selection[i])];
+        shiftY += m_ShiftsY[i * m_NumCandidates + static_cast<int64_t>(m_Selection[i])];
+        residualsX[i] = static_cast<double>(shiftX) - static_cast<double>(m_EstimatedX[i]);
+        residualsY[i] = static_cast<double>(shiftY) - static_cast<double>(m_EstimatedY[i]);
+        m_SquaredResiduals += residualsX[i] * residualsX[i] + residualsY[i] * residualsY[i];
+      }
+      for(int64_t i = n - 1; i >= 1; i--)
+      {
+        residualsX[i] += residualsX[i + 1];
+        residualsY[i] += residualsY[i + 1];
+      }
+      m_ResidualSumsX.swap(residualsX);
+      m_ResidualSumsY.swap(residualsY);
+    }
+    m_Error = findError(1, 0, 0);
+  }
+
+  /**
+   * @brief findError Returns the error of the current selection with the shift of section pair iter changed by
+   * (deltaX, deltaY), which changes the cumulative shifts of pairs iter..n by the same amount
+   */
+  float findError(int64_t iter, int64_t deltaX, int64_t deltaY) const
+  {
+    const int64_t n = m_NumSections - 1;
+    const int64_t count = n - iter + 1;
+    if(m_UseTrend)
+    {
+      // Least squares slope of X(i) against i: (n sum iX - sum i sum X) / (n sum i^2 - (sum i)^2)
+      const int64_t sumI = n * (n + 1) / 2;
+      const int64_t sumISquared = n * (n + 1) * (2 * n + 1) / 6;
+      const int64_t sumIFromIter = sumI - (iter - 1) * iter / 2;
+      const double sumX = static_cast<double>(m_SumX + deltaX * count);
+      const double sumY = static_cast<double>(m_SumY + deltaY * count);
+      const double sumIX = static_cast<double>(m_SumIX + deltaX * sumIFromIter);
+      const double sumIY = static_cast<double>(m_SumIY + deltaY * sumIFromIter);
+      const double denominator = static_cast<double>(n) * static_cast<double>(sumISquared) - static_cast<double>(sumI) * static_cast<double>(sumI);
+      if(denominator == 0.0)
+      {
+        // A single section pair has no trend to fit, so there is nothing to correct
+        return 0.0f;
+      }
+      const double xtrend = (static_cast<double>(n) * sumIX - static_cast<double>(sumI) * sumX) / denominator;
+      const double ytrend = (static_cast<double>(n) * sumIY - static_cast<double>(sumI) * sumY) / denominator;
+      return static_cast<float>(std::fabs(std::atan(xtrend) - std::atan(m_NeedTrendX)) + std::fabs(std::atan(ytrend) - std::atan(m_NeedTrendY)));
+    }
+
+    // sum (r + d)^2 = sum r^2 + 2 d sum r + count d^2 over the pairs iter..n
+    const double dx = static_cast<double>(deltaX);
+    const double dy = static_cast<double>(deltaY);
+    const double squaredResiduals =
+        m_SquaredResiduals + 2.0 * dx * m_ResidualSumsX[iter] + 2.0 * dy * m_ResidualSumsY[iter] + static_cast<double>(count) * (dx * dx + dy * dy);
+    return static_cast<float>(squaredResiduals / static_cast<double>(2 * n));
+  }
+};
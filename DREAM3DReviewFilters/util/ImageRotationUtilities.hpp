@@ -4,11 +4,17 @@
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include <Eigen/Dense>
 
-#include <fstream>
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <type_traits>
+#include <vector>
 
 using Matrix3fR = Eigen::Matrix<float, 3, 3, Eigen::RowMajor>;
 using Matrix4fR = Eigen::Matrix<float, 4, 4, Eigen::RowMajor>;
@@ -46,154 +52,275 @@ struct RotateArgs
   float zMinNew = 0.0f;
 };
 
-template <typename T>
-T inline GetSourceArrayValue(const RotateArgs& params, Vector3i64 xyzIndex, DataArray<T>& sourceArray, size_t compIndex)
+/**
+ * @brief The TrilinearSample struct holds the 8 source voxels (as flat value offsets) and the
+ * trilinear weights that produce a single transformed voxel.
+ */
+struct TrilinearSample
 {
-  if(xyzIndex[0] < 0)
-  {
-    xyzIndex[0] = 0;
-  }
-  if(xyzIndex[0] >= params.xp)
-  {
-    xyzIndex[0] = params.xp - 1;
-  }
+  std::array<size_t, 8> offsets = {0, 0, 0, 0, 0, 0, 0, 0};
+  std::array<float, 8> weights = {0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+  bool valid = false;
+};
 
-  if(xyzIndex[1] < 0)
-  {
-    xyzIndex[1] = 0;
-  }
-  if(xyzIndex[1] >= params.yp)
-  {
-    xyzIndex[1] = params.yp - 1;
-  }
+/**
+ * @brief CreateIndexTransform Composes the inverse transformation with the index to coordinate mappings
+ * of both geometries so that a transformed voxel index (i, j, k) maps straight to a continuous index into
+ * the original geometry, where integer values sit on the original cell centers.
+ * @param params
+ * @param transformationMatrix
+ * @return Transformed index to continuous original index matrix
+ */
+inline Eigen::Matrix4d CreateIndexTransform(const RotateArgs& params, const Matrix4fR& transformationMatrix)
+{
+  FloatVec3Type origin = params.origImageGeom->getOrigin();
+
+  Eigen::Matrix4d newIndexToCoords = Eigen::Matrix4d::Identity();
+  newIndexToCoords(0, 0) = params.xResNew;
+  newIndexToCoords(1, 1) = params.yResNew;
+  newIndexToCoords(2, 2) = params.zResNew;
+  newIndexToCoords(0, 3) = params.xMinNew + 0.5 * params.xResNew;
+  newIndexToCoords(1, 3) = params.yMinNew + 0.5 * params.yResNew;
+  newIndexToCoords(2, 3) = params.zMinNew + 0.5 * params.zResNew;
+
+  Eigen::Matrix4d coordsToOldIndex = Eigen::Matrix4d::Identity();
+  coordsToOldIndex(0, 0) = 1.0 / params.xRes;
+  coordsToOldIndex(1, 1) = 1.0 / params.yRes;
+  coordsToOldIndex(2, 2) = 1.0 / params.zRes;
+  coordsToOldIndex(0, 3) = -origin[0] / params.xRes - 0.5;
+  coordsToOldIndex(1, 3) = -origin[1] / params.yRes - 0.5;
+  coordsToOldIndex(2, 3) = -origin[2] / params.zRes - 0.5;
+
+  Eigen::Matrix4d inverseTransform = transformationMatrix.cast<double>().inverse();
+
+  return coordsToOldIndex * inverseTransform * newIndexToCoords;
+}
 
-  if(xyzIndex[2] < 0)
+/**
+ * @brief FindSourceSlab Computes the range of original Z slices that the transformed slices [zStart, zEnd)
+ * read from, including the upper neighbor used by the interpolation. The range is only used to skip slabs that
+ * map entirely outside of the original geometry and to report progress; the whole source array stays in memory.
+ * @param params
+ * @param indexTransform
+ * @param zStart
+ * @param zEnd
+ * @return First and last original slice; first is greater than last if the slab maps outside of the original geometry
+ */
+inline std::pair<int64_t, int64_t> FindSourceSlab(const RotateArgs& params, const Eigen::Matrix4d& indexTransform, int64_t zStart, int64_t zEnd)
+{
+  double zMin = std::numeric_limits<double>::max();
+  double zMax = std::numeric_limits<double>::lowest();
+  for(const auto& x : {int64_t(0), params.xpNew - 1})
   {
-    xyzIndex[2] = 0;
+    for(const auto& y : {int64_t(0), params.ypNew - 1})
+    {
+      for(const auto& z : {zStart, zEnd - 1})
+      {
+        Eigen::Vector4d index = indexTransform * Eigen::Vector4d(static_cast<double>(x), static_cast<double>(y), static_cast<double>(z), 1.0);
+        zMin = std::min(zMin, index[2]);
+        zMax = std::max(zMax, index[2]);
+      }
+    }
   }
-  if(xyzIndex[2] >= params.zp)
+
+  if(zMax < -0.5 || zMin >= static_cast<double>(params.zp) - 0.5)
   {
-    xyzIndex[2] = params.zp - 1;
+    return {1, 0};
   }
-
-  // Now just compute the proper index
-  size_t index = (xyzIndex[2] * params.xp * params.yp) + (xyzIndex[1] * params.xp) + xyzIndex[0];
-  return sourceArray[index * sourceArray.getNumberOfComponents() + compIndex];
+  int64_t first = std::max(static_cast<int64_t>(std::floor(zMin)), int64_t(0));
+  int64_t last = std::min(static_cast<int64_t>(std::floor(zMax)) + 1, params.zp - 1);
+  return {first, last};
 }
 
 /**
- * @brief FindOctant
+ * @brief FindInterpolationValues Computes the trilinear samples for a run of voxels along one row of the
+ * transformed geometry. Since the transformation is affine, each voxel is the row start plus a multiple of a
+ * constant step in original index space. Neighbors past the edge of the original geometry are clamped to it
+ * and voxels that map outside of the original geometry are flagged as invalid.
  * @param params
- * @param index
- * @param coord
- * @return
+ * @param start Continuous original index of the first voxel in the run
+ * @param step Change in continuous original index from one voxel to the next
+ * @param numComps
+ * @param samples
  */
-inline size_t FindOctant(const RotateArgs& params, size_t index, FloatVec3Type coord)
+inline void FindInterpolationValues(const RotateArgs& params, const Eigen::Vector3d& start, const Eigen::Vector3d& step, size_t numComps, std::vector<TrilinearSample>& samples)
 {
+  const int64_t dims[3] = {params.xp, params.yp, params.zp};
+  const int64_t strides[3] = {1, params.xp, params.xp * params.yp};
 
-  float xResHalf = params.xRes * 0.5;
-  float yResHalf = params.yRes * 0.5;
-  float zResHalf = params.zRes * 0.5;
-
-  // Get the center coord of the original source voxel
-  Eigen::Vector3f centerPoint;
-  params.origImageGeom->getCoords(index, centerPoint.data());
-
-  // Form the 8 corner coords for the voxel
-  // clang-format off
-  std::array<FloatVec3Type, 8> unitSquareCoords = {
-  /* P1 */ FloatVec3Type(centerPoint[0]-xResHalf, centerPoint[1]-yResHalf, centerPoint[2]-zResHalf),
-  /* P2 */ FloatVec3Type(centerPoint[0]+xResHalf, centerPoint[1]-yResHalf, centerPoint[2]-zResHalf),
-  /* P3 */ FloatVec3Type(centerPoint[0]+xResHalf, centerPoint[1]+yResHalf, centerPoint[2]-zResHalf),
-  /* P4 */ FloatVec3Type(centerPoint[0]-xResHalf, centerPoint[1]+yResHalf, centerPoint[2]-zResHalf),
-  /* P5 */ FloatVec3Type(centerPoint[0]-xResHalf, centerPoint[1]-yResHalf, centerPoint[2]+zResHalf),
-  /* P6 */ FloatVec3Type(centerPoint[0]+xResHalf, centerPoint[1]-yResHalf, centerPoint[2]+zResHalf),
-  /* P7 */ FloatVec3Type(centerPoint[0]+xResHalf, centerPoint[1]+yResHalf, centerPoint[2]+zResHalf),
-  /* P8 */ FloatVec3Type(centerPoint[0]-xResHalf, centerPoint[1]+yResHalf, centerPoint[2]+zResHalf),
-  };
-  // clang-format on
-
-  FloatVec3Type temp;
-  // Now figure out which corner the inverse transformed point is closest to
-  // this will give us which octant the point lies.
-  float minDistance = std::numeric_limits<float>::max();
-  size_t minIndex = 0;
-  for(size_t i = 0; i < 8; i++)
+  for(size_t n = 0; n < samples.size(); n++)
   {
-    float distance = (unitSquareCoords[i] - coord).norm();
-    if(distance < minDistance)
+    TrilinearSample& sample = samples[n];
+    Eigen::Vector3d index = start + static_cast<double>(n) * step;
+
+    sample.valid = true;
+    int64_t lower[3] = {0, 0, 0};
+    int64_t upper[3] = {0, 0, 0};
+    float fraction[3] = {0.0F, 0.0F, 0.0F};
+    for(size_t d = 0; d < 3; d++)
     {
-      minDistance = distance;
-      minIndex = i;
+      if(index[d] < -0.5 || index[d] >= static_cast<double>(dims[d]) - 0.5)
+      {
+        sample.valid = false;
+        break;
+      }
+      double base = std::floor(index[d]);
+      fraction[d] = static_cast<float>(index[d] - base);
+      lower[d] = std::max(static_cast<int64_t>(base), int64_t(0)) * strides[d];
+      upper[d] = std::min(static_cast<int64_t>(base) + 1, dims[d] - 1) * strides[d];
+    }
+    if(!sample.valid)
+    {
+      continue;
     }
-  }
 
-  return minIndex;
+    const float u = fraction[0];
+    const float v = fraction[1];
+    const float w = fraction[2];
+    // clang-format off
+    sample.offsets = {static_cast<size_t>(lower[2] + lower[1] + lower[0]) * numComps, static_cast<size_t>(lower[2] + lower[1] + upper[0]) * numComps,
+                      static_cast<size_t>(lower[2] + upper[1] + lower[0]) * numComps, static_cast<size_t>(lower[2] + upper[1] + upper[0]) * numComps,
+                      static_cast<size_t>(upper[2] + lower[1] + lower[0]) * numComps, static_cast<size_t>(upper[2] + lower[1] + upper[0]) * numComps,
+                      static_cast<size_t>(upper[2] + upper[1] + lower[0]) * numComps, static_cast<size_t>(upper[2] + upper[1] + upper[0]) * numComps};
+    sample.weights = {(1.0F - u) * (1.0F - v) * (1.0F - w), u * (1.0F - v) * (1.0F - w),
+                      (1.0F - u) * v * (1.0F - w),          u * v * (1.0F - w),
+                      (1.0F - u) * (1.0F - v) * w,          u * (1.0F - v) * w,
+                      (1.0F - u) * v * w,                   u * v * w};
+    // clang-format on
+  }
 }
 
-using OctantOffsetArrayType = std::array<Vector3i64, 8>;
-
-static const OctantOffsetArrayType k_IndexOffset0 = {Vector3i64{-1, -1, -1}, Vector3i64{0, -1, -1}, Vector3i64{0, 0, -1}, Vector3i64{-1, 0, -1},
-                                                     Vector3i64{-1, -1, 0},  Vector3i64{0, -1, 0},  Vector3i64{0, 0, 0},  Vector3i64{-1, 0, 0}};
-static const OctantOffsetArrayType k_IndexOffset1 = {Vector3i64{0, -1, -1}, Vector3i64{1, -1, -1}, Vector3i64{1, 0, -1}, Vector3i64{0, 0, -1},
-                                                     Vector3i64{0, -1, 0},  Vector3i64{1, -1, 0},  Vector3i64{1, 0, 0},  Vector3i64{0, 0, 0}};
-static const OctantOffsetArrayType k_IndexOffset2 = {Vector3i64{0, 0, -1}, Vector3i64{1, 0, -1}, Vector3i64{1, 1, -1}, Vector3i64{0, 1, -1},
-                                                     Vector3i64{0, 0, 0},  Vector3i64{1, 0, 0},  Vector3i64{1, 1, 0},  Vector3i64{0, 1, 0}};
-static const OctantOffsetArrayType k_IndexOffset3 = {Vector3i64{-1, 0, -1}, Vector3i64{0, 0, -1}, Vector3i64{0, 1, -1}, Vector3i64{-1, 1, -1},
-                                                     Vector3i64{-1, 0, 0},  Vector3i64{0, 0, 0},  Vector3i64{0, 1, 0},  Vector3i64{-1, 1, 0}};
-static const OctantOffsetArrayType k_IndexOffset4 = {Vector3i64{-1, -1, 0}, Vector3i64{0, -1, 0}, Vector3i64{0, 0, 0}, Vector3i64{-1, 0, 0},
-                                                     Vector3i64{-1, -1, 1}, Vector3i64{0, -1, 1}, Vector3i64{0, 0, 1}, Vector3i64{-1, 0, 1}};
-static const OctantOffsetArrayType k_IndexOffset5 = {Vector3i64{0, -1, 0}, Vector3i64{1, -1, 0}, Vector3i64{1, 0, 0}, Vector3i64{0, 0, 0},
-                                                     Vector3i64{0, -1, 1}, Vector3i64{1, -1, 1}, Vector3i64{1, 0, 1}, Vector3i64{0, 0, 1}};
-static const OctantOffsetArrayType k_IndexOffset6 = {Vector3i64{0, 0, 0}, Vector3i64{1, 0, 0}, Vector3i64{1, 1, 0}, Vector3i64{0, 1, 0},
-                                                     Vector3i64{0, 0, 1}, Vector3i64{1, 0, 1}, Vector3i64{1, 1, 1}, Vector3i64{0, 1, 1}};
-static const OctantOffsetArrayType k_IndexOffset7 = {Vector3i64{-1, 0, 0}, Vector3i64{0, 0, 0}, Vector3i64{0, 1, 0}, Vector3i64{-1, -1, 0},
-                                                     Vector3i64{-1, 0, 1}, Vector3i64{0, 0, 1}, Vector3i64{0, 1, 1}, Vector3i64{-1, -1, 1}};
-static const std::array<OctantOffsetArrayType, 8> k_AllOctantOffsets{k_IndexOffset0, k_IndexOffset1, k_IndexOffset2, k_IndexOffset3, k_IndexOffset4, k_IndexOffset5, k_IndexOffset6, k_IndexOffset7};
-
 /**
- * @brief FindInterpolationValues
- * @param params
- * @param index
- * @param octant
- * @param oldIndicesU
- * @param oldCoords
- * @param sourceArray
- * @param pValues
- * @param uvw
+ * @brief The TrilinearResampleImpl class interpolates one slab of the transformed geometry. The slab is
+ * split into tiles of rows so that the source voxels touched by neighboring rows are still in cache, and
+ * each invocation reuses its sample and accumulator buffers for all of the tiles in its range.
  */
 template <typename T>
-inline void FindInterpolationValues(const RotateArgs& params, size_t index, size_t octant, Vector3s oldIndicesU, Eigen::Array4f& oldCoords, DataArray<T>& sourceArray, std::vector<T>& pValues,
-                                    Eigen::Vector3f& uvw)
+class TrilinearResampleImpl
 {
-  const std::array<Vector3i64, 8>& indexOffset = k_AllOctantOffsets[octant];
+public:
+  using AccumType = std::conditional_t<std::is_same<T, float>::value || (sizeof(T) < 4), float, double>;
+
+  static constexpr int64_t k_TileX = 64;
+  static constexpr int64_t k_TileY = 16;
+  static constexpr int64_t k_TileZ = 8;
+
+  TrilinearResampleImpl(const RotateArgs& params, const Eigen::Matrix4d& indexTransform, const T* source, T* target, size_t numComps, int64_t zStart, int64_t zEnd)
+  : m_Params(params)
+  , m_IndexTransform(indexTransform)
+  , m_Source(source)
+  , m_Target(target)
+  , m_NumComps(numComps)
+  , m_ZStart(zStart)
+  , m_ZEnd(zEnd)
+  {
+  }
 
-  Vector3i64 oldIndices(static_cast<int64_t>(oldIndicesU[0]), static_cast<int64_t>(oldIndicesU[1]), static_cast<int64_t>(oldIndicesU[2]));
-  size_t numComps = sourceArray.getNumberOfComponents();
+  static int64_t NumberOfTiles(const RotateArgs& params)
+  {
+    return ((params.xpNew + k_TileX - 1) / k_TileX) * ((params.ypNew + k_TileY - 1) / k_TileY);
+  }
 
-  Vector3i64 pIndices;
-  Eigen::Vector3f p1Coord;
+  static AccumType ToAccumType(T value)
+  {
+    return static_cast<AccumType>(value);
+  }
 
-  auto origin = params.origImageGeom->getOrigin();
+  static T FromAccumType(AccumType value)
+  {
+    if constexpr(std::is_integral<T>::value)
+    {
+      return static_cast<T>(std::round(value));
+    }
+    else
+    {
+      return static_cast<T>(value);
+    }
+  }
 
-  for(size_t i = 0; i < 8; i++)
+  void operator()(const SIMPLRange& range) const
   {
-    auto pIndices = oldIndices + indexOffset[i];
-    for(size_t compIndex = 0; compIndex < numComps; compIndex++)
+    const int64_t numTilesX = (m_Params.xpNew + k_TileX - 1) / k_TileX;
+    const Eigen::Vector3d step = m_IndexTransform.block<3, 1>(0, 0);
+
+    std::vector<TrilinearSample> samples;
+    samples.reserve(k_TileX);
+    std::vector<AccumType> accum(m_NumComps);
+
+    for(size_t tile = range.min(); tile < range.max(); tile++)
+    {
+      const int64_t xStart = (static_cast<int64_t>(tile) % numTilesX) * k_TileX;
+      const int64_t yStart = (static_cast<int64_t>(tile) / numTilesX) * k_TileY;
+      const int64_t xEnd = std::min(xStart + k_TileX, m_Params.xpNew);
+      const int64_t yEnd = std::min(yStart + k_TileY, m_Params.ypNew);
+      samples.resize(xEnd - xStart);
+
+      for(int64_t k = m_ZStart; k < m_ZEnd; k++)
+      {
+        for(int64_t j = yStart; j < yEnd; j++)
+        {
+          Eigen::Vector4d rowStart = m_IndexTransform * Eigen::Vector4d(static_cast<double>(xStart), static_cast<double>(j), static_cast<double>(k), 1.0);
+          FindInterpolationValues(m_Params, rowStart.head<3>(), step, m_NumComps, samples);
+
+          T* target = m_Target + ((k * m_Params.ypNew + j) * m_Params.xpNew + xStart) * m_NumComps;
+          for(const auto& sample : samples)
+          {
+            interpolate(sample, target, accum);
+            target += m_NumComps;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const RotateArgs& m_Params;
+  Eigen::Matrix4d m_IndexTransform;
+  const T* m_Source = nullptr;
+  T* m_Target = nullptr;
+  size_t m_NumComps = 0;
+  int64_t m_ZStart = 0;
+  int64_t m_ZEnd = 0;
+
+  /**
+   * @brief Blends the 8 source tuples of the sample into the target tuple. Components are contiguous in
+   * both arrays, so for multi-component data the inner loop runs across the components of each neighbor.
+   */
+  void interpolate(const TrilinearSample& sample, T* target, std::vector<AccumType>& accum) const
+  {
+    if(!sample.valid)
+    {
+      std::fill(target, target + m_NumComps, static_cast<T>(0));
+      return;
+    }
+
+    if(m_NumComps == 1)
+    {
+      AccumType value = 0;
+      for(size_t n = 0; n < 8; n++)
+      {
+        value += static_cast<AccumType>(sample.weights[n]) * ToAccumType(m_Source[sample.offsets[n]]);
+      }
+      *target = FromAccumType(value);
+      return;
+    }
+
+    std::fill(accum.begin(), accum.end(), static_cast<AccumType>(0));
+    for(size_t n = 0; n < 8; n++)
     {
-      T value = GetSourceArrayValue<T>(params, pIndices, sourceArray, compIndex);
-      pValues[i * numComps + compIndex] = value;
+      const AccumType weight = static_cast<AccumType>(sample.weights[n]);
+      const T* source = m_Source + sample.offsets[n];
+      for(size_t c = 0; c < m_NumComps; c++)
+      {
+        accum[c] += weight * ToAccumType(source[c]);
+      }
     }
-    if(i == 0)
+    for(size_t c = 0; c < m_NumComps; c++)
     {
-      p1Coord = {pIndices[0] * params.xRes + (0.5F * params.xRes) + origin[0], pIndices[1] * params.yRes + (0.5F * params.yRes) + origin[1],
-                 pIndices[2] * params.zRes + (0.5F * params.zRes) + origin[2]};
+      target[c] = FromAccumType(accum[c]);
     }
   }
-  uvw[0] = oldCoords[0] - p1Coord[0];
-  uvw[1] = oldCoords[1] - p1Coord[1];
-  uvw[2] = oldCoords[2] - p1Coord[2];
-}
+};
 
 /**
  * @brief The RotateImageGeometryWithTrilinearInterpolation class
@@ -217,67 +344,17 @@ public:
   {
   }
 
-  /**
-   * @brief CalculateInterpolatedValue
-   *
-   * This comes from https://www.cs.purdue.edu/homes/cs530/slides/04.DataStructure.pdf, page 36.
-   *
-   * Note in the codes below the equations have been changed to do all of the additions first, then
-   * the subtractions. This should hopefully alleviate issue with trying to subtract unsigned integers
-   * and ending up with what should have been a negative number but since it is unsigned the value
-   * that the compiler will compute would be vastly different.
-   *
-   * @param sourceArray
-   * @param oldIndex
-   * @param indices
-   * @return
-   */
-  T CalculateInterpolatedValue(std::vector<T>& pValues, Eigen::Vector3f& uvw, size_t numComps, size_t compIndex) const
-  {
-    constexpr size_t P1 = 0;
-    constexpr size_t P2 = 1;
-    constexpr size_t P3 = 2;
-    constexpr size_t P4 = 3;
-    constexpr size_t P5 = 4;
-    constexpr size_t P6 = 5;
-    constexpr size_t P7 = 6;
-    constexpr size_t P8 = 7;
-
-    const float u = uvw[0];
-    const float v = uvw[1];
-    const float w = uvw[2];
-
-    T value = pValues[0];
-    // clang-format off
-    value += u * (pValues[P2 * numComps + compIndex] - pValues[P1 * numComps + compIndex]);
-    value += v * (pValues[P4 * numComps + compIndex] - pValues[P1 * numComps + compIndex]);
-    value += w * (pValues[P5 * numComps + compIndex] - pValues[P1 * numComps + compIndex]);
-    value += u * v * (pValues[P1 * numComps + compIndex] + pValues[P3 * numComps + compIndex] - pValues[P2 * numComps + compIndex] - pValues[P4 * numComps + compIndex]);
-    value += u * w * (pValues[P1 * numComps + compIndex] + pValues[P6 * numComps + compIndex] - pValues[P2 * numComps + compIndex] - pValues[P5 * numComps + compIndex]);
-    value += v * w * (pValues[P1 * numComps + compIndex] + pValues[P8 * numComps + compIndex] - pValues[P4 * numComps + compIndex] - pValues[P5 * numComps + compIndex]);
-    value += u * v * w *
-             ( pValues[P4 * numComps + compIndex]
-              + pValues[P2 * numComps + compIndex]
-              + pValues[P8 * numComps + compIndex]
-              + pValues[P6 * numComps + compIndex]
-              - pValues[P1 * numComps + compIndex]
-              - pValues[P3 * numComps + compIndex]
-              - pValues[P5 * numComps + compIndex]
-              - pValues[P7 * numComps + compIndex] );
-
-    // clang-format on
-    return value;
-  }
-
   /**
    * @brief This is the main algorithm to perform the interpolation and get a final value that is placed into the transformed
    * voxel. This uses Trilinear interpolation which will devolve into Bilinear and Linear interpolation depending on the
-   * values of U, V and W.
+   * values of U, V and W. The transformed geometry is processed one slab of slices at a time and each slab is split into
+   * tiles that are interpolated in parallel.
    */
   void operator()() const
   {
     using DataArrayType = DataArray<T>;
     using DataArrayPointerType = typename DataArrayType::Pointer;
+    using ResampleImplType = TrilinearResampleImpl<T>;
 
     DataArrayPointerType sourceArrayPtr = std::dynamic_pointer_cast<DataArrayType>(m_SourceArray);
     DataArrayType& sourceArray = *(sourceArrayPtr.get());
@@ -293,73 +370,32 @@ public:
 
     DataArrayPointerType targetArrayPtr = std::dynamic_pointer_cast<DataArrayType>(m_TargetArray);
 
-    //    std::ofstream originalPointsFile("/tmp/original_point_centers.csv", std::ios_base::binary);
-    //    originalPointsFile << "x,y,z" << std::endl;
-    //    std::ofstream transformedPointsFile("/tmp/transformed_point_centers.csv", std::ios_base::binary);
-    //    transformedPointsFile << "x,y,z,index,error" << std::endl;
-
-    Vector3s origImageGeomDims(m_Params.origImageGeom->getDimensions().data());
-    Eigen::Vector3f coordsOld(0.0F, 0.0F, 0.0F);
-
-    // TrilinearInterpolationData<T> interpolationValues;
-    Vector3s oldGeomIndices = {std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max()};
-
-    Eigen::Vector4f coordsNew;
-    std::vector<T> pValues(8 * numComps);
-    Eigen::Vector3f uvw;
+    Eigen::Matrix4d indexTransform = CreateIndexTransform(m_Params, m_TransformationMatrix);
+    const int64_t numTiles = ResampleImplType::NumberOfTiles(m_Params);
 
-    Matrix4fR inverseTransform = m_TransformationMatrix.inverse();
-
-    for(int64_t k = 0; k < m_Params.zpNew; k++)
+    for(int64_t zStart = 0; zStart < m_Params.zpNew; zStart += ResampleImplType::k_TileZ)
     {
       if(m_Filter->getCancel() || m_Filter->getErrorCode() < 0)
       {
         break;
       }
-      int64_t ktot = (m_Params.xpNew * m_Params.ypNew) * k;
+      int64_t zEnd = std::min(zStart + ResampleImplType::k_TileZ, m_Params.zpNew);
 
-      m_Filter->sendThreadSafeProgressMessage(QString("%1: Interpolating values for slice '%2/%3'").arg(m_SourceArray->getName()).arg(k).arg(m_Params.zpNew));
-      for(int64_t j = 0; j < m_Params.ypNew; j++)
+      // Slabs that map entirely outside of the original geometry are just zero filled
+      std::pair<int64_t, int64_t> sourceSlab = FindSourceSlab(m_Params, indexTransform, zStart, zEnd);
+      if(sourceSlab.first > sourceSlab.second)
       {
-        int64_t jtot = (m_Params.xpNew) * j;
-        for(int64_t i = 0; i < m_Params.xpNew; i++)
-        {
-          int64_t newIndex = ktot + jtot + i;
-
-          coordsNew[0] = (static_cast<float>(i) * m_Params.xResNew) + m_Params.xMinNew + 0.5F * m_Params.xResNew;
-          coordsNew[1] = (static_cast<float>(j) * m_Params.yResNew) + m_Params.yMinNew + 0.5F * m_Params.yResNew;
-          coordsNew[2] = (static_cast<float>(k) * m_Params.zResNew) + m_Params.zMinNew + 0.5F * m_Params.zResNew;
-          coordsNew[3] = 1.0F; // We take translation into account
-
-          Eigen::Array4f coordsOld = inverseTransform * coordsNew;
-
-          auto errorResult = m_Params.origImageGeom->computeCellIndex(coordsOld.data(), oldGeomIndices.data());
-          //          transformedPointsFile << coordsNew[0] << "," << coordsNew[1] << "," << coordsNew[2] << "," << newIndex << "," << static_cast<int32_t>(errorResult) << std::endl;
-          //          originalPointsFile << coordsOld[0] << "," << coordsOld[1] << "," << coordsOld[2]
-          //          << ","
-          //                             << oldIndex
-          /* << "," << value */
-          //                             << std::endl;
-          // Now we know what voxel the new cell center maps back to in the original geometry.
-          if(errorResult == ImageGeom::ErrorType::NoError)
-          {
-            size_t oldIndex = (origImageGeomDims[0] * origImageGeomDims[1] * oldGeomIndices[2]) + (origImageGeomDims[0] * oldGeomIndices[1]) + oldGeomIndices[0];
-            int octant = FindOctant(m_Params, oldIndex, {coordsOld.data()});
-
-            FindInterpolationValues(m_Params, oldIndex, octant, oldGeomIndices, coordsOld, sourceArray, pValues, uvw);
-            for(size_t compIndex = 0; compIndex < numComps; compIndex++)
-            {
-              T value = CalculateInterpolatedValue(pValues, uvw, numComps, compIndex);
-              targetArrayPtr->setComponent(newIndex, compIndex, value);
-            }
-          }
-          else
-          {
-            T value = static_cast<T>(0);
-            targetArrayPtr->fillTuple(newIndex, value);
-          }
-        }
+        const size_t sliceSize = static_cast<size_t>(m_Params.xpNew * m_Params.ypNew) * numComps;
+        std::fill(targetArrayPtr->getPointer(zStart * sliceSize), targetArrayPtr->getPointer(0) + zEnd * sliceSize, static_cast<T>(0));
+        continue;
       }
+
+      m_Filter->sendThreadSafeProgressMessage(
+          QString("%1: Interpolating values for slice '%2/%3' from slices %4-%5").arg(m_SourceArray->getName()).arg(zEnd).arg(m_Params.zpNew).arg(sourceSlab.first).arg(sourceSlab.second));
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numTiles);
+      dataAlg.execute(ResampleImplType(m_Params, indexTransform, sourceArray.getPointer(0), targetArrayPtr->getPointer(0), numComps, zStart, zEnd));
     }
 
     m_SourceArray->resizeTuples(0);
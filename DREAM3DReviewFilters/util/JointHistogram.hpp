@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The JointHistogram class counts pairs of integer labels and returns the mutual information of the two
+ * labelings.  The joint counts live in one flat array of numLabelsA * numLabelsB bins, and the bins and marginal
+ * counts touched since the last clear() are remembered, so evaluating the mutual information and clearing the
+ * histogram cost time proportional to the number of pairs added rather than to the number of bins.  The n log n
+ * terms come from a lookup table over the counts.  If the flat array would exceed k_MaxDenseBins the pairs are
+ * instead collected as keys and counted by sorting.
+ */
+class JointHistogram
+{
+public:
+  static constexpr size_t k_MaxDenseBins = size_t(1) << 24;
+
+  JointHistogram() = default;
+  ~JointHistogram() = default;
+
+  JointHistogram(const JointHistogram&) = default;
+  JointHistogram(JointHistogram&&) noexcept = default;
+  JointHistogram& operator=(const JointHistogram&) = default;
+  JointHistogram& operator=(JointHistogram&&) noexcept = default;
+
+  /**
+   * @brief resize Sets the label ranges [0, numLabelsA) and [0, numLabelsB) and clears the histogram
+   * @param numLabelsA
+   * @param numLabelsB
+   */
+  void resize(int32_t numLabelsA, int32_t numLabelsB)
+  {
+    clear();
+    m_NumLabelsB = static_cast<size_t>(std::max(numLabelsB, 0));
+    const size_t numBins = static_cast<size_t>(std::max(numLabelsA, 0)) * m_NumLabelsB;
+    m_Dense = (numBins <= k_MaxDenseBins);
+    m_Bins.assign(m_Dense ? numBins : 0, 0);
+    m_CountsA.assign(static_cast<size_t>(std::max(numLabelsA, 0)), 0);
+    m_CountsB.assign(m_NumLabelsB, 0);
+  }
+
+  /**
+   * @brief add Counts one pair of labels
+   * @param a Label in [0, numLabelsA)
+   * @param b Label in [0, numLabelsB)
+   */
+  void add(int32_t a, int32_t b)
+  {
+    const size_t key = static_cast<size_t>(a) * m_NumLabelsB + static_cast<size_t>(b);
+    if(m_Dense)
+    {
+      if(m_Bins[key]++ == 0)
+      {
+        m_TouchedBins.push_back(key);
+      }
+    }
+    else
+    {
+      m_TouchedBins.push_back(key);
+    }
+    if(m_CountsA[a]++ == 0)
+    {
+      m_TouchedA.push_back(a);
+    }
+    if(m_CountsB[b]++ == 0)
+    {
+      m_TouchedB.push_back(b);
+    }
+    m_Total++;
+  }
+
+  /**
+   * @brief findMutualInformation Returns sum p(a, b) log(p(a, b) / (p(a) p(b))) over the counted pairs, with every
+   * probability taken as a count divided by the normalizer.  The normalizer is usually the number of pairs added, but
+   * may differ from it when some pairs only serve as a background.
+   * @param normalizer
+   * @return Mutual information in nats, or 0 if the normalizer is not positive
+   */
+  double findMutualInformation(double normalizer)
+  {
+    if(normalizer <= 0.0 || m_Total == 0)
+    {
+      return 0.0;
+    }
+    growTable(m_Total);
+
+    // With n(a, b) summing to n(a) and n(b) along the rows and columns, the mutual information is
+    // (sum n(a, b) log n(a, b) - sum n(a) log n(a) - sum n(b) log n(b) + total log N) / N
+    double jointTerm = 0.0;
+    if(m_Dense)
+    {
+      for(size_t key : m_TouchedBins)
+      {
+        jointTerm += m_XLogX[m_Bins[key]];
+      }
+    }
+    else
+    {
+      std::sort(m_TouchedBins.begin(), m_TouchedBins.end());
+      for(size_t i = 0; i < m_TouchedBins.size();)
+      {
+        size_t j = i + 1;
+        while(j < m_TouchedBins.size() && m_TouchedBins[j] == m_TouchedBins[i])
+        {
+          j++;
+        }
+        jointTerm += m_XLogX[j - i];
+        i = j;
+      }
+    }
+    double marginalTerm = 0.0;
+    for(int32_t a : m_TouchedA)
+    {
+      marginalTerm += m_XLogX[m_CountsA[a]];
+    }
+    for(int32_t b : m_TouchedB)
+    {
+      marginalTerm += m_XLogX[m_CountsB[b]];
+    }
+    return (jointTerm - marginalTerm + static_cast<double>(m_Total) * std::log(normalizer)) / normalizer;
+  }
+
+  /**
+   * @brief clear Zeroes the counts added since the last clear
+   */
+  void clear()
+  {
+    if(m_Dense)
+    {
+      for(size_t key : m_TouchedBins)
+      {
+        m_Bins[key] = 0;
+      }
+    }
+    for(int32_t a : m_TouchedA)
+    {
+      m_CountsA[a] = 0;
+    }
+    for(int32_t b : m_TouchedB)
+    {
+      m_CountsB[b] = 0;
+    }
+    m_TouchedBins.clear();
+    m_TouchedA.clear();
+    m_TouchedB.clear();
+    m_Total = 0;
+  }
+
+private:
+  bool m_Dense = true;
+  size_t m_NumLabelsB = 0;
+  size_t m_Total = 0;
+  std::vector<uint32_t> m_Bins;
+  std::vector<uint32_t> m_CountsA;
+  std::vector<uint32_t> m_CountsB;
+  std::vector<size_t> m_TouchedBins;
+  std::vector<int32_t> m_TouchedA;
+  std::vector<int32_t> m_TouchedB;
+  std::vector<double> m_XLogX = {0.0};
+
+  /**
+   * @brief growTable Extends the n log n table to cover every count up to maxCount
+   */
+  void growTable(size_t maxCount)
+  {
+    for(size_t n = m_XLogX.size(); n <= maxCount; n++)
+    {
+      m_XLogX.push_back(static_cast<double>(n) * std::log(static_cast<double>(n)));
+    }
+  }
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The MajorityGapFiller class fills the gap voxels (Feature Id < 0) of an image geometry one layer at a
+ * time: every gap voxel that touches a Feature (Feature Id > 0) through a face takes the Feature that appears most
+ * often among its 6 face neighbors, with ties going to the first neighbor in -Z, -Y, -X, +X, +Y, +Z order.  This
+ * is the same assignment as repeatedly sweeping the whole volume, but only the current frontier of gap voxels is
+ * visited, so the total work is proportional to the gap volume.  The assignments of a layer are computed in parallel
+ * and written once the whole layer is known.
+ */
+class MajorityGapFiller
+{
+public:
+  /**
+   * @brief MajorityGapFiller Counts the gap voxels and collects the first frontier
+   * @param dims Image dimensions
+   * @param featureIds Cell Feature Ids, modified by fillNextLayer()
+   */
+  MajorityGapFiller(const std::array<int64_t, 3>& dims, int32_t* featureIds)
+  : m_Dims(dims)
+  , m_FeatureIds(featureIds)
+  {
+    const int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    m_Queued.assign(totalPoints, 0);
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(m_FeatureIds[i] < 0)
+      {
+        m_RemainingGaps++;
+        if(touchesFeature(i))
+        {
+          m_Queued[i] = 1;
+          m_Frontier.push_back(i);
+        }
+      }
+    }
+  }
+
+  ~MajorityGapFiller() = default;
+
+  /**
+   * @brief getRemainingGaps Returns the number of gap voxels that are not filled yet
+   */
+  size_t getRemainingGaps() const
+  {
+    return m_RemainingGaps;
+  }
+
+  /**
+   * @brief getFrontierSize Returns the number of gap voxels that the next layer will fill
+   */
+  size_t getFrontierSize() const
+  {
+    return m_Frontier.size();
+  }
+
+  /**
+   * @brief fillNextLayer Assigns every gap voxel on the current frontier and collects the next frontier
+   * @param cellPhases Cell phases, set from the Feature phases of the assigned Features
+   * @param featurePhases Feature phases
+   * @return False if there was nothing left to fill
+   */
+  bool fillNextLayer(int32_t* cellPhases, const int32_t* featurePhases)
+  {
+    if(m_Frontier.empty())
+    {
+      return false;
+    }
+
+    m_Assignments.resize(m_Frontier.size());
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, m_Frontier.size());
+    dataAlg.execute(FindMajorityImpl(this));
+
+    const size_t frontierSize = m_Frontier.size();
+    for(size_t i = 0; i < frontierSize; i++)
+    {
+      m_FeatureIds[m_Frontier[i]] = m_Assignments[i];
+      cellPhases[m_Frontier[i]] = featurePhases[m_Assignments[i]];
+    }
+    m_RemainingGaps -= frontierSize;
+
+    // The next layer is every gap voxel that touches a voxel filled by this one
+    std::vector<int64_t> nextFrontier;
+    for(int64_t voxel : m_Frontier)
+    {
+      std::array<int64_t, 6> neighbors;
+      const int32_t numNeighbors = findNeighbors(voxel, neighbors);
+      for(int32_t l = 0; l < numNeighbors; l++)
+      {
+        const int64_t neighbor = neighbors[l];
+        if(m_FeatureIds[neighbor] < 0 && m_Queued[neighbor] == 0)
+        {
+          m_Queued[neighbor] = 1;
+          nextFrontier.push_back(neighbor);
+        }
+      }
+    }
+    m_Frontier.swap(nextFrontier);
+    return true;
+  }
+
+private:
+  std::array<int64_t, 3> m_Dims;
+  int32_t* m_FeatureIds = nullptr;
+  size_t m_RemainingGaps = 0;
+  std::vector<int64_t> m_Frontier;
+  std::vector<int32_t> m_Assignments;
+  std::vector<uint8_t> m_Queued;
+
+  /**
+   * @brief findNeighbors Collects the face neighbors of a voxel that lie inside the image, in -Z, -Y, -X, +X, +Y, +Z order
+   * @param voxel
+   * @param neighbors
+   * @return Number of neighbors
+   */
+  int32_t findNeighbors(int64_t voxel, std::array<int64_t, 6>& neighbors) const
+  {
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    const int64_t x = voxel % m_Dims[0];
+    const int64_t y = (voxel / m_Dims[0]) % m_Dims[1];
+    const int64_t z = voxel / sliceSize;
+    int32_t count = 0;
+    if(z > 0)
+    {
+      neighbors[count++] = voxel - sliceSize;
+    }
+    if(y > 0)
+    {
+      neighbors[count++] = voxel - m_Dims[0];
+    }
+    if(x > 0)
+    {
+      neighbors[count++] = voxel - 1;
+    }
+    if(x < m_Dims[0] - 1)
+    {
+      neighbors[count++] = voxel + 1;
+    }
+    if(y < m_Dims[1] - 1)
+    {
+      neighbors[count++] = voxel + m_Dims[0];
+    }
+    if(z < m_Dims[2] - 1)
+    {
+      neighbors[count++] = voxel + sliceSize;
+    }
+    return count;
+  }
+
+  bool touchesFeature(int64_t voxel) const
+  {
+    std::array<int64_t, 6> neighbors;
+    const int32_t numNeighbors = findNeighbors(voxel, neighbors);
+    for(int32_t l = 0; l < numNeighbors; l++)
+    {
+      if(m_FeatureIds[neighbors[l]] > 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief The FindMajorityImpl class finds the most common neighboring Feature for a range of the frontier
+   */
+  class FindMajorityImpl
+  {
+  public:
+    explicit FindMajorityImpl(MajorityGapFiller* filler)
+    : m_Filler(filler)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      std::array<int64_t, 6> neighbors;
+      std::array<int32_t, 6> features;
+      std::array<int32_t, 6> counts;
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        const int32_t numNeighbors = m_Filler->findNeighbors(m_Filler->m_Frontier[i], neighbors);
+        int32_t numFeatures = 0;
+        int32_t most = 0;
+        int32_t assignment = 0;
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          const int32_t feature = m_Filler->m_FeatureIds[neighbors[l]];
+          if(feature <= 0)
+          {
+            continue;
+          }
+          int32_t f = 0;
+          while(f < numFeatures && features[f] != feature)
+          {
+            f++;
+          }
+          if(f == numFeatures)
+          {
+            features[f] = feature;
+            counts[f] = 0;
+            numFeatures++;
+          }
+          counts[f]++;
+          if(counts[f] > most)
+          {
+            most = counts[f];
+            assignment = feature;
+          }
+        }
+        m_Filler->m_Assignments[i] = assignment;
+      }
+    }
+
+  private:
+    MajorityGapFiller* m_Filler = nullptr;
+  };
+};
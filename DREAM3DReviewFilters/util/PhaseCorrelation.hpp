@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The PhaseCorrelation class estimates the translation between two images of the same size from the peak of
+ * their phase correlation, the inverse Fourier transform of the normalized cross-power spectrum.  The images are
+ * made zero mean, tapered with a Hann window and zero padded to powers of two, so one transform per image and one
+ * inverse transform give the correlation at every shift at once.  Whitening the spectrum makes the peak sharp and
+ * independent of the image contrast; its height is close to 1 for a pure translation and falls towards 0 as the
+ * images stop matching.  The peak location is refined to a fraction of a pixel by a parabola through the peak and
+ * its neighbors along each axis.
+ */
+class PhaseCorrelation
+{
+public:
+  using SpectrumType = std::vector<std::complex<double>>;
+
+  /**
+   * @brief The Peak struct holds one peak of the phase correlation.  The shift is the offset (x, y) for which
+   * moving(p + shift) matches reference(p).
+   */
+  struct Peak
+  {
+    int64_t x = 0;
+    int64_t y = 0;
+    double subX = 0.0;
+    double subY = 0.0;
+    float value = 0.0f;
+  };
+
+  /**
+   * @brief PhaseCorrelation
+   * @param dimX Image width
+   * @param dimY Image height
+   */
+  PhaseCorrelation(int64_t dimX, int64_t dimY)
+  : m_DimX(dimX)
+  , m_DimY(dimY)
+  , m_SizeX(findPowerOfTwo(dimX))
+  , m_SizeY(findPowerOfTwo(dimY))
+  {
+    m_WindowX = createWindow(m_DimX);
+    m_WindowY = createWindow(m_DimY);
+    m_TwiddlesX = createTwiddles(m_SizeX);
+    m_TwiddlesY = createTwiddles(m_SizeY);
+    m_Column.resize(m_SizeY);
+  }
+
+  ~PhaseCorrelation() = default;
+
+  PhaseCorrelation(const PhaseCorrelation&) = default;
+  PhaseCorrelation(PhaseCorrelation&&) noexcept = default;
+  PhaseCorrelation& operator=(const PhaseCorrelation&) = default;
+  PhaseCorrelation& operator=(PhaseCorrelation&&) noexcept = default;
+
+  /**
+   * @brief transform Computes the spectrum of a windowed image
+   * @param image dimX * dimY values, x fastest
+   * @param spectrum Resized and overwritten
+   */
+  void transform(const float* image, SpectrumType& spectrum)
+  {
+    const size_t numPixels = static_cast<size_t>(m_DimX * m_DimY);
+    double mean = 0.0;
+    for(size_t i = 0; i < numPixels; i++)
+    {
+      mean += image[i];
+    }
+    mean /= static_cast<double>(std::max<size_t>(numPixels, 1));
+
+    spectrum.assign(static_cast<size_t>(m_SizeX * m_SizeY), std::complex<double>(0.0, 0.0));
+    for(int64_t y = 0; y < m_DimY; y++)
+    {
+      const float* row = image + y * m_DimX;
+      std::complex<double>* out = spectrum.data() + y * m_SizeX;
+      for(int64_t x = 0; x < m_DimX; x++)
+      {
+        out[x] = (static_cast<double>(row[x]) - mean) * m_WindowX[x] * m_WindowY[y];
+      }
+    }
+    transform2D(spectrum, false);
+  }
+
+  /**
+   * @brief findPeaks Returns the highest values of the phase correlation between two spectra, highest first
+   * @param reference Spectrum of the reference image
+   * @param moving Spectrum of the moving image
+   * @param numPeaks Number of peaks to return
+   * @param maxShiftX Only shifts with |x| <= maxShiftX are considered
+   * @param maxShiftY Only shifts with |y| <= maxShiftY are considered
+   * @return Peaks; the first one is refined to sub-pixel precision
+   */
+  std::vector<Peak> findPeaks(const SpectrumType& reference, const SpectrumType& moving, size_t numPeaks, int64_t maxShiftX, int64_t maxShiftY)
+  {
+    const size_t size = static_cast<size_t>(m_SizeX * m_SizeY);
+    m_Correlation.resize(size);
+    double maxMagnitude = 0.0;
+    for(size_t i = 0; i < size; i++)
+    {
+      m_Correlation[i] = std::conj(reference[i]) * moving[i];
+      maxMagnitude = std::max(maxMagnitude, std::abs(m_Correlation[i]));
+    }
+    // Frequencies with no energy in either image carry no phase and are left out
+    const double threshold = 1.0E-12 * maxMagnitude;
+    for(std::complex<double>& value : m_Correlation)
+    {
+      const double magnitude = std::abs(value);
+      value = (magnitude > threshold) ? value / magnitude : std::complex<double>(0.0, 0.0);
+    }
+    transform2D(m_Correlation, true);
+
+    maxShiftX = std::min(maxShiftX, m_SizeX / 2 - 1);
+    maxShiftY = std::min(maxShiftY, m_SizeY / 2 - 1);
+    std::vector<Peak> peaks;
+    peaks.reserve(static_cast<size_t>((2 * maxShiftX + 1) * (2 * maxShiftY + 1)));
+    for(int64_t y = -maxShiftY; y <= maxShiftY; y++)
+    {
+      for(int64_t x = -maxShiftX; x <= maxShiftX; x++)
+      {
+        Peak peak;
+        peak.x = x;
+        peak.y = y;
+        peak.subX = static_cast<double>(x);
+        peak.subY = static_cast<double>(y);
+        peak.value = static_cast<float>(correlationAt(x, y));
+        peaks.push_back(peak);
+      }
+    }
+
+    numPeaks = std::min(numPeaks, peaks.size());
+    auto higher = [](const Peak& a, const Peak& b) { return a.value > b.value || (a.value == b.value && std::abs(a.x) + std::abs(a.y) < std::abs(b.x) + std::abs(b.y)); };
+    std::partial_sort(peaks.begin(), peaks.begin() + numPeaks, peaks.end(), higher);
+    peaks.resize(numPeaks);
+    if(!peaks.empty())
+    {
+      Peak& best = peaks[0];
+      best.subX += findParabolaOffset(correlationAt(best.x - 1, best.y), correlationAt(best.x, best.y), correlationAt(best.x + 1, best.y));
+      best.subY += findParabolaOffset(correlationAt(best.x, best.y - 1), correlationAt(best.x, best.y), correlationAt(best.x, best.y + 1));
+    }
+    return peaks;
+  }
+
+private:
+  int64_t m_DimX = 0;
+  int64_t m_DimY = 0;
+  int64_t m_SizeX = 1;
+  int64_t m_SizeY = 1;
+  std::vector<double> m_WindowX;
+  std::vector<double> m_WindowY;
+  std::vector<std::complex<double>> m_TwiddlesX;
+  std::vector<std::complex<double>> m_TwiddlesY;
+  std::vector<std::complex<double>> m_Column;
+  SpectrumType m_Correlation;
+
+  static int64_t findPowerOfTwo(int64_t value)
+  {
+    int64_t size = 1;
+    while(size < value)
+    {
+      size *= 2;
+    }
+    return size;
+  }
+
+  static std::vector<double> createWindow(int64_t dim)
+  {
+    std::vector<double> window(static_cast<size_t>(std::max<int64_t>(dim, 0)), 1.0);
+    if(dim > 1)
+    {
+      const double pi = 3.14159265358979323846;
+      for(int64_t i = 0; i < dim; i++)
+      {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / static_cast<double>(dim - 1));
+      }
+    }
+    return window;
+  }
+
+  static std::vector<std::complex<double>> createTwiddles(int64_t size)
+  {
+    const double pi = 3.14159265358979323846;
+    std::vector<std::complex<double>> twiddles(static_cast<size_t>(size / 2));
+    for(int64_t i = 0; i < size / 2; i++)
+    {
+      const double angle = -2.0 * pi * static_cast<double>(i) / static_cast<double>(size);
+      twiddles[i] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+    return twiddles;
+  }
+
+  /**
+   * @brief transform1D In place iterative radix-2 transform of a strided sequence whose length is a power of two
+   */
+  static void transform1D(std::complex<double>* data, int64_t size, const std::vector<std::complex<double>>& twiddles, bool inverse)
+  {
+    for(int64_t i = 1, j = 0; i < size; i++)
+    {
+      int64_t bit = size >> 1;
+      for(; (j & bit) != 0; bit >>= 1)
+      {
+        j ^= bit;
+      }
+      j ^= bit;
+      if(i < j)
+      {
+        std::swap(data[i], data[j]);
+      }
+    }
+    for(int64_t length = 2; length <= size; length *= 2)
+    {
+      const int64_t half = length / 2;
+      const int64_t step = size / length;
+      for(int64_t start = 0; start < size; start += length)
+      {
+        for(int64_t k = 0; k < half; k++)
+        {
+          const std::complex<double> twiddle = inverse ? std::conj(twiddles[k * step]) : twiddles[k * step];
+          const std::complex<double> odd = data[start + k + half] * twiddle;
+          data[start + k + half] = data[start + k] - odd;
+          data[start + k] += odd;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief transform2D Transforms the rows and then the columns; the inverse transform is scaled by 1 / size
+   */
+  void transform2D(SpectrumType& data, bool inverse)
+  {
+    for(int64_t y = 0; y < m_SizeY; y++)
+    {
+      transform1D(data.data() + y * m_SizeX, m_SizeX, m_TwiddlesX, inverse);
+    }
+    for(int64_t x = 0; x < m_SizeX; x++)
+    {
+      for(int64_t y = 0; y < m_SizeY; y++)
+      {
+        m_Column[y] = data[y * m_SizeX + x];
+      }
+      transform1D(m_Column.data(), m_SizeY, m_TwiddlesY, inverse);
+      for(int64_t y = 0; y < m_SizeY; y++)
+      {
+        data[y * m_SizeX + x] = m_Column[y];
+      }
+    }
+    if(inverse)
+    {
+      const double scale = 1.0 / static_cast<double>(m_SizeX * m_SizeY);
+      for(std::complex<double>& value : data)
+      {
+        value *= scale;
+      }
+    }
+  }
+
+  double correlationAt(int64_t x, int64_t y) const
+  {
+    const int64_t wrappedX = ((x % m_SizeX) + m_SizeX) % m_SizeX;
+    const int64_t wrappedY = ((y % m_SizeY) + m_SizeY) % m_SizeY;
+    return m_Correlation[wrappedY * m_SizeX + wrappedX].real();
+  }
+
+  /**
+   * @brief findParabolaOffset Returns the offset of the vertex of the parabola through three equally spaced values
+   * from the middle one, limited to half a pixel
+   */
+  static double findParabolaOffset(double before, double center, double after)
+  {
+    const double curvature = before - 2.0 * center + after;
+    if(curvature >= 0.0)
+    {
+      return 0.0;
+    }
+    return std::min(std::max(0.5 * (before - after) / curvature, -0.5), 0.5);
+  }
+};
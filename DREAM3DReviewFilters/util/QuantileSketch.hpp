@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The QuantileSketch class is a mergeable streaming quantile summary (Karnin, Lang & Liberty, "Optimal
+ * Quantile Approximation in Streams").  Values are collected in a stack of compactors; a full compactor is sorted
+ * and every other value moves one level up with twice the weight.  The capacities shrink geometrically towards the
+ * bottom of the stack, so the sketch keeps O(k) values however many are added, and with capacity k the rank of a
+ * reported quantile is off by about 2/k of the count.  Until the first compaction the sketch holds every value and
+ * its quantiles are exact.  Sketches built on separate parts of an input merge into the sketch of the whole input;
+ * the compaction offsets come from a fixed seed, so the same inputs merged in the same order give the same result.
+ */
+template <typename T>
+class QuantileSketch
+{
+public:
+  /**
+   * @brief QuantileSketch
+   * @param capacity Capacity k of the top compactor, at least 8
+   */
+  explicit QuantileSketch(size_t capacity = 200)
+  : m_Capacity(std::max<size_t>(capacity, 8))
+  {
+  }
+
+  ~QuantileSketch() = default;
+
+  QuantileSketch(const QuantileSketch&) = default;
+  QuantileSketch(QuantileSketch&&) noexcept = default;
+  QuantileSketch& operator=(const QuantileSketch&) = default;
+  QuantileSketch& operator=(QuantileSketch&&) noexcept = default;
+
+  /**
+   * @brief FindCapacity Returns the capacity that keeps the rank error of a sketch below the given fraction of its count
+   * @param rankError Allowed rank error as a fraction of the count, in (0, 0.5]
+   * @return Capacity
+   */
+  static size_t FindCapacity(double rankError)
+  {
+    return static_cast<size_t>(std::ceil(2.0 / rankError));
+  }
+
+  /**
+   * @brief FindMaxSize Returns an upper bound on the number of values that a sketch of the given capacity keeps
+   * @param capacity Capacity k of the top compactor
+   * @return Number of values
+   */
+  static size_t FindMaxSize(size_t capacity)
+  {
+    // The level capacities sum to less than 3k plus two per level, and a 64 bit count never needs more than 64 levels
+    return 3 * std::max<size_t>(capacity, 8) + 128;
+  }
+
+  /**
+   * @brief add Adds one value to the sketch
+   * @param value
+   */
+  void add(T value)
+  {
+    if(m_Compactors.empty())
+    {
+      grow();
+    }
+    m_Compactors[0].push_back(value);
+    m_Count++;
+    m_Size++;
+    if(m_Size >= m_MaxSize)
+    {
+      compress();
+    }
+  }
+
+  /**
+   * @brief merge Adds every value summarized by another sketch to this one
+   * @param other
+   */
+  void merge(const QuantileSketch& other)
+  {
+    if(other.m_Count == 0)
+    {
+      return;
+    }
+    while(m_Compactors.size() < other.m_Compactors.size())
+    {
+      grow();
+    }
+    for(size_t h = 0; h < other.m_Compactors.size(); h++)
+    {
+      m_Compactors[h].insert(m_Compactors[h].end(), other.m_Compactors[h].begin(), other.m_Compactors[h].end());
+    }
+    m_Count += other.m_Count;
+    m_Size += other.m_Size;
+    while(m_Size >= m_MaxSize)
+    {
+      compress();
+    }
+  }
+
+  /**
+   * @brief getCount Returns the number of values added to the sketch
+   */
+  uint64_t getCount() const
+  {
+    return m_Count;
+  }
+
+  /**
+   * @brief getQuantiles Returns the values at the given quantiles.  A quantile q sits at rank q * (count - 1) and
+   * falls between the two neighboring ranks by linear interpolation, so an exact sketch reports the median of an even
+   * count as the mean of the two middle values.
+   * @param quantiles Quantiles in [0, 1]
+   * @return One value per quantile, or zeros if the sketch is empty
+   */
+  std::vector<float> getQuantiles(const std::vector<float>& quantiles) const
+  {
+    std::vector<float> result(quantiles.size(), 0.0f);
+    if(m_Count == 0)
+    {
+      return result;
+    }
+
+    std::vector<std::pair<T, uint64_t>> items;
+    items.reserve(m_Size);
+    for(size_t h = 0; h < m_Compactors.size(); h++)
+    {
+      for(const T& value : m_Compactors[h])
+      {
+        items.emplace_back(value, uint64_t(1) << h);
+      }
+    }
+    std::sort(items.begin(), items.end(), [](const std::pair<T, uint64_t>& a, const std::pair<T, uint64_t>& b) { return a.first < b.first; });
+
+    // A compaction replaces two values of one weight with one value of twice that weight, so the weights add up to the count
+    const uint64_t totalWeight = m_Count;
+    auto valueAtRank = [&items](uint64_t rank) {
+      uint64_t cumulative = 0;
+      for(const auto& item : items)
+      {
+        cumulative += item.second;
+        if(rank < cumulative)
+        {
+          return static_cast<float>(item.first);
+        }
+      }
+      return static_cast<float>(items.back().first);
+    };
+
+    for(size_t i = 0; i < quantiles.size(); i++)
+    {
+      const double q = std::min(std::max(static_cast<double>(quantiles[i]), 0.0), 1.0);
+      const double rank = q * static_cast<double>(totalWeight - 1);
+      const uint64_t lowRank = static_cast<uint64_t>(std::floor(rank));
+      const float low = valueAtRank(lowRank);
+      const float high = valueAtRank(std::min(lowRank + 1, totalWeight - 1));
+      const float fraction = static_cast<float>(rank - static_cast<double>(lowRank));
+      result[i] = (fraction == 0.0f) ? low : low + (high - low) * fraction;
+    }
+    return result;
+  }
+
+private:
+  size_t m_Capacity = 200;
+  uint64_t m_Count = 0;
+  size_t m_Size = 0;
+  size_t m_MaxSize = 0;
+  uint64_t m_RandomState = 0x9E3779B97F4A7C15ULL;
+  std::vector<std::vector<T>> m_Compactors;
+
+  /**
+   * @brief levelCapacity Returns the capacity of the compactor at the given height; each level below the top holds 2/3 of the one above
+   */
+  size_t levelCapacity(size_t height) const
+  {
+    const size_t depth = m_Compactors.size() - height - 1;
+    return static_cast<size_t>(std::ceil(std::pow(2.0 / 3.0, static_cast<double>(depth)) * static_cast<double>(m_Capacity))) + 1;
+  }
+
+  void grow()
+  {
+    m_Compactors.emplace_back();
+    m_MaxSize = 0;
+    for(size_t h = 0; h < m_Compactors.size(); h++)
+    {
+      m_MaxSize += levelCapacity(h);
+    }
+  }
+
+  bool nextCoin()
+  {
+    // xorshift64
+    m_RandomState ^= m_RandomState << 13;
+    m_RandomState ^= m_RandomState >> 7;
+    m_RandomState ^= m_RandomState << 17;
+    return (m_RandomState & 1) != 0;
+  }
+
+  void compress()
+  {
+    for(size_t h = 0; h < m_Compactors.size(); h++)
+    {
+      if(m_Compactors[h].size() < levelCapacity(h))
+      {
+        continue;
+      }
+      if(h + 1 == m_Compactors.size())
+      {
+        grow();
+      }
+
+      // Every other value of the sorted pairs moves up; an odd value out stays on this level
+      std::vector<T>& compactor = m_Compactors[h];
+      std::vector<T>& above = m_Compactors[h + 1];
+      std::sort(compactor.begin(), compactor.end());
+      const size_t numPairs = compactor.size() / 2;
+      const size_t start = compactor.size() - 2 * numPairs;
+      const size_t offset = nextCoin() ? 1 : 0;
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        above.push_back(compactor[start + 2 * i + offset]);
+      }
+      compactor.resize(start);
+      m_Size -= numPairs;
+
+      if(m_Size < m_MaxSize)
+      {
+        break;
+      }
+    }
+  }
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The SectionComponentLabeling namespace labels the connected components of a 2D section with a two pass
+ * union-find.  The first pass joins every pair of face neighbors that the caller reports as connected; the second
+ * pass gives every component a compact label in the order its first Cell appears in the section.  Sections do not
+ * share any state, so separate sections can be labeled concurrently.
+ */
+namespace SectionComponentLabeling
+{
+/**
+ * @brief FindRoot Returns the root of a Cell, halving the path on the way
+ */
+inline int64_t FindRoot(std::vector<int64_t>& parents, int64_t index)
+{
+  while(parents[index] != index)
+  {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+  return index;
+}
+
+/**
+ * @brief Union Joins the components of two Cells under the smaller root
+ */
+inline void Union(std::vector<int64_t>& parents, int64_t a, int64_t b)
+{
+  a = FindRoot(parents, a);
+  b = FindRoot(parents, b);
+  if(a < b)
+  {
+    parents[b] = a;
+  }
+  else if(b < a)
+  {
+    parents[a] = b;
+  }
+}
+
+/**
+ * @brief LabelSection Labels the components of one section
+ * @param dimX Section width
+ * @param dimY Section height
+ * @param eligible eligible(i) is true if Cell i can belong to a component
+ * @param connected connected(i, j) is true if the eligible face neighbors i < j belong to the same component
+ * @param seedable seedable(i) is true if Cell i can start a component; components without such a Cell stay unlabeled
+ * @param labels dimX * dimY labels, 1 and up for components and 0 for unlabeled Cells
+ * @param parents Scratch buffer reused between calls
+ * @return Number of components labeled
+ */
+template <typename Eligible, typename Connected, typename Seedable>
+int32_t LabelSection(int64_t dimX, int64_t dimY, Eligible&& eligible, Connected&& connected, Seedable&& seedable, int32_t* labels, std::vector<int64_t>& parents)
+{
+  const int64_t numCells = dimX * dimY;
+  parents.resize(static_cast<size_t>(numCells));
+  for(int64_t i = 0; i < numCells; i++)
+  {
+    parents[i] = i;
+  }
+
+  for(int64_t y = 0; y < dimY; y++)
+  {
+    for(int64_t x = 0; x < dimX; x++)
+    {
+      const int64_t index = y * dimX + x;
+      if(!eligible(index))
+      {
+        continue;
+      }
+      if(x + 1 < dimX && eligible(index + 1) && connected(index, index + 1))
+      {
+        Union(parents, index, index + 1);
+      }
+      if(y + 1 < dimY && eligible(index + dimX) && connected(index, index + dimX))
+      {
+        Union(parents, index, index + dimX);
+      }
+    }
+  }
+
+  // A root is the first Cell of its component, so one raster pass can flag the seedable roots
+  // and a second one hands out the labels in order of appearance
+  for(int64_t i = 0; i < numCells; i++)
+  {
+    labels[i] = 0;
+  }
+  for(int64_t i = 0; i < numCells; i++)
+  {
+    if(eligible(i) && seedable(i))
+    {
+      labels[FindRoot(parents, i)] = -1;
+    }
+  }
+  int32_t numLabels = 0;
+  for(int64_t i = 0; i < numCells; i++)
+  {
+    if(!eligible(i))
+    {
+      continue;
+    }
+    const int64_t root = FindRoot(parents, i);
+    if(root == i && labels[i] == -1)
+    {
+      labels[i] = ++numLabels;
+    }
+    else if(root != i)
+    {
+      labels[i] = labels[root];
+    }
+  }
+  return numLabels;
+}
+} // namespace SectionComponentLabeling
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The ShapeRasterizer namespace holds the voxelization kernel shared by the synthetic builders that place
+ * ellipsoids, super ellipsoids, cube-octahedra and cylinders with the SIMPLib ShapeOps.  Every shape the ShapeOps
+ * describe lies inside the unit box of its own (radius scaled) axes, so along each grid line of the bounding box
+ * only the span of voxels whose axis components all lie in [-1, 1] can be inside.  The span is found in closed form;
+ * the axis components along the span are computed in one contiguous pass and only those voxels are handed to the
+ * ShapeOps inside() test, which stays the single definition of every shape.
+ */
+namespace ShapeRasterizer
+{
+/**
+ * @brief The Shape struct describes one placed shape.  The rows of the axes matrix project an offset from the
+ * center onto the shape axes, and the inverse radii scale those projections to the unit box of the shape.
+ */
+struct Shape
+{
+  std::array<float, 3> center = {0.0f, 0.0f, 0.0f};
+  float axes[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+  std::array<float, 3> invRadii = {1.0f, 1.0f, 1.0f};
+  ShapeOps* shapeOps = nullptr;
+};
+
+/**
+ * @brief FindRowSpan Narrows a range of columns along the grid line (row, plane) to the columns whose axis
+ * components all lie in [-1, 1].  The unit box is widened slightly and the span is padded by one voxel on either
+ * side, so single precision rounding can never drop a voxel that the per voxel test would accept.
+ * @param shape
+ * @param spacing Grid spacing
+ * @param row
+ * @param plane
+ * @param xmin First column, modified in place
+ * @param xmax Last column, modified in place
+ * @return False if no column of the line can be inside the shape
+ */
+inline bool FindRowSpan(const Shape& shape, const std::array<float, 3>& spacing, int64_t row, int64_t plane, int64_t& xmin, int64_t& xmax)
+{
+  const double c1 = static_cast<double>(row) * spacing[1] - shape.center[1];
+  const double c2 = static_cast<double>(plane) * spacing[2] - shape.center[2];
+  double lower = static_cast<double>(xmin);
+  double upper = static_cast<double>(xmax);
+  for(size_t i = 0; i < 3; i++)
+  {
+    // Axis component i along the line is (slope * x + intercept) * invRadii[i]
+    const double radius = (1.0 + 1.0E-3) / shape.invRadii[i];
+    const double slope = static_cast<double>(shape.axes[i][0]) * spacing[0];
+    const double intercept = -static_cast<double>(shape.axes[i][0]) * shape.center[0] + shape.axes[i][1] * c1 + shape.axes[i][2] * c2;
+    if(std::fabs(slope) * (upper - lower + 2.0) < 1.0E-6 * radius)
+    {
+      // The component barely changes along the line, so only its value at the start decides
+      if(std::fabs(slope * lower + intercept) > radius)
+      {
+        return false;
+      }
+      continue;
+    }
+    double first = (-radius - intercept) / slope;
+    double last = (radius - intercept) / slope;
+    if(first > last)
+    {
+      std::swap(first, last);
+    }
+    lower = std::max(lower, std::floor(first) - 1.0);
+    upper = std::min(upper, std::ceil(last) + 1.0);
+    if(lower > upper)
+    {
+      return false;
+    }
+  }
+  xmin = static_cast<int64_t>(lower);
+  xmax = static_cast<int64_t>(upper);
+  return true;
+}
+
+/**
+ * @brief RasterizeRow Visits every voxel of the grid line (row, plane) between columns xmin and xmax that is
+ * inside the shape.  The axis components use the same single precision arithmetic as a per voxel evaluation, so
+ * the accepted voxels and their shape values are unchanged by the span culling.
+ * @param shape
+ * @param spacing Grid spacing
+ * @param row
+ * @param plane
+ * @param xmin First column
+ * @param xmax Last column
+ * @param scratch Buffer reused between calls
+ * @param visitor Called as visitor(column, inside) for every voxel with a non-negative shape value
+ */
+template <typename Visitor>
+void RasterizeRow(const Shape& shape, const std::array<float, 3>& spacing, int64_t row, int64_t plane, int64_t xmin, int64_t xmax, std::vector<float>& scratch, Visitor&& visitor)
+{
+  if(!FindRowSpan(shape, spacing, row, plane, xmin, xmax))
+  {
+    return;
+  }
+
+  const size_t count = static_cast<size_t>(xmax - xmin + 1);
+  scratch.resize(3 * count);
+  float* axis1comp = scratch.data();
+  float* axis2comp = axis1comp + count;
+  float* axis3comp = axis2comp + count;
+  const float c1 = float(row) * spacing[1] - shape.center[1];
+  const float c2 = float(plane) * spacing[2] - shape.center[2];
+  for(size_t i = 0; i < count; i++)
+  {
+    const float c0 = float(xmin + static_cast<int64_t>(i)) * spacing[0] - shape.center[0];
+    axis1comp[i] = (shape.axes[0][0] * c0 + shape.axes[0][1] * c1 + shape.axes[0][2] * c2) * shape.invRadii[0];
+    axis2comp[i] = (shape.axes[1][0] * c0 + shape.axes[1][1] * c1 + shape.axes[1][2] * c2) * shape.invRadii[1];
+    axis3comp[i] = (shape.axes[2][0] * c0 + shape.axes[2][1] * c1 + shape.axes[2][2] * c2) * shape.invRadii[2];
+  }
+  for(size_t i = 0; i < count; i++)
+  {
+    const float inside = shape.shapeOps->inside(axis1comp[i], axis2comp[i], axis3comp[i]);
+    if(inside >= 0)
+    {
+      visitor(xmin + static_cast<int64_t>(i), inside);
+    }
+  }
+}
+
+/**
+ * @brief The RasterizeShapeImpl class claims the voxels inside a shape for one Feature over a range of the grid
+ * lines of a bounding box.  Box coordinates outside the image wrap once around it, and a voxel goes to the Feature
+ * with the largest shape value, keeping the earlier Feature on a tie.
+ */
+class RasterizeShapeImpl
+{
+public:
+  RasterizeShapeImpl(const Shape& shape, int32_t featureId, const std::array<int64_t, 3>& dims, const std::array<float, 3>& spacing, const std::array<int64_t, 6>& bounds, int32_t* owners,
+                     float* shapeValues)
+  : m_Shape(shape)
+  , m_FeatureId(featureId)
+  , m_Dims(dims)
+  , m_Spacing(spacing)
+  , m_Bounds(bounds)
+  , m_Owners(owners)
+  , m_ShapeValues(shapeValues)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    std::vector<float> scratch;
+    const int64_t numRows = m_Bounds[3] - m_Bounds[2] + 1;
+    for(size_t line = range.min(); line < range.max(); line++)
+    {
+      const int64_t row = m_Bounds[2] + static_cast<int64_t>(line) % numRows;
+      const int64_t plane = m_Bounds[4] + static_cast<int64_t>(line) / numRows;
+      const int64_t rowOffset = (wrap(plane, m_Dims[2]) * m_Dims[1] + wrap(row, m_Dims[1])) * m_Dims[0];
+      RasterizeRow(m_Shape, m_Spacing, row, plane, m_Bounds[0], m_Bounds[1], scratch, [this, rowOffset](int64_t column, float inside) {
+        const int64_t index = rowOffset + wrap(column, m_Dims[0]);
+        if((m_Owners[index] > 0 && inside > m_ShapeValues[index]) || m_Owners[index] == -1)
+        {
+          m_Owners[index] = m_FeatureId;
+          m_ShapeValues[index] = inside;
+        }
+      });
+    }
+  }
+
+private:
+  Shape m_Shape;
+  int32_t m_FeatureId;
+  std::array<int64_t, 3> m_Dims;
+  std::array<float, 3> m_Spacing;
+  std::array<int64_t, 6> m_Bounds;
+  int32_t* m_Owners;
+  float* m_ShapeValues;
+
+  static int64_t wrap(int64_t value, int64_t dim)
+  {
+    if(value < 0)
+    {
+      return value + dim;
+    }
+    if(value > dim - 1)
+    {
+      return value - dim;
+    }
+    return value;
+  }
+};
+
+/**
+ * @brief RasterizeShape Claims the voxels of an image that are inside a shape for one Feature.  Unclaimed voxels
+ * hold an owner of -1; a claimed voxel moves to this Feature only if its shape value is larger.
+ * @param shape
+ * @param featureId Feature claiming the voxels, must be positive
+ * @param dims Image dimensions
+ * @param spacing Image spacing
+ * @param bounds Inclusive voxel bounding box (xmin, xmax, ymin, ymax, zmin, zmax), at most one image size outside the image
+ * @param owners Owning Feature of every voxel
+ * @param shapeValues Shape value of every voxel for its owning Feature
+ */
+inline void RasterizeShape(const Shape& shape, int32_t featureId, const std::array<int64_t, 3>& dims, const std::array<float, 3>& spacing, const std::array<int64_t, 6>& bounds, int32_t* owners,
+                           float* shapeValues)
+{
+  const int64_t numRows = bounds[3] - bounds[2] + 1;
+  const int64_t numPlanes = bounds[5] - bounds[4] + 1;
+  if(bounds[1] < bounds[0] || numRows <= 0 || numPlanes <= 0)
+  {
+    return;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(numRows * numPlanes));
+  // Grid lines of a box larger than the image wrap onto the same voxels, so such a box is not split between threads
+  dataAlg.setParallelizationEnabled(numRows <= dims[1] && numPlanes <= dims[2]);
+  dataAlg.execute(RasterizeShapeImpl(shape, featureId, dims, spacing, bounds, owners, shapeValues));
+}
+} // namespace ShapeRasterizer
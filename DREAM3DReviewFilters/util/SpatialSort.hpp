@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace SpatialSort
+{
+/**
+ * @brief HilbertIndex2D Returns the distance along a Hilbert curve of the given order for the
+ * integer grid location (x, y); both coordinates must be less than 2^order
+ * @param x
+ * @param y
+ * @param order
+ * @return Hilbert index
+ */
+inline uint64_t HilbertIndex2D(uint32_t x, uint32_t y, uint32_t order)
+{
+  const uint32_t n = 1U << order;
+  uint64_t index = 0;
+  for(uint32_t s = n >> 1; s > 0; s >>= 1)
+  {
+    uint32_t rx = (x & s) > 0 ? 1 : 0;
+    uint32_t ry = (y & s) > 0 ? 1 : 0;
+    index += static_cast<uint64_t>(s) * static_cast<uint64_t>(s) * ((3 * rx) ^ ry);
+    if(ry == 0)
+    {
+      if(rx == 1)
+      {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+/**
+ * @brief HilbertSort Sorts the given point indices along a 2D Hilbert curve through the XY
+ * bounding box of the points.  The container only needs to support vertices[i][0] and vertices[i][1].
+ * @param vertices
+ * @param first
+ * @param last
+ */
+template <typename VertexContainer>
+void HilbertSort(const VertexContainer& vertices, std::vector<int64_t>::iterator first, std::vector<int64_t>::iterator last)
+{
+  if(last - first < 2)
+  {
+    return;
+  }
+
+  constexpr uint32_t k_Order = 16;
+  constexpr double k_GridMax = static_cast<double>((1U << k_Order) - 1);
+
+  double bounds[4] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()};
+  for(auto iter = first; iter != last; ++iter)
+  {
+    bounds[0] = std::min(bounds[0], static_cast<double>(vertices[*iter][0]));
+    bounds[1] = std::max(bounds[1], static_cast<double>(vertices[*iter][0]));
+    bounds[2] = std::min(bounds[2], static_cast<double>(vertices[*iter][1]));
+    bounds[3] = std::max(bounds[3], static_cast<double>(vertices[*iter][1]));
+  }
+  double scale = std::max(bounds[1] - bounds[0], bounds[3] - bounds[2]);
+  scale = scale > 0.0 ? k_GridMax / scale : 0.0;
+
+  std::vector<std::pair<uint64_t, int64_t>> keys;
+  keys.reserve(last - first);
+  for(auto iter = first; iter != last; ++iter)
+  {
+    uint32_t gx = static_cast<uint32_t>((static_cast<double>(vertices[*iter][0]) - bounds[0]) * scale);
+    uint32_t gy = static_cast<uint32_t>((static_cast<double>(vertices[*iter][1]) - bounds[2]) * scale);
+    keys.emplace_back(HilbertIndex2D(gx, gy, k_Order), *iter);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  for(auto&& key : keys)
+  {
+    *first = key.second;
+    ++first;
+  }
+}
+
+/**
+ * @brief BiasedRandomizedInsertionOrder Returns a biased randomized insertion order (BRIO) for
+ * the given vertices: the points are randomly shuffled, split into rounds of doubling size,
+ * and each round is sorted along a Hilbert curve.  Incremental triangulators that walk from the
+ * last inserted point then see short walks while keeping the expected behavior of random insertion.
+ * The order is fully determined by the seed.
+ * @param vertices
+ * @param seed
+ * @return Insertion order
+ */
+template <typename VertexContainer>
+std::vector<int64_t> BiasedRandomizedInsertionOrder(const VertexContainer& vertices, uint64_t seed = 5489U)
+{
+  std::vector<int64_t> order(vertices.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  std::mt19937_64 generator(seed);
+  std::shuffle(order.begin(), order.end(), generator);
+
+  constexpr size_t k_MinRoundSize = 64;
+  size_t end = order.size();
+  while(end > 0)
+  {
+    size_t begin = end > k_MinRoundSize ? end / 2 : 0;
+    HilbertSort(vertices, order.begin() + begin, order.begin() + end);
+    end = begin;
+  }
+
+  return order;
+}
+} // namespace SpatialSort
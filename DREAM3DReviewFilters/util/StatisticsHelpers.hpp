@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <numeric>
 #include <type_traits>
 #include <vector>
@@ -31,19 +33,19 @@ T findMax(const C<T, Ts...>& source)
 }
 
 // -----------------------------------------------------------------------------
-template <class Container>
-auto computeSum(const Container& source)
+template <typename Iterator>
+auto computeSum(Iterator first, Iterator last)
 {
-  using T = typename Container::value_type;
+  using T = typename std::iterator_traits<Iterator>::value_type;
   if constexpr(std::is_integral_v<T>)
   {
     if constexpr(std::is_signed_v<T>)
     {
-      return std::accumulate(std::cbegin(source), std::cend(source), static_cast<int64_t>(0));
+      return std::accumulate(first, last, static_cast<int64_t>(0));
     }
     else
     {
-      return std::accumulate(std::cbegin(source), std::cend(source), static_cast<uint64_t>(0));
+      return std::accumulate(first, last, static_cast<uint64_t>(0));
     }
   }
   else // Use Kahan Summation for float/double
@@ -54,9 +56,9 @@ auto computeSum(const Container& source)
     double c = 0.0;
 
     // Loop to iterate over the array
-    for(const T& f : source)
+    for(; first != last; ++first)
     {
-      double y = static_cast<double>(f) - c;
+      double y = static_cast<double>(*first) - c;
       double t = sum + y;
 
       // Algebraically, c is always 0
@@ -74,6 +76,13 @@ auto computeSum(const Container& source)
   }
 }
 
+// -----------------------------------------------------------------------------
+template <class Container>
+auto computeSum(const Container& source)
+{
+  return computeSum(std::cbegin(source), std::cend(source));
+}
+
 // -----------------------------------------------------------------------------
 template <template <typename, typename...> class C, typename T, typename... Ts>
 float findMean(const C<T, Ts...>& source)
@@ -87,6 +96,25 @@ float findMean(const C<T, Ts...>& source)
   return sum / static_cast<float>(source.size());
 }
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief findMean Finds the mean of a range of values, with the same result as findMean() on a container of them
+ * @param first
+ * @param last
+ * @return Mean value
+ */
+template <typename Iterator>
+float findMean(Iterator first, Iterator last)
+{
+  if(first == last)
+  {
+    return 0.0f;
+  }
+  float sum = static_cast<float>(computeSum(first, last));
+
+  return sum / static_cast<float>(std::distance(first, last));
+}
+
 // -----------------------------------------------------------------------------
 template <template <typename, typename...> class C, typename... Ts>
 bool findMean(const C<bool, Ts...>& source)
@@ -125,6 +153,73 @@ float findMedian(const C<T, Ts...>& source)
   return medVal;
 }
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief findMedianInPlace Finds the median of a range with a partial sort instead of a full one.  The range is
+ * reordered.  The result is the same as findMedian() on the same values.
+ * @param first
+ * @param last
+ * @return Median value
+ */
+template <typename Iterator>
+float findMedianInPlace(Iterator first, Iterator last)
+{
+  const auto numElements = std::distance(first, last);
+  if(numElements == 0)
+  {
+    return 0.0f;
+  }
+  Iterator high = first + numElements / 2;
+  std::nth_element(first, high, last);
+  if(numElements % 2 == 1)
+  {
+    return static_cast<float>(*high);
+  }
+  // After the partition the lower middle value is the largest value in front of the upper one
+  Iterator low = std::max_element(first, high);
+  return static_cast<float>((*low + *high) * 0.5f);
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief findPercentilesInPlace Finds the values of a range at the given quantiles with partial sorts.  A quantile
+ * q sits at rank q * (size - 1) and falls between the two neighboring ranks by linear interpolation.  The range is
+ * reordered.
+ * @param first
+ * @param last
+ * @param quantiles Quantiles in [0, 1]
+ * @return One value per quantile, or zeros if the range is empty
+ */
+template <typename Iterator>
+std::vector<float> findPercentilesInPlace(Iterator first, Iterator last, const std::vector<float>& quantiles)
+{
+  std::vector<float> result(quantiles.size(), 0.0f);
+  const auto numElements = std::distance(first, last);
+  if(numElements == 0)
+  {
+    return result;
+  }
+  for(size_t i = 0; i < quantiles.size(); i++)
+  {
+    const double q = std::min(std::max(static_cast<double>(quantiles[i]), 0.0), 1.0);
+    const double rank = q * static_cast<double>(numElements - 1);
+    const auto lowRank = static_cast<decltype(numElements)>(std::floor(rank));
+    Iterator lowIter = first + lowRank;
+    std::nth_element(first, lowIter, last);
+    const float low = static_cast<float>(*lowIter);
+    const float fraction = static_cast<float>(rank - static_cast<double>(lowRank));
+    if(fraction == 0.0f)
+    {
+      result[i] = low;
+      continue;
+    }
+    // After the partition the next rank is the smallest value behind the lower one
+    const float high = static_cast<float>(*std::min_element(lowIter + 1, last));
+    result[i] = low + (high - low) * fraction;
+  }
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 template <template <typename, typename...> class C, typename T, typename... Ts>
 float findStdDeviation(const C<T, Ts...>& source)
@@ -141,6 +236,33 @@ float findStdDeviation(const C<T, Ts...>& source)
   return std::sqrt(squaredSum / source.size());
 }
 
+// -----------------------------------------------------------------------------
+/**
+ * @brief findStdDeviation Finds the standard deviation of a range of values without a buffer of differences.  The
+ * arithmetic follows findStdDeviation() on a container step by step, so the result is the same to the last bit.
+ * @param first
+ * @param last
+ * @return Standard deviation
+ */
+template <typename Iterator>
+float findStdDeviation(Iterator first, Iterator last)
+{
+  if(first == last)
+  {
+    return 0.0f;
+  }
+  const size_t numElements = static_cast<size_t>(std::distance(first, last));
+  float sum = static_cast<float>(computeSum(first, last));
+  float mean = static_cast<double>(sum / numElements);
+  float squaredSum = 0.0f;
+  for(; first != last; ++first)
+  {
+    const double difference = static_cast<float>(*first) - mean;
+    squaredSum = static_cast<float>(squaredSum + difference * difference);
+  }
+  return std::sqrt(squaredSum / numElements);
+}
+
 // -----------------------------------------------------------------------------
 template <template <typename, typename...> class C, typename... Ts>
 bool findStdDeviation(const C<bool, Ts...>& source)
@@ -164,6 +286,111 @@ double findSummation(const C<T, Ts...>& source)
   float sum = static_cast<float>(computeSum(source));
   return sum;
 }
+
+/**
+ * @brief The RunningStatistics class accumulates the count, extrema, sum and variance of a stream of values in a
+ * single pass.  Integer sums are exact as in computeSum(), floating point sums are Kahan compensated, and the
+ * variance uses Welford's update.  Accumulators over disjoint parts of a stream can be merged, so a stream may be
+ * split between threads and the partial results combined afterwards.
+ */
+template <typename T>
+class RunningStatistics
+{
+public:
+  using SumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>, double>;
+
+  void add(T value)
+  {
+    if(m_Count == 0)
+    {
+      m_Min = value;
+      m_Max = value;
+    }
+    else
+    {
+      m_Min = std::min(m_Min, value);
+      m_Max = std::max(m_Max, value);
+    }
+    m_Count++;
+    addToSum(static_cast<SumType>(value), 0);
+    const double delta = static_cast<double>(value) - m_Mean;
+    m_Mean += delta / static_cast<double>(m_Count);
+    m_M2 += delta * (static_cast<double>(value) - m_Mean);
+  }
+
+  void merge(const RunningStatistics& other)
+  {
+    if(other.m_Count == 0)
+    {
+      return;
+    }
+    if(m_Count == 0)
+    {
+      *this = other;
+      return;
+    }
+    m_Min = std::min(m_Min, other.m_Min);
+    m_Max = std::max(m_Max, other.m_Max);
+    addToSum(other.m_Sum, other.m_Compensation);
+    const double count = static_cast<double>(m_Count + other.m_Count);
+    const double delta = other.m_Mean - m_Mean;
+    m_Mean += delta * static_cast<double>(other.m_Count) / count;
+    m_M2 += other.m_M2 + delta * delta * static_cast<double>(m_Count) * static_cast<double>(other.m_Count) / count;
+    m_Count += other.m_Count;
+  }
+
+  size_t getCount() const
+  {
+    return m_Count;
+  }
+
+  T getMin() const
+  {
+    return m_Count == 0 ? static_cast<T>(0) : m_Min;
+  }
+
+  T getMax() const
+  {
+    return m_Count == 0 ? static_cast<T>(0) : m_Max;
+  }
+
+  SumType getSum() const
+  {
+    return m_Sum;
+  }
+
+  /**
+   * @brief getVariance Returns the population variance
+   */
+  double getVariance() const
+  {
+    return m_Count == 0 ? 0.0 : m_M2 / static_cast<double>(m_Count);
+  }
+
+private:
+  size_t m_Count = 0;
+  T m_Min = static_cast<T>(0);
+  T m_Max = static_cast<T>(0);
+  SumType m_Sum = 0;
+  SumType m_Compensation = 0;
+  double m_Mean = 0.0;
+  double m_M2 = 0.0;
+
+  void addToSum(SumType value, SumType compensation)
+  {
+    if constexpr(std::is_integral_v<SumType>)
+    {
+      m_Sum += value;
+    }
+    else
+    {
+      SumType y = value - compensation - m_Compensation;
+      SumType t = m_Sum + y;
+      m_Compensation = (t - m_Sum) - y;
+      m_Sum = t;
+    }
+  }
+};
 } // namespace StatisticsHelpers
 
 #ifdef STATISTICS_FILTER_CLASS_NAME
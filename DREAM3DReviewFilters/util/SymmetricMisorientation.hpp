@@ -0,0 +1,114 @@
+#pragma once
+
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The SymmetricMisorientation namespace finds misorientation angles in batches.  It uses the same convention
+ * as LaueOps::calculateMisorientation: the product X = q1 * q2^-1 of the two orientations, formed with the EbsdLib
+ * quaternion product, is reduced against every symmetry operator S applied on the left, and the misorientation angle
+ * is that of the closest equivalent S * X.  Only the w component of S * X is needed, sw * xw - s . x, and the largest
+ * |w| over the operators gives the angle 2 * acos(|w|).  The operators are kept in structure of arrays form so that
+ * one operator at a time can be applied to a whole batch of products.
+ */
+namespace SymmetricMisorientation
+{
+/**
+ * @brief The SymmetryTable struct holds the symmetry operators of one crystal structure in structure of arrays form
+ */
+struct SymmetryTable
+{
+  std::vector<double> w;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+};
+
+/**
+ * @brief CreateSymmetryTable Collects the symmetry operators of a LaueOps class
+ * @param ops
+ * @return Symmetry table
+ */
+inline SymmetryTable CreateSymmetryTable(const LaueOps& ops)
+{
+  SymmetryTable table;
+  const int32_t numSymOps = ops.getNumSymOps();
+  for(int32_t i = 0; i < numSymOps; i++)
+  {
+    QuatD symOp = ops.getQuatSymOp(i);
+    table.w.push_back(symOp.w());
+    table.x.push_back(symOp.x());
+    table.y.push_back(symOp.y());
+    table.z.push_back(symOp.z());
+  }
+  return table;
+}
+
+/**
+ * @brief FindMisorientationProduct Returns the product q1 * q2^-1 that LaueOps reduces against the symmetry operators
+ * @param q1 First quaternion, stored as (x, y, z, w)
+ * @param q2 Second quaternion, stored as (x, y, z, w)
+ * @return Misorientation product
+ */
+inline QuatD FindMisorientationProduct(const float* q1, const float* q2)
+{
+  return QuatD(q1[0], q1[1], q1[2], q1[3]) * QuatD(q2[0], q2[1], q2[2], q2[3]).conjugate();
+}
+
+/**
+ * @brief FindMaxSymmetricCosine Returns the largest |w| over the symmetric equivalents of one misorientation product
+ * @param table
+ * @param product
+ * @return Cosine of half the misorientation angle
+ */
+inline double FindMaxSymmetricCosine(const SymmetryTable& table, const QuatD& product)
+{
+  double best = 0.0;
+  for(size_t s = 0; s < table.w.size(); s++)
+  {
+    best = std::max(best, std::fabs(table.w[s] * product.w() - table.x[s] * product.x() - table.y[s] * product.y() - table.z[s] * product.z()));
+  }
+  return best;
+}
+
+/**
+ * @brief FindMaxSymmetricCosines Finds the largest |w| over the symmetric equivalents of a batch of misorientation
+ * products, applying one symmetry operator to the whole batch at a time.  The results are maxima with the values
+ * already in best, so best should start out as zeros.
+ * @param table
+ * @param w W components of the products
+ * @param x X components of the products
+ * @param y Y components of the products
+ * @param z Z components of the products
+ * @param count Number of products
+ * @param best Cosines of half the misorientation angles, count values updated in place
+ */
+inline void FindMaxSymmetricCosines(const SymmetryTable& table, const double* w, const double* x, const double* y, const double* z, size_t count, double* best)
+{
+  for(size_t s = 0; s < table.w.size(); s++)
+  {
+    const double sw = table.w[s];
+    const double sx = table.x[s];
+    const double sy = table.y[s];
+    const double sz = table.z[s];
+    for(size_t i = 0; i < count; i++)
+    {
+      best[i] = std::max(best[i], std::fabs(sw * w[i] - sx * x[i] - sy * y[i] - sz * z[i]));
+    }
+  }
+}
+
+/**
+ * @brief FindAngle Returns the misorientation angle, in radians, for the largest |w| over the symmetric equivalents
+ * @param maxCosine
+ * @return Misorientation angle
+ */
+inline double FindAngle(double maxCosine)
+{
+  return 2.0 * std::acos(std::min(maxCosine, 1.0));
+}
+} // namespace SymmetricMisorientation
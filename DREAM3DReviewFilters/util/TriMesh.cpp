@@ -1,9 +1,17 @@
 #include "TriMesh.h"
 
+#include <algorithm>
+
+namespace
+{
+constexpr int64_t k_Tombstone = -1;
+constexpr int32_t k_DefaultLinkCapacity = 8;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TriMesh::TriMesh(VertexCoordList vertices)
+TriMesh::TriMesh(const VertexCoordList& vertices)
 {
   initialize(vertices);
 }
@@ -16,14 +24,81 @@ TriMesh::~TriMesh() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::initialize(VertexCoordList& vertices)
+void TriMesh::initialize(const VertexCoordList& vertices)
 {
   m_Triangles = TriList();
-  m_Vertices = VertexList();
-  for(auto&& vert : vertices)
+  m_VertX.clear();
+  m_VertY.clear();
+  m_VertZ.clear();
+  m_LinkSegments.clear();
+  m_Links.clear();
+  m_NumTombstones = 0;
+
+  m_VertX.reserve(vertices.size());
+  m_VertY.reserve(vertices.size());
+  m_VertZ.reserve(vertices.size());
+  m_LinkSegments.reserve(vertices.size());
+  m_Links.reserve(vertices.size() * k_DefaultLinkCapacity);
+
+  for(const auto& vert : vertices)
+  {
+    addVertex(vert[0], vert[1], vert[2]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriMesh::addVertex(float x, float y, float z)
+{
+  m_VertX.push_back(x);
+  m_VertY.push_back(y);
+  m_VertZ.push_back(z);
+  appendLinkSegment(k_DefaultLinkCapacity);
+  return static_cast<int64_t>(m_VertX.size() - 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriMesh::appendLinkSegment(int32_t capacity)
+{
+  LinkSegment segment = {static_cast<int64_t>(m_Links.size()), 0, capacity};
+  m_LinkSegments.push_back(segment);
+  m_Links.resize(m_Links.size() + capacity, k_Tombstone);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriMesh::relocateLinkSegment(int64_t vertex, int32_t capacity)
+{
+  LinkSegment& segment = m_LinkSegments[vertex];
+  int64_t newStart = static_cast<int64_t>(m_Links.size());
+  m_Links.resize(m_Links.size() + capacity, k_Tombstone);
+  std::copy_n(m_Links.begin() + segment.start, segment.size, m_Links.begin() + newStart);
+  std::fill_n(m_Links.begin() + segment.start, segment.capacity, k_Tombstone);
+  m_NumTombstones += segment.capacity;
+  segment.start = newStart;
+  segment.capacity = capacity;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TriMesh::compactLinks()
+{
+  std::vector<int64_t> links;
+  links.reserve(m_Links.size() - m_NumTombstones);
+  for(auto&& segment : m_LinkSegments)
   {
-    m_Vertices.emplace_back(TriMeshPrimitives::Vertex(vert));
+    int64_t newStart = static_cast<int64_t>(links.size());
+    links.insert(links.end(), m_Links.begin() + segment.start, m_Links.begin() + segment.start + segment.size);
+    links.resize(links.size() + (segment.capacity - segment.size), k_Tombstone);
+    segment.start = newStart;
   }
+  m_Links.swap(links);
+  m_NumTombstones = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -31,12 +106,24 @@ void TriMesh::initialize(VertexCoordList& vertices)
 // -----------------------------------------------------------------------------
 void TriMesh::buildTriangleLinks()
 {
-  for(auto&& vert : m_Vertices)
+  std::vector<int32_t> counts(m_LinkSegments.size(), 0);
+  for(const auto& tri : m_Triangles)
   {
-    vert.triangleLinks.clear();
+    counts[tri.vert0]++;
+    counts[tri.vert1]++;
+    counts[tri.vert2]++;
   }
 
-  for(auto t = 0; t < m_Triangles.size(); t++)
+  int64_t offset = 0;
+  for(size_t v = 0; v < m_LinkSegments.size(); v++)
+  {
+    m_LinkSegments[v] = {offset, 0, counts[v]};
+    offset += counts[v];
+  }
+  m_Links.assign(offset, k_Tombstone);
+  m_NumTombstones = 0;
+
+  for(size_t t = 0; t < m_Triangles.size(); t++)
   {
     addLinkToTriangle(m_Triangles[t].vert0, t);
     addLinkToTriangle(m_Triangles[t].vert1, t);
@@ -49,7 +136,18 @@ void TriMesh::buildTriangleLinks()
 // -----------------------------------------------------------------------------
 void TriMesh::addLinkToTriangle(int64_t vertex, int64_t triangle)
 {
-  m_Vertices[vertex].triangleLinks.push_back(triangle);
+  if(m_LinkSegments[vertex].size == m_LinkSegments[vertex].capacity)
+  {
+    relocateLinkSegment(vertex, std::max(2 * m_LinkSegments[vertex].capacity, k_DefaultLinkCapacity));
+    if(m_NumTombstones > m_Links.size() / 2)
+    {
+      compactLinks();
+    }
+  }
+
+  LinkSegment& segment = m_LinkSegments[vertex];
+  m_Links[segment.start + segment.size] = triangle;
+  segment.size++;
 }
 
 // -----------------------------------------------------------------------------
@@ -57,45 +155,62 @@ void TriMesh::addLinkToTriangle(int64_t vertex, int64_t triangle)
 // -----------------------------------------------------------------------------
 void TriMesh::removeLinkFromTriangle(int64_t vertex, int64_t triangle)
 {
-  m_Vertices[vertex].triangleLinks.remove(triangle);
+  LinkSegment& segment = m_LinkSegments[vertex];
+  auto first = m_Links.begin() + segment.start;
+  auto last = first + segment.size;
+  auto newLast = std::remove(first, last, triangle);
+  std::fill(newLast, last, k_Tombstone);
+  segment.size = static_cast<int32_t>(newLast - first);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<int64_t> TriMesh::getTrianglesToVertex(int64_t vertex)
+TriMesh::LinkSpan TriMesh::getTriangleLinks(int64_t vertex) const
 {
-  std::vector<int64_t> triangles;
-  triangles.reserve(m_Vertices[vertex].triangleLinks.size());
-  std::copy(std::begin(m_Vertices[vertex].triangleLinks), std::end(m_Vertices[vertex].triangleLinks), std::back_inserter(triangles));
-
-  return triangles;
+  const LinkSegment& segment = m_LinkSegments[vertex];
+  return LinkSpan(m_Links.data() + segment.start, static_cast<size_t>(segment.size));
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle)
+std::vector<int64_t> TriMesh::getTrianglesToVertex(int64_t vertex) const
 {
-  std::list<int64_t> vert0tris = m_Vertices[vertex0].triangleLinks;
-  std::list<int64_t> vert1tris = m_Vertices[vertex1].triangleLinks;
-  vert0tris.sort();
-  vert1tris.sort();
+  LinkSpan links = getTriangleLinks(vertex);
+  return std::vector<int64_t>(links.begin(), links.end());
+}
 
-  std::list<int64_t> sharedTriangles;
-  std::set_intersection(vert0tris.begin(), vert0tris.end(), vert1tris.begin(), vert1tris.end(), std::back_inserter(sharedTriangles));
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriMesh::getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle) const
+{
+  LinkSpan vert0tris = getTriangleLinks(vertex0);
+  LinkSpan vert1tris = getTriangleLinks(vertex1);
 
-  if(sharedTriangles.size() > 2)
+  // Link segments hold a handful of entries, so a direct scan beats sorting copies
+  size_t numShared = 0;
+  int64_t neighbor = -1;
+  for(const auto& tri : vert0tris)
   {
-    return -1;
-  }                                 // non-manifold
-  sharedTriangles.remove(triangle); // remove the source triangle
-  if(sharedTriangles.empty())
+    if(std::find(vert1tris.begin(), vert1tris.end(), tri) == vert1tris.end())
+    {
+      continue;
+    }
+    numShared++;
+    if(tri != triangle && (neighbor < 0 || tri < neighbor))
+    {
+      neighbor = tri;
+    }
+  }
+
+  if(numShared > 2)
   {
     return -1;
-  } // boundary
+  } // non-manifold
 
-  return (*sharedTriangles.begin());
+  return neighbor; // -1 if boundary
 }
 
 // -----------------------------------------------------------------------------
@@ -123,15 +238,36 @@ int64_t TriMesh::addTriangle(int64_t vertex0, int64_t vertex1, int64_t vertex2)
 }
 
 // -----------------------------------------------------------------------------
-//
+// Removes the given vertices and their links; Triangle vertex indices are not remapped
 // -----------------------------------------------------------------------------
 void TriMesh::removeVertices(std::vector<int64_t> vertices)
 {
+  std::vector<bool> removed(m_VertX.size(), false);
   for(auto&& index : vertices)
   {
-    VertexList::iterator iter = m_Vertices.begin() + index;
-    m_Vertices.erase(iter);
+    removed[index] = true;
+  }
+
+  size_t newIndex = 0;
+  for(size_t v = 0; v < m_VertX.size(); v++)
+  {
+    if(removed[v])
+    {
+      m_NumTombstones += m_LinkSegments[v].capacity;
+      continue;
+    }
+    m_VertX[newIndex] = m_VertX[v];
+    m_VertY[newIndex] = m_VertY[v];
+    m_VertZ[newIndex] = m_VertZ[v];
+    m_LinkSegments[newIndex] = m_LinkSegments[v];
+    newIndex++;
   }
+
+  m_VertX.resize(newIndex);
+  m_VertY.resize(newIndex);
+  m_VertZ.resize(newIndex);
+  m_LinkSegments.resize(newIndex);
+  compactLinks();
 }
 
 // -----------------------------------------------------------------------------
@@ -139,17 +275,30 @@ void TriMesh::removeVertices(std::vector<int64_t> vertices)
 // -----------------------------------------------------------------------------
 void TriMesh::removeTriangles(std::vector<int64_t> triangles)
 {
+  std::vector<bool> removed(m_Triangles.size(), false);
   for(auto&& index : triangles)
   {
-    TriList::iterator iter = m_Triangles.begin() + index;
-    m_Triangles.erase(iter);
+    removed[index] = true;
+  }
+
+  size_t newIndex = 0;
+  for(size_t t = 0; t < m_Triangles.size(); t++)
+  {
+    if(!removed[t])
+    {
+      m_Triangles[newIndex] = m_Triangles[t];
+      newIndex++;
+    }
   }
+  m_Triangles.erase(m_Triangles.begin() + newIndex, m_Triangles.end());
+
+  buildTriangleLinks();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::getTriangleVertices(int64_t triangle, int64_t vertices[3])
+void TriMesh::getTriangleVertices(int64_t triangle, int64_t vertices[3]) const
 {
   vertices[0] = m_Triangles[triangle].vert0;
   vertices[1] = m_Triangles[triangle].vert1;
@@ -159,27 +308,27 @@ void TriMesh::getTriangleVertices(int64_t triangle, int64_t vertices[3])
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::getVertexCoordinates(int64_t vertex, float coordinates[3])
+void TriMesh::getVertexCoordinates(int64_t vertex, float coordinates[3]) const
 {
-  coordinates[0] = m_Vertices[vertex].vert[0];
-  coordinates[1] = m_Vertices[vertex].vert[1];
-  coordinates[2] = m_Vertices[vertex].vert[2];
+  coordinates[0] = m_VertX[vertex];
+  coordinates[1] = m_VertY[vertex];
+  coordinates[2] = m_VertZ[vertex];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::getVertexCoordinates(int64_t vertex, double coordinates[3])
+void TriMesh::getVertexCoordinates(int64_t vertex, double coordinates[3]) const
 {
-  coordinates[0] = static_cast<double>(m_Vertices[vertex].vert[0]);
-  coordinates[1] = static_cast<double>(m_Vertices[vertex].vert[1]);
-  coordinates[2] = static_cast<double>(m_Vertices[vertex].vert[2]);
+  coordinates[0] = static_cast<double>(m_VertX[vertex]);
+  coordinates[1] = static_cast<double>(m_VertY[vertex]);
+  coordinates[2] = static_cast<double>(m_VertZ[vertex]);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle)
+int64_t TriMesh::getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle) const
 {
   TriMeshPrimitives::Edge edge(vertex0, vertex1);
   return (m_Triangles[triangle].getOppositeVertex(edge));
@@ -188,7 +337,15 @@ int64_t TriMesh::getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t tri
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::getNumberOfTriangles()
+int64_t TriMesh::getNumberOfVertices() const
+{
+  return (static_cast<int64_t>(m_VertX.size()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t TriMesh::getNumberOfTriangles() const
 {
   return (static_cast<int64_t>(m_Triangles.size()));
 }
@@ -196,21 +353,21 @@ int64_t TriMesh::getNumberOfTriangles()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TriangleGeom::Pointer TriMesh::convertToTriangleGeometry()
+TriangleGeom::Pointer TriMesh::convertToTriangleGeometry() const
 {
-  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(m_Vertices.size());
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(m_VertX.size());
   TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(m_Triangles.size(), vertices, SIMPL::Geometry::TriangleGeometry);
   float* verts = triangles->getVertexPointer(0);
   size_t* tris = triangles->getTriPointer(0);
 
-  for(auto i = 0; i < m_Vertices.size(); i++)
+  for(size_t i = 0; i < m_VertX.size(); i++)
   {
-    verts[3 * i + 0] = m_Vertices[i].vert[0];
-    verts[3 * i + 1] = m_Vertices[i].vert[1];
-    verts[3 * i + 2] = m_Vertices[i].vert[2];
+    verts[3 * i + 0] = m_VertX[i];
+    verts[3 * i + 1] = m_VertY[i];
+    verts[3 * i + 2] = m_VertZ[i];
   }
 
-  for(auto i = 0; i < m_Triangles.size(); i++)
+  for(size_t i = 0; i < m_Triangles.size(); i++)
   {
     tris[3 * i + 0] = m_Triangles[i].vert0;
     tris[3 * i + 1] = m_Triangles[i].vert1;
@@ -5,7 +5,12 @@
 #include "DREAM3DReviewFilters/util/TriMeshPrimitives.hpp"
 
 /**
- * @brief The TriMesh class
+ * @brief The TriMesh class is a mutable triangle mesh used by the triangulation utilities.
+ *
+ * Vertex coordinates are stored as a structure of arrays.  The vertex to triangle links
+ * are stored in a single packed buffer in which every vertex owns a segment (CSR style).
+ * When a segment overflows it is moved to the end of the buffer and the old slots are
+ * tombstoned; the buffer is compacted once the tombstones outnumber the live links.
  */
 class TriMesh
 {
@@ -20,34 +25,52 @@ public:
   virtual ~TriMesh();
 
   typedef std::vector<std::vector<float>> VertexCoordList;
-  typedef std::vector<TriMeshPrimitives::Vertex> VertexList;
   typedef std::vector<TriMeshPrimitives::Triangle> TriList;
+  typedef TriMeshPrimitives::ConstSpan<int64_t> LinkSpan;
 
-  static Pointer New(VertexCoordList vertices)
+  static Pointer New(const VertexCoordList& vertices)
   {
     Pointer sharedPtr(new TriMesh(vertices));
     return sharedPtr;
   }
 
-  VertexList getVertices()
+  const std::vector<float>& getXCoordinates() const
   {
-    return m_Vertices;
+    return m_VertX;
   }
 
-  TriList getTriangles()
+  const std::vector<float>& getYCoordinates() const
+  {
+    return m_VertY;
+  }
+
+  const std::vector<float>& getZCoordinates() const
+  {
+    return m_VertZ;
+  }
+
+  const TriList& getTriangles() const
   {
     return m_Triangles;
   }
 
+  int64_t addVertex(float x, float y, float z);
+
   void buildTriangleLinks();
 
   void addLinkToTriangle(int64_t vertex, int64_t triangle);
 
   void removeLinkFromTriangle(int64_t vertex, int64_t triangle);
 
-  std::vector<int64_t> getTrianglesToVertex(int64_t vertex);
+  /**
+   * @brief Returns a view of the Triangles linked to the given vertex.  The view is
+   * invalidated by any subsequent change to the links.
+   */
+  LinkSpan getTriangleLinks(int64_t vertex) const;
 
-  int64_t getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle);
+  std::vector<int64_t> getTrianglesToVertex(int64_t vertex) const;
+
+  int64_t getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle) const;
 
   void replaceTriangleVertices(int64_t vertex0, int64_t vertex1, int64_t vertex2, int64_t triangle);
 
@@ -57,26 +80,47 @@ public:
 
   void removeTriangles(std::vector<int64_t> triangles);
 
-  void getTriangleVertices(int64_t triangle, int64_t vertices[3]);
+  void getTriangleVertices(int64_t triangle, int64_t vertices[3]) const;
+
+  void getVertexCoordinates(int64_t vertex, float coordinates[3]) const;
 
-  void getVertexCoordinates(int64_t vertex, float coordinates[3]);
+  void getVertexCoordinates(int64_t vertex, double coordinates[3]) const;
 
-  void getVertexCoordinates(int64_t vertex, double coordinates[3]);
+  int64_t getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle) const;
 
-  int64_t getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle);
+  int64_t getNumberOfVertices() const;
 
-  int64_t getNumberOfTriangles();
+  int64_t getNumberOfTriangles() const;
 
-  TriangleGeom::Pointer convertToTriangleGeometry();
+  TriangleGeom::Pointer convertToTriangleGeometry() const;
 
 protected:
-  explicit TriMesh(VertexCoordList vertices);
+  explicit TriMesh(const VertexCoordList& vertices);
 
 private:
-  VertexList m_Vertices;
+  struct LinkSegment
+  {
+    int64_t start;
+    int32_t size;
+    int32_t capacity;
+  };
+
+  std::vector<float> m_VertX;
+  std::vector<float> m_VertY;
+  std::vector<float> m_VertZ;
   TriList m_Triangles;
 
-  void initialize(VertexCoordList& vertices);
+  std::vector<LinkSegment> m_LinkSegments;
+  std::vector<int64_t> m_Links;
+  size_t m_NumTombstones = 0;
+
+  void initialize(const VertexCoordList& vertices);
+
+  void appendLinkSegment(int32_t capacity);
+
+  void relocateLinkSegment(int64_t vertex, int32_t capacity);
+
+  void compactLinks();
 
   TriMesh(const TriMesh&) = delete;        // Copy Constructor Not Implemented
   void operator=(const TriMesh&) = delete; // Operator '=' Not Implemented
@@ -1,28 +1,61 @@
 #pragma once
 
-#include <list>
+#include <cstddef>
 #include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 
 namespace TriMeshPrimitives
 {
-class Vertex
+/**
+ * @brief The ConstSpan class is a non-owning, read-only view of a contiguous run of values
+ */
+template <typename T>
+class ConstSpan
 {
 public:
-  Vertex(const std::vector<float>& vert)
-  : vert(vert)
+  ConstSpan() = default;
+
+  ConstSpan(const T* data, size_t size)
+  : m_Data(data)
+  , m_Size(size)
   {
   }
 
-  std::vector<float> vert;
-  std::list<int64_t> triangleLinks;
-};
+  const T* begin() const
+  {
+    return m_Data;
+  }
 
-inline bool operator==(const Vertex& vert0, const Vertex& vert1)
-{
-  return (vert0.vert == vert1.vert);
-}
+  const T* end() const
+  {
+    return m_Data + m_Size;
+  }
+
+  const T* data() const
+  {
+    return m_Data;
+  }
+
+  size_t size() const
+  {
+    return m_Size;
+  }
+
+  bool empty() const
+  {
+    return m_Size == 0;
+  }
+
+  const T& operator[](size_t index) const
+  {
+    return m_Data[index];
+  }
+
+private:
+  const T* m_Data = nullptr;
+  size_t m_Size = 0;
+};
 
 class Edge
 {
@@ -62,7 +95,7 @@ public:
   Edge edge1;
   Edge edge2;
 
-  int64_t getOppositeVertex(Edge& edge)
+  int64_t getOppositeVertex(const Edge& edge) const
   {
     if(edge == edge0)
     {
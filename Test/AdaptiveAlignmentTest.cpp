@@ -0,0 +1,468 @@
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Observer.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/AdaptiveAlignmentFeature.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/AdaptiveAlignmentMisorientation.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/AdaptiveAlignmentMutualInformation.h"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+class AdaptiveAlignmentTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellAttributeMatrixName = {"CellData"};
+  const QString k_EnsembleAttributeMatrixName = {"CellEnsembleData"};
+  const QString k_QuatsName = {"Quats"};
+  const QString k_PhasesName = {"Phases"};
+  const QString k_GoodVoxelsName = {"Mask"};
+  const QString k_CrystalStructuresName = {"CrystalStructures"};
+  const std::array<size_t, 3> k_Dims = {48, 40, 6};
+  const int64_t k_Margin = 12;
+  const QString k_ShiftsFile = UnitTest::TestTempDir + "/AdaptiveAlignmentTest_Shifts.txt";
+
+  enum ShiftSearch
+  {
+    LocalSearch = 0,
+    PhaseCorrelationAndLocalSearch = 1,
+    PhaseCorrelation = 2
+  };
+
+  // Offsets in x and y of the grain map under each section of the last stack created
+  std::vector<std::array<int64_t, 2>> m_SectionOffsets;
+
+  /**
+   * @brief Counts the times the Mutual Information filter computes the misorientations between neighboring Cells
+   */
+  class EdgeAngleObserver : public Observer
+  {
+  public:
+    void processPipelineMessage(const AbstractMessage::Pointer& pm) override
+    {
+      if(pm->generateMessageString().contains("Finding Misorientations on Sections"))
+      {
+        m_Count++;
+      }
+    }
+
+    int32_t getCount() const
+    {
+      return m_Count;
+    }
+
+  private:
+    int32_t m_Count = 0;
+  };
+
+public:
+  AdaptiveAlignmentTest() = default;
+  virtual ~AdaptiveAlignmentTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(k_ShiftsFile);
+#endif
+  }
+
+  /**
+   * @brief Creates a stack of sections cut from one grain map, each section offset from the one above it by a few
+   * Cells, so that the true shifts are known to be within reach of the local search from zero
+   */
+  DataContainerArray::Pointer createDataStructure()
+  {
+    const int64_t canvasDimX = static_cast<int64_t>(k_Dims[0]) + 2 * k_Margin;
+    const int64_t canvasDimY = static_cast<int64_t>(k_Dims[1]) + 2 * k_Margin;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::uniform_int_distribution<int64_t> step(-2, 2);
+
+    const size_t numGrains = static_cast<size_t>(canvasDimX * canvasDimY / 60);
+    std::vector<std::array<float, 2>> seeds(numGrains);
+    std::vector<std::array<float, 4>> orientations(numGrains);
+    for(size_t g = 0; g < numGrains; g++)
+    {
+      seeds[g] = {canvasDimX * distribution(generator), canvasDimY * distribution(generator)};
+      std::array<float, 4> q = {normal(generator), normal(generator), normal(generator), normal(generator)};
+      const float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+      for(auto&& value : q)
+      {
+        value /= norm;
+      }
+      orientations[g] = q;
+    }
+    std::vector<size_t> canvas(static_cast<size_t>(canvasDimX * canvasDimY), 0);
+    for(int64_t y = 0; y < canvasDimY; y++)
+    {
+      for(int64_t x = 0; x < canvasDimX; x++)
+      {
+        float nearest = std::numeric_limits<float>::max();
+        for(size_t g = 0; g < numGrains; g++)
+        {
+          const float distance = (x - seeds[g][0]) * (x - seeds[g][0]) + (y - seeds[g][1]) * (y - seeds[g][1]);
+          if(distance < nearest)
+          {
+            nearest = distance;
+            canvas[y * canvasDimX + x] = g;
+          }
+        }
+      }
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(SizeVec3Type(k_Dims[0], k_Dims[1], k_Dims[2]));
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    dc->setGeometry(image);
+
+    const std::vector<size_t> tupleDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    const size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, std::vector<size_t>(1, 4), k_QuatsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, k_PhasesName, true);
+    DataArray<bool>::Pointer goodVoxels = DataArray<bool>::CreateArray(totalPoints, k_GoodVoxelsName, true);
+    cellAttrMat->addOrReplaceAttributeArray(quats);
+    cellAttrMat->addOrReplaceAttributeArray(phases);
+    cellAttrMat->addOrReplaceAttributeArray(goodVoxels);
+
+    int64_t offsetX = 0;
+    int64_t offsetY = 0;
+    m_SectionOffsets.clear();
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      m_SectionOffsets.push_back({offsetX, offsetY});
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          const size_t index = (z * k_Dims[1] + y) * k_Dims[0] + x;
+          const size_t grain = canvas[(static_cast<int64_t>(y) + k_Margin + offsetY) * canvasDimX + static_cast<int64_t>(x) + k_Margin + offsetX];
+          for(size_t c = 0; c < 4; c++)
+          {
+            quats->setComponent(index, c, orientations[grain][c]);
+          }
+          phases->setValue(index, 1);
+          goodVoxels->setValue(index, grain % 3 != 0);
+        }
+      }
+      offsetX += step(generator);
+      offsetY += step(generator);
+    }
+
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New({2}, k_EnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAttrMat);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, k_CrystalStructuresName, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAttrMat->addOrReplaceAttributeArray(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename ArrayType>
+  typename ArrayType::Pointer getCellArray(const DataContainerArray::Pointer& dca, const QString& name)
+  {
+    return dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName)->getAttributeArrayAs<ArrayType>(name);
+  }
+
+  /**
+   * @brief Returns true if the two arrays hold the same values
+   */
+  template <typename T>
+  bool isEqual(const DataArray<T>& a, const DataArray<T>& b)
+  {
+    if(a.getSize() != b.getSize())
+    {
+      return false;
+    }
+    for(size_t i = 0; i < a.getSize(); i++)
+    {
+      if(a[i] != b[i])
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads the shift file written by a filter and requires that the shift found between each pair of sections
+   * is the difference of the offsets the two sections were cut at, and that the running totals add those shifts up
+   */
+  int checkShiftsFile()
+  {
+    std::ifstream inFile(k_ShiftsFile.toStdString());
+    DREAM3D_REQUIRE(inFile.is_open())
+    int64_t totalX = 0;
+    int64_t totalY = 0;
+    for(int64_t expectedSlice = static_cast<int64_t>(k_Dims[2]) - 2; expectedSlice >= 0; expectedSlice--)
+    {
+      int64_t slice = -1;
+      int64_t nextSlice = -1;
+      int64_t shiftX = 0;
+      int64_t shiftY = 0;
+      int64_t cumulativeX = 0;
+      int64_t cumulativeY = 0;
+      inFile >> slice >> nextSlice >> shiftX >> shiftY >> cumulativeX >> cumulativeY;
+      DREAM3D_REQUIRE(!inFile.fail())
+      DREAM3D_REQUIRE_EQUAL(slice, expectedSlice)
+      DREAM3D_REQUIRE_EQUAL(nextSlice, expectedSlice + 1)
+      DREAM3D_REQUIRE_EQUAL(shiftX, m_SectionOffsets[nextSlice][0] - m_SectionOffsets[slice][0])
+      DREAM3D_REQUIRE_EQUAL(shiftY, m_SectionOffsets[nextSlice][1] - m_SectionOffsets[slice][1])
+      totalX += shiftX;
+      totalY += shiftY;
+      DREAM3D_REQUIRE_EQUAL(cumulativeX, totalX)
+      DREAM3D_REQUIRE_EQUAL(cumulativeY, totalY)
+    }
+    int64_t extra = 0;
+    inFile >> extra;
+    DREAM3D_REQUIRE(inFile.fail())
+
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief Runs one filter with every shift search on copies of the same stack and requires that each finds the
+   * offsets the sections were cut at, that they align the sections the same way, and that the stack was actually
+   * moved
+   */
+  template <typename FilterType>
+  int checkShiftSearches(const std::function<void(FilterType*)>& setup)
+  {
+    std::array<DataContainerArray::Pointer, 3> results;
+    for(int32_t shiftSearch : {LocalSearch, PhaseCorrelationAndLocalSearch, PhaseCorrelation})
+    {
+      QFile::remove(k_ShiftsFile);
+      typename FilterType::Pointer filter = FilterType::New();
+      DataContainerArray::Pointer dca = createDataStructure();
+      filter->setDataContainerArray(dca);
+      setup(filter.get());
+      filter->setGlobalCorrection(0);
+      filter->setShiftSearch(shiftSearch);
+      filter->setWriteAlignmentShifts(true);
+      filter->setAlignmentShiftFileName(k_ShiftsFile);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+      DREAM3D_REQUIRE_EQUAL(checkShiftsFile(), EXIT_SUCCESS)
+      results[shiftSearch] = dca;
+    }
+
+    FloatArrayType::Pointer localQuats = getCellArray<FloatArrayType>(results[LocalSearch], k_QuatsName);
+    DataArray<bool>::Pointer localGoodVoxels = getCellArray<DataArray<bool>>(results[LocalSearch], k_GoodVoxelsName);
+    DREAM3D_REQUIRE_VALID_POINTER(localQuats.get())
+    DREAM3D_REQUIRE_VALID_POINTER(localGoodVoxels.get())
+    for(int32_t shiftSearch : {PhaseCorrelationAndLocalSearch, PhaseCorrelation})
+    {
+      FloatArrayType::Pointer correlatedQuats = getCellArray<FloatArrayType>(results[shiftSearch], k_QuatsName);
+      DataArray<bool>::Pointer correlatedGoodVoxels = getCellArray<DataArray<bool>>(results[shiftSearch], k_GoodVoxelsName);
+      DREAM3D_REQUIRE_VALID_POINTER(correlatedQuats.get())
+      DREAM3D_REQUIRE_VALID_POINTER(correlatedGoodVoxels.get())
+      DREAM3D_REQUIRE(isEqual(*localQuats, *correlatedQuats))
+      DREAM3D_REQUIRE(isEqual(*localGoodVoxels, *correlatedGoodVoxels))
+    }
+
+    FloatArrayType::Pointer originalQuats = getCellArray<FloatArrayType>(createDataStructure(), k_QuatsName);
+    DREAM3D_REQUIRE(!isEqual(*localQuats, *originalQuats))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestFeature()
+  {
+    return checkShiftSearches<AdaptiveAlignmentFeature>([this](AdaptiveAlignmentFeature* filter) {
+      filter->setGoodVoxelsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_GoodVoxelsName));
+    });
+  }
+
+  // -----------------------------------------------------------------------------
+  void setupMisorientation(AdaptiveAlignmentMisorientation* filter, int32_t coarseToFineLevels)
+  {
+    filter->setMisorientationTolerance(5.0f);
+    filter->setCoarseToFineLevels(coarseToFineLevels);
+    filter->setUseGoodVoxels(false);
+    filter->setQuatsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_QuatsName));
+    filter->setCellPhasesArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_PhasesName));
+    filter->setGoodVoxelsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_GoodVoxelsName));
+    filter->setCrystalStructuresArrayPath(DataArrayPath(k_DataContainerName, k_EnsembleAttributeMatrixName, k_CrystalStructuresName));
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMisorientation()
+  {
+    return checkShiftSearches<AdaptiveAlignmentMisorientation>([this](AdaptiveAlignmentMisorientation* filter) { setupMisorientation(filter, 0); });
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMisorientationCoarseToFine()
+  {
+    // Every level must lead the local search to the alignment found without coarse levels.  With four levels the
+    // coarsest samples are 64 Cells apart, so some shifts leave no sampled Cell pair on the overlap of the sections
+    std::vector<DataContainerArray::Pointer> results;
+    for(int32_t coarseToFineLevels : {0, 1, 2, 4})
+    {
+      AdaptiveAlignmentMisorientation::Pointer filter = AdaptiveAlignmentMisorientation::New();
+      DataContainerArray::Pointer dca = createDataStructure();
+      filter->setDataContainerArray(dca);
+      setupMisorientation(filter.get(), coarseToFineLevels);
+      filter->setGlobalCorrection(0);
+      filter->setShiftSearch(LocalSearch);
+      filter->execute();
+      DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+      results.push_back(dca);
+    }
+
+    FloatArrayType::Pointer fineQuats = getCellArray<FloatArrayType>(results[0], k_QuatsName);
+    DataArray<bool>::Pointer fineGoodVoxels = getCellArray<DataArray<bool>>(results[0], k_GoodVoxelsName);
+    DREAM3D_REQUIRE_VALID_POINTER(fineQuats.get())
+    DREAM3D_REQUIRE_VALID_POINTER(fineGoodVoxels.get())
+    DREAM3D_REQUIRE(!isEqual(*fineQuats, *getCellArray<FloatArrayType>(createDataStructure(), k_QuatsName)))
+    for(size_t i = 1; i < results.size(); i++)
+    {
+      FloatArrayType::Pointer coarseQuats = getCellArray<FloatArrayType>(results[i], k_QuatsName);
+      DataArray<bool>::Pointer coarseGoodVoxels = getCellArray<DataArray<bool>>(results[i], k_GoodVoxelsName);
+      DREAM3D_REQUIRE_VALID_POINTER(coarseQuats.get())
+      DREAM3D_REQUIRE_VALID_POINTER(coarseGoodVoxels.get())
+      DREAM3D_REQUIRE(isEqual(*fineQuats, *coarseQuats))
+      DREAM3D_REQUIRE(isEqual(*fineGoodVoxels, *coarseGoodVoxels))
+    }
+
+    for(int32_t coarseToFineLevels : {-1, 9})
+    {
+      AdaptiveAlignmentMisorientation::Pointer filter = AdaptiveAlignmentMisorientation::New();
+      filter->setDataContainerArray(createDataStructure());
+      setupMisorientation(filter.get(), coarseToFineLevels);
+      filter->setGlobalCorrection(0);
+      filter->preflight();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -3020)
+      filter->execute();
+      DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -3020)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  void setupMutualInformation(AdaptiveAlignmentMutualInformation* filter, float tolerance)
+  {
+    filter->setMisorientationTolerance(tolerance);
+    filter->setUseGoodVoxels(true);
+    filter->setQuatsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_QuatsName));
+    filter->setCellPhasesArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_PhasesName));
+    filter->setGoodVoxelsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_GoodVoxelsName));
+    filter->setCrystalStructuresArrayPath(DataArrayPath(k_DataContainerName, k_EnsembleAttributeMatrixName, k_CrystalStructuresName));
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMutualInformation()
+  {
+    return checkShiftSearches<AdaptiveAlignmentMutualInformation>([this](AdaptiveAlignmentMutualInformation* filter) { setupMutualInformation(filter, 5.0f); });
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMutualInformationToleranceRerun()
+  {
+    // Re-running with only the tolerance changed must reuse the kept misorientations and align the stack as a
+    // filter that has never run does
+    EdgeAngleObserver rerunObserver;
+    AdaptiveAlignmentMutualInformation::Pointer rerunFilter = AdaptiveAlignmentMutualInformation::New();
+    rerunFilter->connect(rerunFilter.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), &rerunObserver, SLOT(processPipelineMessage(const AbstractMessage::Pointer&)));
+    DataContainerArray::Pointer rerun;
+    for(float tolerance : {5.0f, 40.0f})
+    {
+      rerun = createDataStructure();
+      rerunFilter->setDataContainerArray(rerun);
+      setupMutualInformation(rerunFilter.get(), tolerance);
+      rerunFilter->setKeepMisorientations(true);
+      rerunFilter->execute();
+      DREAM3D_REQUIRED(rerunFilter->getErrorCode(), >=, 0)
+    }
+    DREAM3D_REQUIRE_EQUAL(rerunObserver.getCount(), 1)
+
+    EdgeAngleObserver coldObserver;
+    AdaptiveAlignmentMutualInformation::Pointer coldFilter = AdaptiveAlignmentMutualInformation::New();
+    coldFilter->connect(coldFilter.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), &coldObserver, SLOT(processPipelineMessage(const AbstractMessage::Pointer&)));
+    DataContainerArray::Pointer cold = createDataStructure();
+    coldFilter->setDataContainerArray(cold);
+    setupMutualInformation(coldFilter.get(), 40.0f);
+    coldFilter->execute();
+    DREAM3D_REQUIRED(coldFilter->getErrorCode(), >=, 0)
+    DREAM3D_REQUIRE_EQUAL(coldObserver.getCount(), 1)
+
+    DREAM3D_REQUIRE(isEqual(*getCellArray<FloatArrayType>(rerun, k_QuatsName), *getCellArray<FloatArrayType>(cold, k_QuatsName)))
+    DREAM3D_REQUIRE(isEqual(*getCellArray<DataArray<bool>>(rerun, k_GoodVoxelsName), *getCellArray<DataArray<bool>>(cold, k_GoodVoxelsName)))
+
+    // Different orientations must not be served from the cache
+    DataContainerArray::Pointer changed = createDataStructure();
+    getCellArray<FloatArrayType>(changed, k_QuatsName)->setComponent(0, 0, 0.5f);
+    rerunFilter->setDataContainerArray(changed);
+    rerunFilter->execute();
+    DREAM3D_REQUIRED(rerunFilter->getErrorCode(), >=, 0)
+    DREAM3D_REQUIRE_EQUAL(rerunObserver.getCount(), 2)
+
+    // Without keeping them, the misorientations are released after each run and found again by the next one
+    EdgeAngleObserver releaseObserver;
+    AdaptiveAlignmentMutualInformation::Pointer releaseFilter = AdaptiveAlignmentMutualInformation::New();
+    releaseFilter->connect(releaseFilter.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), &releaseObserver, SLOT(processPipelineMessage(const AbstractMessage::Pointer&)));
+    DataContainerArray::Pointer release;
+    for(float tolerance : {5.0f, 40.0f})
+    {
+      release = createDataStructure();
+      releaseFilter->setDataContainerArray(release);
+      setupMutualInformation(releaseFilter.get(), tolerance);
+      releaseFilter->execute();
+      DREAM3D_REQUIRED(releaseFilter->getErrorCode(), >=, 0)
+    }
+    DREAM3D_REQUIRE_EQUAL(releaseObserver.getCount(), 2)
+    DREAM3D_REQUIRE(isEqual(*getCellArray<FloatArrayType>(release, k_QuatsName), *getCellArray<FloatArrayType>(cold, k_QuatsName)))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### AdaptiveAlignmentTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFeature())
+    DREAM3D_REGISTER_TEST(TestMisorientation())
+    DREAM3D_REGISTER_TEST(TestMisorientationCoarseToFine())
+    DREAM3D_REGISTER_TEST(TestMutualInformation())
+    DREAM3D_REGISTER_TEST(TestMutualInformationToleranceRerun())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  AdaptiveAlignmentTest(const AdaptiveAlignmentTest&) = delete;            // Copy Constructor Not Implemented
+  AdaptiveAlignmentTest(AdaptiveAlignmentTest&&) = delete;                 // Move Constructor Not Implemented
+  AdaptiveAlignmentTest& operator=(const AdaptiveAlignmentTest&) = delete; // Copy Assignment Not Implemented
+  AdaptiveAlignmentTest& operator=(AdaptiveAlignmentTest&&) = delete;      // Move Assignment Not Implemented
+};
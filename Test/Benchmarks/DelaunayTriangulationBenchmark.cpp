@@ -0,0 +1,100 @@
+/**
+ * Times the Delaunay2D triangulators on random and on raster ordered points.
+ *
+ *   DREAM3DReview_DelaunayTriangulationBenchmark [numVertices] [repeats]
+ *
+ * The raster ordered points are a jittered grid listed row by row, which is the order in which
+ * scanned or imaged point data usually arrives and the worst case for an incremental triangulator
+ * that inserts in input order.  Each configuration reports the best wall time of the repeats.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/Delaunay2D.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+TriMesh::VertexCoordList createRandomVertices(size_t numVerts)
+{
+  std::mt19937_64 generator(5489U);
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+  TriMesh::VertexCoordList vertices(numVerts);
+  for(auto&& vert : vertices)
+  {
+    vert = {distribution(generator), distribution(generator), 0.0f};
+  }
+  return vertices;
+}
+
+// -----------------------------------------------------------------------------
+TriMesh::VertexCoordList createRasterVertices(size_t numVerts)
+{
+  size_t dim = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(numVerts))));
+  float spacing = 1.0f / static_cast<float>(dim);
+  std::mt19937_64 generator(5489U);
+  std::uniform_real_distribution<float> jitter(-0.1f * spacing, 0.1f * spacing);
+  TriMesh::VertexCoordList vertices;
+  vertices.reserve(numVerts);
+  for(size_t y = 0; y < dim && vertices.size() < numVerts; y++)
+  {
+    for(size_t x = 0; x < dim && vertices.size() < numVerts; x++)
+    {
+      vertices.push_back({static_cast<float>(x) * spacing + jitter(generator), static_cast<float>(y) * spacing + jitter(generator), 0.0f});
+    }
+  }
+  return vertices;
+}
+
+// -----------------------------------------------------------------------------
+void runBenchmark(const char* inputName, const TriMesh::VertexCoordList& vertices, const char* algorithmName, Delaunay2D::Algorithm algorithm, Delaunay2D::InsertionOrder insertionOrder,
+                  int32_t repeats)
+{
+  double bestMilliseconds = std::numeric_limits<double>::max();
+  size_t numTris = 0;
+  for(int32_t i = 0; i < repeats; i++)
+  {
+    Delaunay2D::Pointer delaunay = Delaunay2D::New(vertices, 1.0, 0.00001, 0.0);
+    delaunay->setAlgorithm(algorithm);
+    delaunay->setInsertionOrder(insertionOrder);
+
+    auto start = std::chrono::steady_clock::now();
+    TriangleGeom::Pointer triangles = delaunay->triangulate();
+    auto end = std::chrono::steady_clock::now();
+
+    bestMilliseconds = std::min(bestMilliseconds, std::chrono::duration<double, std::milli>(end - start).count());
+    numTris = triangles->getNumberOfTris();
+  }
+
+  std::printf("%-8s %-34s %12.1f ms %12zu triangles\n", inputName, algorithmName, bestMilliseconds, numTris);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numVerts = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000;
+  int32_t repeats = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 3;
+
+  std::printf("%zu vertices, best of %d\n", numVerts, repeats);
+
+  TriMesh::VertexCoordList random = createRandomVertices(numVerts);
+  TriMesh::VertexCoordList raster = createRasterVertices(numVerts);
+
+  for(const auto& input : {std::make_pair("random", &random), std::make_pair("raster", &raster)})
+  {
+    runBenchmark(input.first, *input.second, "Incremental, Input Order", Delaunay2D::Algorithm::Incremental, Delaunay2D::InsertionOrder::Input, repeats);
+    runBenchmark(input.first, *input.second, "Incremental, Spatially Sorted", Delaunay2D::Algorithm::Incremental, Delaunay2D::InsertionOrder::SpatiallySorted, repeats);
+    runBenchmark(input.first, *input.second, "Divide and Conquer", Delaunay2D::Algorithm::DivideAndConquer, Delaunay2D::InsertionOrder::SpatiallySorted, repeats);
+  }
+
+  return EXIT_SUCCESS;
+}
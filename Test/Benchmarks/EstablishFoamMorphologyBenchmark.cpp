@@ -0,0 +1,101 @@
+/**
+ * Reports the packing rate of EstablishFoamMorphology on the Open-Cell-Foam-Example pipeline.
+ *
+ *   DREAM3DReview_EstablishFoamMorphologyBenchmark [repeats]
+ *
+ * Only the filters up to and including Establish Foam Morphology are run. The filter posts the number of
+ * swap/move iterations and the Moves/Sec of its packing loop once the loop finishes; that message is
+ * printed for each repeat. Build this target at two revisions to compare packing changes.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Observer.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+namespace
+{
+/**
+ * @brief Prints only the packing rate message of EstablishFoamMorphology
+ */
+class PackingRateObserver : public Observer
+{
+public:
+  void processPipelineMessage(const AbstractMessage::Pointer& pm) override
+  {
+    QString message = pm->generateMessageString();
+    if(message.contains("Moves/Sec"))
+    {
+      std::printf("%s\n", message.toStdString().c_str());
+    }
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  int32_t repeats = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 3;
+
+  QMetaObjectUtilities::RegisterMetaTypes();
+  SIMPLibPluginLoader::LoadPluginFilters(FilterManager::Instance());
+
+  QString pipelineFile = UnitTest::PluginSourceDir + "/" + "ExamplePipelines/" + UnitTest::PluginName + "/" + "Open-Cell-Foam-Example.json";
+  if(!QFileInfo(pipelineFile).exists())
+  {
+    std::printf("The input file '%s' does not exist\n", pipelineFile.toStdString().c_str());
+    return EXIT_FAILURE;
+  }
+
+  FilterPipeline::Pointer examplePipeline = JsonFilterParametersReader::New()->readPipelineFromFile(pipelineFile);
+  if(nullptr == examplePipeline.get())
+  {
+    std::printf("An error occurred trying to read the pipeline file\n");
+    return EXIT_FAILURE;
+  }
+
+  // Drop everything after the packing so that the timing is not diluted by the statistics and the file writer
+  FilterPipeline::Pointer pipeline = FilterPipeline::New();
+  for(const AbstractFilter::Pointer& filter : examplePipeline->getFilterContainer())
+  {
+    pipeline->pushBack(filter);
+    if(filter->getNameOfClass() == "EstablishFoamMorphology")
+    {
+      break;
+    }
+  }
+
+  PackingRateObserver obs;
+  pipeline->addMessageReceiver(&obs);
+  if(pipeline->preflightPipeline() < 0)
+  {
+    std::printf("Errors preflighting the pipeline\n");
+    return EXIT_FAILURE;
+  }
+
+  for(int32_t i = 0; i < repeats; i++)
+  {
+    pipeline->execute();
+    if(pipeline->getErrorCode() < 0)
+    {
+      std::printf("Error Condition of Pipeline: %d\n", pipeline->getErrorCode());
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
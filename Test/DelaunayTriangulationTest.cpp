@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/Delaunay2D.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/DivideAndConquerDelaunay2D.hpp"
+
+class DelaunayTriangulationTest
+{
+  using VertexList = std::vector<std::array<float, 3>>;
+  using TriangleSet = std::set<std::array<int64_t, 3>>;
+
+public:
+  DelaunayTriangulationTest() = default;
+  virtual ~DelaunayTriangulationTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  VertexList createRandomVertices(size_t numVerts, uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    VertexList vertices(numVerts);
+    for(auto&& vert : vertices)
+    {
+      vert = {distribution(generator), distribution(generator), 0.0f};
+    }
+    return vertices;
+  }
+
+  // -----------------------------------------------------------------------------
+  VertexList createRasterVertices(size_t dimX, size_t dimY)
+  {
+    VertexList vertices;
+    for(size_t y = 0; y < dimY; y++)
+    {
+      for(size_t x = 0; x < dimX; x++)
+      {
+        vertices.push_back({0.5f * static_cast<float>(x), 0.5f * static_cast<float>(y), 0.0f});
+      }
+    }
+    return vertices;
+  }
+
+  // -----------------------------------------------------------------------------
+  double signedArea(const VertexList& vertices, int64_t a, int64_t b, int64_t c)
+  {
+    return 0.5 * ((static_cast<double>(vertices[b][0]) - vertices[a][0]) * (static_cast<double>(vertices[c][1]) - vertices[a][1]) -
+                  (static_cast<double>(vertices[b][1]) - vertices[a][1]) * (static_cast<double>(vertices[c][0]) - vertices[a][0]));
+  }
+
+  // -----------------------------------------------------------------------------
+  double convexHullArea(const VertexList& vertices)
+  {
+    std::vector<std::array<double, 2>> points;
+    for(const auto& vert : vertices)
+    {
+      points.push_back({vert[0], vert[1]});
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if(points.size() < 3)
+    {
+      return 0.0;
+    }
+
+    auto cross = [](const std::array<double, 2>& o, const std::array<double, 2>& a, const std::array<double, 2>& b) {
+      return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+    };
+    std::vector<std::array<double, 2>> hull(2 * points.size());
+    size_t k = 0;
+    for(size_t i = 0; i < points.size(); i++)
+    {
+      while(k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0)
+      {
+        k--;
+      }
+      hull[k++] = points[i];
+    }
+    for(size_t i = points.size() - 1, lower = k + 1; i > 0; i--)
+    {
+      while(k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0)
+      {
+        k--;
+      }
+      hull[k++] = points[i - 1];
+    }
+
+    double area = 0.0;
+    for(size_t i = 0; i + 1 < k; i++)
+    {
+      area += hull[i][0] * hull[i + 1][1] - hull[i + 1][0] * hull[i][1];
+    }
+    return 0.5 * area;
+  }
+
+  // -----------------------------------------------------------------------------
+  TriangleSet toTriangleSet(const std::vector<int64_t>& triangles)
+  {
+    TriangleSet triangleSet;
+    for(size_t i = 0; i < triangles.size(); i += 3)
+    {
+      std::array<int64_t, 3> tri = {triangles[i], triangles[i + 1], triangles[i + 2]};
+      std::sort(tri.begin(), tri.end());
+      triangleSet.insert(tri);
+    }
+    return triangleSet;
+  }
+
+  /**
+   * @brief Checks that the triangles are counter-clockwise, tile the convex hull of the vertices, and that no
+   * vertex lies strictly inside the circumcircle of any triangle
+   */
+  void checkDelaunay(const VertexList& vertices, const std::vector<int64_t>& triangles)
+  {
+    DREAM3D_REQUIRE_EQUAL(triangles.size() % 3, 0)
+
+    double area = 0.0;
+    for(size_t t = 0; t < triangles.size(); t += 3)
+    {
+      const int64_t* tri = triangles.data() + t;
+      double triArea = signedArea(vertices, tri[0], tri[1], tri[2]);
+      DREAM3D_REQUIRED(triArea, >, 0.0)
+      area += triArea;
+
+      for(const auto& vert : vertices)
+      {
+        double ax = static_cast<double>(vertices[tri[0]][0]) - vert[0];
+        double ay = static_cast<double>(vertices[tri[0]][1]) - vert[1];
+        double bx = static_cast<double>(vertices[tri[1]][0]) - vert[0];
+        double by = static_cast<double>(vertices[tri[1]][1]) - vert[1];
+        double cx = static_cast<double>(vertices[tri[2]][0]) - vert[0];
+        double cy = static_cast<double>(vertices[tri[2]][1]) - vert[1];
+        double det = (ax * ax + ay * ay) * (bx * cy - by * cx) - (bx * bx + by * by) * (ax * cy - ay * cx) + (cx * cx + cy * cy) * (ax * by - ay * bx);
+        DREAM3D_REQUIRED(det, <=, 1.0e-9)
+      }
+    }
+
+    double hullArea = convexHullArea(vertices);
+    DREAM3D_REQUIRED(std::abs(area - hullArea), <=, 1.0e-6 * std::max(1.0, hullArea))
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<int64_t> triangulate(const VertexList& vertices, size_t numStrips, double tolerance = 0.0)
+  {
+    DivideAndConquerDelaunay2D triangulator(vertices, tolerance, numStrips);
+    triangulator.triangulate();
+    return triangulator.getTriangles();
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRandomVertices()
+  {
+    for(size_t numVerts : {3, 4, 5, 10, 100, 500})
+    {
+      VertexList vertices = createRandomVertices(numVerts, static_cast<uint32_t>(numVerts));
+      TriangleSet reference;
+      for(size_t numStrips : {1, 2, 8})
+      {
+        std::vector<int64_t> triangles = triangulate(vertices, numStrips);
+        checkDelaunay(vertices, triangles);
+
+        // Points in general position have a unique Delaunay triangulation, so the strips must not matter
+        TriangleSet triangleSet = toTriangleSet(triangles);
+        if(numStrips == 1)
+        {
+          reference = triangleSet;
+        }
+        DREAM3D_REQUIRE(triangleSet == reference)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRasterVertices()
+  {
+    // Raster ordered grid points are all co-circular in fours, which is the worst case for the predicates
+    VertexList vertices = createRasterVertices(17, 20);
+    for(size_t numStrips : {1, 4, 16})
+    {
+      std::vector<int64_t> triangles = triangulate(vertices, numStrips);
+      checkDelaunay(vertices, triangles);
+      DREAM3D_REQUIRE_EQUAL(triangles.size() / 3, 2 * 16 * 19)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestDegenerateVertices()
+  {
+    for(size_t numVerts : {0, 1, 2})
+    {
+      DREAM3D_REQUIRE(triangulate(createRandomVertices(numVerts, 1), 4).empty())
+    }
+
+    VertexList collinear;
+    for(int32_t i = 0; i < 10; i++)
+    {
+      collinear.push_back({static_cast<float>(i), static_cast<float>(2 * i), 0.0f});
+    }
+    DREAM3D_REQUIRE(triangulate(collinear, 2).empty())
+
+    // 200 points on a 5x5 grid, so most of them are duplicates
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int32_t> distribution(0, 4);
+    VertexList duplicates(200);
+    for(auto&& vert : duplicates)
+    {
+      vert = {static_cast<float>(distribution(generator)), static_cast<float>(distribution(generator)), 0.0f};
+    }
+    std::set<std::array<float, 3>> distinct(duplicates.begin(), duplicates.end());
+    DivideAndConquerDelaunay2D triangulator(duplicates, 0.0, 4);
+    triangulator.triangulate();
+    DREAM3D_REQUIRE_EQUAL(triangulator.getNumberOfDuplicatePoints(), duplicates.size() - distinct.size())
+    checkDelaunay(duplicates, triangulator.getTriangles());
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestDelaunay2DAlgorithms()
+  {
+    VertexList vertices = createRandomVertices(300, 42);
+    TriMesh::VertexCoordList vertexList;
+    for(const auto& vert : vertices)
+    {
+      vertexList.push_back({vert[0], vert[1], vert[2]});
+    }
+
+    std::vector<int64_t> reference = triangulate(vertices, 1);
+
+    for(auto algorithm : {Delaunay2D::Algorithm::Incremental, Delaunay2D::Algorithm::DivideAndConquer})
+    {
+      Delaunay2D::Pointer delaunay = Delaunay2D::New(vertexList, 1.0, 0.00001, 0.0);
+      delaunay->setAlgorithm(algorithm);
+      TriangleGeom::Pointer triangles = delaunay->triangulate();
+      DREAM3D_REQUIRE(triangles != nullptr)
+      DREAM3D_REQUIRE_EQUAL(triangles->getNumberOfVertices(), vertices.size())
+
+      std::vector<int64_t> triList(3 * triangles->getNumberOfTris());
+      size_t* triPtr = triangles->getTriPointer(0);
+      for(size_t i = 0; i < triList.size(); i++)
+      {
+        triList[i] = static_cast<int64_t>(triPtr[i]);
+        DREAM3D_REQUIRED(triList[i], <, static_cast<int64_t>(vertices.size()))
+      }
+
+      if(algorithm == Delaunay2D::Algorithm::DivideAndConquer)
+      {
+        checkDelaunay(vertices, triList);
+        DREAM3D_REQUIRE(toTriangleSet(triList) == toTriangleSet(reference))
+      }
+      else
+      {
+        // The bounding points may cut off some of the hull triangles, so only the interior has to match
+        DREAM3D_REQUIRED(triList.size(), <=, reference.size())
+        double area = 0.0;
+        for(size_t t = 0; t < triList.size(); t += 3)
+        {
+          area += std::abs(signedArea(vertices, triList[t], triList[t + 1], triList[t + 2]));
+        }
+        DREAM3D_REQUIRED(area, <=, convexHullArea(vertices) * (1.0 + 1.0e-6))
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### DelaunayTriangulationTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestRandomVertices())
+    DREAM3D_REGISTER_TEST(TestRasterVertices())
+    DREAM3D_REGISTER_TEST(TestDegenerateVertices())
+    DREAM3D_REGISTER_TEST(TestDelaunay2DAlgorithms())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  DelaunayTriangulationTest(const DelaunayTriangulationTest&) = delete;            // Copy Constructor Not Implemented
+  DelaunayTriangulationTest(DelaunayTriangulationTest&&) = delete;                 // Move Constructor Not Implemented
+  DelaunayTriangulationTest& operator=(const DelaunayTriangulationTest&) = delete; // Copy Assignment Not Implemented
+  DelaunayTriangulationTest& operator=(DelaunayTriangulationTest&&) = delete;      // Move Assignment Not Implemented
+};
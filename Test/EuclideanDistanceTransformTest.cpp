@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/EuclideanDistanceTransform.hpp"
+
+class EuclideanDistanceTransformTest
+{
+public:
+  EuclideanDistanceTransformTest() = default;
+  virtual ~EuclideanDistanceTransformTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  double squaredDistance(const std::array<int64_t, 3>& dims, const std::array<double, 3>& spacing, int64_t a, int64_t b)
+  {
+    double dx = spacing[0] * static_cast<double>(a % dims[0] - b % dims[0]);
+    double dy = spacing[1] * static_cast<double>((a / dims[0]) % dims[1] - (b / dims[0]) % dims[1]);
+    double dz = spacing[2] * static_cast<double>(a / (dims[0] * dims[1]) - b / (dims[0] * dims[1]));
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+  /**
+   * @brief Seeds every voxel with the given probability, runs the transform and compares every voxel with the
+   * minimum over all seeds.  The nearest seed may differ from the brute force one on ties, so it is checked
+   * through its distance instead.
+   */
+  void checkAgainstBruteForce(const std::array<int64_t, 3>& dims, const std::array<double, 3>& spacing, double seedProbability, uint32_t seed)
+  {
+    const double inf = std::numeric_limits<double>::infinity();
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::vector<double> sqDistances(totalPoints, inf);
+    std::vector<int64_t> nearest(totalPoints, -1);
+    std::vector<int64_t> seeds;
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(distribution(generator) < seedProbability)
+      {
+        sqDistances[i] = 0.0;
+        nearest[i] = i;
+        seeds.push_back(i);
+      }
+    }
+
+    EuclideanDistanceTransform::ComputeSquaredDistanceMap(dims, spacing, sqDistances, nearest);
+
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(seeds.empty())
+      {
+        DREAM3D_REQUIRE(sqDistances[i] == inf)
+        DREAM3D_REQUIRE_EQUAL(nearest[i], -1)
+        continue;
+      }
+
+      double expected = inf;
+      for(int64_t s : seeds)
+      {
+        expected = std::min(expected, squaredDistance(dims, spacing, i, s));
+      }
+      double tolerance = 1.0e-9 * std::max(1.0, expected);
+      DREAM3D_REQUIRED(std::abs(sqDistances[i] - expected), <=, tolerance)
+      DREAM3D_REQUIRE(std::binary_search(seeds.begin(), seeds.end(), nearest[i]))
+      DREAM3D_REQUIRED(std::abs(squaredDistance(dims, spacing, i, nearest[i]) - expected), <=, tolerance)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestIsotropic()
+  {
+    checkAgainstBruteForce({17, 13, 11}, {1.0, 1.0, 1.0}, 0.01, 1);
+    checkAgainstBruteForce({17, 13, 11}, {1.0, 1.0, 1.0}, 0.2, 2);
+    checkAgainstBruteForce({40, 1, 1}, {1.0, 1.0, 1.0}, 0.05, 3);
+    checkAgainstBruteForce({1, 1, 40}, {1.0, 1.0, 1.0}, 0.05, 4);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestAnisotropic()
+  {
+    checkAgainstBruteForce({15, 12, 9}, {0.25, 1.5, 3.0}, 0.02, 5);
+    checkAgainstBruteForce({9, 20, 7}, {2.0, 0.1, 0.7}, 0.1, 6);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestSparseSeeds()
+  {
+    // A single seed in a corner gives the longest envelopes, no seeds must leave everything infinite
+    const std::array<int64_t, 3> dims = {12, 10, 8};
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::vector<double> sqDistances(totalPoints, std::numeric_limits<double>::infinity());
+    std::vector<int64_t> nearest(totalPoints, -1);
+    sqDistances[totalPoints - 1] = 0.0;
+    nearest[totalPoints - 1] = totalPoints - 1;
+
+    EuclideanDistanceTransform::ComputeSquaredDistanceMap(dims, {1.0, 2.0, 0.5}, sqDistances, nearest);
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(nearest[i], totalPoints - 1)
+      DREAM3D_REQUIRED(std::abs(sqDistances[i] - squaredDistance(dims, {1.0, 2.0, 0.5}, i, totalPoints - 1)), <=, 1.0e-9)
+    }
+
+    checkAgainstBruteForce(dims, {1.0, 1.0, 1.0}, 0.0, 7);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### EuclideanDistanceTransformTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestIsotropic())
+    DREAM3D_REGISTER_TEST(TestAnisotropic())
+    DREAM3D_REGISTER_TEST(TestSparseSeeds())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  EuclideanDistanceTransformTest(const EuclideanDistanceTransformTest&) = delete;            // Copy Constructor Not Implemented
+  EuclideanDistanceTransformTest(EuclideanDistanceTransformTest&&) = delete;                 // Move Constructor Not Implemented
+  EuclideanDistanceTransformTest& operator=(const EuclideanDistanceTransformTest&) = delete; // Copy Assignment Not Implemented
+  EuclideanDistanceTransformTest& operator=(EuclideanDistanceTransformTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,355 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/FarFieldSlabReader.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+class FarFieldSlabReaderTest
+{
+  const QString k_SlabFile = UnitTest::TestTempDir + "/FarFieldSlabReaderTest.txt";
+
+  /**
+   * @brief The text of a slab file and the values it holds, each as the float the reader must produce
+   */
+  struct SlabText
+  {
+    std::string text;
+    float beamCenter = 0.0f;
+    float beamThickness = 0.0f;
+    float globalZPos = 0.0f;
+    std::vector<float> referenceLattice;
+    std::vector<FarFieldSlabReader::FarFieldGrain> grains;
+  };
+
+public:
+  FarFieldSlabReaderTest() = default;
+  virtual ~FarFieldSlabReaderTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(k_SlabFile);
+    QFile::remove(k_SlabFile + ".cache");
+#endif
+  }
+
+  /**
+   * @brief Appends a random decimal to text and returns the float the reader must produce for it
+   */
+  float appendValue(std::string& text, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<double> distribution(-100.0, 100.0);
+    const std::string value = std::to_string(distribution(generator));
+    text += value + " ";
+    return static_cast<float>(std::strtod(value.c_str(), nullptr));
+  }
+
+  /**
+   * @brief Creates a slab file with numPhases phases and numFeatures feature rows.  The header counts are written as
+   * given, so they can disagree with the rows.
+   */
+  SlabText createSlabText(const std::string& numFeaturesToken, const std::string& numPhasesToken, int32_t numPhases, int32_t numFeatures, std::mt19937& generator)
+  {
+    SlabText slab;
+    std::string& text = slab.text;
+    text += "NumFeatures " + numFeaturesToken + "\nBeamCenter ";
+    slab.beamCenter = appendValue(text, generator);
+    text += "\nBeamThickness ";
+    slab.beamThickness = appendValue(text, generator);
+    text += "\nGlobalZPos ";
+    slab.globalZPos = appendValue(text, generator);
+    text += "\nNumPhases " + numPhasesToken + "\n";
+    for(int32_t i = 0; i < numPhases; i++)
+    {
+      text += "Phase" + std::to_string(i + 1) + (i % 2 == 0 ? " Cubic " : " Hexagonal ");
+      slab.referenceLattice.clear();
+      for(size_t j = 0; j < 6; j++)
+      {
+        slab.referenceLattice.push_back(appendValue(text, generator));
+      }
+      text += "\n";
+    }
+    for(int32_t i = 0; i < numFeatures; i++)
+    {
+      FarFieldSlabReader::FarFieldGrain grain;
+      std::memset(&grain, 0, sizeof(grain));
+      grain.phase = 1 + i % std::max(numPhases, 1);
+      text += std::to_string(i + 1) + "\t" + std::to_string(grain.phase) + "\t";
+      for(float& value : grain.orientationMatrix)
+      {
+        value = appendValue(text, generator);
+      }
+      for(float& value : grain.centroid)
+      {
+        value = appendValue(text, generator);
+      }
+      for(float& value : grain.latticeParameters)
+      {
+        value = appendValue(text, generator);
+      }
+      text += "0.0 0.0 0.0 ";
+      grain.equivalentRadius = appendValue(text, generator);
+      text += "1.0\r\n";
+      slab.grains.push_back(grain);
+    }
+    return slab;
+  }
+
+  // -----------------------------------------------------------------------------
+  void writeSlabFile(const std::string& text)
+  {
+    std::ofstream outFile(k_SlabFile.toStdString(), std::ios_base::binary | std::ios_base::trunc);
+    outFile << text;
+  }
+
+  // -----------------------------------------------------------------------------
+  FarFieldSlabReader::FarFieldSlab loadSlab(bool useCache)
+  {
+    FarFieldSlabReader::FarFieldSlab slab;
+    FarFieldSlabReader::LoadSlabImpl(k_SlabFile, useCache, slab)();
+    return slab;
+  }
+
+  /**
+   * @brief Requires the loaded slab to hold the values of the slab text
+   */
+  void checkSlab(const FarFieldSlabReader::FarFieldSlab& slab, const SlabText& expected)
+  {
+    DREAM3D_REQUIRE_EQUAL(slab.errorCode, 0)
+    DREAM3D_REQUIRE_EQUAL(slab.beamCenter, expected.beamCenter)
+    DREAM3D_REQUIRE_EQUAL(slab.beamThickness, expected.beamThickness)
+    DREAM3D_REQUIRE_EQUAL(slab.globalZPos, expected.globalZPos)
+    for(size_t j = 0; j < 6; j++)
+    {
+      DREAM3D_REQUIRE_EQUAL(slab.referenceLattice[j], expected.referenceLattice[j])
+    }
+    DREAM3D_REQUIRE_EQUAL(slab.grains.size(), expected.grains.size())
+    for(size_t i = 0; i < slab.grains.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(std::memcmp(&slab.grains[i], &expected.grains[i], sizeof(FarFieldSlabReader::FarFieldGrain)), 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void checkInteger(const std::string& text, bool valid, T expected)
+  {
+    FarFieldSlabReader::SlabTokenizer tokenizer(text.c_str());
+    T value = 0;
+    DREAM3D_REQUIRE_EQUAL(tokenizer.readInteger(value), valid)
+    if(valid)
+    {
+      DREAM3D_REQUIRE_EQUAL(value, expected)
+      return;
+    }
+    // A rejected token is left for the next read
+    std::string token;
+    DREAM3D_REQUIRE_EQUAL(tokenizer.readToken(token), !text.empty())
+    DREAM3D_REQUIRE_EQUAL(token, text)
+  }
+
+  // -----------------------------------------------------------------------------
+  void checkFloat(const std::string& text, bool valid)
+  {
+    FarFieldSlabReader::SlabTokenizer tokenizer(text.c_str());
+    float value = 0.0f;
+    DREAM3D_REQUIRE_EQUAL(tokenizer.readFloat(value), valid)
+    if(valid)
+    {
+      DREAM3D_REQUIRE_EQUAL(value, static_cast<float>(std::strtod(text.c_str(), nullptr)))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestIntegers()
+  {
+    checkInteger<int64_t>("12", true, 12);
+    checkInteger<int64_t>("-7", true, -7);
+    checkInteger<int64_t>("+3", true, 3);
+    checkInteger<int64_t>("-0", true, 0);
+    checkInteger<int64_t>("0009", true, 9);
+    checkInteger<int64_t>("9223372036854775807", true, std::numeric_limits<int64_t>::max());
+    checkInteger<int64_t>("-9223372036854775808", true, std::numeric_limits<int64_t>::min());
+    checkInteger<int64_t>("9223372036854775808", false, 0);
+    checkInteger<int64_t>("-9223372036854775809", false, 0);
+    checkInteger<int64_t>("123456789012345678901234567890", false, 0);
+    checkInteger<int32_t>("2147483647", true, std::numeric_limits<int32_t>::max());
+    checkInteger<int32_t>("-2147483648", true, std::numeric_limits<int32_t>::min());
+    checkInteger<int32_t>("2147483648", false, 0);
+    checkInteger<int32_t>("-2147483649", false, 0);
+    checkInteger<int32_t>("4294967297", false, 0);
+    checkInteger<int32_t>("12a", false, 0);
+    checkInteger<int32_t>("1.5", false, 0);
+    checkInteger<int32_t>("-", false, 0);
+    checkInteger<int32_t>("", false, 0);
+
+    // Tokens are separated by any whitespace
+    FarFieldSlabReader::SlabTokenizer tokenizer(" \t1\r\n-2\v\f3");
+    int32_t value = 0;
+    for(int32_t expected : {1, -2, 3})
+    {
+      DREAM3D_REQUIRE(tokenizer.readInteger(value))
+      DREAM3D_REQUIRE_EQUAL(value, expected)
+    }
+    DREAM3D_REQUIRE(!tokenizer.readInteger(value))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestFloats()
+  {
+    for(const char* text : {"0", "-0.0", "1.5", "-2.5E+3", ".5", "5.", "+0.000001", "123456.789012", "0.1", "3.4028234e38", "1e-30", "3.14159265358979323846", "17e22", "17e23"})
+    {
+      checkFloat(text, true);
+    }
+    for(const char* text : {"", ".", "-", "e5", "1e", "1e+", "1.0x", "--1"})
+    {
+      checkFloat(text, false);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMalformedFiles()
+  {
+    std::mt19937 generator(1);
+    auto errorCode = [this](const std::string& text) {
+      writeSlabFile(text);
+      return loadSlab(false).errorCode;
+    };
+
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("3", "2", 2, 3, generator).text), 0)
+    // Counts that do not fit, or that could not possibly be in the file, are read errors
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("99999999999999999999", "2", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("9223372036854775807", "2", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("3", "4294967297", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("3", "2000000", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("-3", "2", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("3", "-1", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("3.5", "2", 2, 3, generator).text), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("0", "2", 2, 0, generator).text), -600)
+    // Fewer feature rows than the header promises
+    DREAM3D_REQUIRE_EQUAL(errorCode(createSlabText("4", "2", 2, 3, generator).text), -601)
+    // A truncated last row
+    std::string text = createSlabText("3", "2", 2, 3, generator).text;
+    DREAM3D_REQUIRE_EQUAL(errorCode(text.substr(0, text.size() - 12)), -601)
+    // A phase out of the range of int32_t in a feature row
+    text = createSlabText("1", "1", 1, 1, generator).text;
+    const size_t phase = text.rfind("1\t1\t") + 2;
+    DREAM3D_REQUIRE_EQUAL(errorCode(text.substr(0, phase) + "2147483648" + text.substr(phase + 1)), -601)
+    DREAM3D_REQUIRE_EQUAL(errorCode(""), -601)
+
+    QFile::remove(k_SlabFile);
+    DREAM3D_REQUIRE_EQUAL(loadSlab(false).errorCode, -1)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestCacheRoundTrip()
+  {
+    std::mt19937 generator(2);
+    const QString cacheFile = k_SlabFile + ".cache";
+    QFile::remove(cacheFile);
+
+    SlabText expected = createSlabText("40", "3", 3, 40, generator);
+    writeSlabFile(expected.text);
+    checkSlab(loadSlab(false), expected);
+    DREAM3D_REQUIRE(!QFile::exists(cacheFile))
+
+    // The first load writes the cache and the second reads it back
+    FarFieldSlabReader::FarFieldSlab parsed = loadSlab(true);
+    checkSlab(parsed, expected);
+    DREAM3D_REQUIRE(!parsed.cacheWriteFailed)
+    DREAM3D_REQUIRE(QFile::exists(cacheFile))
+    FarFieldSlabReader::FarFieldSlab cached = loadSlab(true);
+    checkSlab(cached, expected);
+    DREAM3D_REQUIRE(cached.crystalStructures == parsed.crystalStructures)
+    for(size_t i = 0; i < 3; i++)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        DREAM3D_REQUIRE_EQUAL(cached.referenceRootTensor[i][j], parsed.referenceRootTensor[i][j])
+      }
+    }
+
+    // The beam center follows the magic, the source size and the source time stamp in the cache, so changing it
+    // there shows that the cache is what the second load read
+    const float changedBeamCenter = expected.beamCenter + 1.0f;
+    {
+      std::fstream cache(cacheFile.toStdString(), std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+      cache.seekp(24);
+      cache.write(reinterpret_cast<const char*>(&changedBeamCenter), sizeof(float));
+    }
+    DREAM3D_REQUIRE_EQUAL(loadSlab(true).beamCenter, changedBeamCenter)
+
+    // A truncated cache is ignored and rewritten
+    std::vector<char> bytes;
+    {
+      std::ifstream cache(cacheFile.toStdString(), std::ios_base::binary);
+      bytes.assign(std::istreambuf_iterator<char>(cache), std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream cache(cacheFile.toStdString(), std::ios_base::binary | std::ios_base::trunc);
+      cache.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 10));
+    }
+    checkSlab(loadSlab(true), expected);
+    checkSlab(loadSlab(true), expected);
+
+    // A cache claiming more features than it holds is ignored
+    {
+      std::fstream cache(cacheFile.toStdString(), std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+      const uint64_t numFeatures = std::numeric_limits<uint64_t>::max() / 2;
+      cache.seekp(static_cast<std::streamoff>(24 + 3 * sizeof(float) + 6 * sizeof(float) + sizeof(uint32_t) + 3 * sizeof(uint32_t)));
+      cache.write(reinterpret_cast<const char*>(&numFeatures), sizeof(numFeatures));
+    }
+    checkSlab(loadSlab(true), expected);
+
+    // A cache for an earlier version of the file is ignored
+    expected = createSlabText("41", "3", 3, 41, generator);
+    writeSlabFile(expected.text);
+    checkSlab(loadSlab(true), expected);
+    checkSlab(loadSlab(true), expected);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### FarFieldSlabReaderTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestIntegers())
+    DREAM3D_REGISTER_TEST(TestFloats())
+    DREAM3D_REGISTER_TEST(TestMalformedFiles())
+    DREAM3D_REGISTER_TEST(TestCacheRoundTrip())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  FarFieldSlabReaderTest(const FarFieldSlabReaderTest&) = delete;            // Copy Constructor Not Implemented
+  FarFieldSlabReaderTest(FarFieldSlabReaderTest&&) = delete;                 // Move Constructor Not Implemented
+  FarFieldSlabReaderTest& operator=(const FarFieldSlabReaderTest&) = delete; // Copy Assignment Not Implemented
+  FarFieldSlabReaderTest& operator=(FarFieldSlabReaderTest&&) = delete;      // Move Assignment Not Implemented
+};
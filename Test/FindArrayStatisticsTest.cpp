@@ -0,0 +1,471 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/FindArrayStatistics.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/StatisticsHelpers.hpp"
+
+class FindArrayStatisticsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellAttributeMatrixName = {"CellData"};
+  const QString k_FeatureAttributeMatrixName = {"FeatureData"};
+  const QString k_StatisticsAttributeMatrixName = {"Statistics"};
+  const QString k_DataName = {"Data"};
+  const QString k_FeatureIdsName = {"FeatureIds"};
+  const QString k_MaskName = {"Mask"};
+  const QString k_Percentiles = {"5, 25, 50, 90, 100"};
+  // 300000 Cells hold four chunks of the 65536 tuples each chunk needs at least, so the chunks of the filter are
+  // merged whenever it has more than one thread to run them on
+  const std::array<size_t, 3> k_Dims = {100, 60, 50};
+  const int32_t k_NumFeatures = 40;
+  const int32_t k_NumBins = 16;
+  // Features without Cells, a Feature whose Cells are all masked out, one with only negative values and one that
+  // only has Cells at the end of the array
+  const std::vector<int32_t> k_EmptyFeatures = {7, 23};
+  const int32_t k_MaskedFeature = 11;
+  const int32_t k_NegativeFeature = 5;
+  const int32_t k_LastFeature = 31;
+  const size_t k_LastFeatureCells = 1000;
+
+  /**
+   * @brief The statistics of one Feature, computed from a sorted copy of its values
+   */
+  template <typename T>
+  struct ExpectedStatistics
+  {
+    size_t length = 0;
+    T min = static_cast<T>(0);
+    T max = static_cast<T>(0);
+    double mean = 0.0;
+    double stdDeviation = 0.0;
+    double sum = 0.0;
+    double sumOfMagnitudes = 0.0;
+    float median = 0.0f;
+    std::vector<float> percentiles;
+    std::vector<float> histogram;
+  };
+
+public:
+  FindArrayStatisticsTest() = default;
+  virtual ~FindArrayStatisticsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<float> createQuantiles()
+  {
+    std::vector<float> quantiles;
+    for(const QString& token : k_Percentiles.split(','))
+    {
+      quantiles.push_back(static_cast<float>(token.trimmed().toDouble() / 100.0));
+    }
+    return quantiles;
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  double getScale()
+  {
+    return std::is_integral_v<T> ? 10.0 : 1.0;
+  }
+
+  /**
+   * @brief Creates an Image Geometry with a scalar array, Feature Ids and a mask.  The values of each Feature
+   * scatter around a center of their own, so that the Features have different statistics.
+   */
+  template <typename T>
+  DataContainerArray::Pointer createDataStructure()
+  {
+    const size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    const double scale = getScale<T>();
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int32_t> featureDistribution(0, k_NumFeatures - 1);
+    std::uniform_real_distribution<double> centerDistribution(-60.0, 60.0);
+    std::uniform_real_distribution<double> spreadDistribution(-20.0, 20.0);
+    std::bernoulli_distribution maskDistribution(0.8);
+
+    std::vector<double> centers(k_NumFeatures);
+    for(auto&& center : centers)
+    {
+      center = centerDistribution(generator);
+    }
+    centers[k_NegativeFeature] = -75.0;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(SizeVec3Type(k_Dims[0], k_Dims[1], k_Dims[2]));
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New({k_Dims[0], k_Dims[1], k_Dims[2]}, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    typename DataArray<T>::Pointer data = DataArray<T>::CreateArray(totalPoints, k_DataName, true);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, k_FeatureIdsName, true);
+    DataArray<bool>::Pointer mask = DataArray<bool>::CreateArray(totalPoints, k_MaskName, true);
+    cellAttrMat->addOrReplaceAttributeArray(data);
+    cellAttrMat->addOrReplaceAttributeArray(featureIds);
+    cellAttrMat->addOrReplaceAttributeArray(mask);
+
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      int32_t featureId = featureDistribution(generator);
+      if(std::find(k_EmptyFeatures.begin(), k_EmptyFeatures.end(), featureId) != k_EmptyFeatures.end() || featureId == k_LastFeature)
+      {
+        featureId++;
+      }
+      if(i >= totalPoints - k_LastFeatureCells && i % 3 == 0)
+      {
+        featureId = k_LastFeature;
+      }
+      double value = (centers[featureId] + spreadDistribution(generator)) * scale;
+      if constexpr(std::is_integral_v<T>)
+      {
+        value = std::round(value);
+      }
+      data->setValue(i, static_cast<T>(value));
+      featureIds->setValue(i, featureId);
+      mask->setValue(i, featureId != k_MaskedFeature && maskDistribution(generator));
+    }
+
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New({static_cast<size_t>(k_NumFeatures)}, k_FeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    AttributeMatrix::Pointer statisticsAttrMat = AttributeMatrix::New({1}, k_StatisticsAttributeMatrixName, AttributeMatrix::Type::Generic);
+    dc->addOrReplaceAttributeMatrix(statisticsAttrMat);
+
+    return dca;
+  }
+
+  /**
+   * @brief Bins the values as the filter does: the range is split into equal bins, the maximum falls into the last
+   * bin, and values outside of the range are not counted
+   */
+  template <typename T>
+  std::vector<float> findExpectedHistogram(const std::vector<T>& values, float histMin, float histMax)
+  {
+    std::vector<float> histogram(k_NumBins, 0.0f);
+    const float increment = (histMax - histMin) / k_NumBins;
+    if(std::abs(increment) < 1E-10)
+    {
+      histogram[0] = static_cast<float>(values.size());
+      return histogram;
+    }
+    for(T element : values)
+    {
+      const float value = static_cast<float>(element);
+      const size_t bin = static_cast<size_t>((value - histMin) / increment);
+      if(bin < static_cast<size_t>(k_NumBins))
+      {
+        histogram[bin]++;
+      }
+      else if(value == histMax)
+      {
+        histogram[k_NumBins - 1]++;
+      }
+    }
+    return histogram;
+  }
+
+  /**
+   * @brief Finds the statistics of one Feature in separate passes over its values, with double sums, a two pass
+   * variance and a full sort for the median and the percentiles
+   */
+  template <typename T>
+  ExpectedStatistics<T> findExpectedStatistics(std::vector<T> values, const std::vector<float>& quantiles, bool histFullRange, float histMin, float histMax)
+  {
+    ExpectedStatistics<T> expected;
+    expected.percentiles.assign(quantiles.size(), 0.0f);
+    expected.histogram.assign(k_NumBins, 0.0f);
+    expected.length = values.size();
+    if(values.empty())
+    {
+      return expected;
+    }
+
+    std::sort(values.begin(), values.end());
+    expected.min = values.front();
+    expected.max = values.back();
+    for(T value : values)
+    {
+      expected.sum += static_cast<double>(value);
+      expected.sumOfMagnitudes += std::abs(static_cast<double>(value));
+    }
+    expected.mean = expected.sum / static_cast<double>(values.size());
+    double squaredSum = 0.0;
+    for(T value : values)
+    {
+      squaredSum += (static_cast<double>(value) - expected.mean) * (static_cast<double>(value) - expected.mean);
+    }
+    expected.stdDeviation = std::sqrt(squaredSum / static_cast<double>(values.size()));
+
+    const size_t half = values.size() / 2;
+    expected.median = (values.size() % 2 == 1) ? static_cast<float>(values[half]) : static_cast<float>((values[half - 1] + values[half]) * 0.5f);
+    for(size_t i = 0; i < quantiles.size(); i++)
+    {
+      const double rank = static_cast<double>(quantiles[i]) * static_cast<double>(values.size() - 1);
+      const size_t lowRank = static_cast<size_t>(std::floor(rank));
+      const float low = static_cast<float>(values[lowRank]);
+      const float fraction = static_cast<float>(rank - static_cast<double>(lowRank));
+      expected.percentiles[i] = (fraction == 0.0f) ? low : low + (static_cast<float>(values[lowRank + 1]) - low) * fraction;
+    }
+
+    if(histFullRange)
+    {
+      histMin = static_cast<float>(expected.min);
+      histMax = static_cast<float>(expected.max);
+    }
+    expected.histogram = findExpectedHistogram(values, histMin, histMax);
+
+    return expected;
+  }
+
+  // -----------------------------------------------------------------------------
+  bool isClose(double value, double expected, double tolerance)
+  {
+    return std::abs(value - expected) <= tolerance;
+  }
+
+  /**
+   * @brief Runs the filter with every statistic selected and compares each statistic of each Feature, or of the whole
+   * array, with the statistics of its values gathered one by one
+   */
+  template <typename T>
+  int checkStatistics(bool computeByIndex, bool useMask)
+  {
+    DataContainerArray::Pointer dca = createDataStructure<T>();
+    const QString destinationName = computeByIndex ? k_FeatureAttributeMatrixName : k_StatisticsAttributeMatrixName;
+    // Per Feature the histogram spans the values of each Feature, for the whole array it has a fixed range
+    const bool histFullRange = computeByIndex;
+    const float histMin = static_cast<float>(-100.0 * getScale<T>());
+    const float histMax = static_cast<float>(100.0 * getScale<T>());
+
+    FindArrayStatistics::Pointer filter = FindArrayStatistics::New();
+    filter->setDataContainerArray(dca);
+    filter->setSelectedArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_DataName));
+    filter->setFeatureIdsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_FeatureIdsName));
+    filter->setMaskArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_MaskName));
+    filter->setDestinationAttributeMatrix(DataArrayPath(k_DataContainerName, destinationName, ""));
+    filter->setComputeByIndex(computeByIndex);
+    filter->setUseMask(useMask);
+    filter->setFindLength(true);
+    filter->setFindMin(true);
+    filter->setFindMax(true);
+    filter->setFindMean(true);
+    filter->setFindMedian(true);
+    filter->setFindPercentiles(true);
+    filter->setPercentiles(k_Percentiles);
+    filter->setFindStdDeviation(true);
+    filter->setFindSummation(true);
+    filter->setFindHistogram(true);
+    filter->setUseFullRange(histFullRange);
+    filter->setMinRange(histMin);
+    filter->setMaxRange(histMax);
+    filter->setNumBins(k_NumBins);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName);
+    typename DataArray<T>::Pointer data = cellAttrMat->getAttributeArrayAs<DataArray<T>>(k_DataName);
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsName);
+    DataArray<bool>::Pointer mask = cellAttrMat->getAttributeArrayAs<DataArray<bool>>(k_MaskName);
+    const size_t numSlots = computeByIndex ? static_cast<size_t>(k_NumFeatures) : 1;
+    std::vector<std::vector<T>> slotValues(numSlots);
+    for(size_t i = 0; i < data->getNumberOfTuples(); i++)
+    {
+      if(useMask && !mask->getValue(i))
+      {
+        continue;
+      }
+      slotValues[computeByIndex ? featureIds->getValue(i) : 0].push_back(data->getValue(i));
+    }
+
+    AttributeMatrix::Pointer destAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(destinationName);
+    MeshIndexArrayType::Pointer length = destAttrMat->getAttributeArrayAs<MeshIndexArrayType>(filter->getLengthArrayName());
+    typename DataArray<T>::Pointer minimum = destAttrMat->getAttributeArrayAs<DataArray<T>>(filter->getMinimumArrayName());
+    typename DataArray<T>::Pointer maximum = destAttrMat->getAttributeArrayAs<DataArray<T>>(filter->getMaximumArrayName());
+    FloatArrayType::Pointer mean = destAttrMat->getAttributeArrayAs<FloatArrayType>(filter->getMeanArrayName());
+    FloatArrayType::Pointer median = destAttrMat->getAttributeArrayAs<FloatArrayType>(filter->getMedianArrayName());
+    FloatArrayType::Pointer percentiles = destAttrMat->getAttributeArrayAs<FloatArrayType>(filter->getPercentilesArrayName());
+    FloatArrayType::Pointer stdDeviation = destAttrMat->getAttributeArrayAs<FloatArrayType>(filter->getStdDeviationArrayName());
+    FloatArrayType::Pointer summation = destAttrMat->getAttributeArrayAs<FloatArrayType>(filter->getSummationArrayName());
+    FloatArrayType::Pointer histogram = destAttrMat->getAttributeArrayAs<FloatArrayType>(filter->getHistogramArrayName());
+    DREAM3D_REQUIRE_VALID_POINTER(length.get())
+    DREAM3D_REQUIRE_VALID_POINTER(minimum.get())
+    DREAM3D_REQUIRE_VALID_POINTER(maximum.get())
+    DREAM3D_REQUIRE_VALID_POINTER(mean.get())
+    DREAM3D_REQUIRE_VALID_POINTER(median.get())
+    DREAM3D_REQUIRE_VALID_POINTER(percentiles.get())
+    DREAM3D_REQUIRE_VALID_POINTER(stdDeviation.get())
+    DREAM3D_REQUIRE_VALID_POINTER(summation.get())
+    DREAM3D_REQUIRE_VALID_POINTER(histogram.get())
+    DREAM3D_REQUIRE_EQUAL(length->getNumberOfTuples(), numSlots)
+    DREAM3D_REQUIRE_EQUAL(percentiles->getNumberOfComponents(), createQuantiles().size())
+    DREAM3D_REQUIRE_EQUAL(histogram->getNumberOfComponents(), static_cast<size_t>(k_NumBins))
+
+    const std::vector<float> quantiles = createQuantiles();
+    size_t numEmpty = 0;
+    bool hasNegative = false;
+    for(size_t i = 0; i < numSlots; i++)
+    {
+      const ExpectedStatistics<T> expected = findExpectedStatistics(slotValues[i], quantiles, histFullRange, histMin, histMax);
+      const double magnitude = expected.length > 0 ? expected.sumOfMagnitudes / static_cast<double>(expected.length) : 0.0;
+      numEmpty += (expected.length == 0) ? 1 : 0;
+      hasNegative = hasNegative || (expected.length > 0 && expected.max < static_cast<T>(0));
+
+      DREAM3D_REQUIRE_EQUAL(length->getValue(i), expected.length)
+      DREAM3D_REQUIRE_EQUAL(minimum->getValue(i), expected.min)
+      DREAM3D_REQUIRE_EQUAL(maximum->getValue(i), expected.max)
+      DREAM3D_REQUIRE(isClose(summation->getValue(i), expected.sum, 1.0E-6 * expected.sumOfMagnitudes + 1.0E-6))
+      DREAM3D_REQUIRE(isClose(mean->getValue(i), expected.mean, 1.0E-5 * magnitude + 1.0E-6))
+      DREAM3D_REQUIRE(isClose(stdDeviation->getValue(i), expected.stdDeviation, 1.0E-5 * std::max(expected.stdDeviation, 1.0)))
+      DREAM3D_REQUIRE(isClose(median->getValue(i), expected.median, 1.0E-6 * std::max(std::abs(expected.median), 1.0f)))
+      for(size_t q = 0; q < quantiles.size(); q++)
+      {
+        DREAM3D_REQUIRE(isClose(percentiles->getComponent(i, q), expected.percentiles[q], 1.0E-4 * std::max(std::abs(expected.percentiles[q]), 1.0f)))
+      }
+      for(int32_t bin = 0; bin < k_NumBins; bin++)
+      {
+        DREAM3D_REQUIRE_EQUAL(histogram->getComponent(i, bin), expected.histogram[bin])
+      }
+    }
+
+    if(computeByIndex)
+    {
+      DREAM3D_REQUIRE_EQUAL(numEmpty, k_EmptyFeatures.size() + (useMask ? 1 : 0))
+      DREAM3D_REQUIRE(hasNegative)
+      DREAM3D_REQUIRED(slotValues[k_LastFeature].size(), >, 0)
+    }
+    else
+    {
+      DREAM3D_REQUIRE(numEmpty == 0)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestByIndex()
+  {
+    for(bool useMask : {false, true})
+    {
+      DREAM3D_REQUIRE_EQUAL(checkStatistics<float>(true, useMask), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(checkStatistics<int32_t>(true, useMask), EXIT_SUCCESS)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestWholeArray()
+  {
+    for(bool useMask : {false, true})
+    {
+      DREAM3D_REQUIRE_EQUAL(checkStatistics<float>(false, useMask), EXIT_SUCCESS)
+      DREAM3D_REQUIRE_EQUAL(checkStatistics<int32_t>(false, useMask), EXIT_SUCCESS)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief Splits a stream of values into uneven parts and requires that merging the accumulators of the parts gives
+   * the statistics of one accumulator over the whole stream, as the chunks of the filter do on any number of threads
+   */
+  template <typename T>
+  int checkMerge(const std::vector<T>& values)
+  {
+    StatisticsHelpers::RunningStatistics<T> whole;
+    for(T value : values)
+    {
+      whole.add(value);
+    }
+
+    for(size_t numParts : {1, 2, 3, 7, 64})
+    {
+      StatisticsHelpers::RunningStatistics<T> merged;
+      for(size_t p = 0; p < numParts; p++)
+      {
+        // Parts that grow with their index, each merged next to an empty accumulator from both sides
+        StatisticsHelpers::RunningStatistics<T> part;
+        const size_t start = values.size() * p * p / (numParts * numParts);
+        const size_t end = values.size() * (p + 1) * (p + 1) / (numParts * numParts);
+        for(size_t i = start; i < end; i++)
+        {
+          part.add(values[i]);
+        }
+        part.merge(StatisticsHelpers::RunningStatistics<T>());
+        merged.merge(StatisticsHelpers::RunningStatistics<T>());
+        merged.merge(part);
+      }
+
+      DREAM3D_REQUIRE_EQUAL(merged.getCount(), whole.getCount())
+      DREAM3D_REQUIRE_EQUAL(merged.getMin(), whole.getMin())
+      DREAM3D_REQUIRE_EQUAL(merged.getMax(), whole.getMax())
+      DREAM3D_REQUIRE(isClose(static_cast<double>(merged.getSum()), static_cast<double>(whole.getSum()), 1.0E-9 * std::abs(static_cast<double>(whole.getSum()))))
+      DREAM3D_REQUIRE(isClose(merged.getVariance(), whole.getVariance(), 1.0E-9 * whole.getVariance()))
+      if constexpr(std::is_integral_v<T>)
+      {
+        DREAM3D_REQUIRE_EQUAL(merged.getSum(), whole.getSum())
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRunningStatisticsMerge()
+  {
+    std::mt19937 generator(3);
+    std::normal_distribution<double> distribution(-250.0, 40.0);
+    const size_t count = 10000;
+    std::vector<float> floats(count);
+    std::vector<int32_t> integers(count);
+    for(size_t i = 0; i < count; i++)
+    {
+      floats[i] = static_cast<float>(distribution(generator));
+      integers[i] = static_cast<int32_t>(std::round(distribution(generator) * 1000.0));
+    }
+    DREAM3D_REQUIRE_EQUAL(checkMerge(floats), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkMerge(integers), EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### FindArrayStatisticsTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestRunningStatisticsMerge())
+    DREAM3D_REGISTER_TEST(TestByIndex())
+    DREAM3D_REGISTER_TEST(TestWholeArray())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  FindArrayStatisticsTest(const FindArrayStatisticsTest&) = delete;            // Copy Constructor Not Implemented
+  FindArrayStatisticsTest(FindArrayStatisticsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindArrayStatisticsTest& operator=(const FindArrayStatisticsTest&) = delete; // Copy Assignment Not Implemented
+  FindArrayStatisticsTest& operator=(FindArrayStatisticsTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/FindLayerStatistics.h"
+
+class FindLayerStatisticsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellAttributeMatrixName = {"CellData"};
+  const QString k_LayerAttributeMatrixName = {"LayerData"};
+  const QString k_IntensityName = {"Intensity"};
+  const QString k_CountsName = {"Counts"};
+  const QString k_Percentiles = {"0, 5, 50, 95, 100"};
+  // The X extent is not a multiple of the tiles the YZ plane is swept in
+  const std::array<size_t, 3> k_Dims = {37, 13, 20};
+  const int32_t k_NumBins = 8;
+  // On every plane the layer at the first index holds only negative values and the one at the second only zeros and
+  // negative values, so neither has a value that takes part in the statistics
+  const size_t k_NegativeLayer = 3;
+  const size_t k_EmptyLayer = 5;
+
+  /**
+   * @brief The statistics of the positive values of one layer
+   */
+  struct ExpectedLayer
+  {
+    size_t count = 0;
+    float min = 0.0f;
+    float max = 0.0f;
+    double mean = 0.0;
+    double variance = 0.0;
+    std::vector<float> percentiles;
+    std::vector<float> histogram;
+  };
+
+public:
+  FindLayerStatisticsTest() = default;
+  virtual ~FindLayerStatisticsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<float> createQuantiles()
+  {
+    std::vector<float> quantiles;
+    for(const QString& token : k_Percentiles.split(','))
+    {
+      quantiles.push_back(static_cast<float>(token.trimmed().toDouble() / 100.0));
+    }
+    return quantiles;
+  }
+
+  /**
+   * @brief Returns a random value for a voxel: negative on the negative layers, zero on the empty layers and of
+   * either sign otherwise
+   */
+  double findValue(size_t x, size_t y, size_t z, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<double> negative(-50.0, -1.0);
+    std::uniform_real_distribution<double> mixed(-20.0, 100.0);
+    if(x == k_NegativeLayer || y == k_NegativeLayer || z == k_NegativeLayer)
+    {
+      return negative(generator);
+    }
+    if(x == k_EmptyLayer || y == k_EmptyLayer || z == k_EmptyLayer)
+    {
+      return 0.0;
+    }
+    return mixed(generator);
+  }
+
+  /**
+   * @brief Creates an Image Geometry with a float and an int16 array of mixed sign
+   */
+  DataContainerArray::Pointer createDataStructure()
+  {
+    std::mt19937 generator(11);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(SizeVec3Type(k_Dims[0], k_Dims[1], k_Dims[2]));
+    image->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    dc->setGeometry(image);
+
+    const size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New({k_Dims[0], k_Dims[1], k_Dims[2]}, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+    FloatArrayType::Pointer intensity = FloatArrayType::CreateArray(totalPoints, k_IntensityName, true);
+    Int16ArrayType::Pointer counts = Int16ArrayType::CreateArray(totalPoints, k_CountsName, true);
+    cellAttrMat->addOrReplaceAttributeArray(intensity);
+    cellAttrMat->addOrReplaceAttributeArray(counts);
+
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          const size_t index = (z * k_Dims[1] + y) * k_Dims[0] + x;
+          intensity->setValue(index, static_cast<float>(findValue(x, y, z, generator)));
+          counts->setValue(index, static_cast<int16_t>(std::round(findValue(x, y, z, generator) * 20.0)));
+        }
+      }
+    }
+
+    return dca;
+  }
+
+  /**
+   * @brief Finds the statistics of the positive values of one layer with a two pass variance and a sorted copy
+   */
+  template <typename T>
+  ExpectedLayer findExpectedLayer(std::vector<T> values, const std::vector<float>& quantiles)
+  {
+    ExpectedLayer expected;
+    expected.percentiles.assign(quantiles.size(), 0.0f);
+    expected.histogram.assign(k_NumBins, 0.0f);
+    expected.count = values.size();
+    if(values.empty())
+    {
+      return expected;
+    }
+
+    std::sort(values.begin(), values.end());
+    expected.min = static_cast<float>(values.front());
+    expected.max = static_cast<float>(values.back());
+    double sum = 0.0;
+    for(T value : values)
+    {
+      sum += static_cast<double>(value);
+    }
+    expected.mean = sum / static_cast<double>(values.size());
+    double squaredSum = 0.0;
+    for(T value : values)
+    {
+      squaredSum += (static_cast<double>(value) - expected.mean) * (static_cast<double>(value) - expected.mean);
+    }
+    expected.variance = squaredSum / static_cast<double>(values.size());
+
+    for(size_t i = 0; i < quantiles.size(); i++)
+    {
+      const double rank = static_cast<double>(quantiles[i]) * static_cast<double>(values.size() - 1);
+      const size_t lowRank = static_cast<size_t>(std::floor(rank));
+      const float low = static_cast<float>(values[lowRank]);
+      const float fraction = static_cast<float>(rank - static_cast<double>(lowRank));
+      expected.percentiles[i] = (fraction == 0.0f) ? low : low + (static_cast<float>(values[lowRank + 1]) - low) * fraction;
+    }
+
+    // The bins span the range of the layer's own values and the maximum falls into the last bin
+    const double min = static_cast<double>(values.front());
+    const double range = static_cast<double>(values.back()) - min;
+    for(T value : values)
+    {
+      size_t bin = 0;
+      if(range > 0.0)
+      {
+        bin = std::min(static_cast<size_t>((static_cast<double>(value) - min) / range * k_NumBins), static_cast<size_t>(k_NumBins - 1));
+      }
+      expected.histogram[bin]++;
+    }
+
+    return expected;
+  }
+
+  // -----------------------------------------------------------------------------
+  size_t findLayer(unsigned int plane, size_t x, size_t y, size_t z)
+  {
+    return (plane == 0) ? z : ((plane == 1) ? y : x);
+  }
+
+  // -----------------------------------------------------------------------------
+  bool isClose(double value, double expected, double tolerance)
+  {
+    return std::abs(value - expected) <= tolerance;
+  }
+
+  /**
+   * @brief Gathers the values of every layer of one array by walking the whole geometry and compares the layer
+   * statistics of the filter with their statistics
+   */
+  template <typename T>
+  int checkLayers(const DataContainerArray::Pointer& dca, unsigned int plane, const QString& arrayName, const QString& prefix)
+  {
+    const size_t numLayers = k_Dims[plane == 0 ? 2 : (plane == 1 ? 1 : 0)];
+    typename DataArray<T>::Pointer data = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName)->getAttributeArrayAs<DataArray<T>>(arrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(data.get())
+    std::vector<std::vector<T>> layerValues(numLayers);
+    std::vector<bool> hasNegative(numLayers, false);
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          const T value = data->getValue((z * k_Dims[1] + y) * k_Dims[0] + x);
+          const size_t layer = findLayer(plane, x, y, z);
+          if(value > static_cast<T>(0))
+          {
+            layerValues[layer].push_back(value);
+          }
+          else if(value < static_cast<T>(0))
+          {
+            hasNegative[layer] = true;
+          }
+        }
+      }
+    }
+    // The negative and the empty layers have no value to quantify; all others do
+    DREAM3D_REQUIRE(hasNegative[k_NegativeLayer])
+    DREAM3D_REQUIRE(layerValues[k_NegativeLayer].empty())
+    DREAM3D_REQUIRE(layerValues[k_EmptyLayer].empty())
+
+    AttributeMatrix::Pointer layerAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_LayerAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(layerAttrMat.get())
+    DREAM3D_REQUIRE_EQUAL(layerAttrMat->getNumberOfTuples(), numLayers)
+    FloatArrayType::Pointer minimum = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerMin");
+    FloatArrayType::Pointer maximum = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerMax");
+    FloatArrayType::Pointer average = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerAvg");
+    FloatArrayType::Pointer stdDeviation = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerStd");
+    FloatArrayType::Pointer variance = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerVar");
+    FloatArrayType::Pointer percentiles = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerPercentiles");
+    FloatArrayType::Pointer histogram = layerAttrMat->getAttributeArrayAs<FloatArrayType>(prefix + "LayerHistogram");
+    DREAM3D_REQUIRE_VALID_POINTER(minimum.get())
+    DREAM3D_REQUIRE_VALID_POINTER(maximum.get())
+    DREAM3D_REQUIRE_VALID_POINTER(average.get())
+    DREAM3D_REQUIRE_VALID_POINTER(stdDeviation.get())
+    DREAM3D_REQUIRE_VALID_POINTER(variance.get())
+    DREAM3D_REQUIRE_VALID_POINTER(percentiles.get())
+    DREAM3D_REQUIRE_VALID_POINTER(histogram.get())
+
+    const std::vector<float> quantiles = createQuantiles();
+    for(size_t l = 0; l < numLayers; l++)
+    {
+      const ExpectedLayer expected = findExpectedLayer(layerValues[l], quantiles);
+      const double scale = std::max(static_cast<double>(expected.max), 1.0);
+      DREAM3D_REQUIRE_EQUAL(minimum->getValue(l), expected.min)
+      DREAM3D_REQUIRE_EQUAL(maximum->getValue(l), expected.max)
+      DREAM3D_REQUIRE(isClose(average->getValue(l), expected.mean, 1.0E-6 * scale))
+      DREAM3D_REQUIRE(isClose(variance->getValue(l), expected.variance, 1.0E-6 * scale * scale))
+      DREAM3D_REQUIRE(isClose(stdDeviation->getValue(l), std::sqrt(expected.variance), 1.0E-6 * scale))
+      for(size_t q = 0; q < quantiles.size(); q++)
+      {
+        DREAM3D_REQUIRE(isClose(percentiles->getComponent(l, q), expected.percentiles[q], 1.0E-6 * scale))
+      }
+      float histogramCount = 0.0f;
+      for(int32_t bin = 0; bin < k_NumBins; bin++)
+      {
+        DREAM3D_REQUIRE_EQUAL(histogram->getComponent(l, bin), expected.histogram[bin])
+        histogramCount += histogram->getComponent(l, bin);
+      }
+      DREAM3D_REQUIRE_EQUAL(histogramCount, static_cast<float>(expected.count))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * @brief Runs the filter on one plane with both arrays selected and checks the Layer Ids and the statistics of both
+   * arrays on every layer
+   */
+  int checkPlane(unsigned int plane)
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    FindLayerStatistics::Pointer filter = FindLayerStatistics::New();
+    filter->setDataContainerArray(dca);
+    filter->setSelectedArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_IntensityName));
+    filter->setAdditionalArrayPaths({DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_CountsName)});
+    filter->setPlane(plane);
+    filter->setLayerAttributeMatrixName(k_LayerAttributeMatrixName);
+    filter->setFindPercentiles(true);
+    filter->setPercentiles(k_Percentiles);
+    filter->setFindHistogram(true);
+    filter->setNumBins(k_NumBins);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    Int32ArrayType::Pointer layerIds = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(filter->getLayerIDsArrayName());
+    DREAM3D_REQUIRE_VALID_POINTER(layerIds.get())
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          DREAM3D_REQUIRE_EQUAL(layerIds->getValue((z * k_Dims[1] + y) * k_Dims[0] + x), static_cast<int32_t>(findLayer(plane, x, y, z)))
+        }
+      }
+    }
+
+    // The statistics of the additional array are prefixed with its name
+    DREAM3D_REQUIRE_EQUAL(checkLayers<float>(dca, plane, k_IntensityName, ""), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkLayers<int16_t>(dca, plane, k_CountsName, k_CountsName), EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPlanes()
+  {
+    for(unsigned int plane : {0, 1, 2})
+    {
+      DREAM3D_REQUIRE_EQUAL(checkPlane(plane), EXIT_SUCCESS)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### FindLayerStatisticsTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPlanes())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  FindLayerStatisticsTest(const FindLayerStatisticsTest&) = delete;            // Copy Constructor Not Implemented
+  FindLayerStatisticsTest(FindLayerStatisticsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindLayerStatisticsTest& operator=(const FindLayerStatisticsTest&) = delete; // Copy Assignment Not Implemented
+  FindLayerStatisticsTest& operator=(FindLayerStatisticsTest&&) = delete;      // Move Assignment Not Implemented
+};
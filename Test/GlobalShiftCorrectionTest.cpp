@@ -0,0 +1,452 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/GlobalShiftCorrection.hpp"
+
+class GlobalShiftCorrectionTest
+{
+  /**
+   * @brief The candidate shifts and scores of a stack as the AdaptiveAlignment filters pass them in
+   */
+  struct Candidates
+  {
+    std::vector<std::vector<int64_t>> newxshift;
+    std::vector<std::vector<int64_t>> newyshift;
+    std::vector<std::vector<float>> scores;
+    std::vector<float> xneedshifts;
+    std::vector<float> yneedshifts;
+  };
+
+public:
+  GlobalShiftCorrectionTest() = default;
+  virtual ~GlobalShiftCorrectionTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief Creates ranked candidates for every section pair.  With integral estimates the squared residuals are exact
+   * in any summation order, so the errors of the correction and of the reference loop can be compared exactly.
+   */
+  Candidates createCandidates(int64_t numSections, size_t numCandidates, bool trend, bool integralEstimates, std::mt19937& generator)
+  {
+    std::uniform_int_distribution<int64_t> shift(-6, 6);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    Candidates candidates;
+    candidates.newxshift.resize(numSections);
+    candidates.newyshift.resize(numSections);
+    candidates.scores.resize(numSections);
+    for(int64_t iter = 1; iter < numSections; iter++)
+    {
+      candidates.newxshift[iter].resize(numCandidates);
+      candidates.newyshift[iter].resize(numCandidates);
+      candidates.scores[iter].resize(numCandidates);
+      float score = 0.1f * unit(generator);
+      for(size_t index = 0; index < numCandidates; index++)
+      {
+        candidates.newxshift[iter][index] = shift(generator);
+        candidates.newyshift[iter][index] = shift(generator);
+        candidates.scores[iter][index] = score;
+        score += 0.05f * unit(generator);
+      }
+    }
+
+    if(trend)
+    {
+      candidates.xneedshifts.assign(1, 2.0f * unit(generator) - 1.0f);
+      candidates.yneedshifts.assign(1, 2.0f * unit(generator) - 1.0f);
+    }
+    else
+    {
+      for(int64_t iter = 1; iter < numSections; iter++)
+      {
+        const float x = static_cast<float>(shift(generator));
+        const float y = static_cast<float>(shift(generator));
+        candidates.xneedshifts.push_back(integralEstimates ? x : x + unit(generator));
+        candidates.yneedshifts.push_back(integralEstimates ? y : y + unit(generator));
+      }
+    }
+    return candidates;
+  }
+
+  // -----------------------------------------------------------------------------
+  GlobalShiftCorrection createCorrection(const Candidates& candidates, GlobalShiftCorrection::ScoreChange scoreChange)
+  {
+    GlobalShiftCorrection correction(candidates.newxshift, candidates.newyshift, candidates.scores, scoreChange);
+    if(candidates.xneedshifts.size() == 1)
+    {
+      correction.setTargetTrend(candidates.xneedshifts[0], candidates.yneedshifts[0]);
+    }
+    else
+    {
+      correction.setTargetShifts(candidates.xneedshifts, candidates.yneedshifts);
+    }
+    return correction;
+  }
+
+  /**
+   * @brief compute_error1 as the AdaptiveAlignment filters had it: the trend of the cumulative shifts with candidate
+   * index selected for pair iter, from sums divided by n
+   */
+  float computeError1(uint64_t iter, uint64_t index, float xneedtrend, float yneedtrend, const Candidates& candidates, const std::vector<uint64_t>& curindex)
+  {
+    int64_t n = curindex.size() - 1;
+    int64_t xshifts = 0;
+    int64_t yshifts = 0;
+    double sumX = 0.0;
+    double sumX_2 = 0.0;
+    double x_sumY = 0.0;
+    double x_sumXY = 0.0;
+    double y_sumY = 0.0;
+    double y_sumXY = 0.0;
+    for(int64_t i = 1; i <= n; i++)
+    {
+      const uint64_t selected = (static_cast<uint64_t>(i) == iter) ? index : curindex[i];
+      xshifts += candidates.newxshift[i][selected];
+      yshifts += candidates.newyshift[i][selected];
+      sumX += static_cast<double>(i) / static_cast<double>(n);
+      sumX_2 += static_cast<double>(i * i) / static_cast<double>(n * n);
+      x_sumY += static_cast<double>(xshifts) / static_cast<double>(n);
+      x_sumXY += static_cast<double>(i * xshifts) / static_cast<double>(n * n);
+      y_sumY += static_cast<double>(yshifts) / static_cast<double>(n);
+      y_sumXY += static_cast<double>(i * yshifts) / static_cast<double>(n * n);
+    }
+    double xtrend = (n * x_sumXY - sumX * x_sumY) / (n * sumX_2 - sumX * sumX);
+    double ytrend = (n * y_sumXY - sumX * y_sumY) / (n * sumX_2 - sumX * sumX);
+    return std::fabs(atan(xtrend) - atan(xneedtrend)) + std::fabs(atan(ytrend) - atan(yneedtrend));
+  }
+
+  /**
+   * @brief compute_error2 as the AdaptiveAlignment filters had it: the mean squared distance from the cumulative
+   * estimated shifts with candidate index selected for pair iter, accumulated in float
+   */
+  float computeError2(uint64_t iter, uint64_t index, const std::vector<float>& xshiftsest, const std::vector<float>& yshiftsest, const Candidates& candidates, const std::vector<uint64_t>& curindex)
+  {
+    uint64_t n = curindex.size() - 1;
+    int64_t xshifts = 0;
+    int64_t yshifts = 0;
+    float error = 0;
+    float divide = static_cast<float>(2 * n);
+    for(uint64_t i = 1; i <= n; i++)
+    {
+      const uint64_t selected = (i == iter) ? index : curindex[i];
+      xshifts += candidates.newxshift[i][selected];
+      yshifts += candidates.newyshift[i][selected];
+      float xdif = static_cast<float>(xshifts) - xshiftsest[i];
+      float ydif = static_cast<float>(yshifts) - yshiftsest[i];
+      error += (xdif * xdif + ydif * ydif) / divide;
+    }
+    return error;
+  }
+
+  /**
+   * @brief The error of a selection recomputed from scratch with exact sums, the form the greedy loop below needs to
+   * see the same ties as the correction
+   */
+  float findExactError(const Candidates& candidates, const std::vector<float>& xshiftsest, const std::vector<float>& yshiftsest, const std::vector<uint64_t>& selection)
+  {
+    const int64_t n = static_cast<int64_t>(selection.size()) - 1;
+    int64_t shiftX = 0;
+    int64_t shiftY = 0;
+    if(candidates.xneedshifts.size() == 1)
+    {
+      int64_t sumX = 0;
+      int64_t sumY = 0;
+      int64_t sumIX = 0;
+      int64_t sumIY = 0;
+      for(int64_t i = 1; i <= n; i++)
+      {
+        shiftX += candidates.newxshift[i][selection[i]];
+        shiftY += candidates.newyshift[i][selection[i]];
+        sumX += shiftX;
+        sumY += shiftY;
+        sumIX += i * shiftX;
+        sumIY += i * shiftY;
+      }
+      const int64_t sumI = n * (n + 1) / 2;
+      const int64_t sumISquared = n * (n + 1) * (2 * n + 1) / 6;
+      const double denominator = static_cast<double>(n) * static_cast<double>(sumISquared) - static_cast<double>(sumI) * static_cast<double>(sumI);
+      const double xtrend = (static_cast<double>(n) * static_cast<double>(sumIX) - static_cast<double>(sumI) * static_cast<double>(sumX)) / denominator;
+      const double ytrend = (static_cast<double>(n) * static_cast<double>(sumIY) - static_cast<double>(sumI) * static_cast<double>(sumY)) / denominator;
+      return static_cast<float>(std::fabs(std::atan(xtrend) - std::atan(candidates.xneedshifts[0])) + std::fabs(std::atan(ytrend) - std::atan(candidates.yneedshifts[0])));
+    }
+
+    double squaredResiduals = 0.0;
+    for(int64_t i = 1; i <= n; i++)
+    {
+      shiftX += candidates.newxshift[i][selection[i]];
+      shiftY += candidates.newyshift[i][selection[i]];
+      const double residualX = static_cast<double>(shiftX) - static_cast<double>(xshiftsest[i]);
+      const double residualY = static_cast<double>(shiftY) - static_cast<double>(yshiftsest[i]);
+      squaredResiduals += residualX * residualX + residualY * residualY;
+    }
+    return static_cast<float>(squaredResiduals / static_cast<double>(2 * n));
+  }
+
+  // -----------------------------------------------------------------------------
+  void findEstimatedShifts(const Candidates& candidates, std::vector<float>& xshiftsest, std::vector<float>& yshiftsest)
+  {
+    const size_t numSections = candidates.newxshift.size();
+    xshiftsest.assign(numSections, 0.0f);
+    yshiftsest.assign(numSections, 0.0f);
+    if(candidates.xneedshifts.size() > 1)
+    {
+      for(size_t iter = 1; iter < numSections; iter++)
+      {
+        xshiftsest[iter] = xshiftsest[iter - 1] + candidates.xneedshifts[iter - 1];
+        yshiftsest[iter] = yshiftsest[iter - 1] + candidates.yneedshifts[iter - 1];
+      }
+    }
+  }
+
+  /**
+   * @brief The correction loop the AdaptiveAlignment filters had before GlobalShiftCorrection, with every candidate
+   * error recomputed over the whole stack
+   */
+  std::vector<uint64_t> correctShiftsByLoop(const Candidates& candidates, GlobalShiftCorrection::ScoreChange scoreChange)
+  {
+    const uint64_t numSections = candidates.newxshift.size();
+    const uint64_t maxstoredshifts = candidates.newxshift[1].size();
+    const std::vector<std::vector<int64_t>>& newxshift = candidates.newxshift;
+    const std::vector<std::vector<int64_t>>& newyshift = candidates.newyshift;
+    const std::vector<std::vector<float>>& mindisorientation = candidates.scores;
+    auto scoreChangeOf = [&](uint64_t iter, uint64_t index) {
+      return (scoreChange == GlobalShiftCorrection::ScoreChange::Ratio) ? mindisorientation[iter][index] / mindisorientation[iter][0] : mindisorientation[iter][index] - mindisorientation[iter][0];
+    };
+
+    std::vector<float> xshiftsest;
+    std::vector<float> yshiftsest;
+    findEstimatedShifts(candidates, xshiftsest, yshiftsest);
+
+    std::vector<uint64_t> curindex(numSections, 0);
+    std::vector<float> changedisorientation(numSections, 0);
+    std::vector<uint64_t> changeindex(numSections, 0);
+    std::vector<float> changeerror(numSections, 0);
+    const float tolerance = (candidates.xneedshifts.size() == 1) ? 1.0f / static_cast<float>(numSections - 1) : 1.0f;
+    float curerror = findExactError(candidates, xshiftsest, yshiftsest, curindex);
+    if(curerror > tolerance)
+    {
+      float minchangedisorientation = 0;
+      float minchangeerror = 0;
+      int64_t minchangeindex = 0;
+      int64_t minchangeiter = 0;
+      float olderror = 0;
+      do
+      {
+        olderror = curerror;
+        for(uint64_t iter = 1; iter < numSections; iter++)
+        {
+          float newminerror = std::numeric_limits<float>::max();
+          float newmindisorientation = std::numeric_limits<float>::max();
+          uint64_t newminindex = 0;
+          for(uint64_t index = curindex[iter] + 1; index < maxstoredshifts; index++)
+          {
+            std::vector<uint64_t> changed = curindex;
+            changed[iter] = index;
+            const float newerror = findExactError(candidates, xshiftsest, yshiftsest, changed);
+            if(newerror < curerror && scoreChangeOf(iter, index) < newmindisorientation)
+            {
+              newminerror = newerror;
+              newminindex = index;
+              newmindisorientation = scoreChangeOf(iter, index);
+            }
+          }
+          changeerror[iter] = newminerror;
+          changeindex[iter] = newminindex;
+          changedisorientation[iter] = newmindisorientation;
+        }
+
+        minchangedisorientation = std::numeric_limits<float>::max() - 1;
+        minchangeerror = std::numeric_limits<float>::max();
+        minchangeindex = 0;
+        minchangeiter = 0;
+        for(uint64_t iter = 1; iter < numSections; iter++)
+        {
+          if(changeerror[iter] < curerror && (changedisorientation[iter] < minchangedisorientation ||
+                                              (changedisorientation[iter] == minchangedisorientation && llabs(newxshift[iter][changeindex[iter]]) + llabs(newyshift[iter][changeindex[iter]]) <
+                                                                                                            llabs(newxshift[iter][minchangeindex]) + llabs(newyshift[iter][minchangeindex]))))
+          {
+            minchangeiter = iter;
+            minchangeindex = changeindex[iter];
+            minchangedisorientation = changedisorientation[iter];
+            minchangeerror = changeerror[iter];
+          }
+        }
+
+        if(minchangeerror < curerror && minchangeerror >= tolerance)
+        {
+          curindex[minchangeiter] = minchangeindex;
+          curerror = minchangeerror;
+        }
+      } while(minchangedisorientation < std::numeric_limits<float>::max() - 1 && curerror < olderror && curerror > tolerance);
+    }
+    return curindex;
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<uint64_t> correctShifts(const Candidates& candidates, GlobalShiftCorrection::ScoreChange scoreChange)
+  {
+    GlobalShiftCorrection correction = createCorrection(candidates, scoreChange);
+    if(correction.needsCorrection())
+    {
+      while(correction.iterate())
+      {
+      }
+    }
+    return correction.getSelection();
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestCandidateErrors()
+  {
+    // The constant time update of every candidate error must match compute_error1 and compute_error2, at the first
+    // selection and at every selection the correction passes through
+    std::mt19937 generator(1);
+    for(int64_t numSections : {3, 4, 11, 60})
+    {
+      for(bool trend : {true, false})
+      {
+        const Candidates candidates = createCandidates(numSections, 20, trend, false, generator);
+        std::vector<float> xshiftsest;
+        std::vector<float> yshiftsest;
+        findEstimatedShifts(candidates, xshiftsest, yshiftsest);
+
+        GlobalShiftCorrection correction = createCorrection(candidates, GlobalShiftCorrection::ScoreChange::Difference);
+        bool improving = true;
+        while(improving)
+        {
+          const std::vector<uint64_t>& selection = correction.getSelection();
+          for(int64_t iter = 1; iter < numSections; iter++)
+          {
+            for(int64_t index = 0; index < 20; index++)
+            {
+              const float expected = trend ? computeError1(iter, index, candidates.xneedshifts[0], candidates.yneedshifts[0], candidates, selection)
+                                           : computeError2(iter, index, xshiftsest, yshiftsest, candidates, selection);
+              const float error = correction.findCandidateError(iter, index);
+              DREAM3D_REQUIRED(std::abs(error - expected), <=, 1.0e-5f * std::max(1.0f, std::abs(expected)))
+            }
+          }
+          const float expected = trend ? computeError1(1, selection[1], candidates.xneedshifts[0], candidates.yneedshifts[0], candidates, selection)
+                                       : computeError2(1, selection[1], xshiftsest, yshiftsest, candidates, selection);
+          DREAM3D_REQUIRED(std::abs(correction.getError() - expected), <=, 1.0e-5f * std::max(1.0f, std::abs(expected)))
+          improving = correction.needsCorrection() && correction.iterate();
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestAgainstLoop()
+  {
+    std::mt19937 generator(2);
+    size_t numCorrected = 0;
+    for(int64_t numSections : {3, 5, 12, 40})
+    {
+      for(bool trend : {true, false})
+      {
+        for(auto scoreChange : {GlobalShiftCorrection::ScoreChange::Difference, GlobalShiftCorrection::ScoreChange::Ratio})
+        {
+          for(int32_t repeat = 0; repeat < 5; repeat++)
+          {
+            const Candidates candidates = createCandidates(numSections, 20, trend, true, generator);
+            const std::vector<uint64_t> selection = correctShifts(candidates, scoreChange);
+            DREAM3D_REQUIRE(selection == correctShiftsByLoop(candidates, scoreChange))
+            numCorrected += std::any_of(selection.begin(), selection.end(), [](uint64_t index) { return index != 0; }) ? 1 : 0;
+          }
+        }
+      }
+    }
+    // Most stacks must actually have been corrected for the comparison to mean anything
+    DREAM3D_REQUIRED(numCorrected, >, 40)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestSinglePair()
+  {
+    // With one section pair the trend denominator n sum i^2 - (sum i)^2 is 0.  The loop got a NaN error and never
+    // corrected; the correction must not either.  The estimated shifts have no such problem.
+    std::mt19937 generator(3);
+    for(bool trend : {true, false})
+    {
+      for(int32_t repeat = 0; repeat < 20; repeat++)
+      {
+        const Candidates candidates = createCandidates(2, 20, trend, true, generator);
+        GlobalShiftCorrection correction = createCorrection(candidates, GlobalShiftCorrection::ScoreChange::Difference);
+        DREAM3D_REQUIRE(!std::isnan(correction.getError()))
+        const std::vector<uint64_t> selection = correctShifts(candidates, GlobalShiftCorrection::ScoreChange::Difference);
+        DREAM3D_REQUIRE(selection == correctShiftsByLoop(candidates, GlobalShiftCorrection::ScoreChange::Difference))
+        if(trend)
+        {
+          DREAM3D_REQUIRE(!correction.needsCorrection())
+          DREAM3D_REQUIRE_EQUAL(selection[1], 0)
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestZeroBestScore()
+  {
+    // A ratio against a best score of 0 must neither divide by zero nor select a worse candidate, while a second
+    // candidate scoring 0 as well is as good as the best and may be selected to follow the estimated shifts
+    std::mt19937 generator(4);
+    Candidates candidates = createCandidates(6, 4, false, true, generator);
+    for(size_t iter = 1; iter < candidates.scores.size(); iter++)
+    {
+      candidates.newxshift[iter] = {6, 0, 0, 0};
+      candidates.newyshift[iter] = {6, 0, 0, 0};
+      candidates.scores[iter] = {0.0f, 0.0f, 0.5f, 1.0f};
+      candidates.xneedshifts[iter - 1] = 0.0f;
+      candidates.yneedshifts[iter - 1] = 0.0f;
+    }
+    const std::vector<uint64_t> selection = correctShifts(candidates, GlobalShiftCorrection::ScoreChange::Ratio);
+    // Against a best score of 0 the differences rank the candidates as the guarded ratios do
+    DREAM3D_REQUIRE(selection == correctShiftsByLoop(candidates, GlobalShiftCorrection::ScoreChange::Difference))
+    DREAM3D_REQUIRED(std::count(selection.begin(), selection.end(), 1), >, 0)
+    for(size_t iter = 1; iter < selection.size(); iter++)
+    {
+      DREAM3D_REQUIRED(selection[iter], <=, 1)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### GlobalShiftCorrectionTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestCandidateErrors())
+    DREAM3D_REGISTER_TEST(TestAgainstLoop())
+    DREAM3D_REGISTER_TEST(TestSinglePair())
+    DREAM3D_REGISTER_TEST(TestZeroBestScore())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  GlobalShiftCorrectionTest(const GlobalShiftCorrectionTest&) = delete;            // Copy Constructor Not Implemented
+  GlobalShiftCorrectionTest(GlobalShiftCorrectionTest&&) = delete;                 // Move Constructor Not Implemented
+  GlobalShiftCorrectionTest& operator=(const GlobalShiftCorrectionTest&) = delete; // Copy Assignment Not Implemented
+  GlobalShiftCorrectionTest& operator=(GlobalShiftCorrectionTest&&) = delete;      // Move Assignment Not Implemented
+};
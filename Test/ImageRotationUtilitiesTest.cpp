@@ -0,0 +1,316 @@
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/ApplyTransformationToGeometry.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ImageRotationUtilities.hpp"
+
+class ImageRotationUtilitiesTest
+{
+public:
+  ImageRotationUtilitiesTest() = default;
+  virtual ~ImageRotationUtilitiesTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief Creates the arguments for a transformed grid of newDims Cells of newSpacing, whose minimum corner is at
+   * newMin, sampling an original geometry of dims Cells of spacing at origin
+   */
+  ImageRotationUtilities::RotateArgs createArgs(const std::array<int64_t, 3>& dims, const std::array<float, 3>& spacing, const std::array<float, 3>& origin, const std::array<int64_t, 3>& newDims,
+                                                const std::array<float, 3>& newSpacing, const std::array<float, 3>& newMin)
+  {
+    ImageRotationUtilities::RotateArgs params;
+    params.origImageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    params.origImageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    params.origImageGeom->setSpacing(FloatVec3Type(spacing[0], spacing[1], spacing[2]));
+    params.origImageGeom->setOrigin(FloatVec3Type(origin[0], origin[1], origin[2]));
+    params.xp = dims[0];
+    params.yp = dims[1];
+    params.zp = dims[2];
+    params.xRes = spacing[0];
+    params.yRes = spacing[1];
+    params.zRes = spacing[2];
+    params.xpNew = newDims[0];
+    params.ypNew = newDims[1];
+    params.zpNew = newDims[2];
+    params.xResNew = newSpacing[0];
+    params.yResNew = newSpacing[1];
+    params.zResNew = newSpacing[2];
+    params.xMinNew = newMin[0];
+    params.yMinNew = newMin[1];
+    params.zMinNew = newMin[2];
+    return params;
+  }
+
+  /**
+   * @brief Trilinear interpolation of one transformed Cell straight from its definition: the Cell center is taken
+   * back through the inverse transformation into original Cell index space, where the 8 surrounding Cell centers
+   * are blended by the products of the fractional distances along each axis, with neighbors past the edge clamped
+   * to it.  Returns false for a Cell center outside of the original geometry.  On a center within 1.0e-6 of the
+   * edge nearEdge is set, since rounding may put it on either side.  magnitudes sums the absolute weighted terms,
+   * which bounds the rounding error of the float weights.
+   */
+  template <typename T>
+  bool findExpectedValues(const ImageRotationUtilities::RotateArgs& params, const Matrix4fR& transformationMatrix, const std::vector<T>& source, size_t numComps, const std::array<int64_t, 3>& cell,
+                          std::vector<double>& values, std::vector<double>& magnitudes, bool& nearEdge)
+  {
+    const std::array<int64_t, 3> dims = {params.xp, params.yp, params.zp};
+    const std::array<double, 3> spacing = {params.xRes, params.yRes, params.zRes};
+    const std::array<double, 3> newSpacing = {params.xResNew, params.yResNew, params.zResNew};
+    const std::array<double, 3> newMin = {params.xMinNew, params.yMinNew, params.zMinNew};
+    const FloatVec3Type origin = params.origImageGeom->getOrigin();
+
+    Eigen::Vector4d coords(0.0, 0.0, 0.0, 1.0);
+    for(size_t d = 0; d < 3; d++)
+    {
+      coords[d] = newMin[d] + (static_cast<double>(cell[d]) + 0.5) * newSpacing[d];
+    }
+    const Eigen::Vector4d sourceCoords = transformationMatrix.cast<double>().inverse() * coords;
+
+    nearEdge = false;
+    std::array<int64_t, 3> base = {0, 0, 0};
+    std::array<double, 3> fraction = {0.0, 0.0, 0.0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      const double index = (sourceCoords[d] - origin[d]) / spacing[d] - 0.5;
+      nearEdge = nearEdge || std::abs(index + 0.5) < 1.0e-6 || std::abs(index - (static_cast<double>(dims[d]) - 0.5)) < 1.0e-6;
+      if(index < -0.5 || index >= static_cast<double>(dims[d]) - 0.5)
+      {
+        return false;
+      }
+      base[d] = static_cast<int64_t>(std::floor(index));
+      fraction[d] = index - std::floor(index);
+    }
+
+    values.assign(numComps, 0.0);
+    magnitudes.assign(numComps, 0.0);
+    for(int64_t corner = 0; corner < 8; corner++)
+    {
+      double weight = 1.0;
+      int64_t tuple = 0;
+      int64_t stride = 1;
+      for(size_t d = 0; d < 3; d++)
+      {
+        const int64_t upper = (corner >> d) & 1;
+        weight *= (upper == 1) ? fraction[d] : 1.0 - fraction[d];
+        tuple += std::min(std::max(base[d] + upper, int64_t(0)), dims[d] - 1) * stride;
+        stride *= dims[d];
+      }
+      for(size_t c = 0; c < numComps; c++)
+      {
+        values[c] += weight * static_cast<double>(source[tuple * numComps + c]);
+        magnitudes[c] += std::abs(weight * static_cast<double>(source[tuple * numComps + c]));
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Transforms the source values with the resampler and requires every transformed Cell to match the per
+   * Cell reference: zero outside of the original geometry, the interpolated value rounded to the nearest integer
+   * for integer arrays, and the interpolated value to float precision otherwise.  Cells whose centers fall on the
+   * edge of the original geometry are only checked if exactEdges is set.
+   */
+  template <typename T>
+  void checkAgainstReference(ImageRotationUtilities::RotateArgs& params, Matrix4fR& transformationMatrix, const std::vector<T>& source, size_t numComps, bool exactEdges)
+  {
+    using DataArrayType = DataArray<T>;
+    const std::vector<size_t> cDims = {numComps};
+    const size_t numTuples = static_cast<size_t>(params.xp * params.yp * params.zp);
+    const size_t newNumTuples = static_cast<size_t>(params.xpNew * params.ypNew * params.zpNew);
+
+    typename DataArrayType::Pointer sourceArray = DataArrayType::CreateArray(numTuples, cDims, "Source", true);
+    std::copy(source.begin(), source.end(), sourceArray->getPointer(0));
+    typename DataArrayType::Pointer targetArray = DataArrayType::CreateArray(newNumTuples, cDims, "Target", true);
+    // The resampler must write every transformed Cell, including the zero filled ones
+    std::fill(targetArray->getPointer(0), targetArray->getPointer(0) + newNumTuples * numComps, static_cast<T>(1));
+
+    ApplyTransformationToGeometry::Pointer filter = ApplyTransformationToGeometry::New();
+    IDataArray::Pointer sourcePtr = sourceArray;
+    IDataArray::Pointer targetPtr = targetArray;
+    ImageRotationUtilities::RotateImageGeometryWithTrilinearInterpolation<T, ApplyTransformationToGeometry> resample(filter.get(), sourcePtr, targetPtr, params, transformationMatrix);
+    resample();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    std::vector<double> values;
+    std::vector<double> magnitudes;
+    size_t numValid = 0;
+    size_t numInvalid = 0;
+    for(int64_t k = 0; k < params.zpNew; k++)
+    {
+      for(int64_t j = 0; j < params.ypNew; j++)
+      {
+        for(int64_t i = 0; i < params.xpNew; i++)
+        {
+          bool nearEdge = false;
+          const bool valid = findExpectedValues(params, transformationMatrix, source, numComps, {i, j, k}, values, magnitudes, nearEdge);
+          if(nearEdge && !exactEdges)
+          {
+            continue;
+          }
+          const size_t tuple = static_cast<size_t>((k * params.ypNew + j) * params.xpNew + i);
+          for(size_t c = 0; c < numComps; c++)
+          {
+            const double value = static_cast<double>(targetArray->getValue(tuple * numComps + c));
+            if(!valid)
+            {
+              DREAM3D_REQUIRE_EQUAL(value, 0.0)
+              continue;
+            }
+            // Integers must be rounded, not truncated; the rest is the float precision of the weights
+            const double tolerance = (std::is_integral<T>::value ? 0.5 : 0.0) + 1.0e-6 * std::max(1.0, magnitudes[c]);
+            DREAM3D_REQUIRED(std::abs(value - values[c]), <=, tolerance)
+          }
+          numValid += valid ? 1 : 0;
+          numInvalid += valid ? 0 : 1;
+        }
+      }
+    }
+    // Both kinds of Cells must have been checked
+    DREAM3D_REQUIRED(numValid, >, 0)
+    DREAM3D_REQUIRED(numInvalid, >, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  std::vector<T> createValues(size_t count, double low, double high, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<double> distribution(low, high);
+    std::vector<T> values(count);
+    for(auto&& value : values)
+    {
+      value = static_cast<T>(distribution(generator));
+    }
+    return values;
+  }
+
+  /**
+   * @brief A transformation that rotates about an oblique axis through center and then translates
+   */
+  Matrix4fR createTransformation(const Eigen::Vector3f& center, const Eigen::Vector3f& axis, float angle, const Eigen::Vector3f& translation)
+  {
+    Eigen::Affine3f transform = Eigen::Translation3f(translation + center) * Eigen::AngleAxisf(angle, axis.normalized()) * Eigen::Translation3f(-center);
+    Matrix4fR transformationMatrix = transform.matrix();
+    return transformationMatrix;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestValidityEdges()
+  {
+    // Without a transformation, a grid of half the spacing whose second Cell center sits on the minimum corner of
+    // the original geometry puts Cell centers exactly on the -0.5 and dim - 0.5 edges of the original Cell index
+    // space.  The spacings are powers of two, so the indices are exact.
+    const std::array<int64_t, 3> dims = {7, 5, 4};
+    const std::array<float, 3> spacing = {1.0f, 2.0f, 0.5f};
+    const std::array<float, 3> origin = {1.0f, -2.0f, 0.5f};
+    const std::array<int64_t, 3> newDims = {2 * dims[0] + 2, 2 * dims[1] + 2, 2 * dims[2] + 2};
+    const std::array<float, 3> newSpacing = {0.5f * spacing[0], 0.5f * spacing[1], 0.5f * spacing[2]};
+    const std::array<float, 3> newMin = {origin[0] - 1.5f * newSpacing[0], origin[1] - 1.5f * newSpacing[1], origin[2] - 1.5f * newSpacing[2]};
+    ImageRotationUtilities::RotateArgs params = createArgs(dims, spacing, origin, newDims, newSpacing, newMin);
+    Matrix4fR identity = Matrix4fR::Identity();
+
+    std::mt19937 generator(1);
+    const size_t numTuples = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    const std::vector<float> values = createValues<float>(3 * numTuples, 1.0, 2.0, generator);
+    checkAgainstReference(params, identity, values, 3, true);
+    checkAgainstReference(params, identity, createValues<uint8_t>(numTuples, 0.0, 255.0, generator), 1, true);
+
+    // The first Cell lies before the -0.5 edge and the last on the dim - 0.5 edge, so both are zero filled, while
+    // the second sits on the -0.5 edge and takes the value of the first original Cell
+    using DataArrayType = DataArray<float>;
+    DataArrayType::Pointer sourceArray = DataArrayType::CreateArray(numTuples, std::vector<size_t>(1, 3), "Source", true);
+    std::copy(values.begin(), values.end(), sourceArray->getPointer(0));
+    DataArrayType::Pointer targetArray = DataArrayType::CreateArray(static_cast<size_t>(newDims[0] * newDims[1] * newDims[2]), std::vector<size_t>(1, 3), "Target", true);
+    ApplyTransformationToGeometry::Pointer filter = ApplyTransformationToGeometry::New();
+    IDataArray::Pointer sourcePtr = sourceArray;
+    IDataArray::Pointer targetPtr = targetArray;
+    ImageRotationUtilities::RotateImageGeometryWithTrilinearInterpolation<float, ApplyTransformationToGeometry> resample(filter.get(), sourcePtr, targetPtr, params, identity);
+    resample();
+    const size_t second = static_cast<size_t>((1 * newDims[1] + 1) * newDims[0] + 1);
+    const size_t last = static_cast<size_t>((1 * newDims[1] + 1) * newDims[0] + newDims[0] - 1);
+    for(size_t c = 0; c < 3; c++)
+    {
+      DREAM3D_REQUIRE_EQUAL(targetArray->getValue(c), 0.0f)
+      DREAM3D_REQUIRED(std::abs(targetArray->getValue(second * 3 + c) - values[c]), <=, 1.0e-6f)
+      DREAM3D_REQUIRE_EQUAL(targetArray->getValue(last * 3 + c), 0.0f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRotated()
+  {
+    // An anisotropic original geometry, rotated and shifted so that part of the transformed grid falls outside of
+    // it.  The transformed grid spans more than one tile in X and Y and more than one slab in Z.
+    const std::array<int64_t, 3> dims = {30, 12, 25};
+    const std::array<float, 3> spacing = {1.0f, 2.5f, 0.4f};
+    const std::array<float, 3> origin = {0.0f, 0.0f, 0.0f};
+    const std::array<int64_t, 3> newDims = {70, 20, 12};
+    const std::array<float, 3> newSpacing = {0.75f, 2.0f, 1.2f};
+    const std::array<float, 3> newMin = {-5.0f, -5.0f, -2.0f};
+    ImageRotationUtilities::RotateArgs params = createArgs(dims, spacing, origin, newDims, newSpacing, newMin);
+    Matrix4fR transformationMatrix = createTransformation({15.0f, 15.0f, 5.0f}, {0.3f, -0.2f, 1.0f}, 0.6f, {1.5f, -0.7f, 0.3f});
+    DREAM3D_REQUIRED(newDims[0], >, ImageRotationUtilities::TrilinearResampleImpl<float>::k_TileX)
+    DREAM3D_REQUIRED(newDims[1], >, ImageRotationUtilities::TrilinearResampleImpl<float>::k_TileY)
+    DREAM3D_REQUIRED(newDims[2], >, ImageRotationUtilities::TrilinearResampleImpl<float>::k_TileZ)
+
+    std::mt19937 generator(2);
+    const size_t numTuples = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    checkAgainstReference(params, transformationMatrix, createValues<float>(numTuples, -100.0, 100.0, generator), 1, false);
+    checkAgainstReference(params, transformationMatrix, createValues<float>(4 * numTuples, -1.0, 1.0, generator), 4, false);
+    checkAgainstReference(params, transformationMatrix, createValues<double>(2 * numTuples, -1.0e3, 1.0e3, generator), 2, false);
+    checkAgainstReference(params, transformationMatrix, createValues<int16_t>(numTuples, -30000.0, 30000.0, generator), 1, false);
+
+    // Neighbors alternating between 0 and 255 make every difference between them wrap in uint8_t
+    std::vector<uint8_t> checkerboard(3 * numTuples);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      const int64_t x = static_cast<int64_t>(i) % dims[0];
+      const int64_t y = (static_cast<int64_t>(i) / dims[0]) % dims[1];
+      const int64_t z = static_cast<int64_t>(i) / (dims[0] * dims[1]);
+      const uint8_t value = ((x + y + z) % 2 == 0) ? 255 : 0;
+      checkerboard[3 * i] = value;
+      checkerboard[3 * i + 1] = 255 - value;
+      checkerboard[3 * i + 2] = static_cast<uint8_t>(value == 0 ? 1 : 254);
+    }
+    checkAgainstReference(params, transformationMatrix, checkerboard, 3, false);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### ImageRotationUtilitiesTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestValidityEdges())
+    DREAM3D_REGISTER_TEST(TestRotated())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  ImageRotationUtilitiesTest(const ImageRotationUtilitiesTest&) = delete;            // Copy Constructor Not Implemented
+  ImageRotationUtilitiesTest(ImageRotationUtilitiesTest&&) = delete;                 // Move Constructor Not Implemented
+  ImageRotationUtilitiesTest& operator=(const ImageRotationUtilitiesTest&) = delete; // Copy Assignment Not Implemented
+  ImageRotationUtilitiesTest& operator=(ImageRotationUtilitiesTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/JointHistogram.hpp"
+
+class JointHistogramTest
+{
+public:
+  JointHistogramTest() = default;
+  virtual ~JointHistogramTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief The mutual information from the full joint and marginal count tables, sum p(a, b) log(p(a, b) / (p(a) p(b)))
+   * with every probability taken as a count divided by the normalizer
+   */
+  double findNaiveMutualInformation(const std::vector<std::vector<double>>& joint, double normalizer)
+  {
+    std::vector<double> countsA(joint.size(), 0.0);
+    std::vector<double> countsB(joint.empty() ? 0 : joint[0].size(), 0.0);
+    for(size_t a = 0; a < joint.size(); a++)
+    {
+      for(size_t b = 0; b < joint[a].size(); b++)
+      {
+        countsA[a] += joint[a][b];
+        countsB[b] += joint[a][b];
+      }
+    }
+    double mutualInformation = 0.0;
+    for(size_t a = 0; a < joint.size(); a++)
+    {
+      for(size_t b = 0; b < joint[a].size(); b++)
+      {
+        if(joint[a][b] > 0.0)
+        {
+          const double p = joint[a][b] / normalizer;
+          const double pa = countsA[a] / normalizer;
+          const double pb = countsB[b] / normalizer;
+          mutualInformation += p * std::log(p / (pa * pb));
+        }
+      }
+    }
+    return mutualInformation;
+  }
+
+  /**
+   * @brief Adds random pairs to the histogram and to a nested count table and compares the two mutual informations.
+   * The labels are drawn from labelsA and labelsB, and the table is indexed by the position of a label in them, which
+   * leaves the mutual information unchanged.  Every backgroundEvery'th pair is a (0, 0) background pair, which is
+   * counted but left out of the normalizer, as the filter does for samples outside the shifted section.
+   */
+  void checkAgainstNaive(JointHistogram& histogram, const std::vector<int32_t>& labelsA, const std::vector<int32_t>& labelsB, size_t numPairs, size_t backgroundEvery, double correlation,
+                         std::mt19937& generator)
+  {
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::uniform_int_distribution<size_t> pickA(0, labelsA.size() - 1);
+    std::uniform_int_distribution<size_t> pickB(0, labelsB.size() - 1);
+
+    std::vector<std::vector<double>> joint(labelsA.size(), std::vector<double>(labelsB.size(), 0.0));
+    size_t count = 0;
+    for(size_t i = 0; i < numPairs; i++)
+    {
+      size_t a = 0;
+      size_t b = 0;
+      if(backgroundEvery == 0 || i % backgroundEvery != 0)
+      {
+        a = pickA(generator);
+        // Correlated pairs give the mutual information something to measure
+        b = (distribution(generator) < correlation) ? a % labelsB.size() : pickB(generator);
+        count++;
+      }
+      histogram.add(labelsA[a], labelsB[b]);
+      joint[a][b]++;
+    }
+
+    const double expected = findNaiveMutualInformation(joint, static_cast<double>(count));
+    const double result = histogram.findMutualInformation(static_cast<double>(count));
+    DREAM3D_REQUIRED(std::abs(result - expected), <=, 1.0e-9 * std::max(1.0, std::abs(expected)))
+    histogram.clear();
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> createLabels(int32_t numLabels)
+  {
+    std::vector<int32_t> labels(static_cast<size_t>(numLabels));
+    for(int32_t i = 0; i < numLabels; i++)
+    {
+      labels[i] = i;
+    }
+    return labels;
+  }
+
+  /**
+   * @brief Returns count distinct labels in [1, numLabels) in random order, with label 0 first so that the background
+   * pair has an index
+   */
+  std::vector<int32_t> createSparseLabels(int32_t numLabels, size_t count, std::mt19937& generator)
+  {
+    std::vector<int32_t> labels = createLabels(numLabels);
+    std::shuffle(labels.begin() + 1, labels.end(), generator);
+    labels.resize(count);
+    return labels;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestDense()
+  {
+    std::mt19937 generator(1);
+    JointHistogram histogram;
+    for(int32_t numLabels : {1, 2, 17, 300})
+    {
+      histogram.resize(numLabels, numLabels + 5);
+      const std::vector<int32_t> labelsA = createLabels(numLabels);
+      const std::vector<int32_t> labelsB = createLabels(numLabels + 5);
+      for(double correlation : {0.0, 0.5, 1.0})
+      {
+        // The histogram is cleared and reused between the checks, as the filter reuses it between shifts
+        checkAgainstNaive(histogram, labelsA, labelsB, 2000, 0, correlation, generator);
+        checkAgainstNaive(histogram, labelsA, labelsB, 2000, 7, correlation, generator);
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestBackgroundOnly()
+  {
+    // Samples that all fall outside the section leave nothing to normalize by
+    JointHistogram histogram;
+    histogram.resize(4, 4);
+    for(size_t i = 0; i < 10; i++)
+    {
+      histogram.add(0, 0);
+    }
+    DREAM3D_REQUIRE_EQUAL(histogram.findMutualInformation(0.0), 0.0)
+    histogram.clear();
+    DREAM3D_REQUIRE_EQUAL(histogram.findMutualInformation(1.0), 0.0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestSortedFallback()
+  {
+    std::mt19937 generator(2);
+    JointHistogram histogram;
+    // 4200 * 4100 bins exceed k_MaxDenseBins, so the pairs are counted by sorting
+    const int32_t numLabelsA = 4200;
+    const int32_t numLabelsB = 4100;
+    DREAM3D_REQUIRED(static_cast<size_t>(numLabelsA) * static_cast<size_t>(numLabelsB), >, JointHistogram::k_MaxDenseBins)
+    histogram.resize(numLabelsA, numLabelsB);
+    for(size_t count : {2, 40, 400})
+    {
+      const std::vector<int32_t> labelsA = createSparseLabels(numLabelsA, count, generator);
+      const std::vector<int32_t> labelsB = createSparseLabels(numLabelsB, count, generator);
+      for(double correlation : {0.0, 0.5, 1.0})
+      {
+        checkAgainstNaive(histogram, labelsA, labelsB, 5000, 0, correlation, generator);
+        checkAgainstNaive(histogram, labelsA, labelsB, 5000, 5, correlation, generator);
+      }
+    }
+
+    // Back to the dense table after the fallback
+    histogram.resize(50, 60);
+    checkAgainstNaive(histogram, createLabels(50), createLabels(60), 3000, 3, 0.5, generator);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### JointHistogramTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestDense())
+    DREAM3D_REGISTER_TEST(TestBackgroundOnly())
+    DREAM3D_REGISTER_TEST(TestSortedFallback())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  JointHistogramTest(const JointHistogramTest&) = delete;            // Copy Constructor Not Implemented
+  JointHistogramTest(JointHistogramTest&&) = delete;                 // Move Constructor Not Implemented
+  JointHistogramTest& operator=(const JointHistogramTest&) = delete; // Copy Assignment Not Implemented
+  JointHistogramTest& operator=(JointHistogramTest&&) = delete;      // Move Assignment Not Implemented
+};
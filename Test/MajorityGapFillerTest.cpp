@@ -0,0 +1,187 @@
+#include <array>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/MajorityGapFiller.hpp"
+
+class MajorityGapFillerTest
+{
+public:
+  MajorityGapFillerTest() = default;
+  virtual ~MajorityGapFillerTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief The whole-volume sweep that assign_gaps_only used before the frontier filler: every sweep gives each gap
+   * voxel the first of its most common Feature face neighbors, and the assignments are written after the sweep.
+   * Stops when a sweep leaves the gap count unchanged.
+   */
+  void sweepFill(const std::array<int64_t, 3>& dims, std::vector<int32_t>& featureIds, std::vector<int32_t>& cellPhases, const std::vector<int32_t>& featurePhases)
+  {
+    const int64_t xPoints = dims[0];
+    const int64_t yPoints = dims[1];
+    const int64_t zPoints = dims[2];
+    const int64_t totalPoints = xPoints * yPoints * zPoints;
+    const std::array<int64_t, 6> neighpoints = {-xPoints * yPoints, -xPoints, -1, 1, xPoints, xPoints * yPoints};
+
+    std::vector<int64_t> neighbors(totalPoints, -1);
+    std::vector<int32_t> n(featurePhases.size(), 0);
+    int64_t gapVoxelCount = 1;
+    int64_t previousGapVoxelCount = 0;
+    while(gapVoxelCount != 0 && gapVoxelCount != previousGapVoxelCount)
+    {
+      previousGapVoxelCount = gapVoxelCount;
+      gapVoxelCount = 0;
+      for(int64_t i = 0; i < zPoints; i++)
+      {
+        for(int64_t j = 0; j < yPoints; j++)
+        {
+          for(int64_t k = 0; k < xPoints; k++)
+          {
+            const int64_t point = (i * yPoints + j) * xPoints + k;
+            if(featureIds[point] >= 0)
+            {
+              continue;
+            }
+            gapVoxelCount++;
+            const std::array<bool, 6> good = {i > 0, j > 0, k > 0, k < xPoints - 1, j < yPoints - 1, i < zPoints - 1};
+            int32_t most = 0;
+            for(int32_t l = 0; l < 6; l++)
+            {
+              const int32_t feature = good[l] ? featureIds[point + neighpoints[l]] : 0;
+              if(feature > 0)
+              {
+                n[feature]++;
+                if(n[feature] > most)
+                {
+                  most = n[feature];
+                  neighbors[point] = point + neighpoints[l];
+                }
+              }
+            }
+            for(int32_t l = 0; l < 6; l++)
+            {
+              const int32_t feature = good[l] ? featureIds[point + neighpoints[l]] : 0;
+              if(feature > 0)
+              {
+                n[feature] = 0;
+              }
+            }
+          }
+        }
+      }
+      for(int64_t j = 0; j < totalPoints; j++)
+      {
+        const int64_t neighbor = neighbors[j];
+        if(featureIds[j] < 0 && neighbor != -1 && featureIds[neighbor] > 0)
+        {
+          featureIds[j] = featureIds[neighbor];
+          cellPhases[j] = featurePhases[featureIds[neighbor]];
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Fills a random volume with both fillers and requires identical Feature Ids and phases.  Feature Id 0
+   * voxels are neither gaps nor Features, so dense enough zeros wall off gaps that can never be filled.
+   */
+  void checkAgainstSweep(const std::array<int64_t, 3>& dims, int32_t numFeatures, double featureFraction, double zeroFraction, uint32_t seed)
+  {
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    std::uniform_int_distribution<int32_t> featureDistribution(1, numFeatures);
+
+    std::vector<int32_t> featurePhases(numFeatures + 1, 0);
+    for(int32_t i = 1; i <= numFeatures; i++)
+    {
+      featurePhases[i] = 1 + i % 3;
+    }
+
+    std::vector<int32_t> featureIds(totalPoints, -1);
+    for(auto&& featureId : featureIds)
+    {
+      double value = distribution(generator);
+      if(value < featureFraction)
+      {
+        featureId = featureDistribution(generator);
+      }
+      else if(value < featureFraction + zeroFraction)
+      {
+        featureId = 0;
+      }
+    }
+    std::vector<int32_t> cellPhases(totalPoints, 0);
+
+    std::vector<int32_t> expectedIds = featureIds;
+    std::vector<int32_t> expectedPhases = cellPhases;
+    sweepFill(dims, expectedIds, expectedPhases, featurePhases);
+
+    MajorityGapFiller gapFiller(dims, featureIds.data());
+    size_t numLayers = 0;
+    while(gapFiller.fillNextLayer(cellPhases.data(), featurePhases.data()))
+    {
+      numLayers++;
+      DREAM3D_REQUIRED(numLayers, <=, static_cast<size_t>(totalPoints))
+    }
+    DREAM3D_REQUIRE_EQUAL(gapFiller.getFrontierSize(), 0)
+
+    size_t remainingGaps = 0;
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds[i], expectedIds[i])
+      DREAM3D_REQUIRE_EQUAL(cellPhases[i], expectedPhases[i])
+      remainingGaps += (featureIds[i] < 0) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(gapFiller.getRemainingGaps(), remainingGaps)
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRandomVolumes()
+  {
+    checkAgainstSweep({20, 17, 13}, 40, 0.05, 0.0, 1);
+    checkAgainstSweep({20, 17, 13}, 5, 0.3, 0.0, 2);
+    checkAgainstSweep({31, 29, 1}, 12, 0.02, 0.0, 3);
+    checkAgainstSweep({1, 1, 50}, 3, 0.1, 0.0, 4);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestUnreachableGaps()
+  {
+    checkAgainstSweep({16, 16, 16}, 10, 0.02, 0.45, 5);
+    checkAgainstSweep({16, 16, 16}, 10, 0.0, 0.2, 6);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### MajorityGapFillerTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestRandomVolumes())
+    DREAM3D_REGISTER_TEST(TestUnreachableGaps())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  MajorityGapFillerTest(const MajorityGapFillerTest&) = delete;            // Copy Constructor Not Implemented
+  MajorityGapFillerTest(MajorityGapFillerTest&&) = delete;                 // Move Constructor Not Implemented
+  MajorityGapFillerTest& operator=(const MajorityGapFillerTest&) = delete; // Copy Assignment Not Implemented
+  MajorityGapFillerTest& operator=(MajorityGapFillerTest&&) = delete;      // Move Assignment Not Implemented
+};
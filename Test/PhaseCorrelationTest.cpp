@@ -0,0 +1,153 @@
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/PhaseCorrelation.hpp"
+
+class PhaseCorrelationTest
+{
+public:
+  PhaseCorrelationTest() = default;
+  virtual ~PhaseCorrelationTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief Creates a grain map like image: every pixel takes the random intensity of its nearest seed
+   */
+  std::vector<float> createCanvas(int64_t dimX, int64_t dimY, size_t numSeeds, uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<std::array<float, 3>> seeds(numSeeds);
+    for(auto&& s : seeds)
+    {
+      s = {dimX * distribution(generator), dimY * distribution(generator), distribution(generator)};
+    }
+
+    std::vector<float> canvas(static_cast<size_t>(dimX * dimY), 0.0f);
+    for(int64_t y = 0; y < dimY; y++)
+    {
+      for(int64_t x = 0; x < dimX; x++)
+      {
+        float nearest = std::numeric_limits<float>::max();
+        for(const auto& s : seeds)
+        {
+          const float distance = (x - s[0]) * (x - s[0]) + (y - s[1]) * (y - s[1]);
+          if(distance < nearest)
+          {
+            nearest = distance;
+            canvas[y * dimX + x] = s[2];
+          }
+        }
+      }
+    }
+    return canvas;
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<float> cropCanvas(const std::vector<float>& canvas, int64_t canvasDimX, int64_t originX, int64_t originY, int64_t dimX, int64_t dimY)
+  {
+    std::vector<float> image(static_cast<size_t>(dimX * dimY), 0.0f);
+    for(int64_t y = 0; y < dimY; y++)
+    {
+      for(int64_t x = 0; x < dimX; x++)
+      {
+        image[y * dimX + x] = canvas[(y + originY) * canvasDimX + (x + originX)];
+      }
+    }
+    return image;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestKnownShift()
+  {
+    constexpr int64_t k_Margin = 10;
+    for(const auto& dims : std::vector<std::array<int64_t, 2>>{{64, 64}, {50, 37}, {41, 90}})
+    {
+      const int64_t canvasDimX = dims[0] + 2 * k_Margin;
+      const int64_t canvasDimY = dims[1] + 2 * k_Margin;
+      const std::vector<float> canvas = createCanvas(canvasDimX, canvasDimY, static_cast<size_t>(canvasDimX * canvasDimY / 60), static_cast<uint32_t>(dims[0]));
+
+      PhaseCorrelation phaseCorrelation(dims[0], dims[1]);
+      PhaseCorrelation::SpectrumType reference;
+      PhaseCorrelation::SpectrumType moving;
+      phaseCorrelation.transform(cropCanvas(canvas, canvasDimX, k_Margin, k_Margin, dims[0], dims[1]).data(), reference);
+      for(const auto& shift : std::vector<std::array<int64_t, 2>>{{0, 0}, {3, 0}, {0, -4}, {7, -2}, {-9, 5}, {-1, -10}})
+      {
+        // moving(p + shift) = reference(p)
+        phaseCorrelation.transform(cropCanvas(canvas, canvasDimX, k_Margin - shift[0], k_Margin - shift[1], dims[0], dims[1]).data(), moving);
+        std::vector<PhaseCorrelation::Peak> peaks = phaseCorrelation.findPeaks(reference, moving, 3, dims[0] / 2 - 1, dims[1] / 2 - 1);
+        DREAM3D_REQUIRE_EQUAL(peaks.size(), 3)
+        DREAM3D_REQUIRE_EQUAL(peaks[0].x, shift[0])
+        DREAM3D_REQUIRE_EQUAL(peaks[0].y, shift[1])
+        // The filters round the sub-pixel peak to whole Cells
+        DREAM3D_REQUIRE_EQUAL(std::lround(peaks[0].subX), shift[0])
+        DREAM3D_REQUIRE_EQUAL(std::lround(peaks[0].subY), shift[1])
+        DREAM3D_REQUIRED(peaks[0].value, >=, peaks[1].value)
+        DREAM3D_REQUIRED(peaks[1].value, >=, peaks[2].value)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMaxShift()
+  {
+    // A shift outside the search window must not be reported
+    const int64_t dimX = 48;
+    const int64_t dimY = 48;
+    const int64_t margin = 12;
+    const std::vector<float> canvas = createCanvas(dimX + 2 * margin, dimY + 2 * margin, 80, 7);
+
+    PhaseCorrelation phaseCorrelation(dimX, dimY);
+    PhaseCorrelation::SpectrumType reference;
+    PhaseCorrelation::SpectrumType moving;
+    phaseCorrelation.transform(cropCanvas(canvas, dimX + 2 * margin, margin, margin, dimX, dimY).data(), reference);
+    phaseCorrelation.transform(cropCanvas(canvas, dimX + 2 * margin, margin - 8, margin - 1, dimX, dimY).data(), moving);
+
+    std::vector<PhaseCorrelation::Peak> peaks = phaseCorrelation.findPeaks(reference, moving, 1, 20, 20);
+    DREAM3D_REQUIRE_EQUAL(peaks[0].x, 8)
+    DREAM3D_REQUIRE_EQUAL(peaks[0].y, 1)
+
+    peaks = phaseCorrelation.findPeaks(reference, moving, 5, 4, 4);
+    DREAM3D_REQUIRE_EQUAL(peaks.size(), 5)
+    for(const PhaseCorrelation::Peak& peak : peaks)
+    {
+      DREAM3D_REQUIRED(std::abs(peak.x), <=, 4)
+      DREAM3D_REQUIRED(std::abs(peak.y), <=, 4)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### PhaseCorrelationTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestKnownShift())
+    DREAM3D_REGISTER_TEST(TestMaxShift())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  PhaseCorrelationTest(const PhaseCorrelationTest&) = delete;            // Copy Constructor Not Implemented
+  PhaseCorrelationTest(PhaseCorrelationTest&&) = delete;                 // Move Constructor Not Implemented
+  PhaseCorrelationTest& operator=(const PhaseCorrelationTest&) = delete; // Copy Assignment Not Implemented
+  PhaseCorrelationTest& operator=(PhaseCorrelationTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/QuantileSketch.hpp"
+
+class QuantileSketchTest
+{
+public:
+  QuantileSketchTest() = default;
+  virtual ~QuantileSketchTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<float> createQuantiles()
+  {
+    std::vector<float> quantiles;
+    for(int32_t i = 0; i <= 100; i++)
+    {
+      quantiles.push_back(0.01f * static_cast<float>(i));
+    }
+    return quantiles;
+  }
+
+  /**
+   * @brief Returns how far, as a fraction of the count, the reported value of a quantile is from the rank the
+   * quantile asks for.  A value that is not in the data (an interpolated one) lies between two ranks and counts as
+   * either of them.
+   */
+  double findRankError(const std::vector<float>& sorted, float quantile, float value)
+  {
+    const double count = static_cast<double>(sorted.size());
+    const double target = static_cast<double>(quantile) * (count - 1.0);
+    double low = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+    double high = static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin()) - 1.0;
+    if(high < low)
+    {
+      std::swap(low, high);
+    }
+    if(target < low)
+    {
+      return (low - target) / count;
+    }
+    if(target > high)
+    {
+      return (target - high) / count;
+    }
+    return 0.0;
+  }
+
+  // -----------------------------------------------------------------------------
+  std::vector<float> createValues(size_t count, int32_t order, uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> values(count);
+    for(size_t i = 0; i < count; i++)
+    {
+      switch(order)
+      {
+      case 0:
+        values[i] = distribution(generator);
+        break;
+      case 1:
+        values[i] = static_cast<float>(i);
+        break;
+      case 2:
+        values[i] = static_cast<float>(count - i);
+        break;
+      default:
+        // Many ties
+        values[i] = std::floor(50.0f * distribution(generator));
+        break;
+      }
+    }
+    return values;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestExactBelowCapacity()
+  {
+    const std::vector<float> quantiles = createQuantiles();
+    for(size_t count : {1, 2, 7, 200})
+    {
+      std::vector<float> values = createValues(count, 0, static_cast<uint32_t>(count));
+      QuantileSketch<float> sketch(200);
+      for(float value : values)
+      {
+        sketch.add(value);
+      }
+      DREAM3D_REQUIRE_EQUAL(sketch.getCount(), count)
+
+      std::sort(values.begin(), values.end());
+      std::vector<float> result = sketch.getQuantiles(quantiles);
+      for(size_t i = 0; i < quantiles.size(); i++)
+      {
+        // The same rank interpolation as StatisticsHelpers::findPercentilesInPlace
+        const double rank = static_cast<double>(quantiles[i]) * static_cast<double>(count - 1);
+        const size_t lowRank = static_cast<size_t>(std::floor(rank));
+        const size_t highRank = std::min(lowRank + 1, count - 1);
+        const float fraction = static_cast<float>(rank - static_cast<double>(lowRank));
+        const float expected = (fraction == 0.0f) ? values[lowRank] : values[lowRank] + (values[highRank] - values[lowRank]) * fraction;
+        DREAM3D_REQUIRED(std::abs(result[i] - expected), <=, 1.0e-6f)
+      }
+    }
+
+    QuantileSketch<float> empty(200);
+    for(float value : empty.getQuantiles(quantiles))
+    {
+      DREAM3D_REQUIRE_EQUAL(value, 0.0f)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRankErrorBound()
+  {
+    const std::vector<float> quantiles = createQuantiles();
+    for(double rankError : {0.05, 0.01, 0.001})
+    {
+      const size_t capacity = QuantileSketch<float>::FindCapacity(rankError);
+      for(size_t count : {1000, 100000, 1000000})
+      {
+        for(int32_t order = 0; order < 4; order++)
+        {
+          std::vector<float> values = createValues(count, order, static_cast<uint32_t>(count) + order);
+          QuantileSketch<float> sketch(capacity);
+          for(float value : values)
+          {
+            sketch.add(value);
+          }
+          DREAM3D_REQUIRE_EQUAL(sketch.getCount(), count)
+
+          std::sort(values.begin(), values.end());
+          std::vector<float> result = sketch.getQuantiles(quantiles);
+          for(size_t i = 0; i < quantiles.size(); i++)
+          {
+            DREAM3D_REQUIRED(findRankError(values, quantiles[i], result[i]), <=, rankError)
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMergedRankErrorBound()
+  {
+    // Uneven parts, as the chunks of FindArrayStatistics see them for a Feature
+    const std::vector<float> quantiles = createQuantiles();
+    const double rankError = 0.01;
+    const size_t count = 200000;
+    std::vector<float> values = createValues(count, 0, 11);
+
+    QuantileSketch<float> merged(QuantileSketch<float>::FindCapacity(rankError));
+    QuantileSketch<float> repeated(QuantileSketch<float>::FindCapacity(rankError));
+    for(size_t start = 0, length = 10; start < count; start += length, length *= 3)
+    {
+      QuantileSketch<float> part(QuantileSketch<float>::FindCapacity(rankError));
+      QuantileSketch<float> repeatedPart(QuantileSketch<float>::FindCapacity(rankError));
+      for(size_t i = start; i < std::min(start + length, count); i++)
+      {
+        part.add(values[i]);
+        repeatedPart.add(values[i]);
+      }
+      merged.merge(part);
+      repeated.merge(repeatedPart);
+    }
+    DREAM3D_REQUIRE_EQUAL(merged.getCount(), count)
+
+    std::vector<float> result = merged.getQuantiles(quantiles);
+    DREAM3D_REQUIRE(result == repeated.getQuantiles(quantiles))
+    std::sort(values.begin(), values.end());
+    for(size_t i = 0; i < quantiles.size(); i++)
+    {
+      DREAM3D_REQUIRED(findRankError(values, quantiles[i], result[i]), <=, rankError)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### QuantileSketchTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestExactBelowCapacity())
+    DREAM3D_REGISTER_TEST(TestRankErrorBound())
+    DREAM3D_REGISTER_TEST(TestMergedRankErrorBound())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  QuantileSketchTest(const QuantileSketchTest&) = delete;            // Copy Constructor Not Implemented
+  QuantileSketchTest(QuantileSketchTest&&) = delete;                 // Move Constructor Not Implemented
+  QuantileSketchTest& operator=(const QuantileSketchTest&) = delete; // Copy Assignment Not Implemented
+  QuantileSketchTest& operator=(QuantileSketchTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,246 @@
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/RobustAutomaticThreshold.h"
+
+class RobustAutomaticThresholdTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellAttributeMatrixName = {"CellData"};
+  const QString k_InputName = {"Input"};
+  const QString k_GradientMagnitudeName = {"GradientMagnitude"};
+  const QString k_MaskName = {"Mask"};
+
+public:
+  RobustAutomaticThresholdTest() = default;
+  virtual ~RobustAutomaticThresholdTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief Creates an Image Geometry with an empty Cell Attribute Matrix
+   */
+  DataContainerArray::Pointer createDataStructure(const std::array<size_t, 3>& dims, const std::array<float, 3>& spacing)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    image->setSpacing(FloatVec3Type(spacing[0], spacing[1], spacing[2]));
+    dc->setGeometry(image);
+
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New({dims[0], dims[1], dims[2]}, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  RobustAutomaticThreshold::Pointer createFilter(const DataContainerArray::Pointer& dca, bool useGradientMagnitudeArray)
+  {
+    RobustAutomaticThreshold::Pointer filter = RobustAutomaticThreshold::New();
+    filter->setDataContainerArray(dca);
+    filter->setInputArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_InputName));
+    filter->setUseGradientMagnitudeArray(useGradientMagnitudeArray);
+    filter->setGradientMagnitudeArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_GradientMagnitudeName));
+    filter->setFeatureIdsArrayPath(DataArrayPath(k_DataContainerName, k_CellAttributeMatrixName, k_MaskName));
+    return filter;
+  }
+
+  /**
+   * @brief Computes the gradient magnitude of every Cell from the differences to its neighbors along each axis of
+   * the geometry: central differences inside, one sided differences at the edges and no derivative along an axis
+   * that is a single Cell thick
+   */
+  std::vector<double> findGradientMagnitude(const std::vector<float>& values, const std::array<size_t, 3>& dims, const std::array<float, 3>& spacing)
+  {
+    std::vector<double> gradientMagnitude(values.size(), 0.0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          const std::array<size_t, 3> coords = {x, y, z};
+          double squaredSum = 0.0;
+          for(size_t axis = 0; axis < 3; axis++)
+          {
+            if(dims[axis] < 2)
+            {
+              continue;
+            }
+            std::array<size_t, 3> lower = coords;
+            std::array<size_t, 3> upper = coords;
+            lower[axis] = (coords[axis] > 0) ? coords[axis] - 1 : coords[axis];
+            upper[axis] = (coords[axis] + 1 < dims[axis]) ? coords[axis] + 1 : coords[axis];
+            const double lowerValue = values[(lower[2] * dims[1] + lower[1]) * dims[0] + lower[0]];
+            const double upperValue = values[(upper[2] * dims[1] + upper[1]) * dims[0] + upper[0]];
+            const double derivative = (upperValue - lowerValue) / (static_cast<double>(upper[axis] - lower[axis]) * spacing[axis]);
+            squaredSum += derivative * derivative;
+          }
+          gradientMagnitude[(z * dims[1] + y) * dims[0] + x] = std::sqrt(squaredSum);
+        }
+      }
+    }
+    return gradientMagnitude;
+  }
+
+  /**
+   * @brief Thresholds a smooth field with noise on an anisotropic geometry that is one Cell thick along one axis and
+   * spans more than one chunk, with the gradient computed by the filter, and compares the mask with the threshold
+   * of an explicitly computed gradient magnitude
+   */
+  int checkImageGradient(const std::array<size_t, 3>& dims, const std::array<float, 3>& spacing)
+  {
+    DataContainerArray::Pointer dca = createDataStructure(dims, spacing);
+    const size_t totalPoints = dims[0] * dims[1] * dims[2];
+    DREAM3D_REQUIRED(totalPoints, >, 65536)
+
+    std::mt19937 generator(5);
+    std::normal_distribution<float> noise(0.0f, 4.0f);
+    std::vector<float> values(totalPoints);
+    FloatArrayType::Pointer input = FloatArrayType::CreateArray(totalPoints, k_InputName, true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          const size_t index = (z * dims[1] + y) * dims[0] + x;
+          values[index] = 100.0f + 60.0f * std::sin(0.11f * x * spacing[0] + 0.05f * y * spacing[1]) * std::cos(0.07f * z * spacing[2]) + noise(generator);
+          input->setValue(index, values[index]);
+        }
+      }
+    }
+    dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName)->addOrReplaceAttributeArray(input);
+
+    RobustAutomaticThreshold::Pointer filter = createFilter(dca, false);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    BoolArrayType::Pointer mask = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName)->getAttributeArrayAs<BoolArrayType>(k_MaskName);
+    DREAM3D_REQUIRE_VALID_POINTER(mask.get())
+
+    const std::vector<double> gradientMagnitude = findGradientMagnitude(values, dims, spacing);
+    double numerator = 0.0;
+    double denominator = 0.0;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      numerator += values[i] * gradientMagnitude[i];
+      denominator += gradientMagnitude[i];
+    }
+    const double threshold = numerator / denominator;
+
+    // Values within rounding of the threshold may fall on either side of it
+    size_t numAbove = 0;
+    size_t numBelow = 0;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      if(std::abs(values[i] - threshold) < 1.0E-4 * threshold)
+      {
+        continue;
+      }
+      const bool above = values[i] > threshold;
+      DREAM3D_REQUIRE_EQUAL(mask->getValue(i), above)
+      numAbove += above ? 1 : 0;
+      numBelow += above ? 0 : 1;
+    }
+    DREAM3D_REQUIRED(numAbove, >, totalPoints / 10)
+    DREAM3D_REQUIRED(numBelow, >, totalPoints / 10)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestImageGradient()
+  {
+    DREAM3D_REQUIRE_EQUAL(checkImageGradient({173, 1, 420}, {0.5f, 3.0f, 1.25f}), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(checkImageGradient({1, 260, 270}, {2.0f, 0.75f, 1.5f}), EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestGradientMagnitudeArray()
+  {
+    // Small integer inputs and gradient magnitudes in steps of one half keep every partial sum exact in single
+    // precision, so the threshold of the single precision running sums the filter used to compute is exact as well
+    const std::array<size_t, 3> dims = {290, 250, 1};
+    DataContainerArray::Pointer dca = createDataStructure(dims, {1.0f, 1.0f, 1.0f});
+    const size_t totalPoints = dims[0] * dims[1] * dims[2];
+    DREAM3D_REQUIRED(totalPoints, >, 65536)
+
+    std::mt19937 generator(9);
+    std::uniform_int_distribution<int32_t> inputDistribution(0, 15);
+    std::uniform_int_distribution<int32_t> gradientDistribution(0, 4);
+    UInt8ArrayType::Pointer input = UInt8ArrayType::CreateArray(totalPoints, k_InputName, true);
+    FloatArrayType::Pointer gradientMagnitude = FloatArrayType::CreateArray(totalPoints, k_GradientMagnitudeName, true);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      input->setValue(i, static_cast<uint8_t>(inputDistribution(generator)));
+      // Brighter Cells sit on stronger edges, so the threshold is well above the mean
+      gradientMagnitude->setValue(i, 0.5f * static_cast<float>(std::min(gradientDistribution(generator) + input->getValue(i) / 6, 4)));
+    }
+    AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(k_DataContainerName)->getAttributeMatrix(k_CellAttributeMatrixName);
+    cellAttrMat->addOrReplaceAttributeArray(input);
+    cellAttrMat->addOrReplaceAttributeArray(gradientMagnitude);
+
+    RobustAutomaticThreshold::Pointer filter = createFilter(dca, true);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    BoolArrayType::Pointer mask = cellAttrMat->getAttributeArrayAs<BoolArrayType>(k_MaskName);
+    DREAM3D_REQUIRE_VALID_POINTER(mask.get())
+
+    float numerator = 0;
+    float denominator = 0;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      numerator += (input->getValue(i) * gradientMagnitude->getValue(i));
+      denominator += gradientMagnitude->getValue(i);
+    }
+    const float threshold = numerator / denominator;
+    DREAM3D_REQUIRED(threshold, >, 8.0f)
+    DREAM3D_REQUIRED(threshold, <, 15.0f)
+
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(mask->getValue(i), !(input->getValue(i) < threshold))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### RobustAutomaticThresholdTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestImageGradient())
+    DREAM3D_REGISTER_TEST(TestGradientMagnitudeArray())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  RobustAutomaticThresholdTest(const RobustAutomaticThresholdTest&) = delete;            // Copy Constructor Not Implemented
+  RobustAutomaticThresholdTest(RobustAutomaticThresholdTest&&) = delete;                 // Move Constructor Not Implemented
+  RobustAutomaticThresholdTest& operator=(const RobustAutomaticThresholdTest&) = delete; // Copy Assignment Not Implemented
+  RobustAutomaticThresholdTest& operator=(RobustAutomaticThresholdTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,250 @@
+#include <array>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/SectionComponentLabeling.hpp"
+
+class SectionComponentLabelingTest
+{
+  /**
+   * @brief A section as AdaptiveAlignmentMutualInformation sees it: phases, the good voxel mask and the
+   * misorientation angles to the +x and +y neighbors of every Cell
+   */
+  struct Section
+  {
+    int64_t dimX = 0;
+    int64_t dimY = 0;
+    std::vector<int32_t> phases;
+    std::vector<bool> goodVoxels;
+    std::vector<float> edgeAngles;
+  };
+
+public:
+  SectionComponentLabelingTest() = default;
+  virtual ~SectionComponentLabelingTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief The region growing that form_features_sections used before the union-find: a good Cell with a phase
+   * starts a Feature, which grows into every face neighbor with a phase, good or not, whose misorientation is below
+   * the tolerance.  Seeds are taken in raster order.
+   */
+  int32_t floodFill(const Section& section, float tolerance, std::vector<int32_t>& labels)
+  {
+    const int64_t numCells = section.dimX * section.dimY;
+    labels.assign(static_cast<size_t>(numCells), 0);
+    int32_t numLabels = 0;
+    std::vector<int64_t> voxelsList;
+    for(int64_t seed = 0; seed < numCells; seed++)
+    {
+      if(labels[seed] != 0 || section.phases[seed] <= 0 || !section.goodVoxels[seed])
+      {
+        continue;
+      }
+      numLabels++;
+      labels[seed] = numLabels;
+      voxelsList.assign(1, seed);
+      for(size_t j = 0; j < voxelsList.size(); j++)
+      {
+        const int64_t current = voxelsList[j];
+        const int64_t col = current % section.dimX;
+        const int64_t row = current / section.dimX;
+        // The neighbor and the angle of the edge between it and the current Cell
+        const std::array<std::pair<int64_t, float>, 4> neighbors = {
+            std::make_pair(row > 0 ? current - section.dimX : -1, row > 0 ? section.edgeAngles[2 * (current - section.dimX) + 1] : 0.0f),
+            std::make_pair(col > 0 ? current - 1 : -1, col > 0 ? section.edgeAngles[2 * (current - 1)] : 0.0f),
+            std::make_pair(col < section.dimX - 1 ? current + 1 : -1, section.edgeAngles[2 * current]),
+            std::make_pair(row < section.dimY - 1 ? current + section.dimX : -1, section.edgeAngles[2 * current + 1])};
+        for(const auto& neighbor : neighbors)
+        {
+          if(neighbor.first >= 0 && labels[neighbor.first] <= 0 && section.phases[neighbor.first] > 0 && neighbor.second < tolerance)
+          {
+            labels[neighbor.first] = numLabels;
+            voxelsList.push_back(neighbor.first);
+          }
+        }
+      }
+    }
+    return numLabels;
+  }
+
+  // -----------------------------------------------------------------------------
+  int32_t labelSection(const Section& section, float tolerance, std::vector<int32_t>& labels)
+  {
+    labels.assign(static_cast<size_t>(section.dimX * section.dimY), -1);
+    std::vector<int64_t> parents;
+    const int64_t dimX = section.dimX;
+    return SectionComponentLabeling::LabelSection(
+        section.dimX, section.dimY, [&section](int64_t i) { return section.phases[i] > 0; },
+        [&section, tolerance, dimX](int64_t i, int64_t j) { return section.edgeAngles[2 * i + (j - i == dimX ? 1 : 0)] < tolerance; },
+        [&section](int64_t i) { return section.goodVoxels[i]; }, labels.data(), parents);
+  }
+
+  /**
+   * @brief Requires that both labelings have the same unlabeled Cells and the same components; the labels
+   * themselves may be numbered differently
+   */
+  void checkAgainstFloodFill(const Section& section, float tolerance)
+  {
+    std::vector<int32_t> expected;
+    std::vector<int32_t> labels;
+    const int32_t expectedCount = floodFill(section, tolerance, expected);
+    const int32_t count = labelSection(section, tolerance, labels);
+    DREAM3D_REQUIRE_EQUAL(count, expectedCount)
+
+    std::map<int32_t, int32_t> forward;
+    std::map<int32_t, int32_t> backward;
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+      DREAM3D_REQUIRED(labels[i], >=, 0)
+      DREAM3D_REQUIRED(labels[i], <=, count)
+      DREAM3D_REQUIRE_EQUAL(labels[i] == 0, expected[i] == 0)
+      if(labels[i] == 0)
+      {
+        continue;
+      }
+      auto f = forward.insert({labels[i], expected[i]}).first;
+      auto b = backward.insert({expected[i], labels[i]}).first;
+      DREAM3D_REQUIRE_EQUAL(f->second, expected[i])
+      DREAM3D_REQUIRE_EQUAL(b->second, labels[i])
+    }
+  }
+
+  /**
+   * @brief Creates a section of grains whose neighbors inside a grain are misoriented by less than 1 degree and
+   * across grain boundaries by more than 10 degrees; a fraction of the Cells has no phase and another is masked out
+   */
+  Section createRandomSection(int64_t dimX, int64_t dimY, size_t numGrains, double noPhaseFraction, double maskedFraction, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<std::array<float, 2>> seeds(numGrains);
+    for(auto&& seed : seeds)
+    {
+      seed = {dimX * distribution(generator), dimY * distribution(generator)};
+    }
+
+    Section section;
+    section.dimX = dimX;
+    section.dimY = dimY;
+    const size_t numCells = static_cast<size_t>(dimX * dimY);
+    std::vector<size_t> grains(numCells, 0);
+    section.phases.assign(numCells, 1);
+    section.goodVoxels.assign(numCells, true);
+    section.edgeAngles.assign(2 * numCells, 0.0f);
+    for(int64_t y = 0; y < dimY; y++)
+    {
+      for(int64_t x = 0; x < dimX; x++)
+      {
+        float nearest = std::numeric_limits<float>::max();
+        for(size_t g = 0; g < numGrains; g++)
+        {
+          const float distance = (x - seeds[g][0]) * (x - seeds[g][0]) + (y - seeds[g][1]) * (y - seeds[g][1]);
+          if(distance < nearest)
+          {
+            nearest = distance;
+            grains[y * dimX + x] = g;
+          }
+        }
+      }
+    }
+    for(size_t i = 0; i < numCells; i++)
+    {
+      const float value = distribution(generator);
+      section.phases[i] = (value < noPhaseFraction) ? 0 : 1;
+      section.goodVoxels[i] = (value >= noPhaseFraction + maskedFraction);
+      const size_t right = (static_cast<int64_t>(i % dimX) + 1 < dimX) ? i + 1 : i;
+      const size_t down = (i + dimX < numCells) ? i + dimX : i;
+      section.edgeAngles[2 * i] = (grains[right] == grains[i]) ? 0.01f * distribution(generator) : 0.2f + distribution(generator);
+      section.edgeAngles[2 * i + 1] = (grains[down] == grains[i]) ? 0.01f * distribution(generator) : 0.2f + distribution(generator);
+    }
+    return section;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMaskedBridges()
+  {
+    // Two good regions of one grain joined only by a masked-out bridge form one Feature, and a component of masked
+    // Cells alone stays unlabeled:
+    //   G G . . . . . M M
+    //   G G M M M G G . M
+    //   . . . . . G G . .
+    // G good, M masked out, . no phase
+    const std::vector<std::string> rows = {"GG.....MM", "GGMMMGG.M", ".....GG.."};
+    Section section;
+    section.dimX = static_cast<int64_t>(rows[0].size());
+    section.dimY = static_cast<int64_t>(rows.size());
+    for(const std::string& row : rows)
+    {
+      for(char c : row)
+      {
+        section.phases.push_back(c == '.' ? 0 : 1);
+        section.goodVoxels.push_back(c == 'G');
+      }
+    }
+    section.edgeAngles.assign(2 * section.phases.size(), 0.0f);
+
+    std::vector<int32_t> labels;
+    DREAM3D_REQUIRE_EQUAL(labelSection(section, 0.1f, labels), 1)
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+      const bool bridged = section.phases[i] > 0 && i != 7 && i != 8 && i != 17;
+      DREAM3D_REQUIRE_EQUAL(labels[i], bridged ? 1 : 0)
+    }
+    checkAgainstFloodFill(section, 0.1f);
+
+    // A misoriented bridge splits the two regions
+    section.edgeAngles[2 * 12] = 1.0f;
+    DREAM3D_REQUIRE_EQUAL(labelSection(section, 0.1f, labels), 2)
+    checkAgainstFloodFill(section, 0.1f);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRandomSections()
+  {
+    std::mt19937 generator(1);
+    checkAgainstFloodFill(createRandomSection(40, 30, 20, 0.0, 0.0, generator), 0.1f);
+    checkAgainstFloodFill(createRandomSection(40, 30, 20, 0.1, 0.3, generator), 0.1f);
+    checkAgainstFloodFill(createRandomSection(40, 30, 20, 0.1, 0.6, generator), 0.1f);
+    checkAgainstFloodFill(createRandomSection(64, 17, 40, 0.3, 0.4, generator), 0.1f);
+    // Above the boundary angles every Cell joins its neighbors
+    checkAgainstFloodFill(createRandomSection(40, 30, 20, 0.1, 0.5, generator), 2.0f);
+    checkAgainstFloodFill(createRandomSection(1, 50, 3, 0.1, 0.5, generator), 0.1f);
+    checkAgainstFloodFill(createRandomSection(50, 1, 3, 0.1, 0.5, generator), 0.1f);
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### SectionComponentLabelingTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestMaskedBridges())
+    DREAM3D_REGISTER_TEST(TestRandomSections())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  SectionComponentLabelingTest(const SectionComponentLabelingTest&) = delete;            // Copy Constructor Not Implemented
+  SectionComponentLabelingTest(SectionComponentLabelingTest&&) = delete;                 // Move Constructor Not Implemented
+  SectionComponentLabelingTest& operator=(const SectionComponentLabelingTest&) = delete; // Copy Assignment Not Implemented
+  SectionComponentLabelingTest& operator=(SectionComponentLabelingTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,219 @@
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QMap>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ShapeRasterizer.hpp"
+
+class ShapeRasterizerTest
+{
+public:
+  ShapeRasterizerTest() = default;
+  virtual ~ShapeRasterizerTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief Places a shape with a random orientation, aspect ratio and center.  The ShapeOps must outlive the shape.
+   */
+  ShapeRasterizer::Shape createRandomShape(ShapeOps* shapeOps, const std::array<float, 3>& extent, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    QMap<ShapeOps::ArgName, float> shapeArgMap;
+    shapeArgMap[ShapeOps::Omega3] = 0.3f + 0.7f * unit(generator);
+    shapeArgMap[ShapeOps::VolCur] = 20.0f + 200.0f * unit(generator);
+    shapeArgMap[ShapeOps::B_OverA] = 0.3f + 0.7f * unit(generator);
+    shapeArgMap[ShapeOps::C_OverA] = 0.3f + 0.7f * unit(generator);
+    shapeOps->init();
+    float radcur1 = shapeOps->radcur1(shapeArgMap);
+
+    // The rows of a rotation matrix built from a random unit quaternion
+    std::array<float, 4> q = {normal(generator), normal(generator), normal(generator), normal(generator)};
+    float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for(auto&& value : q)
+    {
+      value /= norm;
+    }
+    const float w = q[0];
+    const float x = q[1];
+    const float y = q[2];
+    const float z = q[3];
+
+    ShapeRasterizer::Shape shape;
+    shape.center = {extent[0] * unit(generator), extent[1] * unit(generator), extent[2] * unit(generator)};
+    float axes[3][3] = {{1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y)},
+                        {2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x)},
+                        {2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y)}};
+    std::copy(&axes[0][0], &axes[0][0] + 9, &shape.axes[0][0]);
+    shape.invRadii = {1.0f / radcur1, 1.0f / (radcur1 * shapeArgMap[ShapeOps::B_OverA]), 1.0f / (radcur1 * shapeArgMap[ShapeOps::C_OverA])};
+    shape.shapeOps = shapeOps;
+    return shape;
+  }
+
+  /**
+   * @brief The per voxel test that the span culling must reproduce: the shape value of a voxel from its axis components
+   */
+  float pointInShape(const ShapeRasterizer::Shape& shape, const std::array<float, 3>& spacing, int64_t column, int64_t row, int64_t plane)
+  {
+    const float c0 = float(column) * spacing[0] - shape.center[0];
+    const float c1 = float(row) * spacing[1] - shape.center[1];
+    const float c2 = float(plane) * spacing[2] - shape.center[2];
+    const float axis1comp = (shape.axes[0][0] * c0 + shape.axes[0][1] * c1 + shape.axes[0][2] * c2) * shape.invRadii[0];
+    const float axis2comp = (shape.axes[1][0] * c0 + shape.axes[1][1] * c1 + shape.axes[1][2] * c2) * shape.invRadii[1];
+    const float axis3comp = (shape.axes[2][0] * c0 + shape.axes[2][1] * c1 + shape.axes[2][2] * c2) * shape.invRadii[2];
+    return shape.shapeOps->inside(axis1comp, axis2comp, axis3comp);
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRowSpans()
+  {
+    const std::array<float, 3> spacing = {0.5f, 0.75f, 1.25f};
+    const int64_t numColumns = 60;
+    const int64_t numRows = 40;
+    const int64_t numPlanes = 24;
+
+    std::mt19937 generator(1);
+    QVector<ShapeOps::Pointer> shapeOpsList = ShapeOps::getShapeOpsQVector();
+    for(const ShapeOps::Pointer& shapeOps : shapeOpsList)
+    {
+      for(int32_t s = 0; s < 10; s++)
+      {
+        ShapeRasterizer::Shape shape = createRandomShape(shapeOps.get(), {numColumns * spacing[0], numRows * spacing[1], numPlanes * spacing[2]}, generator);
+        std::vector<float> scratch;
+        size_t numInside = 0;
+        for(int64_t plane = 0; plane < numPlanes; plane++)
+        {
+          for(int64_t row = 0; row < numRows; row++)
+          {
+            std::vector<float> values(numColumns, -1.0f);
+            std::vector<int32_t> visits(numColumns, 0);
+            ShapeRasterizer::RasterizeRow(shape, spacing, row, plane, 0, numColumns - 1, scratch, [&](int64_t column, float inside) {
+              DREAM3D_REQUIRED(column, >=, 0)
+              DREAM3D_REQUIRED(column, <, numColumns)
+              values[column] = inside;
+              visits[column]++;
+            });
+
+            // Every voxel that passes the point test must be visited exactly once and with the same shape value
+            for(int64_t column = 0; column < numColumns; column++)
+            {
+              float expected = pointInShape(shape, spacing, column, row, plane);
+              if(expected >= 0)
+              {
+                DREAM3D_REQUIRE_EQUAL(visits[column], 1)
+                DREAM3D_REQUIRE_EQUAL(values[column], expected)
+                numInside++;
+              }
+              else
+              {
+                DREAM3D_REQUIRE_EQUAL(visits[column], 0)
+              }
+            }
+          }
+        }
+        DREAM3D_REQUIRED(numInside, >, 0)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestRasterizeShape()
+  {
+    const std::array<int64_t, 3> dims = {32, 28, 20};
+    const std::array<float, 3> spacing = {1.0f, 1.0f, 1.5f};
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    std::mt19937 generator(2);
+    QVector<ShapeOps::Pointer> shapeOpsList = ShapeOps::getShapeOpsQVector();
+    std::vector<int32_t> owners(totalPoints, -1);
+    std::vector<float> shapeValues(totalPoints, -1.0f);
+    std::vector<int32_t> expectedOwners(totalPoints, -1);
+    std::vector<float> expectedValues(totalPoints, -1.0f);
+
+    int32_t featureId = 1;
+    for(const ShapeOps::Pointer& shapeOps : shapeOpsList)
+    {
+      for(int32_t s = 0; s < 6; s++, featureId++)
+      {
+        ShapeRasterizer::Shape shape = createRandomShape(shapeOps.get(), {dims[0] * spacing[0], dims[1] * spacing[1], dims[2] * spacing[2]}, generator);
+
+        // Boxes around the center that cross the image boundary exercise the periodic wrap, and every other box spans
+        // more than the image so that it wraps onto itself
+        std::array<int64_t, 6> bounds;
+        for(size_t d = 0; d < 3; d++)
+        {
+          int64_t center = static_cast<int64_t>(shape.center[d] / spacing[d]);
+          int64_t halfWidth = (s % 2 == 0) ? static_cast<int64_t>(1.0f / (shape.invRadii[0] * spacing[d])) + 1 : dims[d] / 2 + 2;
+          bounds[2 * d] = std::max(center - halfWidth, -dims[d]);
+          bounds[2 * d + 1] = std::min(center + halfWidth, 2 * dims[d] - 1);
+        }
+
+        ShapeRasterizer::RasterizeShape(shape, featureId, dims, spacing, bounds, owners.data(), shapeValues.data());
+
+        for(int64_t plane = bounds[4]; plane <= bounds[5]; plane++)
+        {
+          for(int64_t row = bounds[2]; row <= bounds[3]; row++)
+          {
+            for(int64_t column = bounds[0]; column <= bounds[1]; column++)
+            {
+              float inside = pointInShape(shape, spacing, column, row, plane);
+              if(inside < 0)
+              {
+                continue;
+              }
+              int64_t index = ((plane + dims[2]) % dims[2] * dims[1] + (row + dims[1]) % dims[1]) * dims[0] + (column + dims[0]) % dims[0];
+              if((expectedOwners[index] > 0 && inside > expectedValues[index]) || expectedOwners[index] == -1)
+              {
+                expectedOwners[index] = featureId;
+                expectedValues[index] = inside;
+              }
+            }
+          }
+        }
+
+        for(int64_t i = 0; i < totalPoints; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(owners[i], expectedOwners[i])
+          DREAM3D_REQUIRE_EQUAL(shapeValues[i], expectedValues[i])
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### ShapeRasterizerTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestRowSpans())
+    DREAM3D_REGISTER_TEST(TestRasterizeShape())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  ShapeRasterizerTest(const ShapeRasterizerTest&) = delete;            // Copy Constructor Not Implemented
+  ShapeRasterizerTest(ShapeRasterizerTest&&) = delete;                 // Move Constructor Not Implemented
+  ShapeRasterizerTest& operator=(const ShapeRasterizerTest&) = delete; // Copy Assignment Not Implemented
+  ShapeRasterizerTest& operator=(ShapeRasterizerTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,166 @@
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/SymmetricMisorientation.hpp"
+
+class SymmetricMisorientationTest
+{
+  using Quaternion = std::array<float, 4>;
+
+public:
+  SymmetricMisorientationTest() = default;
+  virtual ~SymmetricMisorientationTest() = default;
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+  }
+
+  /**
+   * @brief Returns a uniformly distributed unit quaternion, stored as (x, y, z, w) like the Quats arrays
+   */
+  Quaternion createRandomQuaternion(std::mt19937& generator)
+  {
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    Quaternion q = {distribution(generator), distribution(generator), distribution(generator), distribution(generator)};
+    const float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for(auto&& value : q)
+    {
+      value /= norm;
+    }
+    return q;
+  }
+
+  // -----------------------------------------------------------------------------
+  double findLaueOpsAngle(const LaueOps& ops, const Quaternion& q1, const Quaternion& q2)
+  {
+    return ops.calculateMisorientation(QuatF(q1[0], q1[1], q1[2], q1[3]), QuatF(q2[0], q2[1], q2[2], q2[3]))[3];
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestBatchedAgainstLaueOps()
+  {
+    constexpr size_t k_NumPairs = 2000;
+    std::mt19937 generator(1);
+
+    LaueOpsContainer orientationOps = LaueOps::GetAllOrientationOps();
+    DREAM3D_REQUIRED(orientationOps.size(), >, 0)
+    for(const LaueOpsShPtrType& ops : orientationOps)
+    {
+      const SymmetricMisorientation::SymmetryTable table = SymmetricMisorientation::CreateSymmetryTable(*ops);
+      DREAM3D_REQUIRE_EQUAL(table.w.size(), static_cast<size_t>(ops->getNumSymOps()))
+
+      std::vector<Quaternion> q1(k_NumPairs);
+      std::vector<Quaternion> q2(k_NumPairs);
+      std::vector<double> w(k_NumPairs);
+      std::vector<double> x(k_NumPairs);
+      std::vector<double> y(k_NumPairs);
+      std::vector<double> z(k_NumPairs);
+      for(size_t i = 0; i < k_NumPairs; i++)
+      {
+        q1[i] = createRandomQuaternion(generator);
+        q2[i] = createRandomQuaternion(generator);
+        // Every other pair is close, where the angle is most sensitive to the product order
+        if(i % 2 == 1)
+        {
+          const Quaternion delta = createRandomQuaternion(generator);
+          const float scale = 0.05f;
+          const float norm = std::sqrt(1.0f + scale * scale * (delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]));
+          const QuatD r(scale * delta[0] / norm, scale * delta[1] / norm, scale * delta[2] / norm, 1.0f / norm);
+          const QuatD near = r * QuatD(q1[i][0], q1[i][1], q1[i][2], q1[i][3]);
+          q2[i] = {static_cast<float>(near.x()), static_cast<float>(near.y()), static_cast<float>(near.z()), static_cast<float>(near.w())};
+        }
+        const QuatD product = SymmetricMisorientation::FindMisorientationProduct(q1[i].data(), q2[i].data());
+        w[i] = product.w();
+        x[i] = product.x();
+        y[i] = product.y();
+        z[i] = product.z();
+      }
+
+      std::vector<double> best(k_NumPairs, 0.0);
+      SymmetricMisorientation::FindMaxSymmetricCosines(table, w.data(), x.data(), y.data(), z.data(), k_NumPairs, best.data());
+      for(size_t i = 0; i < k_NumPairs; i++)
+      {
+        const double expected = findLaueOpsAngle(*ops, q1[i], q2[i]);
+        const double angle = SymmetricMisorientation::FindAngle(best[i]);
+        DREAM3D_REQUIRED(std::abs(angle - expected), <, 1.0e-3)
+
+        // The single pair form must give the same cosine as the batch
+        const QuatD product = SymmetricMisorientation::FindMisorientationProduct(q1[i].data(), q2[i].data());
+        DREAM3D_REQUIRED(std::abs(SymmetricMisorientation::FindMaxSymmetricCosine(table, product) - best[i]), <, 1.0e-12)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestToleranceBoundary()
+  {
+    // A pair misoriented by the tolerance plus or minus 1e-4 radians must be classified the same way by the cosine
+    // test and by comparing the LaueOps angle.  Every Laue class has no symmetric equivalent within 60 degrees of the
+    // identity, so a rotation of at most 15 degrees is its own misorientation.
+    constexpr double k_Delta = 1.0e-4;
+    std::mt19937 generator(2);
+    LaueOpsContainer orientationOps = LaueOps::GetAllOrientationOps();
+    for(double toleranceDeg : {1.0, 5.0, 15.0})
+    {
+      const double tolerance = toleranceDeg * SIMPLib::Constants::k_PiOver180D;
+      const double cosHalfTolerance = std::cos(0.5 * tolerance);
+      for(const LaueOpsShPtrType& ops : orientationOps)
+      {
+        const SymmetricMisorientation::SymmetryTable table = SymmetricMisorientation::CreateSymmetryTable(*ops);
+        for(size_t i = 0; i < 50; i++)
+        {
+          for(double angle : {tolerance - k_Delta, tolerance + k_Delta})
+          {
+            const Quaternion q1 = createRandomQuaternion(generator);
+            const Quaternion axis = createRandomQuaternion(generator);
+            const double axisNorm = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+            const double sinHalf = std::sin(0.5 * angle) / axisNorm;
+            const QuatD r(sinHalf * axis[0], sinHalf * axis[1], sinHalf * axis[2], std::cos(0.5 * angle));
+            // q1 * q2^-1 = r
+            const QuatD rotated = r.conjugate() * QuatD(q1[0], q1[1], q1[2], q1[3]);
+            const Quaternion q2 = {static_cast<float>(rotated.x()), static_cast<float>(rotated.y()), static_cast<float>(rotated.z()), static_cast<float>(rotated.w())};
+
+            const bool expected = angle > tolerance;
+            const double best = SymmetricMisorientation::FindMaxSymmetricCosine(table, SymmetricMisorientation::FindMisorientationProduct(q1.data(), q2.data()));
+            DREAM3D_REQUIRE_EQUAL(best < cosHalfTolerance, expected)
+            DREAM3D_REQUIRE_EQUAL(findLaueOpsAngle(*ops, q1, q2) > tolerance, expected)
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "###### SymmetricMisorientationTest ######" << std::endl;
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestBatchedAgainstLaueOps())
+    DREAM3D_REGISTER_TEST(TestToleranceBoundary())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+public:
+  SymmetricMisorientationTest(const SymmetricMisorientationTest&) = delete;            // Copy Constructor Not Implemented
+  SymmetricMisorientationTest(SymmetricMisorientationTest&&) = delete;                 // Move Constructor Not Implemented
+  SymmetricMisorientationTest& operator=(const SymmetricMisorientationTest&) = delete; // Copy Assignment Not Implemented
+  SymmetricMisorientationTest& operator=(SymmetricMisorientationTest&&) = delete;      // Move Assignment Not Implemented
+};